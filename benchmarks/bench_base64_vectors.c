@@ -0,0 +1,98 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+ * @brief Measures writing, exporting, importing and reading a large vector
+ * stored as exact decimal text ("%.17g") and stored base64 encoded
+ * (tixiUseBase64Vectors).
+ *
+ * Usage: bench_base64_vectors [number of values]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tixi.h"
+#include "benchmarkTimer.h"
+
+static int measure(const char* name, int useBase64, const double* values, int nValues)
+{
+  TixiDocumentHandle handle = -1;
+  TixiDocumentHandle importedHandle = -1;
+  double start, writeTime, exportTime, importTime, readTime;
+  double* readValues = NULL;
+  char* xml = NULL;
+  size_t length = 0;
+  int i, nErrors = 0;
+
+  tixiCreateDocument("root", &handle);
+  tixiUseBase64Vectors(handle, useBase64);
+
+  start = benchmarkSeconds();
+  nErrors += tixiAddFloatVector(handle, "/root", "vector", values, nValues, "%.17g") != SUCCESS;
+  writeTime = benchmarkSeconds() - start;
+
+  start = benchmarkSeconds();
+  nErrors += tixiExportDocumentAsString(handle, &xml) != SUCCESS;
+  exportTime = benchmarkSeconds() - start;
+  length = xml ? strlen(xml) : 0;
+
+  start = benchmarkSeconds();
+  nErrors += tixiImportFromString(xml, &importedHandle) != SUCCESS;
+  importTime = benchmarkSeconds() - start;
+
+  start = benchmarkSeconds();
+  if (tixiGetFloatVector(importedHandle, "/root/vector", &readValues, nValues) != SUCCESS) {
+    nErrors++;
+  }
+  readTime = benchmarkSeconds() - start;
+
+  for (i = 0; readValues && i < nValues; ++i) {
+    nErrors += readValues[i] != values[i];
+  }
+
+  printf("%-8s %10lu bytes  write %8.3f ms  export %8.3f ms  import %8.3f ms  read %8.3f ms\n",
+         name, (unsigned long) length, 1e3 * writeTime, 1e3 * exportTime, 1e3 * importTime, 1e3 * readTime);
+
+  tixiCloseDocument(importedHandle);
+  tixiCloseDocument(handle);
+  return nErrors;
+}
+
+int main(int argc, char* argv[])
+{
+  int nValues = argc > 1 ? atoi(argv[1]) : 1000000;
+  double* values = NULL;
+  int i, nErrors = 0;
+
+  if (nValues <= 0) {
+    fprintf(stderr, "Usage: %s [number of values]\n", argv[0]);
+    return 1;
+  }
+
+  values = (double*) malloc(nValues * sizeof(double));
+  for (i = 0; i < nValues; ++i) {
+    values[i] = 0.001 * (double) (i % 100000) - 17.25 * (double) (i % 7) + 1. / (double) (i + 3);
+  }
+
+  printf("values: %d\n", nValues);
+  nErrors += measure("text", 0, values, nValues);
+  nErrors += measure("base64", 1, values, nValues);
+
+  free(values);
+  tixiCleanup();
+  return nErrors == 0 ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+ * @brief Measures reading the coordinates of all points of a document by
+ * single tixiGetDoubleElement calls and by tixiGetValues batches, where
+ * the coordinates of a point share the path prefix.
+ *
+ * Usage: bench_batch_getter [number of points] [number of repetitions]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tixi.h"
+#include "benchmarkTimer.h"
+
+#define PATH_LENGTH 128
+
+static const char* coordinates[] = {"x", "y", "z", "@weight"};
+
+int main(int argc, char* argv[])
+{
+  int nPoints = argc > 1 ? atoi(argv[1]) : 500;
+  int nRepetitions = argc > 2 ? atoi(argv[2]) : 50;
+  TixiDocumentHandle handle = -1;
+  char* pathBuffer = NULL;
+  const char** paths = NULL;
+  int* types = NULL;
+  double* values = NULL;
+  ReturnCode* errors = NULL;
+  double start, singleTime, batchTime;
+  int i, j, nValues, nErrors = 0;
+
+  if (nPoints <= 0 || nRepetitions <= 0) {
+    fprintf(stderr, "Usage: %s [number of points] [number of repetitions]\n", argv[0]);
+    return 1;
+  }
+
+  nValues = 4 * nPoints;
+  pathBuffer = (char*) malloc(nValues * PATH_LENGTH);
+  paths = (const char**) malloc(nValues * sizeof(const char*));
+  types = (int*) malloc(nValues * sizeof(int));
+  values = (double*) malloc(nValues * sizeof(double));
+  errors = (ReturnCode*) malloc(nValues * sizeof(ReturnCode));
+
+  tixiCreateDocument("model", &handle);
+  tixiCreateElement(handle, "/model", "geometry");
+  tixiCreateElement(handle, "/model/geometry", "points");
+  for (i = 0; i < nPoints; ++i) {
+    char path[PATH_LENGTH];
+    tixiCreateElement(handle, "/model/geometry/points", "point");
+    sprintf(path, "/model/geometry/points/point[%d]", i + 1);
+    tixiAddDoubleAttribute(handle, path, "weight", (double) i, "%g");
+    for (j = 0; j < 3; ++j) {
+      tixiAddDoubleElement(handle, path, coordinates[j], (double) i, "%g");
+    }
+    for (j = 0; j < 4; ++j) {
+      char* target = pathBuffer + (4 * i + j) * PATH_LENGTH;
+      sprintf(target, "%s/%s", path, coordinates[j]);
+      paths[4 * i + j] = target;
+      types[4 * i + j] = VALUETYPE_DOUBLE;
+    }
+  }
+
+  start = benchmarkSeconds();
+  for (i = 0; i < nRepetitions; ++i) {
+    for (j = 0; j < nValues; ++j) {
+      char* attribute = strrchr(paths[j], '@');
+      if (attribute) {
+        char path[PATH_LENGTH];
+        memcpy(path, paths[j], attribute - paths[j] - 1);
+        path[attribute - paths[j] - 1] = '\0';
+        if (tixiGetDoubleAttribute(handle, path, attribute + 1, &values[j]) != SUCCESS) {
+          nErrors++;
+        }
+      }
+      else if (tixiGetDoubleElement(handle, paths[j], &values[j]) != SUCCESS) {
+        nErrors++;
+      }
+    }
+  }
+  singleTime = benchmarkSeconds() - start;
+
+  start = benchmarkSeconds();
+  for (i = 0; i < nRepetitions; ++i) {
+    if (tixiGetValues(handle, paths, types, nValues, values, errors) != SUCCESS) {
+      nErrors++;
+    }
+  }
+  batchTime = benchmarkSeconds() - start;
+
+  for (j = 0; j < nValues; ++j) {
+    if (errors[j] != SUCCESS || values[j] != (double) (j / 4)) {
+      nErrors++;
+    }
+  }
+
+  printf("values:          %d\n", nValues);
+  printf("single getters:  %10.3f us/value\n", 1e6 * singleTime / nRepetitions / nValues);
+  printf("tixiGetValues:   %10.3f us/value\n", 1e6 * batchTime / nRepetitions / nValues);
+  printf("speedup:         %10.2f\n", singleTime / batchTime);
+
+  tixiCloseDocument(handle);
+  tixiCleanup();
+  free(pathBuffer);
+  free(paths);
+  free(types);
+  free(values);
+  free(errors);
+  return nErrors == 0 ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+ * @brief Measures the typical loop over indexed children
+ * (tixiGetNamedChildrenCount followed by reading section[i]/x) with
+ * positional steps answered by the child index and by the XPath engine,
+ * and updating the x elements, which keeps the index of the sections.
+ *
+ * Usage: bench_child_index [number of sections]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tixi.h"
+#include "benchmarkTimer.h"
+
+/* reads all sections, returns the number of errors */
+static int readSections(TixiDocumentHandle handle, const char* format)
+{
+  int i, count = 0, nErrors = 0;
+
+  if (tixiGetNamedChildrenCount(handle, "/root/sections", "section", &count) != SUCCESS) {
+    return 1;
+  }
+  for (i = 1; i <= count; ++i) {
+    char path[128];
+    int x = 0;
+    sprintf(path, format, i);
+    if (tixiGetIntegerElement(handle, path, &x) != SUCCESS || x != i) {
+      nErrors++;
+    }
+  }
+  return nErrors;
+}
+
+/* updates all sections, which must keep the index of the other sections */
+static int updateSections(TixiDocumentHandle handle)
+{
+  int i, count = 0, nErrors = 0;
+
+  if (tixiGetNamedChildrenCount(handle, "/root/sections", "section", &count) != SUCCESS) {
+    return 1;
+  }
+  for (i = 1; i <= count; ++i) {
+    char path[128];
+    sprintf(path, "/root/sections/section[%d]/x", i);
+    if (tixiUpdateIntegerElement(handle, path, i, "%d") != SUCCESS) {
+      nErrors++;
+    }
+  }
+  return nErrors;
+}
+
+int main(int argc, char* argv[])
+{
+  int nSections = argc > 1 ? atoi(argv[1]) : 2000;
+  TixiDocumentHandle handle = -1;
+  double start, indexedTime, xpathTime, updateTime;
+  int i, nErrors = 0;
+
+  if (nSections <= 0) {
+    fprintf(stderr, "Usage: %s [number of sections]\n", argv[0]);
+    return 1;
+  }
+
+  tixiCreateDocument("root", &handle);
+  tixiCreateElement(handle, "/root", "sections");
+  for (i = 0; i < nSections; ++i) {
+    char path[128];
+    tixiCreateElement(handle, "/root/sections", "section");
+    sprintf(path, "/root/sections/section[%d]", i + 1);
+    tixiAddIntegerElement(handle, path, "x", i + 1, "%d");
+  }
+
+  start = benchmarkSeconds();
+  nErrors += readSections(handle, "/root/sections/section[%d]/x");
+  indexedTime = benchmarkSeconds() - start;
+
+  /* position() is not a simple path and is evaluated by the XPath engine */
+  start = benchmarkSeconds();
+  nErrors += readSections(handle, "/root/sections/section[position()=%d]/x");
+  xpathTime = benchmarkSeconds() - start;
+
+  start = benchmarkSeconds();
+  nErrors += updateSections(handle);
+  updateTime = benchmarkSeconds() - start;
+
+  printf("sections:        %d\n", nSections);
+  printf("child index:     %10.3f ms\n", 1e3 * indexedTime);
+  printf("xpath:           %10.3f ms\n", 1e3 * xpathTime);
+  printf("speedup:         %10.2f\n", xpathTime / indexedTime);
+  printf("update:          %10.3f ms\n", 1e3 * updateTime);
+
+  tixiCloseDocument(handle);
+  tixiCleanup();
+  return nErrors == 0 ? 0 : 1;
+}
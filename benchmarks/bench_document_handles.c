@@ -0,0 +1,90 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+ * @brief Measures the cost of resolving a document handle while many
+ * documents are open.
+ *
+ * Usage: bench_document_handles [number of documents] [number of lookups]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tixi.h"
+#include "benchmarkTimer.h"
+
+static void silentMessageHandler(MessageType type, const char* message)
+{
+  (void) type;
+  (void) message;
+}
+
+int main(int argc, char* argv[])
+{
+  int nDocuments = argc > 1 ? atoi(argv[1]) : 10000;
+  int nLookups   = argc > 2 ? atoi(argv[2]) : 1000000;
+  TixiDocumentHandle* handles = NULL;
+  double start, openTime, lookupTime, closeTime;
+  char* text = NULL;
+  int i, nErrors = 0;
+
+  if (nDocuments <= 0 || nLookups <= 0) {
+    fprintf(stderr, "Usage: %s [number of documents] [number of lookups]\n", argv[0]);
+    return 1;
+  }
+
+  handles = (TixiDocumentHandle*) malloc(nDocuments * sizeof(TixiDocumentHandle));
+  if (!handles) {
+    return 1;
+  }
+
+  tixiSetPrintMsgFunc(silentMessageHandler);
+
+  start = benchmarkSeconds();
+  for (i = 0; i < nDocuments; ++i) {
+    if (tixiImportFromString("<root><a>text</a></root>", &handles[i]) != SUCCESS) {
+      fprintf(stderr, "Could not create document %d\n", i);
+      return 1;
+    }
+  }
+  openTime = benchmarkSeconds() - start;
+
+  /* resolve handles spread over the whole table, the newest documents are
+     the worst case for a linear search */
+  start = benchmarkSeconds();
+  for (i = 0; i < nLookups; ++i) {
+    TixiDocumentHandle handle = handles[nDocuments - 1 - (int) ((i * 7919L) % nDocuments)];
+    if (tixiGetTextElement(handle, "/root/a", &text) != SUCCESS) {
+      nErrors++;
+    }
+  }
+  lookupTime = benchmarkSeconds() - start;
+
+  start = benchmarkSeconds();
+  for (i = 0; i < nDocuments; ++i) {
+    tixiCloseDocument(handles[i]);
+  }
+  closeTime = benchmarkSeconds() - start;
+
+  printf("documents:       %d\n", nDocuments);
+  printf("open:            %10.3f us/document\n", 1e6 * openTime / nDocuments);
+  printf("lookup:          %10.3f us/call (%d calls)\n", 1e6 * lookupTime / nLookups, nLookups);
+  printf("close:           %10.3f us/document\n", 1e6 * closeTime / nDocuments);
+
+  free(handles);
+  tixiCleanup();
+  return nErrors == 0 ? 0 : 1;
+}
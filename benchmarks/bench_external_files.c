@@ -0,0 +1,137 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+ * @brief Compares opening a document split into many external files with
+ * tixiOpenDocumentRecursive to opening the same content from one file.
+ * The external files are read and parsed concurrently.
+ *
+ * Usage: bench_external_files [number of files] [points per file]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tixi.h"
+#include "benchmarkTimer.h"
+
+#define MAIN_FILE   "bench_external_main.xml"
+#define INLINE_FILE "bench_external_inline.xml"
+
+static void writeComponent(FILE* file, int index, int nPoints)
+{
+  int i;
+
+  fprintf(file, "<component uID=\"component%d\">\n", index);
+  for (i = 0; i < nPoints; ++i) {
+    fprintf(file, "  <point><x>%d.5</x><y>%d.25</y><z>%d.125</z></point>\n", i, index, i + index);
+  }
+  fprintf(file, "</component>\n");
+}
+
+static int writeDocuments(int nFiles, int nPoints)
+{
+  FILE* mainFile = fopen(MAIN_FILE, "w");
+  FILE* inlineFile = fopen(INLINE_FILE, "w");
+  int i;
+
+  if (!mainFile || !inlineFile) {
+    return 1;
+  }
+  fprintf(mainFile, "<?xml version=\"1.0\"?>\n<model>\n");
+  fprintf(inlineFile, "<?xml version=\"1.0\"?>\n<model>\n");
+  for (i = 0; i < nFiles; ++i) {
+    char fileName[64];
+    FILE* component = NULL;
+
+    sprintf(fileName, "bench_external_%d.xml", i);
+    component = fopen(fileName, "w");
+    if (!component) {
+      return 1;
+    }
+    writeComponent(component, i, nPoints);
+    fclose(component);
+    writeComponent(inlineFile, i, nPoints);
+    fprintf(mainFile, "<externaldata><path></path><filename>%s</filename></externaldata>\n", fileName);
+  }
+  fprintf(mainFile, "</model>\n");
+  fprintf(inlineFile, "</model>\n");
+  fclose(mainFile);
+  fclose(inlineFile);
+  return 0;
+}
+
+static void removeDocuments(int nFiles)
+{
+  int i;
+
+  for (i = 0; i < nFiles; ++i) {
+    char fileName[64];
+    sprintf(fileName, "bench_external_%d.xml", i);
+    remove(fileName);
+  }
+  remove(MAIN_FILE);
+  remove(INLINE_FILE);
+}
+
+/* opens the document and checks the number of components */
+static double openDocument(const char* fileName, OpenMode oMode, int nFiles, int* nErrors)
+{
+  TixiDocumentHandle handle = -1;
+  double start = benchmarkSeconds(), seconds;
+  int count = 0;
+
+  if (tixiOpenDocumentRecursive(fileName, &handle, oMode) != SUCCESS) {
+    (*nErrors)++;
+    return 0.;
+  }
+  seconds = benchmarkSeconds() - start;
+  if (tixiGetNamedChildrenCount(handle, "/model", "component", &count) != SUCCESS || count != nFiles) {
+    (*nErrors)++;
+  }
+  tixiCloseDocument(handle);
+  return seconds;
+}
+
+int main(int argc, char* argv[])
+{
+  int nFiles = argc > 1 ? atoi(argv[1]) : 256;
+  int nPoints = argc > 2 ? atoi(argv[2]) : 2000;
+  double inlineTime, externalTime;
+  int nErrors = 0;
+
+  if (nFiles <= 0 || nPoints <= 0) {
+    fprintf(stderr, "Usage: %s [number of files] [points per file]\n", argv[0]);
+    return 1;
+  }
+  if (writeDocuments(nFiles, nPoints) != 0) {
+    fprintf(stderr, "Could not write the documents\n");
+    removeDocuments(nFiles);
+    return 1;
+  }
+
+  inlineTime = openDocument(INLINE_FILE, OPENMODE_PLAIN, nFiles, &nErrors);
+  externalTime = openDocument(MAIN_FILE, OPENMODE_RECURSIVE, nFiles, &nErrors);
+
+  printf("files:           %d\n", nFiles);
+  printf("points per file: %d\n", nPoints);
+  printf("one file:        %10.3f ms\n", 1e3 * inlineTime);
+  printf("external files:  %10.3f ms\n", 1e3 * externalTime);
+
+  removeDocuments(nFiles);
+  tixiCleanup();
+  return nErrors == 0 ? 0 : 1;
+}
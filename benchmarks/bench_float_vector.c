@@ -0,0 +1,89 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+ * @brief Measures writing a large vector with tixiAddFloatVector and
+ * tixiUpdateFloatVector using the default format and an explicit format,
+ * compared to formatting the same values with snprintf alone.
+ *
+ * Usage: bench_float_vector [number of values]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tixi.h"
+#include "benchmarkTimer.h"
+
+int main(int argc, char* argv[])
+{
+  int nValues = argc > 1 ? atoi(argv[1]) : 1000000;
+  TixiDocumentHandle handle = -1;
+  double start, snprintfTime, defaultTime, formatTime;
+  double* values = NULL;
+  double* readValues = NULL;
+  int i, nErrors = 0;
+  size_t length = 0;
+
+  if (nValues <= 0) {
+    fprintf(stderr, "Usage: %s [number of values]\n", argv[0]);
+    return 1;
+  }
+
+  values = (double*) malloc(nValues * sizeof(double));
+  for (i = 0; i < nValues; ++i) {
+    values[i] = 0.001 * (double) (i % 100000) - 17.25 * (double) (i % 7);
+  }
+
+  /* lower bound: formatting only, without building the text */
+  start = benchmarkSeconds();
+  for (i = 0; i < nValues; ++i) {
+    char number[32];
+    length += (size_t) snprintf(number, sizeof(number), "%g", values[i]);
+  }
+  snprintfTime = benchmarkSeconds() - start;
+
+  tixiCreateDocument("root", &handle);
+
+  start = benchmarkSeconds();
+  nErrors += tixiAddFloatVector(handle, "/root", "vector", values, nValues, NULL) != SUCCESS;
+  defaultTime = benchmarkSeconds() - start;
+
+  start = benchmarkSeconds();
+  nErrors += tixiUpdateFloatVector(handle, "/root/vector", values, nValues, "%.6f") != SUCCESS;
+  formatTime = benchmarkSeconds() - start;
+
+  if (tixiGetFloatVector(handle, "/root/vector", &readValues, nValues) != SUCCESS) {
+    nErrors++;
+  }
+  else {
+    for (i = 0; i < nValues; ++i) {
+      if (readValues[i] < values[i] - 1e-6 || readValues[i] > values[i] + 1e-6) {
+        nErrors++;
+      }
+    }
+  }
+
+  printf("values:          %d (%lu characters)\n", nValues, (unsigned long) length);
+  printf("snprintf only:   %10.3f ms\n", 1e3 * snprintfTime);
+  printf("default format:  %10.3f ms\n", 1e3 * defaultTime);
+  printf("format \"%%.6f\":   %10.3f ms\n", 1e3 * formatTime);
+
+  free(values);
+  tixiCloseDocument(handle);
+  tixiCleanup();
+  return nErrors == 0 ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+ * @brief Measures the open time and the peak memory of opening a large
+ * CPACS like file with tixiOpenDocument and with the options of
+ * tixiOpenDocumentWithOptions, including loading only one profile. Each
+ * variant is opened in a new process, so that the peak memory of the
+ * variants is measured separately.
+ *
+ * Usage: bench_open_options [size in MB] [file name]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tixi.h"
+#include "benchmarkTimer.h"
+
+#ifdef _WIN32
+#include <psapi.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "psapi.lib")
+#endif
+
+static double peakMemoryMB(void)
+{
+  PROCESS_MEMORY_COUNTERS counters;
+  GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+  return (double) counters.PeakWorkingSetSize / (1024. * 1024.);
+}
+#else
+#include <sys/resource.h>
+
+static double peakMemoryMB(void)
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return (double) usage.ru_maxrss / (1024. * 1024.);
+#else
+  return (double) usage.ru_maxrss / 1024.;
+#endif
+}
+#endif
+
+#define NUMBER_OF_VARIANTS 7
+
+static const char* variantNames[NUMBER_OF_VARIANTS] = {
+  "tixiOpenDocument", "size hint 16 MB", "memory map", "compact", "compact, memory map", "keep blanks", "include one profile"
+};
+
+static const int variantFlags[NUMBER_OF_VARIANTS] = {
+  0, 0, OPENFLAG_MEMORY_MAP, OPENFLAG_COMPACT, OPENFLAG_COMPACT | OPENFLAG_MEMORY_MAP, OPENFLAG_KEEP_BLANKS, 0
+};
+
+/* writes wings with profiles of points until the file has the given size */
+static int writeDocument(const char* fileName, double sizeMB)
+{
+  FILE* file = fopen(fileName, "w");
+  long nPoints = 0;
+  int iProfile = 0;
+
+  if (!file) {
+    return 0;
+  }
+  fprintf(file, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<cpacs>\n  <vehicles>\n    <aircraft>\n      <model uID=\"model\">\n");
+  fprintf(file, "        <wingAirfoils>\n");
+  while (ftell(file) < (long) (sizeMB * 1024. * 1024.)) {
+    int i;
+    fprintf(file, "          <wingAirfoil uID=\"profile%d\">\n            <name>Profile %d</name>\n", iProfile, iProfile);
+    fprintf(file, "            <pointList>\n");
+    for (i = 0; i < 100; ++i, ++nPoints) {
+      fprintf(file, "              <point uID=\"profile%d_point%d\">\n", iProfile, i);
+      fprintf(file, "                <x>%g</x>\n                <y>%g</y>\n                <z>%g</z>\n",
+              0.01 * i, 0.001 * (nPoints % 1000), -0.5 * (i % 3));
+      fprintf(file, "              </point>\n");
+    }
+    fprintf(file, "            </pointList>\n          </wingAirfoil>\n");
+    iProfile++;
+  }
+  fprintf(file, "        </wingAirfoils>\n      </model>\n    </aircraft>\n  </vehicles>\n</cpacs>\n");
+  fclose(file);
+  return 1;
+}
+
+/* opens the file with one variant, run in a process of its own */
+static int openVariant(const char* fileName, int variant)
+{
+  TixiOpenOptions options = {OPENMODE_PLAIN, 0, 0, NULL, 0, NULL, 0};
+  const char* includePaths[] = {"/cpacs/vehicles/aircraft/model/wingAirfoils/wingAirfoil[1]"};
+  TixiDocumentHandle handle = -1;
+  double start, openTime;
+  int nProfiles = 0;
+  ReturnCode error;
+
+  options.flags = variantFlags[variant];
+  if (variant == 1) {
+    options.sizeHint = 16 * 1024 * 1024;
+  }
+  if (variant == 6) {
+    options.includePaths = includePaths;
+    options.nIncludePaths = 1;
+  }
+
+  start = benchmarkSeconds();
+  error = variant == 0 ? tixiOpenDocument(fileName, &handle) : tixiOpenDocumentWithOptions(fileName, &handle, &options);
+  openTime = benchmarkSeconds() - start;
+  if (error != SUCCESS) {
+    return 1;
+  }
+  tixiGetNamedChildrenCount(handle, "/cpacs/vehicles/aircraft/model/wingAirfoils", "wingAirfoil", &nProfiles);
+
+  printf("%-22s open %9.1f ms  peak memory %8.1f MB  (%d profiles)\n", variantNames[variant], 1e3 * openTime,
+         peakMemoryMB(), nProfiles);
+  fflush(stdout);
+
+  tixiCloseDocument(handle);
+  tixiCleanup();
+  return 0;
+}
+
+int main(int argc, char* argv[])
+{
+  double sizeMB = argc > 1 ? atof(argv[1]) : 50.;
+  const char* fileName = argc > 2 ? argv[2] : "bench_open_options.xml";
+  int variant, nErrors = 0;
+
+  if (argc > 3) {
+    return openVariant(fileName, atoi(argv[3]));
+  }
+  if (sizeMB <= 0.) {
+    fprintf(stderr, "Usage: %s [size in MB] [file name]\n", argv[0]);
+    return 1;
+  }
+
+  if (!writeDocument(fileName, sizeMB)) {
+    fprintf(stderr, "Unable to write \"%s\".\n", fileName);
+    return 1;
+  }
+  printf("file: %s (%.0f MB)\n", fileName, sizeMB);
+  fflush(stdout);
+
+  for (variant = 0; variant < NUMBER_OF_VARIANTS; ++variant) {
+    char command[1024];
+    snprintf(command, sizeof(command), "\"%s\" %g \"%s\" %d", argv[0], sizeMB, fileName, variant);
+    nErrors += system(command) != 0;
+  }
+
+  remove(fileName);
+  return nErrors == 0 ? 0 : 1;
+}
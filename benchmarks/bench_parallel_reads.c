@@ -0,0 +1,182 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+ * @brief Measures the scaling of a getter heavy workload on one document
+ * with 1 to 32 threads.
+ *
+ * The total number of getter calls is fixed and divided among the threads.
+ *
+ * Usage: bench_parallel_reads [total number of calls] [max threads]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tixi.h"
+#include "benchmarkTimer.h"
+
+#ifdef _WIN32
+#include <windows.h>
+typedef HANDLE BenchmarkThread;
+#else
+#include <pthread.h>
+typedef pthread_t BenchmarkThread;
+#endif
+
+#define N_SECTIONS 200
+
+typedef struct
+{
+  TixiDocumentHandle handle;
+  int nCalls;
+  int offset;
+  int nErrors;
+} ReaderTask;
+
+static void runReader(ReaderTask* task)
+{
+  char path[128];
+  char* text = NULL;
+  double value = 0.;
+  int i, number = 0;
+
+  for (i = 0; i < task->nCalls; i += 4) {
+    int section = (task->offset + i) % N_SECTIONS + 1;
+
+    sprintf(path, "/model/sections/section[%d]/name", section);
+    if (tixiGetTextElement(task->handle, path, &text) != SUCCESS) {
+      task->nErrors++;
+    }
+    sprintf(path, "/model/sections/section[%d]/chord", section);
+    if (tixiGetDoubleElement(task->handle, path, &value) != SUCCESS) {
+      task->nErrors++;
+    }
+    sprintf(path, "/model/sections/section[%d]", section);
+    if (tixiGetTextAttribute(task->handle, path, "uID", &text) != SUCCESS) {
+      task->nErrors++;
+    }
+    if (tixiXPathEvaluateNodeNumber(task->handle, "/model/sections/section", &number) != SUCCESS) {
+      task->nErrors++;
+    }
+  }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI readerThread(LPVOID task)
+{
+  runReader((ReaderTask*) task);
+  return 0;
+}
+
+static void startThread(BenchmarkThread* thread, ReaderTask* task)
+{
+  *thread = CreateThread(NULL, 0, readerThread, task, 0, NULL);
+}
+
+static void joinThread(BenchmarkThread thread)
+{
+  WaitForSingleObject(thread, INFINITE);
+  CloseHandle(thread);
+}
+#else
+static void* readerThread(void* task)
+{
+  runReader((ReaderTask*) task);
+  return NULL;
+}
+
+static void startThread(BenchmarkThread* thread, ReaderTask* task)
+{
+  pthread_create(thread, NULL, readerThread, task);
+}
+
+static void joinThread(BenchmarkThread thread)
+{
+  pthread_join(thread, NULL);
+}
+#endif
+
+static TixiDocumentHandle createDocument(void)
+{
+  TixiDocumentHandle handle = -1;
+  char uid[32];
+  int i;
+
+  tixiCreateDocument("model", &handle);
+  tixiCreateElement(handle, "/model", "sections");
+  for (i = 1; i <= N_SECTIONS; ++i) {
+    char path[64];
+    sprintf(path, "/model/sections/section[%d]", i);
+    sprintf(uid, "section%d", i);
+    tixiCreateElement(handle, "/model/sections", "section");
+    tixiAddTextAttribute(handle, path, "uID", uid);
+    tixiAddTextElement(handle, path, "name", uid);
+    tixiAddDoubleElement(handle, path, "chord", 1. + i, "%g");
+  }
+  return handle;
+}
+
+int main(int argc, char* argv[])
+{
+  int nCalls     = argc > 1 ? atoi(argv[1]) : 400000;
+  int maxThreads = argc > 2 ? atoi(argv[2]) : 32;
+  BenchmarkThread threads[256];
+  ReaderTask tasks[256];
+  double singleThreadTime = 0.;
+  int nThreads, i, nErrors = 0;
+
+  if (nCalls <= 0 || maxThreads <= 0 || maxThreads > 256) {
+    fprintf(stderr, "Usage: %s [total number of calls] [max threads <= 256]\n", argv[0]);
+    return 1;
+  }
+
+  printf("threads      time [s]     calls/s   speedup\n");
+  for (nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+    /* a fresh document per run, returned strings are released on close */
+    TixiDocumentHandle handle = createDocument();
+    double start, elapsed;
+
+    for (i = 0; i < nThreads; ++i) {
+      tasks[i].handle = handle;
+      tasks[i].nCalls = nCalls / nThreads;
+      tasks[i].offset = i * 17;
+      tasks[i].nErrors = 0;
+    }
+
+    start = benchmarkSeconds();
+    for (i = 0; i < nThreads; ++i) {
+      startThread(&threads[i], &tasks[i]);
+    }
+    for (i = 0; i < nThreads; ++i) {
+      joinThread(threads[i]);
+      nErrors += tasks[i].nErrors;
+    }
+    elapsed = benchmarkSeconds() - start;
+
+    if (nThreads == 1) {
+      singleThreadTime = elapsed;
+    }
+    printf("%7d %13.3f %11.0f %9.2f\n", nThreads, elapsed, nCalls / elapsed, singleThreadTime / elapsed);
+
+    tixiCloseDocument(handle);
+  }
+
+  tixiCleanup();
+  if (nErrors > 0) {
+    fprintf(stderr, "%d getter calls failed\n", nErrors);
+  }
+  return nErrors == 0 ? 0 : 1;
+}
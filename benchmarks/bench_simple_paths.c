@@ -0,0 +1,84 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+ * @brief Measures repeated tixiGetDoubleElement calls on simple paths,
+ * resolved by walking the tree, and on equivalent paths evaluated by the
+ * (cached) XPath engine.
+ *
+ * Usage: bench_simple_paths [number of paths] [number of calls]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tixi.h"
+#include "benchmarkTimer.h"
+
+static double runQueries(TixiDocumentHandle handle, const char* pathFormat, int nPaths, int nCalls, int* nErrors)
+{
+  char path[128];
+  double value = 0.;
+  double start = benchmarkSeconds();
+  int i;
+
+  for (i = 0; i < nCalls; ++i) {
+    int index = (int) ((i * 7919L) % nPaths);
+    sprintf(path, pathFormat, index + 1);
+    if (tixiGetDoubleElement(handle, path, &value) != SUCCESS || value != (double) index) {
+      (*nErrors)++;
+    }
+  }
+  return benchmarkSeconds() - start;
+}
+
+int main(int argc, char* argv[])
+{
+  int nPaths = argc > 1 ? atoi(argv[1]) : 200;
+  int nCalls = argc > 2 ? atoi(argv[2]) : 200000;
+  TixiDocumentHandle handle = -1;
+  double xpathTime, walkerTime;
+  size_t hits = 0, misses = 0;
+  int i, nErrors = 0;
+
+  if (nPaths <= 0 || nCalls <= 0) {
+    fprintf(stderr, "Usage: %s [number of paths] [number of calls]\n", argv[0]);
+    return 1;
+  }
+
+  tixiCreateDocument("root", &handle);
+  tixiCreateElement(handle, "/root", "sections");
+  for (i = 0; i < nPaths; ++i) {
+    char path[128];
+    tixiCreateElement(handle, "/root/sections", "section");
+    sprintf(path, "/root/sections/section[%d]", i + 1);
+    tixiAddDoubleElement(handle, path, "x", (double) i, "%g");
+  }
+
+  xpathTime = runQueries(handle, "/root/sections/section[%d]/child::x", nPaths, nCalls, &nErrors);
+  walkerTime = runQueries(handle, "/root/sections/section[%d]/x", nPaths, nCalls, &nErrors);
+  tixiGetXPathCacheStatistics(&hits, &misses);
+
+  printf("paths:           %d\n", nPaths);
+  printf("xpath engine:    %10.3f us/call (%lu hits, %lu misses)\n", 1e6 * xpathTime / nCalls,
+         (unsigned long) hits, (unsigned long) misses);
+  printf("tree walker:     %10.3f us/call\n", 1e6 * walkerTime / nCalls);
+  printf("speedup:         %10.2f\n", xpathTime / walkerTime);
+
+  tixiCloseDocument(handle);
+  tixiCleanup();
+  return nErrors == 0 ? 0 : 1;
+}
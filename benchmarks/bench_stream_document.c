@@ -0,0 +1,186 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+ * @brief Compares reading a few hundred values from a large CPACS like file
+ * with tixiOpenDocument and tixiGetDoubleElement to tixiStreamDocument, which
+ * does not build the tree of the document. Each variant runs in a new process,
+ * so that the peak memory of the variants is measured separately.
+ *
+ * Usage: bench_stream_document [size in MB] [file name]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tixi.h"
+#include "benchmarkTimer.h"
+
+#ifdef _WIN32
+#include <psapi.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "psapi.lib")
+#endif
+
+static double peakMemoryMB(void)
+{
+  PROCESS_MEMORY_COUNTERS counters;
+  GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+  return (double) counters.PeakWorkingSetSize / (1024. * 1024.);
+}
+#else
+#include <sys/resource.h>
+
+static double peakMemoryMB(void)
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return (double) usage.ru_maxrss / (1024. * 1024.);
+#else
+  return (double) usage.ru_maxrss / 1024.;
+#endif
+}
+#endif
+
+#define NUMBER_OF_PATHS 200
+
+typedef struct
+{
+  double sum;
+  int nValues;
+} StreamSum;
+
+static int addValue(int pathIndex, const char* text, const double* vector, int vectorSize, void* userData)
+{
+  StreamSum* sum = (StreamSum*) userData;
+
+  (void) pathIndex;
+  (void) vector;
+  (void) vectorSize;
+  sum->sum += atof(text);
+  sum->nValues++;
+  return 0;
+}
+
+/* writes wings with profiles of points until the file has the given size */
+static int writeDocument(const char* fileName, double sizeMB)
+{
+  FILE* file = fopen(fileName, "w");
+  long nPoints = 0;
+  int iProfile = 0;
+
+  if (!file) {
+    return 0;
+  }
+  fprintf(file, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<cpacs>\n  <vehicles>\n    <aircraft>\n      <model uID=\"model\">\n");
+  fprintf(file, "        <wingAirfoils>\n");
+  while (ftell(file) < (long) (sizeMB * 1024. * 1024.)) {
+    int i;
+    fprintf(file, "          <wingAirfoil uID=\"profile%d\">\n            <name>Profile %d</name>\n", iProfile, iProfile);
+    fprintf(file, "            <pointList>\n");
+    for (i = 0; i < 100; ++i, ++nPoints) {
+      fprintf(file, "              <point uID=\"profile%d_point%d\">\n", iProfile, i);
+      fprintf(file, "                <x>%g</x>\n                <y>%g</y>\n                <z>%g</z>\n",
+              0.01 * i, 0.001 * (nPoints % 1000), -0.5 * (i % 3));
+      fprintf(file, "              </point>\n");
+    }
+    fprintf(file, "            </pointList>\n          </wingAirfoil>\n");
+    iProfile++;
+  }
+  fprintf(file, "        </wingAirfoils>\n      </model>\n    </aircraft>\n  </vehicles>\n</cpacs>\n");
+  fclose(file);
+  return 1;
+}
+
+/* reads the values with one variant, run in a process of its own */
+static int readVariant(const char* fileName, int variant)
+{
+  char* paths[NUMBER_OF_PATHS];
+  StreamSum sum = {0., 0};
+  double start, readTime;
+  ReturnCode error = SUCCESS;
+  int iPath;
+
+  for (iPath = 0; iPath < NUMBER_OF_PATHS; ++iPath) {
+    paths[iPath] = (char*) malloc(128);
+    snprintf(paths[iPath], 128, "/cpacs/vehicles/aircraft/model/wingAirfoils/wingAirfoil[%d]/pointList/point[%d]/y",
+             1 + 5 * (iPath / 2), 1 + 50 * (iPath % 2));
+  }
+
+  start = benchmarkSeconds();
+  if (variant == 0) {
+    TixiDocumentHandle handle = -1;
+
+    error = tixiOpenDocument(fileName, &handle);
+    for (iPath = 0; iPath < NUMBER_OF_PATHS && error == SUCCESS; ++iPath) {
+      double value = 0.;
+      if (tixiGetDoubleElement(handle, paths[iPath], &value) == SUCCESS) {
+        sum.sum += value;
+        sum.nValues++;
+      }
+    }
+    tixiCloseDocument(handle);
+  }
+  else {
+    error = tixiStreamDocument(fileName, OPENMODE_PLAIN, (const char**) paths, NUMBER_OF_PATHS, addValue, &sum);
+  }
+  readTime = benchmarkSeconds() - start;
+
+  for (iPath = 0; iPath < NUMBER_OF_PATHS; ++iPath) {
+    free(paths[iPath]);
+  }
+  if (error != SUCCESS) {
+    return 1;
+  }
+
+  printf("%-20s read %9.1f ms  peak memory %8.1f MB  (%d values, sum %g)\n",
+         variant == 0 ? "tixiOpenDocument" : "tixiStreamDocument", 1e3 * readTime, peakMemoryMB(), sum.nValues, sum.sum);
+  fflush(stdout);
+  tixiCleanup();
+  return 0;
+}
+
+int main(int argc, char* argv[])
+{
+  double sizeMB = argc > 1 ? atof(argv[1]) : 50.;
+  const char* fileName = argc > 2 ? argv[2] : "bench_stream_document.xml";
+  int variant, nErrors = 0;
+
+  if (argc > 3) {
+    return readVariant(fileName, atoi(argv[3]));
+  }
+  if (sizeMB <= 0.) {
+    fprintf(stderr, "Usage: %s [size in MB] [file name]\n", argv[0]);
+    return 1;
+  }
+
+  if (!writeDocument(fileName, sizeMB)) {
+    fprintf(stderr, "Unable to write \"%s\".\n", fileName);
+    return 1;
+  }
+  printf("file: %s (%.0f MB)\n", fileName, sizeMB);
+  fflush(stdout);
+
+  for (variant = 0; variant < 2; ++variant) {
+    char command[1024];
+    snprintf(command, sizeof(command), "\"%s\" %g \"%s\" %d", argv[0], sizeMB, fileName, variant);
+    nErrors += system(command) != 0;
+  }
+
+  remove(fileName);
+  return nErrors == 0 ? 0 : 1;
+}
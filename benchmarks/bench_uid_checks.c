@@ -0,0 +1,112 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+ * @brief Measures the uID checks of a freshly opened document for two document
+ * sizes. For checks scaling linearly, the time grows with the size ratio.
+ *
+ * Usage: bench_uid_checks [number of uIDs]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tixi.h"
+#include "benchmarkTimer.h"
+
+static void silentMessageHandler(MessageType type, const char* message)
+{
+  (void) type;
+  (void) message;
+}
+
+/* every tenth uID is duplicated, every tenth link is broken */
+static char* createDocument(int nUIDs)
+{
+  TixiDocumentHandle handle = -1;
+  char* xml = NULL;
+  char* copy = NULL;
+  int i;
+
+  tixiCreateDocument("root", &handle);
+  tixiCreateElement(handle, "/root", "sections");
+  for (i = 0; i < nUIDs; ++i) {
+    char path[128], uID[32], link[32];
+    tixiCreateElement(handle, "/root/sections", "section");
+    sprintf(path, "/root/sections/section[%d]", i + 1);
+    sprintf(uID, "section%d", i % 10 == 9 ? i : i + 1);
+    sprintf(link, "section%d", i % 10 == 5 ? nUIDs + i : (i % 10 == 9 ? i : i + 1));
+    tixiAddTextAttribute(handle, path, "uID", uID);
+    tixiAddTextAttribute(handle, path, "isLink", link);
+  }
+  tixiExportDocumentAsString(handle, &xml);
+  copy = (char*) malloc(strlen(xml) + 1);
+  strcpy(copy, xml);
+  tixiCloseDocument(handle);
+  return copy;
+}
+
+static double measureChecks(int nUIDs, int* nErrors)
+{
+  TixiDocumentHandle handle = -1;
+  char* xml = createDocument(nUIDs);
+  char** uIDs = NULL;
+  char** links = NULL;
+  char** xPaths = NULL;
+  int nDuplicates = 0, nBrokenLinks = 0;
+  double start, time;
+
+  tixiImportFromString(xml, &handle);
+  start = benchmarkSeconds();
+  if (tixiUIDCheckDuplicates(handle) != UID_NOT_UNIQUE || tixiUIDCheckLinks(handle) != UID_LINK_BROKEN) {
+    (*nErrors)++;
+  }
+  if (tixiUIDGetDuplicates(handle, &uIDs, &xPaths, &nDuplicates) != SUCCESS || nDuplicates != 2 * (nUIDs / 10)) {
+    (*nErrors)++;
+  }
+  if (tixiUIDGetBrokenLinks(handle, &links, &xPaths, &nBrokenLinks) != SUCCESS || nBrokenLinks != (nUIDs + 4) / 10) {
+    (*nErrors)++;
+  }
+  time = benchmarkSeconds() - start;
+
+  tixiCloseDocument(handle);
+  free(xml);
+  return time;
+}
+
+int main(int argc, char* argv[])
+{
+  int nUIDs = argc > 1 ? atoi(argv[1]) : 5000;
+  double smallTime, largeTime;
+  int nErrors = 0;
+
+  if (nUIDs <= 0) {
+    fprintf(stderr, "Usage: %s [number of uIDs]\n", argv[0]);
+    return 1;
+  }
+
+  tixiSetPrintMsgFunc(silentMessageHandler);
+  smallTime = measureChecks(nUIDs, &nErrors);
+  largeTime = measureChecks(4 * nUIDs, &nErrors);
+
+  printf("uIDs:            %d / %d\n", nUIDs, 4 * nUIDs);
+  printf("checks small:    %10.3f ms\n", 1e3 * smallTime);
+  printf("checks large:    %10.3f ms\n", 1e3 * largeTime);
+  printf("time ratio:      %10.2f\n", largeTime / smallTime);
+
+  tixiCleanup();
+  return nErrors == 0 ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+ * @brief Measures resolving all uIDs of a document with tixiUIDGetXPath and
+ * tixiUIDCheckExists compared to searching them with an XPath expression.
+ *
+ * Usage: bench_uid_lookup [number of uIDs]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tixi.h"
+#include "benchmarkTimer.h"
+
+int main(int argc, char* argv[])
+{
+  int nUIDs = argc > 1 ? atoi(argv[1]) : 2000;
+  TixiDocumentHandle handle = -1;
+  double start, uidTime, xpathTime;
+  int i, nErrors = 0;
+
+  if (nUIDs <= 0) {
+    fprintf(stderr, "Usage: %s [number of uIDs]\n", argv[0]);
+    return 1;
+  }
+
+  tixiCreateDocument("root", &handle);
+  tixiCreateElement(handle, "/root", "sections");
+  for (i = 0; i < nUIDs; ++i) {
+    char path[128], uID[32];
+    tixiCreateElement(handle, "/root/sections", "section");
+    sprintf(path, "/root/sections/section[%d]", i + 1);
+    sprintf(uID, "section%d", i + 1);
+    tixiAddTextAttribute(handle, path, "uID", uID);
+  }
+
+  start = benchmarkSeconds();
+  for (i = 0; i < nUIDs; ++i) {
+    char uID[32];
+    char* xPath = NULL;
+    sprintf(uID, "section%d", i + 1);
+    if (tixiUIDCheckExists(handle, uID) != SUCCESS || tixiUIDGetXPath(handle, uID, &xPath) != SUCCESS || !xPath[0]) {
+      nErrors++;
+    }
+  }
+  uidTime = benchmarkSeconds() - start;
+
+  start = benchmarkSeconds();
+  for (i = 0; i < nUIDs; ++i) {
+    char expression[64];
+    char* xPath = NULL;
+    sprintf(expression, "//*[@uID='section%d']", i + 1);
+    if (tixiXPathExpressionGetXPath(handle, expression, 1, &xPath) != SUCCESS) {
+      nErrors++;
+    }
+  }
+  xpathTime = benchmarkSeconds() - start;
+
+  printf("uIDs:            %d\n", nUIDs);
+  printf("uid table:       %10.3f ms\n", 1e3 * uidTime);
+  printf("xpath search:    %10.3f ms\n", 1e3 * xpathTime);
+  printf("speedup:         %10.2f\n", xpathTime / uidTime);
+
+  tixiCloseDocument(handle);
+  tixiCleanup();
+  return nErrors == 0 ? 0 : 1;
+}
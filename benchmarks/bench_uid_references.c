@@ -0,0 +1,97 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+ * @brief Measures finding the elements referring to each section of a wing
+ * with tixiUIDGetIncomingReferences compared to an XPath search per section.
+ *
+ * Usage: bench_uid_references [number of sections]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tixi.h"
+#include "benchmarkTimer.h"
+
+int main(int argc, char* argv[])
+{
+  int nSections = argc > 1 ? atoi(argv[1]) : 500;
+  TixiDocumentHandle handle = -1;
+  double start, graphTime, xpathTime;
+  int i, nErrors = 0;
+
+  if (nSections <= 1) {
+    fprintf(stderr, "Usage: %s [number of sections]\n", argv[0]);
+    return 1;
+  }
+
+  /* segment i connects the sections i and i+1 */
+  tixiCreateDocument("wing", &handle);
+  tixiCreateElement(handle, "/wing", "sections");
+  tixiCreateElement(handle, "/wing", "segments");
+  for (i = 0; i < nSections; ++i) {
+    char path[128], uID[32];
+    tixiCreateElement(handle, "/wing/sections", "section");
+    sprintf(path, "/wing/sections/section[%d]", i + 1);
+    sprintf(uID, "section%d", i + 1);
+    tixiAddTextAttribute(handle, path, "uID", uID);
+  }
+  for (i = 1; i < nSections; ++i) {
+    char path[128], uID[32];
+    tixiCreateElement(handle, "/wing/segments", "segment");
+    sprintf(path, "/wing/segments/segment[%d]", i);
+    sprintf(uID, "segment%d", i);
+    tixiAddTextAttribute(handle, path, "uID", uID);
+    sprintf(uID, "section%d", i);
+    tixiAddTextElement(handle, path, "fromElementUID", uID);
+    sprintf(uID, "section%d", i + 1);
+    tixiAddTextElement(handle, path, "toElementUID", uID);
+  }
+
+  start = benchmarkSeconds();
+  for (i = 0; i < nSections; ++i) {
+    char uID[32];
+    char** xPaths = NULL;
+    int number = 0, expected = (i == 0 || i == nSections - 1) ? 1 : 2;
+    sprintf(uID, "section%d", i + 1);
+    if (tixiUIDGetIncomingReferences(handle, uID, &xPaths, &number) != SUCCESS || number != expected) {
+      nErrors++;
+    }
+  }
+  graphTime = benchmarkSeconds() - start;
+
+  start = benchmarkSeconds();
+  for (i = 0; i < nSections; ++i) {
+    char expression[128];
+    int number = 0, expected = (i == 0 || i == nSections - 1) ? 1 : 2;
+    sprintf(expression, "//*[@isLink='section%d' or fromElementUID='section%d' or toElementUID='section%d']",
+            i + 1, i + 1, i + 1);
+    if (tixiXPathEvaluateNodeNumber(handle, expression, &number) != SUCCESS || number != expected) {
+      nErrors++;
+    }
+  }
+  xpathTime = benchmarkSeconds() - start;
+
+  printf("sections:        %d\n", nSections);
+  printf("reference graph: %10.3f ms\n", 1e3 * graphTime);
+  printf("xpath search:    %10.3f ms\n", 1e3 * xpathTime);
+  printf("speedup:         %10.2f\n", xpathTime / graphTime);
+
+  tixiCloseDocument(handle);
+  tixiCleanup();
+  return nErrors == 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+ * @brief Measures reading vectors of 1e3 up to 1e7 values with tixiGetFloatVector,
+ * compared to copying the text, splitting it with strtok and converting
+ * each value with atof.
+ *
+ * Usage: bench_vector_parsing [maximum number of values]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tixi.h"
+#include "benchmarkTimer.h"
+
+/* reads the vector like tixiGetFloatVector did before, returns the number of errors */
+static int readWithAtof(const char* text, const double* values, int nValues)
+{
+  char* copy = (char*) malloc(strlen(text) + 1);
+  char* token = NULL;
+  int count = 0, nErrors = 0;
+
+  strcpy(copy, text);
+  token = strtok(copy, ";");
+  while (token != NULL && count < nValues) {
+    nErrors += atof(token) != values[count++];
+    token = strtok(NULL, ";");
+  }
+  free(copy);
+  return nErrors + (count != nValues);
+}
+
+int main(int argc, char* argv[])
+{
+  int maxValues = argc > 1 ? atoi(argv[1]) : 1000000;
+  int nValues, i, nErrors = 0;
+
+  if (maxValues <= 0) {
+    fprintf(stderr, "Usage: %s [maximum number of values]\n", argv[0]);
+    return 1;
+  }
+
+  printf("%10s %16s %16s %10s\n", "values", "strtok/atof [ms]", "tixi [ms]", "speedup");
+  for (nValues = 1000; nValues <= maxValues; nValues *= 10) {
+    TixiDocumentHandle handle = -1;
+    double* values = (double*) malloc(nValues * sizeof(double));
+    double* readValues = NULL;
+    const char* text = NULL;
+    double start, atofTime, tixiTime;
+    int nRepetitions = 10000000 / nValues > 0 ? 10000000 / nValues : 1;
+    int rep, mark = 0;
+
+    for (i = 0; i < nValues; ++i) {
+      values[i] = 0.001 * (double) (i % 100000) - 17.25 * (double) (i % 7);
+    }
+    tixiCreateDocument("root", &handle);
+    tixiAddFloatVector(handle, "/root", "vector", values, nValues, "%.17g");
+    tixiUpdateFloatVector(handle, "/root/vector", values, nValues, NULL);
+    for (i = 0; i < nValues; ++i) {
+      /* compare with the written "%g" text */
+      char number[32];
+      sprintf(number, "%g", values[i]);
+      values[i] = atof(number);
+    }
+    tixiGetTextElementBorrowed(handle, "/root/vector", &text);
+    tixiMemoryCheckpoint(handle, &mark);
+
+    start = benchmarkSeconds();
+    for (rep = 0; rep < nRepetitions; ++rep) {
+      nErrors += readWithAtof(text, values, nValues);
+    }
+    atofTime = (benchmarkSeconds() - start) / nRepetitions;
+
+    start = benchmarkSeconds();
+    for (rep = 0; rep < nRepetitions; ++rep) {
+      if (tixiGetFloatVector(handle, "/root/vector", &readValues, nValues) != SUCCESS) {
+        nErrors++;
+        break;
+      }
+      tixiMemoryReleaseTo(handle, mark);
+    }
+    tixiTime = (benchmarkSeconds() - start) / nRepetitions;
+
+    if (tixiGetFloatVector(handle, "/root/vector", &readValues, nValues) != SUCCESS
+        || memcmp(readValues, values, nValues * sizeof(double)) != 0) {
+      nErrors++;
+    }
+
+    printf("%10d %16.3f %16.3f %10.2f\n", nValues, 1e3 * atofTime, 1e3 * tixiTime, atofTime / tixiTime);
+    free(values);
+    tixiCloseDocument(handle);
+  }
+
+  tixiCleanup();
+  return nErrors == 0 ? 0 : 1;
+}
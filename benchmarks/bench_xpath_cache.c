@@ -0,0 +1,87 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+ * @brief Measures repeated tixiGetDoubleElement calls on a set of paths
+ * with and without the cache of compiled XPath expressions.
+ *
+ * Usage: bench_xpath_cache [number of paths] [number of calls]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tixi.h"
+#include "benchmarkTimer.h"
+
+static double runQueries(TixiDocumentHandle handle, int nPaths, int nCalls, int* nErrors)
+{
+  char path[128];
+  double value = 0.;
+  double start = benchmarkSeconds();
+  int i;
+
+  for (i = 0; i < nCalls; ++i) {
+    int index = (int) ((i * 7919L) % nPaths);
+    /* the child axis keeps the paths out of the tree walker for simple paths */
+    sprintf(path, "/root/sections/section[%d]/child::x", index + 1);
+    if (tixiGetDoubleElement(handle, path, &value) != SUCCESS || value != (double) index) {
+      (*nErrors)++;
+    }
+  }
+  return benchmarkSeconds() - start;
+}
+
+int main(int argc, char* argv[])
+{
+  int nPaths = argc > 1 ? atoi(argv[1]) : 200;
+  int nCalls = argc > 2 ? atoi(argv[2]) : 200000;
+  TixiDocumentHandle handle = -1;
+  double uncachedTime, cachedTime;
+  size_t hits = 0, misses = 0;
+  int i, nErrors = 0;
+
+  if (nPaths <= 0 || nCalls <= 0) {
+    fprintf(stderr, "Usage: %s [number of paths] [number of calls]\n", argv[0]);
+    return 1;
+  }
+
+  tixiCreateDocument("root", &handle);
+  tixiCreateElement(handle, "/root", "sections");
+  for (i = 0; i < nPaths; ++i) {
+    char path[128];
+    tixiCreateElement(handle, "/root/sections", "section");
+    sprintf(path, "/root/sections/section[%d]", i + 1);
+    tixiAddDoubleElement(handle, path, "x", (double) i, "%g");
+  }
+
+  tixiSetXPathCacheSize(0);
+  uncachedTime = runQueries(handle, nPaths, nCalls, &nErrors);
+
+  tixiSetXPathCacheSize(1024);
+  cachedTime = runQueries(handle, nPaths, nCalls, &nErrors);
+  tixiGetXPathCacheStatistics(&hits, &misses);
+
+  printf("paths:           %d\n", nPaths);
+  printf("without cache:   %10.3f us/call\n", 1e6 * uncachedTime / nCalls);
+  printf("with cache:      %10.3f us/call (%lu hits, %lu misses)\n", 1e6 * cachedTime / nCalls,
+         (unsigned long) hits, (unsigned long) misses);
+  printf("speedup:         %10.2f\n", uncachedTime / cachedTime);
+
+  tixiCloseDocument(handle);
+  tixiCleanup();
+  return nErrors == 0 ? 0 : 1;
+}
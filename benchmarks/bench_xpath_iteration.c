@@ -0,0 +1,98 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+/**
+ * @brief Measures reading the texts and paths of all results of an XPath
+ * expression by index, by tixiXPathExpressionForEach and by
+ * tixiXPathExpressionGetAllTexts.
+ *
+ * Usage: bench_xpath_iteration [number of elements]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tixi.h"
+#include "benchmarkTimer.h"
+
+static const char* expression = "/root/points/point/x";
+
+static int checkNode(int index, const char* elementName, const char* text, const char* xPath, void* userData)
+{
+  int* nErrors = (int*) userData;
+  (void) elementName;
+  if (!text || !xPath || atoi(text) != index) {
+    (*nErrors)++;
+  }
+  return 0;
+}
+
+int main(int argc, char* argv[])
+{
+  int nElements = argc > 1 ? atoi(argv[1]) : 2000;
+  TixiDocumentHandle handle = -1;
+  double start, indexedTime, forEachTime, allTextsTime;
+  char** texts = NULL;
+  int i, number = 0, nErrors = 0;
+
+  if (nElements <= 0) {
+    fprintf(stderr, "Usage: %s [number of elements]\n", argv[0]);
+    return 1;
+  }
+
+  tixiCreateDocument("root", &handle);
+  tixiCreateElement(handle, "/root", "points");
+  for (i = 0; i < nElements; ++i) {
+    char path[128];
+    tixiCreateElement(handle, "/root/points", "point");
+    sprintf(path, "/root/points/point[%d]", i + 1);
+    tixiAddIntegerElement(handle, path, "x", i + 1, "%d");
+  }
+
+  start = benchmarkSeconds();
+  tixiXPathEvaluateNodeNumber(handle, expression, &number);
+  for (i = 1; i <= number; ++i) {
+    char* text = NULL;
+    char* xPath = NULL;
+    if (tixiXPathExpressionGetTextByIndex(handle, expression, i, &text) != SUCCESS ||
+        tixiXPathExpressionGetXPath(handle, expression, i, &xPath) != SUCCESS || atoi(text) != i) {
+      nErrors++;
+    }
+  }
+  indexedTime = benchmarkSeconds() - start;
+
+  start = benchmarkSeconds();
+  if (tixiXPathExpressionForEach(handle, expression, checkNode, &nErrors) != SUCCESS) {
+    nErrors++;
+  }
+  forEachTime = benchmarkSeconds() - start;
+
+  start = benchmarkSeconds();
+  if (tixiXPathExpressionGetAllTexts(handle, expression, &texts, &number) != SUCCESS || number != nElements) {
+    nErrors++;
+  }
+  allTextsTime = benchmarkSeconds() - start;
+
+  printf("elements:        %d\n", nElements);
+  printf("by index:        %10.3f ms\n", 1e3 * indexedTime);
+  printf("for each:        %10.3f ms\n", 1e3 * forEachTime);
+  printf("all texts:       %10.3f ms\n", 1e3 * allTextsTime);
+  printf("speedup:         %10.2f\n", indexedTime / forEachTime);
+
+  tixiCloseDocument(handle);
+  tixiCleanup();
+  return nErrors == 0 ? 0 : 1;
+}
@@ -336,7 +336,7 @@ class CFunctionArg(object):
         
         regex = r'(?P<const>const\s)?(?P<name>[\w\s]+)(?P<pointer>[*]+)?'
         
-        basictypes    = ['int', 'long', 'float', 'double', 'char', 'void']
+        basictypes    = ['int', 'long', 'size_t', 'float', 'double', 'char', 'void']
 
         match = re.search(regex, mytype)
         name = match.group('name')
@@ -347,6 +347,9 @@ class CFunctionArg(object):
             return mytype
         elif match and name.startswith('enum'):
             return 'int'
+        elif match and name.startswith('struct'):
+            # structs are passed by pointer only, the functions are blacklisted
+            return cst + 'void' + ptr
         elif match and name in typedefs:
             return cst + self.resolv_type(typedefs[name], enums, typedefs) + ptr
         else:
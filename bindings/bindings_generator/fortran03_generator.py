@@ -40,6 +40,7 @@ class Fortran03Generator(object):
         self.basic_types = {
                 'int'    : 'integer(kind=C_INT)',
                 'long'   : 'integer(kind=C_LONG)',
+                'size_t' : 'integer(kind=C_SIZE_T)',
                 'float'  : 'real(kind=C_FLOAT)',
                 'double' : 'real(kind=C_DOUBLE)',
                 'char'   : 'character(kind=C_CHAR,len=1)'}
@@ -445,6 +446,12 @@ end type
         if arg_dec.is_string:
             if arg_dec.arrayinfos['is_array']:
                 if arg_dec.npointer > 2:
+                    # arrays of strings allocated by the library, only the C interface is supported
+                    if language_binding == 'C' and arg_dec.is_outarg and arg_dec.arrayinfos['autoalloc'] \
+                            and arg_dec.npointer == 3:
+                        if dummy_arg:
+                            return 'type(C_PTR), intent(out) :: %s' % arg_name
+                        return 'type(C_PTR) :: %s' % arg_name
                     raise GeneratorException('Unhandled argument type', arg_dec)
                 dim_name = None
                 if arg_dec.arrayinfos['arraysizes']:
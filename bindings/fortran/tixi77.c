@@ -123,6 +123,18 @@ void tixiOpenDocumentRecursive_f(const char *xmlFilename, int *handle, ReturnCod
   free(cString);
 }
 
+void tixiResolveExternal_f(const TixiDocumentHandle *handle, const char *elementPath, ReturnCode *error, const int lengthString1)
+{
+
+  char *cString;
+
+  cString = makeCString(elementPath, lengthString1);
+
+  *error = tixiResolveExternal(*handle, cString);
+
+  free(cString);
+}
+
 void tixiOpenDocumentFromHTTP_f(const char *xmlUrl, int *handle, ReturnCode *error, int lengthString1)
 {
   char *cString;
@@ -321,6 +333,31 @@ void tixiGetDoubleElement_f(const TixiDocumentHandle *handle, char *elementPath,
   free(cElementPath);
 }
 
+void tixiGetValues_f(const TixiDocumentHandle *handle, const char *paths, const int *types, const int *nValues,
+                     double *values, ReturnCode *errors, ReturnCode *error, int pathLength)
+{
+  /* the paths are an array of fortran strings of pathLength characters each */
+  int nPaths = *nValues > 0 ? *nValues : 0;
+  char **cPaths = (char **) malloc(sizeof(char *) * (nPaths + 1));
+  int i;
+
+  if (!cPaths) {
+    *error = FAILED;
+    return;
+  }
+
+  for (i = 0; i < nPaths; i++) {
+    cPaths[i] = makeCString(paths + (size_t) i * pathLength, pathLength);
+  }
+
+  *error = tixiGetValues(*handle, (const char **) cPaths, types, *nValues, values, errors);
+
+  for (i = 0; i < nPaths; i++) {
+    free(cPaths[i]);
+  }
+  free(cPaths);
+}
+
 void tixiAddTextElement_f(const TixiDocumentHandle *handle,
                           char *parentPath,
                           char *elementName,
@@ -1216,6 +1253,13 @@ void tixiUsePrettyPrint_f(TixiDocumentHandle *handle,
     *error = tixiUsePrettyPrint(*handle, *usePrettyPrint);
 }
 
+void tixiUseBase64Vectors_f(TixiDocumentHandle *handle,
+                            int *useBase64Vectors,
+                            int *error)
+{
+    *error = tixiUseBase64Vectors(*handle, *useBase64Vectors);
+}
+
 
 void tixiUIDCheckDuplicates_f(TixiDocumentHandle *handle,
 								int *error)
@@ -56,6 +56,7 @@
 #define tixiGetVersion_f TIXI_GET_VERSION
 #define tixiOpenDocument_f TIXI_OPEN_DOCUMENT
 #define tixiOpenDocumentRecursive_f TIXI_OPEN_DOCUMENT_RECURSIVE
+#define tixiResolveExternal_f TIXI_RESOLVE_EXTERNAL
 #define tixiOpenDocumentFromHTTP_f TIXI_OPEN_DOCUMENT_FROM_HTTP
 #define tixiCreateDocument_f TIXI_CREATE_DOCUMENT
 #define tixiSaveDocument_f TIXI_SAVE_DOCUMENT
@@ -73,6 +74,7 @@
 #define tixiGetBooleanElement_f TIXI_GET_BOOLEAN_ELEMENT
 #define tixiGetIntegerElement_f TIXI_GET_INTEGER_ELEMENT
 #define tixiGetDoubleElement_f TIXI_GET_DOUBLE_ELEMENT
+#define tixiGetValues_f TIXI_GET_VALUES
 #define tixiAddTextElement_f TIXI_ADD_TEXT_ELEMENT
 #define tixiAddTextElementAtIndex_f TIXI_ADD_TEXT_ELEMENT_AT_INDEX
 #define tixiAddDoubleElement_f TIXI_ADD_DOUBLE_ELEMENT
@@ -115,6 +117,7 @@
 #define tixiCheckAttribute_f TIXI_CHECK_ATTRIBUTE
 #define tixiXSLTransformationToFile_f TIXI_XSL_TRANSFORMATION_TO_FILE
 #define tixiUsePrettyPrint_f TIXI_USE_PRETTY_PRINT
+#define tixiUseBase64Vectors_f TIXI_USE_BASE64_VECTORS
 #define tixiUIDCheckDuplicates_f TIXI_UID_CHECK_DUPLICATED
 #define tixiUIDCheckLinks_f TIXI_UID_CHECK_LINKS
 #define tixiUIDGetXPath_f TIXI_UID_GET_XPATH
@@ -134,6 +137,7 @@
 #define tixiGetVersion_f FORTRAN_NAME(tixi_get_version)
 #define tixiOpenDocument_f FORTRAN_NAME(tixi_open_document)
 #define tixiOpenDocumentRecursive_f FORTRAN_NAME(tixi_open_document_recursive)
+#define tixiResolveExternal_f FORTRAN_NAME(tixi_resolve_external)
 #define tixiOpenDocumentFromHTTP_f FORTRAN_NAME(tixi_open_document_from_http)
 #define tixiCreateDocument_f FORTRAN_NAME(tixi_create_document)
 #define tixiSaveDocument_f FORTRAN_NAME(tixi_save_document)
@@ -151,6 +155,7 @@
 #define tixiGetBooleanElement_f FORTRAN_NAME(tixi_get_boolean_element)
 #define tixiGetIntegerElement_f FORTRAN_NAME(tixi_get_integer_element)
 #define tixiGetDoubleElement_f FORTRAN_NAME(tixi_get_double_element)
+#define tixiGetValues_f FORTRAN_NAME(tixi_get_values)
 #define tixiAddTextElement_f FORTRAN_NAME(tixi_add_text_element)
 #define tixiAddTextElementAtIndex_f FORTRAN_NAME(tixi_add_text_element_at_index)
 #define tixiAddDoubleElement_f FORTRAN_NAME(tixi_add_double_element)
@@ -193,6 +198,7 @@
 #define tixiCheckAttribute_f FORTRAN_NAME(tixi_check_attribute)
 #define tixiXSLTransformationToFile_f FORTRAN_NAME(tixi_xsl_transformation_to_file)
 #define tixiUsePrettyPrint_f FORTRAN_NAME(tixi_use_pretty_print)
+#define tixiUseBase64Vectors_f FORTRAN_NAME(tixi_use_base64_vectors)
 #define tixiUIDCheckDuplicates_f FORTRAN_NAME(tixi_uid_check_duplicated)
 #define tixiUIDCheckLinks_f FORTRAN_NAME(tixi_uid_check_links)
 #define tixiUIDGetXPath_f FORTRAN_NAME(tixi_uid_get_xpath)
@@ -223,6 +229,11 @@ void tixiOpenDocumentRecursive_f(const char* xmlFilename,
                                 OpenMode *oMode,
                                 const int lengthString1 );
 
+void tixiResolveExternal_f(const TixiDocumentHandle* handle,
+                           const char* elementPath,
+                           ReturnCode* error,
+                           const int lengthString1 );
+
 void tixiOpenDocumentFromHTTP_f(const char* xmlUrl,
                                 int* handle,
                                 ReturnCode* error,
@@ -309,6 +320,15 @@ void tixiGetDoubleElement_f(const TixiDocumentHandle* handle,
                             ReturnCode* error,
                             int elementPathLength );
 
+void tixiGetValues_f(const TixiDocumentHandle* handle,
+                     const char* paths,
+                     const int* types,
+                     const int* nValues,
+                     double* values,
+                     ReturnCode* errors,
+                     ReturnCode* error,
+                     int pathLength );
+
 void tixiAddTextElement_f(const TixiDocumentHandle* handle,
                           char* parentPath,
                           char* elementName,
@@ -715,6 +735,10 @@ void tixiUsePrettyPrint_f(TixiDocumentHandle *handle,
                             int *usePrettyPrint,
                             int *error);
 
+void tixiUseBase64Vectors_f(TixiDocumentHandle *handle,
+                            int *useBase64Vectors,
+                            int *error);
+
 
 void tixiUIDCheckDuplicates_f(TixiDocumentHandle *handle,
 							  int *error);
@@ -93,7 +93,7 @@ end subroutine
 !end function
 '''
 
-blacklist = ['tixiGetPrintMsgFunc','tixiSetPrintMsgFunc','tixiGetVersion','tixiGetArrayElementNames']
+blacklist = ['tixiGetPrintMsgFunc','tixiSetPrintMsgFunc','tixiGetVersion','tixiGetArrayElementNames','tixiGetTextElementInto','tixiGetTextAttributeInto','tixiXPathExpressionGetTextByIndexInto','tixiGetTextElementBorrowed','tixiXPathExpressionForEach','tixiXPathExpressionGetAllTexts','tixiUIDGetDuplicates','tixiUIDGetBrokenLinks','tixiUIDGetIncomingReferences','tixiUIDGetOutgoingReferences','tixiUIDGetTopologicalOrder','tixiGetFloatVectorInto','tixiGetArrayInto','tixiGetArrayDescriptor','tixiOpenDocumentWithOptions','tixiStreamDocument']
 
 if __name__ == '__main__':
     # parse the file  
@@ -102,7 +102,7 @@ if __name__ == '__main__':
     # set the handle string that the parser can identify the handles
     parser.handle_str = 'TixiDocumentHandle'
     parser.returncode_str  ='ReturnCode'
-    parser.typedefs = {'TixiPrintMsgFnc': 'void*'}
+    parser.typedefs = {'TixiPrintMsgFnc': 'void*', 'TixiXPathNodeFnc': 'void*', 'TixiStreamValueFnc': 'void*'}
     parser.parse_header_file(tixipath + '/src/tixi.h')
     
     # create the wrapper
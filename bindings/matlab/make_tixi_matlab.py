@@ -15,7 +15,7 @@ import bindings_generator.matlab_generator as MG
 import bindings_generator.cheader_parser   as CP
 
 
-blacklist = ['tixiGetRawInterface', 'tixiAddDoubleListWithAttributes', 'tixiSetPrintMsgFunc']
+blacklist = ['tixiGetRawInterface', 'tixiAddDoubleListWithAttributes', 'tixiSetPrintMsgFunc', 'tixiGetTextElementInto', 'tixiGetTextAttributeInto', 'tixiXPathExpressionGetTextByIndexInto', 'tixiGetTextElementBorrowed', 'tixiGetValues', 'tixiXPathExpressionForEach', 'tixiGetFloatVectorInto', 'tixiGetArrayInto', 'tixiGetArrayDescriptor', 'tixiOpenDocumentWithOptions', 'tixiStreamDocument']
 
 if __name__ == '__main__':
     # parse the file
@@ -31,7 +31,7 @@ if __name__ == '__main__':
     # set the handle string that the parser can identify the handles
     parser.handle_str = 'TixiDocumentHandle'
     parser.returncode_str  ='ReturnCode'
-    parser.typedefs = {'TixiPrintMsgFnc': 'void'}
+    parser.typedefs = {'TixiPrintMsgFnc': 'void', 'TixiXPathNodeFnc': 'void', 'TixiStreamValueFnc': 'void'}
     parser.parse_header_file(tixipath + '/src/tixi.h')
     
     # create the wrapper
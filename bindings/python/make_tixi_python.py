@@ -107,7 +107,7 @@ postconstr = '''
 self.version = self.getVersion()
 '''
 
-blacklist = ['tixiCheckElement', 'tixiUIDCheckExists', 'tixiCheckAttribute', 'tixiCloseDocument', 'tixiGetRawInterface', 'tixiSetPrintMsgFunc']
+blacklist = ['tixiCheckElement', 'tixiUIDCheckExists', 'tixiCheckAttribute', 'tixiCloseDocument', 'tixiGetRawInterface', 'tixiSetPrintMsgFunc', 'tixiGetTextElementInto', 'tixiGetTextAttributeInto', 'tixiXPathExpressionGetTextByIndexInto', 'tixiGetTextElementBorrowed', 'tixiXPathExpressionForEach', 'tixiGetFloatVectorInto', 'tixiGetArrayInto', 'tixiGetArrayDescriptor', 'tixiOpenDocumentWithOptions', 'tixiStreamDocument']
 
 if __name__ == '__main__':
     # parse the file
@@ -119,7 +119,7 @@ if __name__ == '__main__':
     # set the handle string that the parser can identify the handles
     parser.handle_str = 'TixiDocumentHandle'
     parser.returncode_str  ='ReturnCode'
-    parser.typedefs = {'TixiPrintMsgFnc': 'void'}
+    parser.typedefs = {'TixiPrintMsgFnc': 'void', 'TixiXPathNodeFnc': 'void', 'TixiStreamValueFnc': 'void'}
     parser.parse_header_file(tixipath + '/src/tixi.h')
     
     # create the wrapper
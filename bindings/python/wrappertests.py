@@ -22,7 +22,7 @@
 
 import os
 import unittest
-from tixiwrapper import Tixi, TixiException, StorageMode
+from tixiwrapper import Tixi, TixiException, StorageMode, ValueType, ReturnCode
 
 class Tests(unittest.TestCase):
     ''' Test almost all TIXI functions to ensure correct generated code '''
@@ -100,6 +100,10 @@ class Tests(unittest.TestCase):
         self.assertEqual(t.getDoubleElement("/plane/wings/wing[1]/cog"), 123.456)
         self.assertFalse(t.getBooleanElement("/plane/bool/aBool2"))
         self.assertTrue(t.getBooleanElement("/plane/bool/aBool1b"))
+        values, errors = t.getValues(["/plane/numberOfPassengers", "/plane/wings/wing[1]/cog", "/plane/bool/aBool1b", "/plane/yy"],
+                                     [ValueType.VALUETYPE_INTEGER, ValueType.VALUETYPE_DOUBLE, ValueType.VALUETYPE_BOOLEAN, ValueType.VALUETYPE_DOUBLE], 4)
+        self.assertEqual(values[:3], (57., 123.456, 1.))
+        self.assertEqual(errors, (ReturnCode.SUCCESS, ReturnCode.SUCCESS, ReturnCode.SUCCESS, ReturnCode.ELEMENT_NOT_FOUND))
         self.assertFalse(t.checkElement("/plane/xx")) #ELEMENT_NOT_FOUND
         t.createElement("/plane", "xx")
         t.checkElement("/plane/xx")
@@ -173,6 +177,8 @@ class Tests(unittest.TestCase):
         t.close()
         t.open(os.path.join("TestData", "in.xml"))
         self.assertEquals(t.xPathExpressionGetTextByIndex("/plane/wings/wing/centerOfGravity/x", 2), "30.0")
+        self.assertEqual(t.xPathExpressionGetAllTexts("/plane/wings/wing/centerOfGravity/y"), ("10.0", "-10.0"))
+        self.assertEqual(t.xPathExpressionGetAllTexts("/plane/wings/wing/nothing"), ())
         t.close()
         t.open(os.path.join("TestData", "uid_correct.xml"))
         t.uIDCheckDuplicates()
@@ -180,6 +186,15 @@ class Tests(unittest.TestCase):
         t.close()
         t.open(os.path.join("TestData", "uid_duplicated.xml"))
         self.assertRaises(TixiException, t.uIDCheckDuplicates) #UID_NOT_UNIQUE
+        self.assertEqual(t.uIDGetDuplicates(), (("a", "a"), ("/root/a[1]/b[1]", "/root/b/c")))
+        t.close()
+        t.open(os.path.join("TestData", "uid_broken_link.xml"))
+        self.assertEqual(t.uIDGetBrokenLinks(), (("bla",), ("/root/b/c",)))
+        t.close()
+        t.open(os.path.join("TestData", "uid_references.xml"))
+        self.assertEqual(t.uIDGetIncomingReferences("seg1"), ("/cpacs/copy",))
+        self.assertEqual(t.uIDGetOutgoingReferences("/cpacs/wing/segments/segment"), ("sec1", "sec2"))
+        self.assertEqual(t.uIDGetTopologicalOrder(), ("sec1", "sec2", "seg1", "wing1"))
 
     def test_api(self):
         t = Tixi()
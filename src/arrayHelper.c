@@ -0,0 +1,259 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "arrayHelper.h"
+
+#include "tixiInternal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define INVALID_NODE_VALUES -2
+#define INITIAL_ARRAY_DESCRIPTOR_BUCKETS 64
+
+/* counts the values of a vector or array element, -1 if it has no text,
+   INVALID_NODE_VALUES if its base64 data is invalid */
+static int countNodeValues(xmlDocPtr doc, xmlNodePtr node)
+{
+  int count = 0;
+
+  if (!node->children) {
+    return -1;
+  }
+  count = readVectorNodeValues(doc, node, NULL, 0);
+  return count < 0 ? INVALID_NODE_VALUES : count;
+}
+
+/* parses the values of a vector or array element, which has count values */
+static double* parseNodeValues(xmlDocPtr doc, xmlNodePtr node, int count)
+{
+  double* values = (double*) malloc((count > 0 ? count : 1) * sizeof(double));
+
+  if (values) {
+    readVectorNodeValues(doc, node, values, count);
+  }
+  return values;
+}
+
+/* checks the mapType attribute like [@mapType="..."] in an XPath expression */
+static int hasMapType(xmlNodePtr node, const char* mapType)
+{
+  xmlChar* value = xmlGetNoNsProp(node, (const xmlChar*) "mapType");
+  int result = value && strcmp((const char*) value, mapType) == 0;
+
+  xmlFree(value);
+  return result;
+}
+
+static void freeDescriptor(TixiArrayDescriptor* descriptor)
+{
+  int i;
+
+  for (i = 0; i < descriptor->nDimensions; ++i) {
+    free(descriptor->dimensionValues[i]);
+  }
+  for (i = 0; i < descriptor->nParameters; ++i) {
+    free(descriptor->parameterValues[i]);
+  }
+  free(descriptor->dimensions);
+  free(descriptor->dimensionSizes);
+  free(descriptor->dimensionValues);
+  free(descriptor->parameters);
+  free(descriptor->parameterSizes);
+  free(descriptor->parameterValues);
+  free(descriptor);
+}
+
+/* reads the dimensions and finds the parameters of the array */
+static TixiArrayDescriptor* createDescriptor(xmlDocPtr doc, xmlNodePtr element)
+{
+  TixiArrayDescriptor* descriptor = (TixiArrayDescriptor*) calloc(1, sizeof(TixiArrayDescriptor));
+  xmlNodePtr child = NULL;
+  int nChildren = 0;
+
+  if (!descriptor) {
+    return NULL;
+  }
+  descriptor->element = element;
+
+  for (child = element->children; child; child = child->next) {
+    nChildren += child->type == XML_ELEMENT_NODE;
+  }
+  descriptor->dimensions = (xmlNodePtr*) malloc((nChildren + 1) * sizeof(xmlNodePtr));
+  descriptor->dimensionSizes = (int*) malloc((nChildren + 1) * sizeof(int));
+  descriptor->dimensionValues = (double**) calloc(nChildren + 1, sizeof(double*));
+  descriptor->parameters = (xmlNodePtr*) malloc((nChildren + 1) * sizeof(xmlNodePtr));
+  descriptor->parameterSizes = (int*) malloc((nChildren + 1) * sizeof(int));
+  descriptor->parameterValues = (double**) calloc(nChildren + 1, sizeof(double*));
+  if (!descriptor->dimensions || !descriptor->dimensionSizes || !descriptor->dimensionValues
+      || !descriptor->parameters || !descriptor->parameterSizes || !descriptor->parameterValues) {
+    freeDescriptor(descriptor);
+    return NULL;
+  }
+
+  descriptor->arraySize = 1;
+  for (child = element->children; child; child = child->next) {
+    if (child->type != XML_ELEMENT_NODE) {
+      continue;
+    }
+    if (hasMapType(child, VECTOR_ATTRIBUTE_NAME)) {
+      int iDimension = descriptor->nDimensions++;
+      int size = countNodeValues(doc, child);
+
+      descriptor->dimensions[iDimension] = child;
+      descriptor->dimensionSizes[iDimension] = size;
+      if (size == INVALID_NODE_VALUES) {
+        freeDescriptor(descriptor);
+        return NULL;
+      }
+      if (size >= 0) {
+        descriptor->dimensionValues[iDimension] = parseNodeValues(doc, child, size);
+        if (!descriptor->dimensionValues[iDimension]) {
+          freeDescriptor(descriptor);
+          return NULL;
+        }
+        descriptor->arraySize *= size;
+      }
+    }
+    else if (hasMapType(child, "array")) {
+      int iParameter = descriptor->nParameters++;
+
+      descriptor->parameters[iParameter] = child;
+      descriptor->parameterSizes[iParameter] = countNodeValues(doc, child);
+      if (descriptor->parameterSizes[iParameter] == INVALID_NODE_VALUES) {
+        freeDescriptor(descriptor);
+        return NULL;
+      }
+    }
+  }
+  return descriptor;
+}
+
+static size_t hashDescriptorElement(xmlNodePtr element, int bucketCount)
+{
+  size_t key = (size_t) element >> 4;
+  return (size_t) ((key * 2654435761u) ^ (key >> 16)) & (size_t) (bucketCount - 1);
+}
+
+/* doubles the number of buckets, arrayDescriptorsMutex has to be locked */
+static int growDescriptorTable(TixiDocument* document)
+{
+  int newCount = document->arrayDescriptorBucketCount > 0 ? 2 * document->arrayDescriptorBucketCount
+                                                          : INITIAL_ARRAY_DESCRIPTOR_BUCKETS;
+  TixiArrayDescriptor** newBuckets = (TixiArrayDescriptor**) calloc((size_t) newCount, sizeof(TixiArrayDescriptor*));
+  int iBucket;
+
+  if (!newBuckets) {
+    return 0;
+  }
+
+  for (iBucket = 0; iBucket < document->arrayDescriptorBucketCount; ++iBucket) {
+    TixiArrayDescriptor* descriptor = document->arrayDescriptorBuckets[iBucket];
+    while (descriptor) {
+      TixiArrayDescriptor* next = descriptor->next;
+      size_t bucket = hashDescriptorElement(descriptor->element, newCount);
+      descriptor->next = newBuckets[bucket];
+      newBuckets[bucket] = descriptor;
+      descriptor = next;
+    }
+  }
+
+  free(document->arrayDescriptorBuckets);
+  document->arrayDescriptorBuckets = newBuckets;
+  document->arrayDescriptorBucketCount = newCount;
+  return 1;
+}
+
+TixiArrayDescriptor* array_getDescriptor(TixiDocument* document, xmlNodePtr element)
+{
+  TixiArrayDescriptor* descriptor = NULL;
+
+  mutex_lock(&document->arrayDescriptorsMutex);
+
+  if (document->arrayDescriptorBucketCount > 0) {
+    descriptor = document->arrayDescriptorBuckets[hashDescriptorElement(element, document->arrayDescriptorBucketCount)];
+    while (descriptor && descriptor->element != element) {
+      descriptor = descriptor->next;
+    }
+  }
+  if (!descriptor
+      && (document->arrayDescriptorCount < document->arrayDescriptorBucketCount || growDescriptorTable(document))) {
+    descriptor = createDescriptor(document->docPtr, element);
+    if (descriptor) {
+      size_t bucket = hashDescriptorElement(element, document->arrayDescriptorBucketCount);
+      descriptor->next = document->arrayDescriptorBuckets[bucket];
+      document->arrayDescriptorBuckets[bucket] = descriptor;
+      document->arrayDescriptorCount++;
+    }
+  }
+
+  mutex_unlock(&document->arrayDescriptorsMutex);
+  return descriptor;
+}
+
+int array_findParameter(const TixiArrayDescriptor* descriptor, xmlNodePtr element)
+{
+  int i;
+
+  for (i = 0; i < descriptor->nParameters; ++i) {
+    if (descriptor->parameters[i] == element) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+const double* array_getParameterValues(TixiDocument* document, TixiArrayDescriptor* descriptor, int iParameter)
+{
+  double* values = NULL;
+
+  if (descriptor->parameterSizes[iParameter] < 0) {
+    return NULL;
+  }
+
+  mutex_lock(&document->arrayDescriptorsMutex);
+  if (!descriptor->parameterValues[iParameter]) {
+    descriptor->parameterValues[iParameter] = parseNodeValues(document->docPtr, descriptor->parameters[iParameter],
+                                                              descriptor->parameterSizes[iParameter]);
+  }
+  values = descriptor->parameterValues[iParameter];
+  mutex_unlock(&document->arrayDescriptorsMutex);
+
+  return values;
+}
+
+void array_clearDescriptors(TixiDocument* document)
+{
+  int iBucket;
+
+  /* called by every modification, most of them did not read arrays before */
+  if (!document->arrayDescriptorBuckets) {
+    return;
+  }
+
+  for (iBucket = 0; iBucket < document->arrayDescriptorBucketCount; ++iBucket) {
+    TixiArrayDescriptor* descriptor = document->arrayDescriptorBuckets[iBucket];
+    while (descriptor) {
+      TixiArrayDescriptor* next = descriptor->next;
+      freeDescriptor(descriptor);
+      descriptor = next;
+    }
+  }
+  free(document->arrayDescriptorBuckets);
+  document->arrayDescriptorBuckets = NULL;
+  document->arrayDescriptorBucketCount = 0;
+  document->arrayDescriptorCount = 0;
+}
@@ -0,0 +1,61 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef TIXI_ARRAYHELPER_H
+#define TIXI_ARRAYHELPER_H
+
+#include "tixi.h"
+#include "tixiData.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Returns the descriptor of the array held by element.
+ *
+ * The descriptor is created on the first use, the names, sizes and values of the
+ * dimensions are read at once. It remains valid until the document is modified.
+ *
+ * @return the descriptor, NULL if memory could not be allocated or the base64 data
+ *         of an element is invalid
+ */
+TixiArrayDescriptor* array_getDescriptor(TixiDocument* document, xmlNodePtr element);
+
+/**
+ * @brief Returns the index of the parameter element of the descriptor, -1 if
+ * element is no parameter of the array.
+ */
+int array_findParameter(const TixiArrayDescriptor* descriptor, xmlNodePtr element);
+
+/**
+ * @brief Returns the values of a parameter, which are read on the first use.
+ *
+ * @return the values, NULL for a parameter without text (descriptor->parameterSizes[iParameter] is -1)
+ *         or if memory could not be allocated
+ */
+const double* array_getParameterValues(TixiDocument* document, TixiArrayDescriptor* descriptor, int iParameter);
+
+/**
+ * @brief Frees all array descriptors of the document, which has to be locked for writing.
+ */
+void array_clearDescriptors(TixiDocument* document);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIXI_ARRAYHELPER_H */
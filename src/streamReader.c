@@ -0,0 +1,778 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "streamReader.h"
+
+#include "tixiInternal.h"
+#include "tixiUtils.h"
+#include "xpathFunctions.h"
+#include "libxml/xmlreader.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+extern void printMsg(MessageType type, const char* message, ...);
+
+/* the files are read for a few values, so huge texts are not rejected */
+#define STREAM_PARSE_OPTIONS (XML_PARSE_NOBLANKS | XML_PARSE_HUGE)
+
+typedef struct
+{
+  char* path;                    /* copy of the path, the steps point into it */
+  SimplePathStep* steps;
+  int nSteps;
+  const char* attributeName;     /* name of the final attribute step, NULL for elements */
+  int matchedDepth;              /* number of steps matched by the open elements */
+  int* siblingCounts;            /* per step, the number of matching children of the matched parent */
+} StreamPath;
+
+typedef struct
+{
+  StreamPath* paths;
+  int nPaths;
+  OpenMode openMode;
+  char* dirname;                 /* directory of the file, the external directories are relative to it */
+  TixiStreamValueFnc callback;
+  void* userData;
+  int stopped;                   /* set by the callback or an error */
+  ReturnCode error;
+
+  /* direct text of the matched elements, by depth */
+  TixiStringBuffer texts[MAX_SIMPLE_PATH_STEPS];
+  int collectText[MAX_SIMPLE_PATH_STEPS];
+  int isVector[MAX_SIMPLE_PATH_STEPS];
+  int isBase64[MAX_SIMPLE_PATH_STEPS];
+
+  double* values;                /* values of the last vector */
+  int valuesCapacity;
+} StreamState;
+
+static ReturnCode streamFile(StreamState* state, const char* filename, int baseDepth);
+
+static int nameEquals(const xmlChar* name, const char* expected, size_t length)
+{
+  return name && strncmp((const char*) name, expected, length) == 0 && name[length] == '\0';
+}
+
+/* returns the value of the unprefixed attribute of the current element, to be freed with xmlFree */
+static xmlChar* getAttribute(xmlTextReaderPtr reader, const char* name, size_t length)
+{
+  xmlChar* value = NULL;
+
+  if (xmlTextReaderMoveToFirstAttribute(reader) != 1) {
+    return NULL;
+  }
+  do {
+    if (!xmlTextReaderConstNamespaceUri(reader) && nameEquals(xmlTextReaderConstName(reader), name, length)) {
+      value = xmlTextReaderValue(reader);
+      break;
+    }
+  }
+  while (xmlTextReaderMoveToNextAttribute(reader) == 1);
+
+  xmlTextReaderMoveToElement(reader);
+  return value;
+}
+
+/* returns 1 if the current element of the reader has the attribute of the predicate of step */
+static int readerHasAttributeValue(void* element, const SimplePathStep* step)
+{
+  xmlChar* value = getAttribute((xmlTextReaderPtr) element, step->attributeName, step->attributeNameLength);
+  int equal = nameEquals(value, step->attributeValue, step->attributeValueLength);
+
+  xmlFree(value);
+  return equal;
+}
+
+/* matches an element against the next step of the path, advances the path and returns 1 if it matches */
+static int matchStep(StreamPath* path, int depth, const xmlChar* name, int hasNamespace,
+                     int (*hasAttributeValue)(void*, const SimplePathStep*), void* element)
+{
+  const SimplePathStep* step = NULL;
+
+  if (path->matchedDepth != depth || depth >= path->nSteps) {
+    return 0;
+  }
+
+  step = &path->steps[depth];
+  if (hasNamespace || !nameEquals(name, step->name, step->nameLength)) {
+    return 0;
+  }
+  if (step->attributeName && !hasAttributeValue(element, step)) {
+    return 0;
+  }
+  if (step->position > 0 && ++path->siblingCounts[depth] != step->position) {
+    return 0;
+  }
+
+  path->matchedDepth = depth + 1;
+  if (depth + 1 < path->nSteps) {
+    path->siblingCounts[depth + 1] = 0;
+  }
+  return 1;
+}
+
+/* closes the steps matched by the element at depth and its descendants */
+static void closeSteps(StreamPath* paths, int nPaths, int depth)
+{
+  int iPath = 0;
+
+  for (iPath = 0; iPath < nPaths; ++iPath) {
+    if (paths[iPath].matchedDepth > depth) {
+      paths[iPath].matchedDepth = depth;
+    }
+  }
+}
+
+/* splits a final attribute step from the path and parses the element steps */
+static ReturnCode initPath(StreamPath* streamPath, const char* path)
+{
+  SimplePathStep steps[MAX_SIMPLE_PATH_STEPS];
+  char* attributeStep = NULL;
+
+  memset(streamPath, 0, sizeof(StreamPath));
+  streamPath->path = buildString("%s", path);
+  if (!streamPath->path) {
+    return FAILED;
+  }
+
+  attributeStep = strrchr(streamPath->path, '/');
+  if (attributeStep && attributeStep[1] == '@') {
+    streamPath->attributeName = attributeStep + 2;
+    if (streamPath->attributeName[0] == '\0' || strpbrk(streamPath->attributeName, "[]=\"' ")) {
+      return INVALID_XPATH;
+    }
+    *attributeStep = '\0';
+  }
+
+  streamPath->nSteps = XPathParseSimplePath(streamPath->path, steps);
+  if (streamPath->nSteps <= 0) {
+    return INVALID_XPATH;
+  }
+  streamPath->steps = (SimplePathStep*) malloc(streamPath->nSteps * sizeof(SimplePathStep));
+  streamPath->siblingCounts = (int*) calloc(streamPath->nSteps, sizeof(int));
+  if (!streamPath->steps || !streamPath->siblingCounts) {
+    return FAILED;
+  }
+  memcpy(streamPath->steps, steps, streamPath->nSteps * sizeof(SimplePathStep));
+  return SUCCESS;
+}
+
+static void freePath(StreamPath* streamPath)
+{
+  free(streamPath->path);
+  free(streamPath->steps);
+  free(streamPath->siblingCounts);
+}
+
+static void reportValue(StreamState* state, int pathIndex, const char* text, const double* values, int nValues)
+{
+  if (state->callback(pathIndex, text, values, nValues, state->userData) != 0) {
+    state->stopped = 1;
+  }
+}
+
+/* parses the collected text of a vector element into state->values */
+static int readVector(StreamState* state, int depth)
+{
+  const char* text = state->texts[depth].data;
+  int count = readVectorTextValues(text, state->isBase64[depth], state->values, state->valuesCapacity);
+
+  if (count > state->valuesCapacity) {
+    double* values = (double*) realloc(state->values, count * sizeof(double));
+    if (!values) {
+      return -1;
+    }
+    state->values = values;
+    state->valuesCapacity = count;
+    count = readVectorTextValues(text, state->isBase64[depth], state->values, state->valuesCapacity);
+  }
+  return count;
+}
+
+/* reports the elements matched at depth and closes their steps */
+static void endElement(StreamState* state, int depth)
+{
+  int iPath = 0;
+  int nValues = 0;
+
+  if (depth < MAX_SIMPLE_PATH_STEPS && state->collectText[depth]) {
+    TixiStringBuffer* text = &state->texts[depth];
+
+    if (text->failed) {
+      printMsg(MESSAGETYPE_ERROR, "Error: Out of memory while reading the text of an element.\n");
+      state->error = FAILED;
+      state->stopped = 1;
+    }
+    else if (state->isVector[depth]) {
+      nValues = readVector(state, depth);
+      if (nValues < 0) {
+        printMsg(MESSAGETYPE_ERROR, "Error: Invalid base64 data in a vector.\n");
+        state->error = FAILED;
+        state->stopped = 1;
+      }
+    }
+  }
+
+  for (iPath = 0; iPath < state->nPaths; ++iPath) {
+    StreamPath* path = &state->paths[iPath];
+
+    if (path->matchedDepth <= depth) {
+      continue;
+    }
+    if (!state->stopped && path->matchedDepth == path->nSteps && !path->attributeName) {
+      reportValue(state, iPath, state->texts[depth].data,
+                  state->isVector[depth] ? state->values : NULL, state->isVector[depth] ? nValues : 0);
+    }
+    path->matchedDepth = depth;
+  }
+
+  if (depth < MAX_SIMPLE_PATH_STEPS && state->collectText[depth]) {
+    state->collectText[depth] = 0;
+    stringBufferFree(&state->texts[depth]);
+  }
+}
+
+/* forgets the elements of a file that could not be read to the end */
+static void closeElements(StreamState* state, int depth)
+{
+  closeSteps(state->paths, state->nPaths, depth);
+  for (; depth < MAX_SIMPLE_PATH_STEPS; ++depth) {
+    if (state->collectText[depth]) {
+      state->collectText[depth] = 0;
+      stringBufferFree(&state->texts[depth]);
+    }
+  }
+}
+
+/* reads the path and filenames of an externaldata element and reads the files in its place */
+static void readExternalData(StreamState* state, xmlTextReaderPtr reader, int depth)
+{
+  xmlNodePtr node = xmlTextReaderExpand(reader);
+  xmlNodePtr child = NULL;
+  xmlChar* directory = NULL;
+  char* resolvedDirectory = NULL;
+  char** filenames = NULL;
+  int nFilenames = 0;
+  int iFile = 0;
+
+  if (!node) {
+    state->error = NOT_WELL_FORMED;
+    state->stopped = 1;
+    return;
+  }
+
+  for (child = node->children; child; child = child->next) {
+    if (child->type != XML_ELEMENT_NODE) {
+      continue;
+    }
+    if (!directory && xmlStrcmp(child->name, (const xmlChar*) EXTERNAL_DATA_NODE_NAME_PATH) == 0) {
+      directory = xmlNodeGetContent(child);
+    }
+    else if (xmlStrcmp(child->name, (const xmlChar*) EXTERNAL_DATA_NODE_NAME_FILENAME) == 0) {
+      char** newFilenames = (char**) realloc(filenames, (nFilenames + 1) * sizeof(char*));
+      if (!newFilenames) {
+        break;
+      }
+      filenames = newFilenames;
+      filenames[nFilenames++] = (char*) xmlNodeGetContent(child);
+    }
+  }
+
+  if (!directory) {
+    printMsg(MESSAGETYPE_ERROR, "Error: No path defined in externaldata node!\n");
+    state->error = OPEN_FAILED;
+    state->stopped = 1;
+  }
+  else if (nFilenames == 0) {
+    printMsg(MESSAGETYPE_ERROR, "Error: no filename nodes defined in externalData node.\n");
+    state->error = OPEN_FAILED;
+    state->stopped = 1;
+  }
+  else {
+    resolvedDirectory = resolveDirectory(state->dirname, (const char*) directory);
+  }
+
+  for (iFile = 0; iFile < nFilenames; ++iFile) {
+    if (!state->stopped && filenames[iFile]) {
+      char* externalFullFileName = buildString("%s%s", resolvedDirectory, filenames[iFile]);
+      ReturnCode error = streamFile(state, externalFullFileName, depth);
+
+      if (error == NOT_WELL_FORMED) {
+        /* like tixiOpenDocumentRecursive, ignore the rest of the file */
+        printMsg(MESSAGETYPE_WARNING, "Document %s will be ignored. No valid XML document!\n", externalFullFileName);
+        closeElements(state, depth);
+      }
+      else if (error != SUCCESS) {
+        state->error = error;
+        state->stopped = 1;
+      }
+      free(externalFullFileName);
+    }
+    xmlFree(filenames[iFile]);
+  }
+
+  free(filenames);
+  free(resolvedDirectory);
+  xmlFree(directory);
+}
+
+/* matches the element against the next step of the paths, returns 1 if its children have to be read */
+static int startElement(StreamState* state, xmlTextReaderPtr reader, int depth)
+{
+  const xmlChar* name = xmlTextReaderConstName(reader);
+  int hasNamespace = xmlTextReaderConstNamespaceUri(reader) != NULL;
+  int isCandidate = 0;
+  int readChildren = 0;
+  int iPath = 0;
+
+  for (iPath = 0; iPath < state->nPaths && !state->stopped; ++iPath) {
+    StreamPath* path = &state->paths[iPath];
+
+    if (path->matchedDepth == depth && depth < path->nSteps) {
+      isCandidate = 1;
+    }
+    if (!matchStep(path, depth, name, hasNamespace, readerHasAttributeValue, reader)) {
+      continue;
+    }
+
+    if (depth + 1 < path->nSteps) {
+      readChildren = 1;
+    }
+    else if (path->attributeName) {
+      xmlChar* value = getAttribute(reader, path->attributeName, strlen(path->attributeName));
+      if (value) {
+        reportValue(state, iPath, (const char*) value, NULL, 0);
+        xmlFree(value);
+      }
+    }
+    else if (!state->collectText[depth]) {
+      xmlChar* mapType = getAttribute(reader, "mapType", 7);
+      xmlChar* encoding = getAttribute(reader, VECTOR_ENCODING_ATTRIBUTE, strlen(VECTOR_ENCODING_ATTRIBUTE));
+
+      state->collectText[depth] = 1;
+      state->isVector[depth] = nameEquals(mapType, "vector", 6);
+      state->isBase64[depth] = nameEquals(encoding, VECTOR_ENCODING_BASE64, strlen(VECTOR_ENCODING_BASE64));
+      stringBufferInit(&state->texts[depth]);
+      readChildren = 1;
+      xmlFree(mapType);
+      xmlFree(encoding);
+    }
+  }
+
+  /* the root of an external file takes the place of the externaldata element */
+  if (isCandidate && !hasNamespace && state->openMode != OPENMODE_PLAIN && !readChildren
+      && xmlStrcmp(name, (const xmlChar*) EXTERNAL_DATA_NODE_NAME) == 0) {
+    readExternalData(state, reader, depth);
+  }
+  return readChildren;
+}
+
+static ReturnCode streamReader(StreamState* state, xmlTextReaderPtr reader, int baseDepth)
+{
+  int result = xmlTextReaderRead(reader);
+
+  while (result == 1 && !state->stopped) {
+    int type = xmlTextReaderNodeType(reader);
+    int depth = baseDepth + xmlTextReaderDepth(reader);
+
+    if (type == XML_READER_TYPE_ELEMENT) {
+      int isEmpty = xmlTextReaderIsEmptyElement(reader);
+      int readChildren = startElement(state, reader, depth);
+
+      if (!readChildren || isEmpty) {
+        endElement(state, depth);
+      }
+      if (!readChildren && !isEmpty) {
+        result = xmlTextReaderNext(reader);
+        continue;
+      }
+    }
+    else if (type == XML_READER_TYPE_END_ELEMENT) {
+      endElement(state, depth);
+    }
+    else if (type == XML_READER_TYPE_TEXT || type == XML_READER_TYPE_CDATA
+             || type == XML_READER_TYPE_WHITESPACE || type == XML_READER_TYPE_SIGNIFICANT_WHITESPACE) {
+      if (depth > 0 && depth <= MAX_SIMPLE_PATH_STEPS && state->collectText[depth - 1]) {
+        const xmlChar* text = xmlTextReaderConstValue(reader);
+        stringBufferAppend(&state->texts[depth - 1], text ? (const char*) text : "");
+      }
+    }
+    result = xmlTextReaderRead(reader);
+  }
+
+  if (result < 0 && !state->stopped) {
+    return NOT_WELL_FORMED;
+  }
+  return SUCCESS;
+}
+
+/* opens a local file, a file:// URI or a web resource, which is loaded into data */
+static xmlTextReaderPtr openReader(const char* filename, char** data)
+{
+  xmlTextReaderPtr reader = NULL;
+
+  *data = NULL;
+  if (isURIPath(filename) != 0) {
+    reader = xmlReaderForFile(filename, NULL, STREAM_PARSE_OPTIONS);
+  }
+  else if (string_startsWith(filename, "file://") == 0) {
+    char* localPath = uriToLocalPath(filename);
+    if (localPath) {
+      reader = xmlReaderForFile(localPath, NULL, STREAM_PARSE_OPTIONS);
+      free(localPath);
+    }
+  }
+  else {
+    *data = loadExternalFileToString(filename);
+    if (*data) {
+      reader = xmlReaderForMemory(*data, (int) strlen(*data), filename, NULL, STREAM_PARSE_OPTIONS);
+    }
+  }
+  return reader;
+}
+
+static ReturnCode streamFile(StreamState* state, const char* filename, int baseDepth)
+{
+  char* data = NULL;
+  xmlTextReaderPtr reader = openReader(filename, &data);
+  ReturnCode error = SUCCESS;
+
+  if (!reader) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Unable to open file \"%s\".\n", filename);
+    free(data);
+    return OPEN_FAILED;
+  }
+
+  error = streamReader(state, reader, baseDepth);
+  xmlFreeTextReader(reader);
+  free(data);
+  return error;
+}
+
+ReturnCode stream_readDocument(const char* xmlFilename, OpenMode oMode, const char** paths, int nPaths,
+                               TixiStreamValueFnc callback, void* userData)
+{
+  StreamState state;
+  char* filename = NULL;
+  ReturnCode error = SUCCESS;
+  int iPath = 0;
+
+  memset(&state, 0, sizeof(StreamState));
+  state.openMode = oMode;
+  state.callback = callback;
+  state.userData = userData;
+
+  state.paths = (StreamPath*) calloc(nPaths > 0 ? nPaths : 1, sizeof(StreamPath));
+  if (!state.paths) {
+    return FAILED;
+  }
+  for (iPath = 0; iPath < nPaths; ++iPath) {
+    state.nPaths++;
+    error = initPath(&state.paths[iPath], paths[iPath]);
+    if (error == INVALID_XPATH) {
+      printMsg(MESSAGETYPE_ERROR, "Error: \"%s\" is not a simple path in tixiStreamDocument.\n", paths[iPath]);
+    }
+    if (error != SUCCESS) {
+      break;
+    }
+  }
+
+  if (error == SUCCESS) {
+    strip_dirname(xmlFilename, &state.dirname, &filename);
+    error = streamFile(&state, xmlFilename, 0);
+    if (error == NOT_WELL_FORMED) {
+      printMsg(MESSAGETYPE_ERROR, "Error: \"%s\" is not a wellformed XML-file.\n", xmlFilename);
+    }
+    else if (error == SUCCESS) {
+      error = state.error;
+    }
+  }
+
+  closeElements(&state, 0);
+  for (iPath = 0; iPath < state.nPaths; ++iPath) {
+    freePath(&state.paths[iPath]);
+  }
+  free(state.paths);
+  free(state.values);
+  free(state.dirname);
+  free(filename);
+  return error;
+}
+
+struct StreamFilter
+{
+  StreamPath* includes;
+  int nIncludes;
+  StreamPath* excludes;
+  int nExcludes;
+  int depth;                     /* depth of the next kept element */
+  int skipDepth;                 /* number of open elements of a skipped subtree */
+  int nSkipped;                  /* number of skipped subtrees */
+  xmlSAXHandler handler;         /* the handlers of the parser, called for the kept nodes */
+};
+
+static StreamFilter* getFilter(void* ctx)
+{
+  return (StreamFilter*) ((xmlParserCtxtPtr) ctx)->_private;
+}
+
+/* returns 1 if the element of a SAX2 start event has the attribute of the predicate of step */
+static int saxHasAttributeValue(void* element, const SimplePathStep* step)
+{
+  const xmlChar** attributes = (const xmlChar**) element;
+  int iAttribute = 0;
+
+  /* the attributes are terminated by a NULL name, see filterStartElement */
+  for (iAttribute = 0; attributes[iAttribute]; iAttribute += 5) {
+    const xmlChar* value = attributes[iAttribute + 3];
+    size_t length = (size_t) (attributes[iAttribute + 4] - value);
+
+    if (!attributes[iAttribute + 2] && nameEquals(attributes[iAttribute], step->attributeName, step->attributeNameLength)) {
+      return length == step->attributeValueLength && strncmp((const char*) value, step->attributeValue, length) == 0;
+    }
+  }
+  return 0;
+}
+
+/* returns 1 if the element is inside or on the way to an included path and not excluded */
+static int keepElement(StreamFilter* filter, const xmlChar* name, int hasNamespace, const xmlChar** attributes)
+{
+  int depth = filter->depth;
+  int keep = filter->nIncludes == 0 || depth == 0;
+  int iPath = 0;
+
+  for (iPath = 0; iPath < filter->nIncludes; ++iPath) {
+    StreamPath* path = &filter->includes[iPath];
+
+    if (path->matchedDepth == path->nSteps && depth >= path->nSteps) {
+      keep = 1;
+    }
+    else if (matchStep(path, depth, name, hasNamespace, saxHasAttributeValue, (void*) attributes)) {
+      keep = 1;
+    }
+  }
+  for (iPath = 0; iPath < filter->nExcludes; ++iPath) {
+    StreamPath* path = &filter->excludes[iPath];
+
+    if (matchStep(path, depth, name, hasNamespace, saxHasAttributeValue, (void*) attributes)
+        && path->matchedDepth == path->nSteps && depth > 0) {
+      keep = 0;
+    }
+  }
+  return keep;
+}
+
+static void filterStartElement(void* ctx, const xmlChar* localname, const xmlChar* prefix, const xmlChar* URI,
+                               int nb_namespaces, const xmlChar** namespaces, int nb_attributes, int nb_defaulted,
+                               const xmlChar** attributes)
+{
+  StreamFilter* filter = getFilter(ctx);
+  const xmlChar* attributeList[5 * 16 + 1];
+  const xmlChar** terminatedAttributes = attributeList;
+  int keep = 0;
+
+  if (filter->skipDepth > 0) {
+    filter->skipDepth++;
+    return;
+  }
+
+  /* the attributes of SAX2 are counted, the predicates expect a terminated list */
+  if (nb_attributes > 16) {
+    terminatedAttributes = (const xmlChar**) malloc((5 * nb_attributes + 1) * sizeof(xmlChar*));
+    if (!terminatedAttributes) {
+      xmlStopParser((xmlParserCtxtPtr) ctx);
+      return;
+    }
+  }
+  if (nb_attributes > 0) {
+    memcpy((void*) terminatedAttributes, (const void*) attributes, 5 * nb_attributes * sizeof(xmlChar*));
+  }
+  terminatedAttributes[5 * nb_attributes] = NULL;
+
+  keep = keepElement(filter, localname, URI != NULL, terminatedAttributes);
+  if (terminatedAttributes != attributeList) {
+    free((void*) terminatedAttributes);
+  }
+
+  if (!keep) {
+    closeSteps(filter->includes, filter->nIncludes, filter->depth);
+    closeSteps(filter->excludes, filter->nExcludes, filter->depth);
+    filter->skipDepth = 1;
+    filter->nSkipped++;
+    return;
+  }
+
+  filter->depth++;
+  filter->handler.startElementNs(ctx, localname, prefix, URI, nb_namespaces, namespaces, nb_attributes, nb_defaulted,
+                                 attributes);
+}
+
+static void filterEndElement(void* ctx, const xmlChar* localname, const xmlChar* prefix, const xmlChar* URI)
+{
+  StreamFilter* filter = getFilter(ctx);
+
+  if (filter->skipDepth > 0) {
+    filter->skipDepth--;
+    return;
+  }
+
+  filter->depth--;
+  closeSteps(filter->includes, filter->nIncludes, filter->depth);
+  closeSteps(filter->excludes, filter->nExcludes, filter->depth);
+  filter->handler.endElementNs(ctx, localname, prefix, URI);
+}
+
+static void filterCharacters(void* ctx, const xmlChar* text, int length)
+{
+  StreamFilter* filter = getFilter(ctx);
+
+  if (filter->skipDepth == 0) {
+    filter->handler.characters(ctx, text, length);
+  }
+}
+
+static void filterIgnorableWhitespace(void* ctx, const xmlChar* text, int length)
+{
+  StreamFilter* filter = getFilter(ctx);
+
+  if (filter->skipDepth == 0 && filter->handler.ignorableWhitespace) {
+    filter->handler.ignorableWhitespace(ctx, text, length);
+  }
+}
+
+static void filterCDataBlock(void* ctx, const xmlChar* text, int length)
+{
+  StreamFilter* filter = getFilter(ctx);
+
+  if (filter->skipDepth == 0) {
+    filter->handler.cdataBlock(ctx, text, length);
+  }
+}
+
+static void filterComment(void* ctx, const xmlChar* text)
+{
+  StreamFilter* filter = getFilter(ctx);
+
+  if (filter->skipDepth == 0) {
+    filter->handler.comment(ctx, text);
+  }
+}
+
+static void filterProcessingInstruction(void* ctx, const xmlChar* target, const xmlChar* data)
+{
+  StreamFilter* filter = getFilter(ctx);
+
+  if (filter->skipDepth == 0) {
+    filter->handler.processingInstruction(ctx, target, data);
+  }
+}
+
+static void filterReference(void* ctx, const xmlChar* name)
+{
+  StreamFilter* filter = getFilter(ctx);
+
+  if (filter->skipDepth == 0) {
+    filter->handler.reference(ctx, name);
+  }
+}
+
+static ReturnCode initFilterPaths(const char** paths, int nPaths, StreamPath** streamPaths, int* nStreamPaths)
+{
+  ReturnCode error = SUCCESS;
+  int iPath = 0;
+
+  *nStreamPaths = 0;
+  *streamPaths = (StreamPath*) calloc(nPaths > 0 ? nPaths : 1, sizeof(StreamPath));
+  if (!*streamPaths) {
+    return FAILED;
+  }
+  for (iPath = 0; iPath < nPaths; ++iPath) {
+    (*nStreamPaths)++;
+    error = initPath(&(*streamPaths)[iPath], paths[iPath]);
+    if (error == SUCCESS && (*streamPaths)[iPath].attributeName) {
+      error = INVALID_XPATH;
+    }
+    if (error == INVALID_XPATH) {
+      printMsg(MESSAGETYPE_ERROR, "Error: \"%s\" is not a simple element path.\n", paths[iPath]);
+    }
+    if (error != SUCCESS) {
+      break;
+    }
+  }
+  return error;
+}
+
+ReturnCode stream_createFilter(const char** includePaths, int nIncludePaths, const char** excludePaths,
+                               int nExcludePaths, StreamFilter** filter)
+{
+  ReturnCode error = SUCCESS;
+
+  *filter = (StreamFilter*) calloc(1, sizeof(StreamFilter));
+  if (!*filter) {
+    return FAILED;
+  }
+
+  error = initFilterPaths(includePaths, nIncludePaths, &(*filter)->includes, &(*filter)->nIncludes);
+  if (error == SUCCESS) {
+    error = initFilterPaths(excludePaths, nExcludePaths, &(*filter)->excludes, &(*filter)->nExcludes);
+  }
+  if (error != SUCCESS) {
+    stream_freeFilter(*filter);
+    *filter = NULL;
+  }
+  return error;
+}
+
+void stream_installFilter(StreamFilter* filter, xmlParserCtxtPtr ctxt)
+{
+  xmlSAXHandlerPtr sax = ctxt->sax;
+
+  filter->handler = *sax;
+  ctxt->_private = filter;
+
+  sax->startElementNs = filterStartElement;
+  sax->endElementNs = filterEndElement;
+  sax->characters = filterCharacters;
+  sax->ignorableWhitespace = filterIgnorableWhitespace;
+  sax->cdataBlock = filterCDataBlock;
+  sax->comment = filterComment;
+  sax->processingInstruction = filterProcessingInstruction;
+  sax->reference = filterReference;
+}
+
+int stream_getSkippedCount(const StreamFilter* filter)
+{
+  return filter->nSkipped;
+}
+
+void stream_freeFilter(StreamFilter* filter)
+{
+  int iPath = 0;
+
+  if (!filter) {
+    return;
+  }
+  for (iPath = 0; iPath < filter->nIncludes; ++iPath) {
+    freePath(&filter->includes[iPath]);
+  }
+  for (iPath = 0; iPath < filter->nExcludes; ++iPath) {
+    freePath(&filter->excludes[iPath]);
+  }
+  free(filter->includes);
+  free(filter->excludes);
+  free(filter);
+}
@@ -0,0 +1,76 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef TIXI_STREAMREADER_H
+#define TIXI_STREAMREADER_H
+
+#include "tixi.h"
+#include "libxml/parser.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Reads the values matching the paths from a file with the libxml2 text reader,
+ * see ::tixiStreamDocument.
+ *
+ * The elements of each path are matched against the stack of the open elements. Each path
+ * remembers the number of its steps matched by the open elements and the number of matching
+ * siblings for position predicates, so no tree is built. Subtrees of elements not matching
+ * the next step of any path are skipped.
+ */
+ReturnCode stream_readDocument(const char* xmlFilename, OpenMode oMode, const char** paths, int nPaths,
+                               TixiStreamValueFnc callback, void* userData);
+
+/**
+ * @brief Filter of the elements of a parsed document, see TixiOpenOptions::includePaths.
+ *
+ * The filter is installed into the SAX2 handlers of a parser context. The elements are
+ * matched against the include and exclude paths like in stream_readDocument, the events of
+ * skipped subtrees are not passed to the handlers, so they are never added to the tree.
+ */
+typedef struct StreamFilter StreamFilter;
+
+/**
+ * @brief Creates a filter keeping the elements on and below the include paths, except for
+ * the subtrees of the exclude paths. Without include paths, all elements are included.
+ * The root element is always kept.
+ *
+ * @return SUCCESS, INVALID_XPATH if a path is not a simple element path or FAILED
+ */
+ReturnCode stream_createFilter(const char** includePaths, int nIncludePaths, const char** excludePaths,
+                               int nExcludePaths, StreamFilter** filter);
+
+/**
+ * @brief Installs the filter into the handlers of the parser context.
+ *
+ * Must be called after the options of the context are set, which replace some of the handlers.
+ */
+void stream_installFilter(StreamFilter* filter, xmlParserCtxtPtr ctxt);
+
+/**
+ * @brief Returns the number of subtrees skipped by the filter.
+ */
+int stream_getSkippedCount(const StreamFilter* filter);
+
+void stream_freeFilter(StreamFilter* filter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIXI_STREAMREADER_H */
@@ -34,6 +34,7 @@ extern "C" {
   - \link Glossary Glossary\endlink
   - \link  XPathExamples XPath Examples\endlink
   - \link UsageExamples Usage\endlink
+  - \link Threads Using TiXI from several threads\endlink
   - <a HREF="modules.html"  class="el">Function Documentation</a>
  */
 /*
@@ -208,13 +209,36 @@ extern "C" {
   To compile, use our Makefile by typing in the command "make".
 */
 
+/**
+ @page Threads Using TiXI from several threads
+
+  All functions of TiXI can be called from several threads at the same time.
+  Any number of threads may read from the same document concurrently (all tixiGet...,
+  tixiCheck... and tixiXPath... functions). Functions modifying a document, saving or
+  validating it get exclusive access, i.e. they wait until all other threads are
+  done with the document.
+
+  XPath expressions are evaluated in an XPath context, which is modified during the
+  evaluation. Therefore, each thread lazily gets its own context for each document it
+  reads from. All namespaces registered with ::tixiRegisterNamespace or
+  ::tixiRegisterNamespacesFromDocument are available in the contexts of all threads.
+  Read-only queries on one document hence run in parallel on all cores. The
+  benchmark bench_parallel_reads (build option TIXI_BUILD_BENCHMARKS) measures the
+  scaling of a getter heavy workload from 1 to 32 threads.
+
+  Strings returned by TiXI belong to the document and remain valid until the document
+  is closed or the memory is released with ::tixiMemoryReleaseTo. If one thread closes a document, other threads still running a function
+  on it finish normally, later calls return INVALID_HANDLE. It is the responsibility
+  of the application to not use returned strings after the document was closed.
+*/
+
 
 /**
  @internal
  @section ImplementationIssuues Implementation issues
 
   - Memory allocated by TIXI and associated with a document is released
-   when closing the document.
+   when closing the document, or earlier with ::tixiMemoryReleaseTo.
 
   - TixiDocumentHandle is an integer used as index to access an TIXI
    internal data structure.
@@ -230,11 +254,18 @@ extern "C" {
 #ifndef TIXI_H
 #define TIXI_H
 
+#include <stddef.h>
+
 /**
    Datatype for TixiDocumentHandle.
 */
 typedef int TixiDocumentHandle;
 
+/**
+   Datatype for TixiNodeCursor, see ::tixiGetNodeCursor.
+*/
+typedef int TixiNodeCursor;
+
 
 /**
   \defgroup Enums Enumerations
@@ -306,7 +337,7 @@ enum ReturnCode
   NO_ATTRIBUTE_NAME,          /*!< 25: No attribute name specified               */
 
   STRING_TRUNCATED,           /*!< 26: String variable supplied is to small to
-                                   hold the result, Fortran only             */
+                                   hold the result                           */
 
   NON_MATCHING_NAME,          /*!< 27: Row or column name specified do not
                                    match the names used in the document      */
@@ -331,7 +362,11 @@ enum ReturnCode
 
   INVALID_NAMESPACE_URI,          /*!< 34: The namespace URI is invalid (e.g. a null pointer) */
 
-  INVALID_NAMESPACE_PREFIX        /*!< 35: The namespace prefix is invalid */
+  INVALID_NAMESPACE_PREFIX,       /*!< 35: The namespace prefix is invalid */
+
+  INVALID_CURSOR,                 /*!< 36: The node cursor is invalid or its element has been removed */
+
+  UID_REFERENCE_CYCLE             /*!< 37: The references between uIDs contain a cycle */
 
 };
 
@@ -366,18 +401,64 @@ typedef enum StorageMode StorageMode;
       If OpenMode is OPENMODE_PLAIN, the xml file is open "normal" and just the given
       file is opend. If OpenMode is OPENMODE_RECURSIVE, then all external files
       specified in a <externaldata> node are opend and replaced in the xml tree.
+      OPENMODE_RECURSIVE_LAZY replaces the <externaldata> nodes on their first use.
 
   Has a typedef to OpenMode.
    */
 enum OpenMode
 {
   OPENMODE_PLAIN,                   /*!< Open just the xml file       */
-  OPENMODE_RECURSIVE                /*!< Open with external files     */
+  OPENMODE_RECURSIVE,               /*!< Open with external files     */
+  OPENMODE_RECURSIVE_LAZY           /*!< Open external files on demand */
 };
 
 
 typedef enum OpenMode OpenMode;
 
+/**
+
+ \ingroup Enums
+      Flags of ::TixiOpenOptions controlling how a xml file is parsed.
+      The flags are combined with "|".
+
+  Has a typedef to OpenFlags.
+   */
+enum OpenFlags
+{
+  OPENFLAG_KEEP_BLANKS = 1,         /*!< Keep text nodes consisting of white space only      */
+  OPENFLAG_COMPACT     = 2,         /*!< Store short texts compactly, saves memory           */
+  OPENFLAG_HUGE        = 4,         /*!< No limits for the parser, e.g. texts above 10 MB    */
+  OPENFLAG_MEMORY_MAP  = 8          /*!< Map the file into memory instead of reading it      */
+};
+
+
+typedef enum OpenFlags OpenFlags;
+
+/**
+
+ \ingroup Enums
+      Options to open a xml file with ::tixiOpenDocumentWithOptions.
+
+  Has a typedef to TixiOpenOptions.
+   */
+struct TixiOpenOptions
+{
+  OpenMode openMode;                /*!< OPENMODE_PLAIN, OPENMODE_RECURSIVE or
+                                         OPENMODE_RECURSIVE_LAZY                            */
+  int flags;                        /*!< Combination of ::OpenFlags, 0 as tixiOpenDocument   */
+  size_t sizeHint;                  /*!< Expected size of the file in bytes, 0 if unknown.
+                                         The file is read in blocks of this size, at most 16 MB */
+  const char **includePaths;        /*!< Only the elements on and below these paths are loaded,
+                                         NULL or no paths load all elements                 */
+  int nIncludePaths;                /*!< Number of includePaths                              */
+  const char **excludePaths;        /*!< The elements of these paths and their subtrees are
+                                         not loaded                                         */
+  int nExcludePaths;                /*!< Number of excludePaths                              */
+};
+
+
+typedef struct TixiOpenOptions TixiOpenOptions;
+
 /**
 
   \ingroup Enums
@@ -396,6 +477,26 @@ enum MessageType
 
 typedef enum MessageType MessageType;
 
+/**
+
+  \ingroup Enums
+       Type of a value read by ::tixiGetValues
+
+       The text of the element or attribute is converted like in
+       ::tixiGetDoubleElement, ::tixiGetIntegerElement and ::tixiGetBooleanElement.
+
+  Has a typedef to ValueType.
+   */
+enum ValueType
+{
+  VALUETYPE_DOUBLE,                  /*!< Floating point number        */
+  VALUETYPE_INTEGER,                 /*!< Integer number               */
+  VALUETYPE_BOOLEAN                  /*!< "true"/"1" or "false"/"0"    */
+};
+
+
+typedef enum ValueType ValueType;
+
 /**
  * TixiPrintMsgFnc:
  * @param[in]  type The message type (error, warning, status)
@@ -407,6 +508,34 @@ typedef enum MessageType MessageType;
  */
 typedef void (*TixiPrintMsgFnc) (MessageType type, const char *msg);
 
+/**
+ * TixiXPathNodeFnc:
+ * @param[in]  index The index of the node in the result, starting with 1
+ * @param[in]  elementName The name of the element or attribute, NULL for other nodes
+ * @param[in]  text The text content of the node, NULL for nodes without text
+ * @param[in]  xPath The path of the node
+ * @param[in]  userData The pointer passed to ::tixiXPathExpressionForEach
+ *
+ * Signature of a callback function called for each node of an XPath result,
+ * see ::tixiXPathExpressionForEach. Returns 0 to continue with the next node,
+ * any other value stops the iteration.
+ */
+typedef int (*TixiXPathNodeFnc) (int index, const char *elementName, const char *text, const char *xPath, void *userData);
+
+/**
+ * TixiStreamValueFnc:
+ * @param[in]  pathIndex The index of the matching path in the paths passed to ::tixiStreamDocument, starting with 0
+ * @param[in]  text The text of the element or the value of the attribute
+ * @param[in]  vector The values of an element with the attribute mapType="vector", NULL for other elements and attributes
+ * @param[in]  vectorSize The number of values in vector
+ * @param[in]  userData The pointer passed to ::tixiStreamDocument
+ *
+ * Signature of a callback function called for each element or attribute matching
+ * a path, see ::tixiStreamDocument. Returns 0 to continue reading the document,
+ * any other value stops reading.
+ */
+typedef int (*TixiStreamValueFnc) (int pathIndex, const char *text, const double *vector, int vectorSize, void *userData);
+
 /**
   @brief Returns the version number of this TIXI version.
 
@@ -486,6 +615,16 @@ DLL_EXPORT ReturnCode tixiOpenDocument (const char *xmlFilename, TixiDocumentHan
   </wings>
   @endcode
 
+  With OPENMODE_RECURSIVE_LAZY, the externaldata nodes are kept when the file is opened.
+  The files of an externaldata node are read and integrated into the tree the first time a
+  path resolves to its parent element or passes through it, e.g. /wings/airfoils/airfoil[2]/name
+  in the example above. Expressions other than simple paths like /a/b[2]/c[@uID="x"], e.g. //airfoil,
+  and the uID functions read all external files. ::tixiResolveExternal reads the files of a
+  subtree in advance. The files of several externaldata nodes are read in parallel.
+  Threads read such a document concurrently. A getter, which reaches an externaldata node
+  that is not read yet, waits for the other readers and integrates the files exclusively.
+  Parts of the document, which are never used, do not slow down the readers.
+
   <b>Fortran syntax:</b>
 
   tixi_open_document_recursive( character*n xml_filename, integer handle, integer openmode, integer error )
@@ -493,7 +632,8 @@ DLL_EXPORT ReturnCode tixiOpenDocument (const char *xmlFilename, TixiDocumentHan
   @param[in]  xmlFilename name of the XML-file to be opened
   @param[out] handle      handle to the XML-document. This handle is used in
                           calls to other TIXI functions.
-  @param[in]  oMode       Enum of the mode to open (OPENMODE_PLAIN / OPENMODE_RECURSIVE).
+  @param[in]  oMode       Enum of the mode to open (OPENMODE_PLAIN / OPENMODE_RECURSIVE /
+                          OPENMODE_RECURSIVE_LAZY).
 
   @return
     - SUCCESS if successfully opened the XML-file
@@ -504,6 +644,123 @@ DLL_EXPORT ReturnCode tixiOpenDocument (const char *xmlFilename, TixiDocumentHan
 DLL_EXPORT ReturnCode tixiOpenDocumentRecursive (const char *xmlFilename, TixiDocumentHandle * handle, OpenMode oMode);
 
 
+/**
+  @brief Open an XML-file for reading with options for large files.
+
+  Acts like ::tixiOpenDocumentRecursive with the open mode of options. The flags
+  of options select how the file is parsed:
+    - OPENFLAG_KEEP_BLANKS keeps text nodes consisting of white space only, which are
+      removed by default.
+    - OPENFLAG_COMPACT stores short texts in the nodes, which saves memory for documents
+      with many small elements.
+    - OPENFLAG_HUGE lifts the limits of the parser, which rejects e.g. texts larger than 10 MB.
+      External files of the document are parsed with the same flags.
+    - OPENFLAG_MEMORY_MAP parses the file mapped into memory instead of reading it in blocks.
+      This is usually faster, the mapped pages are counted in the memory use of the process
+      while the file is parsed.
+
+  Without memory mapping, the file is read in blocks of options->sizeHint bytes (at most 16 MB),
+  which reduces the number of reads for large files. Files compressed with gzip and files
+  larger than 2 GB, which cannot be parsed as one block, are never mapped into memory.
+
+  To load only a part of a large file, options->includePaths and options->excludePaths take
+  simple element paths like /cpacs/vehicles/aircraft/model/wings, see ::tixiStreamDocument.
+  If include paths are given, the elements matching the whole path are loaded with their subtrees.
+  The elements matching the first steps of an include path are loaded with their attributes
+  and texts, even if none of their children matches the rest of the path, their other child
+  elements are skipped. The subtrees of the exclude paths are not loaded, the root element is
+  always loaded. Skipped elements are never added to the tree, which saves time and memory.
+  As the document does not hold the whole file, it cannot be saved or exported: ::tixiSaveDocument,
+  ::tixiSaveCompleteDocument, ::tixiSaveAndRemoveDocument and ::tixiExportDocumentAsString
+  return FAILED, if elements were skipped.
+
+  @param[in]  xmlFilename name of the XML-file to be opened
+  @param[out] handle      handle to the XML-document. This handle is used in
+                          calls to other TIXI functions.
+  @param[in]  options     options to open the document, NULL opens like ::tixiOpenDocument
+
+  @return
+    - SUCCESS if successfully opened the XML-file
+    - NOT_WELL_FORMED if opening the XML-file succeeds but test for
+                      well-formedness fails
+    - OPEN_FAILED if opening of the XML-file failed
+    - INVALID_XPATH if an include or exclude path is not a simple element path
+ */
+DLL_EXPORT ReturnCode tixiOpenDocumentWithOptions (const char *xmlFilename, TixiDocumentHandle * handle,
+                                                   const TixiOpenOptions *options);
+
+
+/**
+  @brief Reads the external files below an element of a document opened with OPENMODE_RECURSIVE_LAZY.
+
+  The files of the externaldata nodes on the path and in the subtrees of the elements matching
+  the path are read and integrated into the tree, including the external files referenced by these
+  files. Other files are read when they are used, see ::tixiOpenDocumentRecursive. Use "/" to read
+  all external files. The files are read in parallel. Does nothing for documents opened otherwise.
+
+  <b>Fortran syntax:</b>
+
+  tixi_resolve_external( integer handle, character*n element_path, integer error )
+
+  @param[in]  handle      handle as returned by ::tixiOpenDocumentRecursive or ::tixiOpenDocumentWithOptions
+  @param[in]  elementPath path of the elements whose external files are read
+
+  @return
+    - SUCCESS if all external files were read
+    - INVALID_HANDLE if the handle is not valid
+    - INVALID_XPATH if elementPath is not a valid XPath expression
+    - ELEMENT_NOT_FOUND if elementPath does not point to a node in the XML-document
+    - OPEN_FAILED if an externaldata node is invalid or a file cannot be read. The externaldata
+                  node is kept, the other files are read
+ */
+DLL_EXPORT ReturnCode tixiResolveExternal (const TixiDocumentHandle handle, const char *elementPath);
+
+
+/**
+  @brief Reads the elements and attributes matching a list of paths from an XML-file
+  without opening it as a document.
+
+  The file is read in a single pass with the libxml2 text reader, no tree of the
+  document is built. The memory used is independent of the size of the file, subtrees
+  that cannot contain a match are skipped. This suits extracting a few values from
+  very large files, the limits of the parser for huge texts are lifted.
+
+  The paths are simple absolute paths of element names with an optional position
+  or attribute predicate per step, e.g. /cpacs/vehicles/aircraft/model[@uID="model"]/wings/wing[2]/name.
+  A path may end with an attribute step like /cpacs/header/version/@uID.
+
+  For each match, callback receives the index of the path, the text of the element or the value
+  of the attribute and, for elements with the attribute mapType="vector", the values of the vector
+  (also if they are base64 encoded, see ::tixiUseBase64Vectors). Like ::tixiGetTextElement, the text of an
+  element consists of its direct text content. Attributes are reported when their element starts, elements
+  when they end, i.e. in document order of the end tags. The strings and values are only valid during the
+  call of the callback.
+
+  With OPENMODE_RECURSIVE or OPENMODE_RECURSIVE_LAZY, the files referenced by the externaldata elements
+  of the file are read at the position of the externaldata element, as if they were included by
+  ::tixiOpenDocumentRecursive. Only the files of externaldata elements inside a subtree which can
+  contain a match are read.
+
+  <b>Fortran syntax:</b> Not available
+
+  @param[in]  xmlFilename name of the XML-file to be read
+  @param[in]  oMode       OPENMODE_PLAIN or OPENMODE_RECURSIVE to read the external files
+  @param[in]  paths       the paths to match
+  @param[in]  nPaths      the number of paths
+  @param[in]  callback    the function called for each match
+  @param[in]  userData    a pointer passed to callback
+
+  @return
+    - SUCCESS if the file was read or callback stopped reading
+    - INVALID_XPATH if a path is not a simple path
+    - NOT_WELL_FORMED if the file or an external file is not well formed
+    - OPEN_FAILED if the file or an external file could not be opened
+    - FAILED if the base64 data of a vector is invalid or for invalid arguments
+ */
+DLL_EXPORT ReturnCode tixiStreamDocument (const char *xmlFilename, OpenMode oMode, const char **paths, int nPaths,
+                                          TixiStreamValueFnc callback, void *userData);
+
+
 /**
   @brief Open an XML-file for reading from a http web resource.
 
@@ -576,6 +833,9 @@ DLL_EXPORT ReturnCode tixiGetDocumentPath (TixiDocumentHandle handle, char** doc
   the main XML tree, please note that these files are saved back into the external files. The external
   nodes will not be removed from the main xml-document.
 
+  With OPENMODE_RECURSIVE_LAZY, the externaldata nodes of the files which were not read yet
+  are written as they are, the files are neither read nor written.
+
   <b>Fortran syntax:</b>
 
   tixi_save_document( integer  handle, character*n xml_filename, integer error )
@@ -604,6 +864,9 @@ DLL_EXPORT ReturnCode tixiSaveDocument (TixiDocumentHandle handle, const char *x
   the main XML document, these additional nodes will be saved in the xml file as well. The external
   nodes will not be removed from the main xml-document.
 
+  With OPENMODE_RECURSIVE_LAZY, the external files which were not read yet are read before
+  the document is written.
+
   <b>Fortran syntax:</b>
 
   tixi_save_complete_document( integer  handle, character*n xml_filename, integer error )
@@ -633,6 +896,9 @@ DLL_EXPORT ReturnCode tixiSaveCompleteDocument (TixiDocumentHandle handle, const
   the main XML document, these additional nodes will be saved in the xml file as well. The external
   nodes will be removed from the main xml-document.
 
+  With OPENMODE_RECURSIVE_LAZY, the externaldata nodes of the files which were not read yet
+  are written as they are.
+
   <b>Fortran syntax:</b>
 
   tixi_save_and_remove_document( integer  handle, character*n xml_filename, integer error )
@@ -717,6 +983,7 @@ DLL_EXPORT ReturnCode tixiCleanup ();
   @return
     - SUCCESS if successfully retrieve the text content of a single element
     - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - FAILED if text is NULL or elements were skipped by ::tixiOpenDocumentWithOptions
  */
 DLL_EXPORT ReturnCode tixiExportDocumentAsString (const TixiDocumentHandle handle, char **text);
 
@@ -906,6 +1173,61 @@ DLL_EXPORT ReturnCode tixiDTDValidate (const TixiDocumentHandle handle, const ch
 DLL_EXPORT ReturnCode tixiGetTextElement (const TixiDocumentHandle handle,
                                           const char *elementPath, char **text);
 
+/**
+  @brief Copies the text content of an element into a buffer supplied by the user.
+
+  Same as ::tixiGetTextElement, but the text is copied into buffer and no memory
+  is allocated for the result. If the buffer is too small, the truncated text is
+  written to the buffer and STRING_TRUNCATED is returned. In any case, requiredSize
+  returns the size of the buffer needed for the complete text (including the terminating
+  zero), so the size can also be queried by passing a NULL buffer.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive or ::tixiOpenDocumentFromHTTP
+
+  @param[in]  elementPath an XPath compliant path to an element in the document
+                    specified by handle (see section \ref XPathExamples above).
+
+  @param[out] buffer buffer receiving the zero terminated text content of the element, may be NULL
+  @param[in]  bufferSize size of buffer in bytes
+  @param[out] requiredSize size of the buffer needed for the text, may be NULL
+
+  @return
+    - SUCCESS if successfully retrieve the text content of a single element
+    - STRING_TRUNCATED if the buffer is too small for the text
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_XPATH if elementPath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if elementPath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if elementPath resolves not to a single element but to a list of elements
+ */
+DLL_EXPORT ReturnCode tixiGetTextElementInto (const TixiDocumentHandle handle, const char *elementPath,
+                                              char *buffer, int bufferSize, int *requiredSize);
+
+/**
+  @brief Returns the text content of an element without copying it.
+
+  Same as ::tixiGetTextElement, but for the common case of an element with a single
+  text node, a pointer to the text stored in the document is returned. The text
+  must not be modified and is only valid until the element is modified or the
+  document is closed. Elements whose text has to be assembled from several nodes
+  or contains characters to be escaped are copied as in ::tixiGetTextElement.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive or ::tixiOpenDocumentFromHTTP
+
+  @param[in]  elementPath an XPath compliant path to an element in the document
+                    specified by handle (see section \ref XPathExamples above).
+
+  @param[out] text text content of the element specified by elementPath
+
+  @return
+    - SUCCESS if successfully retrieve the text content of a single element
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_XPATH if elementPath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if elementPath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if elementPath resolves not to a single element but to a list of elements
+ */
+DLL_EXPORT ReturnCode tixiGetTextElementBorrowed (const TixiDocumentHandle handle,
+                                                  const char *elementPath, const char **text);
+
 
 /**
   @brief Retrieve integer content of an element.
@@ -1001,6 +1323,54 @@ DLL_EXPORT ReturnCode tixiGetDoubleElement (const TixiDocumentHandle handle, con
  */
 DLL_EXPORT ReturnCode tixiGetBooleanElement (const TixiDocumentHandle handle, const char *elementPath, int *boolean);
 
+/**
+  @brief Retrieve several numeric or boolean values in a single call.
+
+  Reads the values of the elements or attributes specified by paths and converts
+  them according to the ::ValueType given per entry. The whole batch is read under
+  a single document lock. Paths sharing a simple prefix like "/plane/wings/wing[2]"
+  are resolved relative to the prefix element, which is looked up only once.
+
+  Errors of single entries do not abort the batch. They are stored in errors and
+  the corresponding value is set to 0. No messages are printed for single entries.
+
+  <b>Fortran syntax:</b>
+
+  tixi_get_values( integer handle, character*n paths(n_values), integer types(n_values),
+                   integer n_values, real*8 values(n_values), integer errors(n_values), integer error )
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive or ::tixiOpenDocumentFromHTTP
+
+  @param[in]  paths array of XPath compliant paths to elements or attributes in the
+                    document specified by handle (see section \ref XPathExamples above).
+
+  @param[in]  types array of the ::ValueType of each entry
+
+  @param[in]  nValues number of entries
+
+  @param[out] values array of nValues doubles allocated by the user, integers and booleans
+                     (0 or 1) are stored as doubles
+
+  @param[out] errors array of nValues return codes allocated by the user:
+    - SUCCESS if the value was read
+    - INVALID_XPATH if the path is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if the path does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if the path resolves not to a single node
+    - NOT_AN_ELEMENT if the path points neither to an element nor to an attribute
+    - FAILED if the type is unknown or the text is not a boolean value
+
+  @return
+    - SUCCESS if the batch was processed, see errors for the results of the entries
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - FAILED if nValues is negative or an array is NULL
+
+  @cond
+  #annotate in: 1A, 2A(3) out: 4AM(3), 5AM(3)#
+  @endcond
+ */
+DLL_EXPORT ReturnCode tixiGetValues (const TixiDocumentHandle handle, const char **paths, const int *types,
+                                     int nValues, double *values, ReturnCode *errors);
+
 
 /**
   @brief Updates the text content of an element.
@@ -1562,6 +1932,8 @@ DLL_EXPORT ReturnCode tixiAddIntegerElementNS (const TixiDocumentHandle handle,
   @param[in]  format format string used to convert number into a string.
                      The format string usage is identical to format strings in printf.
                      If format is NULL "%g" will be used to format the string.
+                     The format is ignored if the vector is written base64 encoded,
+                     see ::tixiUseBase64Vectors.
 
   @return
     - SUCCESS if successfully added the text element
@@ -1601,6 +1973,8 @@ DLL_EXPORT ReturnCode tixiAddFloatVector (const TixiDocumentHandle handle, const
   @param[in]  format format string used to convert number into a string.
                      The format string usage is identical to format strings in printf.
                      If format is NULL "%g" will be used to format the string.
+                     The format is ignored if the vector is written base64 encoded,
+                     see ::tixiUseBase64Vectors.
 
   @return
     - SUCCESS if successfully added the text element
@@ -1940,6 +2314,39 @@ DLL_EXPORT ReturnCode tixiGetTextAttribute (const TixiDocumentHandle handle,
                                             const char *elementPath, const char *attributeName,
                                             char **text);
 
+/**
+  @brief Copies the value of an element's attribute into a buffer supplied by the user.
+
+  Same as ::tixiGetTextAttribute, but the value is copied into buffer and no memory
+  is allocated for the result. Truncation and requiredSize are handled as in
+  ::tixiGetTextElementInto.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument or ::tixiCreateDocument
+
+  @param[in]  elementPath an XPath compliant path to an element in the document
+                          specified by handle (see section \ref XPathExamples above).
+
+  @param[in]  attributeName name of the attribute. The name can also consist of a
+                            namespace prefix + ":" + the attribute name.
+
+  @param[out] buffer buffer receiving the zero terminated value of the attribute, may be NULL
+  @param[in]  bufferSize size of buffer in bytes
+  @param[out] requiredSize size of the buffer needed for the value, may be NULL
+
+  @return
+    - SUCCESS if successfully retrieve the value of the attribute
+    - STRING_TRUNCATED if the buffer is too small for the value
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_XPATH if elementPath is not a well-formed XPath-expression
+    - ATTRIBUTE_NOT_FOUND if the element has no attribute attributeName
+    - ELEMENT_NOT_FOUND if elementPath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if elementPath resolves not to a single element but to a list of elements
+    - INVALID_NAMESPACE_PREFIX if the prefix in attributeName does not match to a namespace
+ */
+DLL_EXPORT ReturnCode tixiGetTextAttributeInto (const TixiDocumentHandle handle,
+                                                const char *elementPath, const char *attributeName,
+                                                char *buffer, int bufferSize, int *requiredSize);
+
 /**
   @brief Retrieves value of an element's attribute as an integer.
 
@@ -2263,107 +2670,518 @@ DLL_EXPORT ReturnCode tixiGetAttributeName(const TixiDocumentHandle handle, cons
 /*@}*/
 
 /**
-  \defgroup Namespaces Namespace Support Functions
-
-  These functions are used, to register xml namespaces to the parser or add namespaces to
-  existing elements. For the following explanations, consider the following xml file
+  \defgroup Cursors Node Cursor Functions
 
-  @verbatim
-  <root>
-    <h:table xmlns:h="http://www.w3.org/TR/html4/">
-      <h:tr>
-        <h:td>Apples</h:td>
-        <h:td>Bananas</h:td>
-      </h:tr>
-    </h:table>
-    <aircraft xmlns="http://www.dlr.de/cpacs">
-      <modelname>D150</modelname>
-    </aircraft>
-  </root>
-  @endverbatim
+  Each getter takes an absolute path, i.e. reading many values of one element
+  resolves the common part of the paths again and again. A node cursor points
+  to an element of the document. The cursor functions take a path relative to
+  this element, which only has to be resolved from there:
 
-  <H2>Reading elements with namespaces</H2>
+  @code{.c}
+  TixiNodeCursor section;
+  double chord, twist;
+  tixiGetNodeCursor(handle, "/cpacs/vehicles/aircraft/model/wings/wing[1]/sections/section[2]", &section);
+  tixiCursorGetDoubleElement(handle, section, "elements/element/transformation/scaling/x", &chord);
+  tixiCursorGetDoubleElement(handle, section, "elements/element/transformation/rotation/y", &twist);
+  tixiReleaseNodeCursor(handle, section);
+  @endcode
 
-  This file defines two namespaces - "http://www.w3.org/TR/html4/" and "http://www.dlr.de/cpacs".
-  A query for "/root/h:table" or "/root/aircraft" will result in an error, as no prefix was defined
-  for both namespaces. The prefix inside the xml file exists only in the file, but not in the parser.
-  To successfully query these paths, the namespaces must be registered with some (arbitrary) prefix using
-  ::tixiRegisterNamespace or ::tixiRegisterNamespacesFromDocument.
+  The relative paths are XPath expressions evaluated with the element of the cursor
+  as context node, absolute paths can be used as well.
 
-  After calling ::tixiRegisterNamespace(handle, "http://www.w3.org/TR/html4/", "html") the query for
-  "/root/html:table" is now valid. After calling ::tixiRegisterNamespace(handle, "http://www.dlr.de/cpacs", "cpacs")
-  the query for "/root/cpacs:aircraft" becomes valid.
+  A cursor stays valid until it is released or the document is closed. If the
+  element of the cursor is removed, e.g. by ::tixiRemoveElement, the cursor is
+  invalidated and all functions except ::tixiReleaseNodeCursor return INVALID_CURSOR.
+ */
+/*@{*/
 
-  <H2>Writing elements with namespaces</H2>
+/**
+  @brief Creates a cursor pointing to an element.
 
-  To write elements with namespaces, the following functions are available:
-   - ::tixiCreateElementNS
-   - ::tixiCreateElementNSAtIndex
-   - ::tixiAddBooleanElementNS
-   - ::tixiAddDoubleElementNS
-   - ::tixiAddIntegerElementNS
-   - ::tixiAddTextElementNS
-   - ::tixiAddTextElementNSAtIndex
+  The cursor has to be released by ::tixiReleaseNodeCursor.
 
-  To reproduce the upper xml file, use the following tixi code:
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  elementPath an XPath compliant path to an element in the document
+                          specified by handle (see section \ref XPathExamples above).
+  @param[out] cursor the new cursor
 
-  @verbatim
-  tixiCreateDocument("root", &handle);
+  @return
+    - SUCCESS if the cursor was created
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_XPATH if elementPath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if elementPath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if elementPath resolves not to a single element but to a list of elements
+    - NOT_AN_ELEMENT if elementPath does not point to an element
+    - FAILED if the cursor could not be allocated
+ */
+DLL_EXPORT ReturnCode tixiGetNodeCursor(const TixiDocumentHandle handle, const char *elementPath, TixiNodeCursor *cursor);
 
-  // create table element in prefixed html namespace
-  tixiCreateElementNS(handle, "/root", "h:table", "http://www.w3.org/TR/html4/");
-  tixiRegisterNamespace(handle, "http://www.w3.org/TR/html4/", "h");
+/**
+  @brief Creates a cursor pointing to an element relative to the element of another cursor.
 
-  tixiCreateElementNS(handle, "/root/h:table", "tr", "http://www.w3.org/TR/html4/");
-  tixiAddTextElementNS(handle, "/root/h:table/h:tr", "td", "http://www.w3.org/TR/html4/", "Apples");
-  tixiAddTextElementNS(handle, "/root/h:table/h:tr", "td", "http://www.w3.org/TR/html4/", "Bananas"):
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
+  @param[in]  relativePath path relative to the element of the cursor, NULL or "" for the element itself
+  @param[out] newCursor the new cursor
 
-  // create aircraft in default namespace (no prefix!)
-  tixiCreateElementNS(handle, "/root", "aircraft", "http://www.dlr.de/cpacs");
-  tixiRegisterNamespace(handle, "http://www.dlr.de/cpacs", "c");
-  tixiAddTextElementNS(handle, "/root/c:aircraft", "modelname", "http://www.dlr.de/cpacs", "D150");
-  @endverbatim
+  @return
+    - SUCCESS if successfully retrieve the cursor
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+    - INVALID_XPATH if relativePath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if relativePath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if relativePath resolves not to a single element but to a list of elements
+    - NOT_AN_ELEMENT if relativePath does not point to an element
+    - FAILED if the cursor could not be allocated
  */
-/*@{*/
-
+DLL_EXPORT ReturnCode tixiCursorGetNodeCursor(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                              TixiNodeCursor *newCursor);
 
 /**
-  @brief Registers the given namespace and its prefix.
+  @brief Releases a cursor.
 
-  When dealing with xml namespaces, elements can only be accessed via xPath
-  when their namespace was registered with a prefix.
+  Cursors of removed elements have to be released as well.
 
-  To automatically register all namespaces and prefixes in the current
-  document, use ::tixiRegisterNamespacesFromDocument.
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
 
-  <b>Fortran syntax:</b>
+  @return
+    - SUCCESS if the cursor was released
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid, e.g. it has already been released
+ */
+DLL_EXPORT ReturnCode tixiReleaseNodeCursor(const TixiDocumentHandle handle, TixiNodeCursor cursor);
 
-  tixi_register_namespace( integer handle, character*n namespace_uri, character*n prefix, integer error )
+/**
+  @brief Moves the cursor to the first child element of its element.
 
-  @param[in]  handle handle as returned by ::tixiCreateDocument, ::tixiOpenDocumentRecursive or ::tixiOpenDocumentFromHTTP
-  @param[in]  namespaceURI The URI for the namespace (e.g. "http://www.w3.org/TR/html4/")
-  @param[in]  prefix The desired prefix of the namespace (e.g. "html")
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
 
   @return
-    - SUCCESS if the namespace could be registered successfully
+    - SUCCESS if the cursor was moved
     - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
-    - FAILED In case of an error
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+    - NO_CHILDREN if the element has no child elements, the cursor is not moved
  */
-DLL_EXPORT ReturnCode tixiRegisterNamespace(const TixiDocumentHandle handle, const char* namespaceURI, const char* prefix);
-
+DLL_EXPORT ReturnCode tixiCursorMoveToFirstChild(const TixiDocumentHandle handle, TixiNodeCursor cursor);
 
 /**
- @brief Registers all prefixed namespaces of the xml document to the parser.
+  @brief Moves the cursor to the next sibling element of its element.
 
- Default (non-prefixed) namespaces must be still registered using ::tixiRegisterNamespace manually
- to be accessible via xPath.
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
 
- In the example above, the namespace "http://www.w3.org/TR/html4/" would be registered with
- the prefix "h" and a query to "/root/h:table" becomes successful.
+  @return
+    - SUCCESS if the cursor was moved
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+    - ELEMENT_NOT_FOUND if the element is the last element, the cursor is not moved
+ */
+DLL_EXPORT ReturnCode tixiCursorMoveToNextSibling(const TixiDocumentHandle handle, TixiNodeCursor cursor);
 
-  <b>Fortran syntax:</b>
+/**
+  @brief Moves the cursor to the parent element of its element.
 
-  tixi_register_namespaces_from_document( integer handle, integer error )
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
+
+  @return
+    - SUCCESS if the cursor was moved
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+    - ELEMENT_NOT_FOUND if the element is the root element, the cursor is not moved
+ */
+DLL_EXPORT ReturnCode tixiCursorMoveToParent(const TixiDocumentHandle handle, TixiNodeCursor cursor);
+
+/**
+  @brief Returns the name of the element of the cursor.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
+  @param[out] name name of the element. The string belongs to the document and
+                   is released with it.
+
+  @return
+    - SUCCESS if the name was retrieved
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+ */
+DLL_EXPORT ReturnCode tixiCursorGetElementName(const TixiDocumentHandle handle, TixiNodeCursor cursor, char **name);
+
+/**
+  @brief Returns an absolute path to the element of the cursor, e.g. to use it
+  with the functions taking a path.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
+  @param[out] path path of the element, e.g. /plane/wings/wing[2]. The string
+                   belongs to the document and is released with it.
+
+  @return
+    - SUCCESS if the path was retrieved
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+ */
+DLL_EXPORT ReturnCode tixiCursorGetPath(const TixiDocumentHandle handle, TixiNodeCursor cursor, char **path);
+
+/**
+  @brief Cursor variant of ::tixiCheckElement.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
+  @param[in]  relativePath path relative to the element of the cursor, NULL or "" for the element itself
+
+  @return
+    - SUCCESS if the element exists
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+    - INVALID_XPATH if relativePath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if relativePath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if relativePath resolves not to a single element but to a list of elements
+ */
+DLL_EXPORT ReturnCode tixiCursorCheckElement(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath);
+
+/**
+  @brief Cursor variant of ::tixiGetTextElement.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
+  @param[in]  relativePath path relative to the element of the cursor, NULL or "" for the element itself
+  @param[out] text text content of the element. The string belongs to the document and
+                   is released with it.
+
+  @return
+    - SUCCESS if successfully retrieve the text content of a single element
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+    - INVALID_XPATH if relativePath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if relativePath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if relativePath resolves not to a single element but to a list of elements
+ */
+DLL_EXPORT ReturnCode tixiCursorGetTextElement(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath, char **text);
+
+/**
+  @brief Cursor variant of ::tixiGetIntegerElement.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
+  @param[in]  relativePath path relative to the element of the cursor, NULL or "" for the element itself
+  @param[out] number content of the element interpreted as an integer number
+
+  @return
+    - SUCCESS if successfully retrieve the text content of a single element
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+    - INVALID_XPATH if relativePath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if relativePath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if relativePath resolves not to a single element but to a list of elements
+ */
+DLL_EXPORT ReturnCode tixiCursorGetIntegerElement(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath, int *number);
+
+/**
+  @brief Cursor variant of ::tixiGetDoubleElement.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
+  @param[in]  relativePath path relative to the element of the cursor, NULL or "" for the element itself
+  @param[out] number content of the element interpreted as a floating point number
+
+  @return
+    - SUCCESS if successfully retrieve the text content of a single element
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+    - INVALID_XPATH if relativePath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if relativePath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if relativePath resolves not to a single element but to a list of elements
+ */
+DLL_EXPORT ReturnCode tixiCursorGetDoubleElement(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath, double *number);
+
+/**
+  @brief Cursor variant of ::tixiGetBooleanElement.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
+  @param[in]  relativePath path relative to the element of the cursor, NULL or "" for the element itself
+  @param[out] boolean content of the element interpreted as a boolean
+
+  @return
+    - SUCCESS if successfully retrieve the text content of a single element
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+    - INVALID_XPATH if relativePath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if relativePath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if relativePath resolves not to a single element but to a list of elements
+ */
+DLL_EXPORT ReturnCode tixiCursorGetBooleanElement(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath, int *boolean);
+
+/**
+  @brief Cursor variant of ::tixiGetTextAttribute.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
+  @param[in]  relativePath path relative to the element of the cursor, NULL or "" for the element itself
+  @param[in]  attributeName name of the attribute
+  @param[out] text value of the attribute. The string belongs to the document and
+                   is released with it.
+
+  @return
+    - SUCCESS if successfully retrieve the value of the attribute
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+    - INVALID_XPATH if relativePath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if relativePath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if relativePath resolves not to a single element but to a list of elements
+    - ATTRIBUTE_NOT_FOUND if the element has no such attribute
+ */
+DLL_EXPORT ReturnCode tixiCursorGetTextAttribute(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                 const char *attributeName, char **text);
+
+/**
+  @brief Cursor variant of ::tixiGetDoubleAttribute.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
+  @param[in]  relativePath path relative to the element of the cursor, NULL or "" for the element itself
+  @param[in]  attributeName name of the attribute
+  @param[out] number value of the attribute interpreted as a floating point number
+
+  @return
+    - SUCCESS if successfully retrieve the value of the attribute
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+    - INVALID_XPATH if relativePath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if relativePath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if relativePath resolves not to a single element but to a list of elements
+    - ATTRIBUTE_NOT_FOUND if the element has no such attribute
+ */
+DLL_EXPORT ReturnCode tixiCursorGetDoubleAttribute(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                   const char *attributeName, double *number);
+
+/**
+  @brief Cursor variant of ::tixiGetIntegerAttribute.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
+  @param[in]  relativePath path relative to the element of the cursor, NULL or "" for the element itself
+  @param[in]  attributeName name of the attribute
+  @param[out] number value of the attribute interpreted as an integer number
+
+  @return
+    - SUCCESS if successfully retrieve the value of the attribute
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+    - INVALID_XPATH if relativePath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if relativePath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if relativePath resolves not to a single element but to a list of elements
+    - ATTRIBUTE_NOT_FOUND if the element has no such attribute
+ */
+DLL_EXPORT ReturnCode tixiCursorGetIntegerAttribute(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                    const char *attributeName, int *number);
+
+/**
+  @brief Cursor variant of ::tixiUpdateTextElement.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
+  @param[in]  relativePath path relative to the element of the cursor, NULL or "" for the element itself
+  @param[in]  text the new text content
+
+  @return
+    - SUCCESS if the element was updated
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+    - INVALID_XPATH if relativePath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if relativePath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if relativePath resolves not to a single element but to a list of elements
+ */
+DLL_EXPORT ReturnCode tixiCursorUpdateTextElement(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath, const char *text);
+
+/**
+  @brief Cursor variant of ::tixiUpdateDoubleElement.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
+  @param[in]  relativePath path relative to the element of the cursor, NULL or "" for the element itself
+  @param[in]  number the new value
+  @param[in]  format format used to convert number into a string, "%g" if NULL
+
+  @return
+    - SUCCESS if the element was updated
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+    - INVALID_XPATH if relativePath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if relativePath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if relativePath resolves not to a single element but to a list of elements
+ */
+DLL_EXPORT ReturnCode tixiCursorUpdateDoubleElement(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                    double number, const char *format);
+
+/**
+  @brief Cursor variant of ::tixiUpdateIntegerElement.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
+  @param[in]  relativePath path relative to the element of the cursor, NULL or "" for the element itself
+  @param[in]  number the new value
+  @param[in]  format format used to convert number into a string
+
+  @return
+    - SUCCESS if the element was updated
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+    - INVALID_XPATH if relativePath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if relativePath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if relativePath resolves not to a single element but to a list of elements
+ */
+DLL_EXPORT ReturnCode tixiCursorUpdateIntegerElement(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                     int number, const char *format);
+
+/**
+  @brief Cursor variant of ::tixiAddTextAttribute.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
+  @param[in]  relativePath path relative to the element of the cursor, NULL or "" for the element itself
+  @param[in]  attributeName name of the attribute
+  @param[in]  attributeValue value of the attribute
+
+  @return
+    - SUCCESS if the attribute was added or updated
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+    - INVALID_XPATH if relativePath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if relativePath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if relativePath resolves not to a single element but to a list of elements
+ */
+DLL_EXPORT ReturnCode tixiCursorAddTextAttribute(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                 const char *attributeName, const char *attributeValue);
+
+/**
+  @brief Cursor variant of ::tixiAddDoubleAttribute.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument
+  @param[in]  cursor cursor as returned by ::tixiGetNodeCursor
+  @param[in]  relativePath path relative to the element of the cursor, NULL or "" for the element itself
+  @param[in]  attributeName name of the attribute
+  @param[in]  number value of the attribute
+  @param[in]  format format used to convert number into a string, "%g" if NULL
+
+  @return
+    - SUCCESS if the attribute was added or updated
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_CURSOR if the cursor is not valid or its element has been removed
+    - INVALID_XPATH if relativePath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if relativePath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if relativePath resolves not to a single element but to a list of elements
+ */
+DLL_EXPORT ReturnCode tixiCursorAddDoubleAttribute(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                   const char *attributeName, double number, const char *format);
+
+/*@}*/
+
+/**
+  \defgroup Namespaces Namespace Support Functions
+
+  These functions are used, to register xml namespaces to the parser or add namespaces to
+  existing elements. For the following explanations, consider the following xml file
+
+  @verbatim
+  <root>
+    <h:table xmlns:h="http://www.w3.org/TR/html4/">
+      <h:tr>
+        <h:td>Apples</h:td>
+        <h:td>Bananas</h:td>
+      </h:tr>
+    </h:table>
+    <aircraft xmlns="http://www.dlr.de/cpacs">
+      <modelname>D150</modelname>
+    </aircraft>
+  </root>
+  @endverbatim
+
+  <H2>Reading elements with namespaces</H2>
+
+  This file defines two namespaces - "http://www.w3.org/TR/html4/" and "http://www.dlr.de/cpacs".
+  A query for "/root/h:table" or "/root/aircraft" will result in an error, as no prefix was defined
+  for both namespaces. The prefix inside the xml file exists only in the file, but not in the parser.
+  To successfully query these paths, the namespaces must be registered with some (arbitrary) prefix using
+  ::tixiRegisterNamespace or ::tixiRegisterNamespacesFromDocument.
+
+  After calling ::tixiRegisterNamespace(handle, "http://www.w3.org/TR/html4/", "html") the query for
+  "/root/html:table" is now valid. After calling ::tixiRegisterNamespace(handle, "http://www.dlr.de/cpacs", "cpacs")
+  the query for "/root/cpacs:aircraft" becomes valid.
+
+  <H2>Writing elements with namespaces</H2>
+
+  To write elements with namespaces, the following functions are available:
+   - ::tixiCreateElementNS
+   - ::tixiCreateElementNSAtIndex
+   - ::tixiAddBooleanElementNS
+   - ::tixiAddDoubleElementNS
+   - ::tixiAddIntegerElementNS
+   - ::tixiAddTextElementNS
+   - ::tixiAddTextElementNSAtIndex
+
+  To reproduce the upper xml file, use the following tixi code:
+
+  @verbatim
+  tixiCreateDocument("root", &handle);
+
+  // create table element in prefixed html namespace
+  tixiCreateElementNS(handle, "/root", "h:table", "http://www.w3.org/TR/html4/");
+  tixiRegisterNamespace(handle, "http://www.w3.org/TR/html4/", "h");
+
+  tixiCreateElementNS(handle, "/root/h:table", "tr", "http://www.w3.org/TR/html4/");
+  tixiAddTextElementNS(handle, "/root/h:table/h:tr", "td", "http://www.w3.org/TR/html4/", "Apples");
+  tixiAddTextElementNS(handle, "/root/h:table/h:tr", "td", "http://www.w3.org/TR/html4/", "Bananas"):
+
+  // create aircraft in default namespace (no prefix!)
+  tixiCreateElementNS(handle, "/root", "aircraft", "http://www.dlr.de/cpacs");
+  tixiRegisterNamespace(handle, "http://www.dlr.de/cpacs", "c");
+  tixiAddTextElementNS(handle, "/root/c:aircraft", "modelname", "http://www.dlr.de/cpacs", "D150");
+  @endverbatim
+ */
+/*@{*/
+
+
+/**
+  @brief Registers the given namespace and its prefix.
+
+  When dealing with xml namespaces, elements can only be accessed via xPath
+  when their namespace was registered with a prefix.
+
+  To automatically register all namespaces and prefixes in the current
+  document, use ::tixiRegisterNamespacesFromDocument.
+
+  <b>Fortran syntax:</b>
+
+  tixi_register_namespace( integer handle, character*n namespace_uri, character*n prefix, integer error )
+
+  @param[in]  handle handle as returned by ::tixiCreateDocument, ::tixiOpenDocumentRecursive or ::tixiOpenDocumentFromHTTP
+  @param[in]  namespaceURI The URI for the namespace (e.g. "http://www.w3.org/TR/html4/")
+  @param[in]  prefix The desired prefix of the namespace (e.g. "html")
+
+  @return
+    - SUCCESS if the namespace could be registered successfully
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - FAILED In case of an error
+ */
+DLL_EXPORT ReturnCode tixiRegisterNamespace(const TixiDocumentHandle handle, const char* namespaceURI, const char* prefix);
+
+
+/**
+ @brief Registers all prefixed namespaces of the xml document to the parser.
+
+ Default (non-prefixed) namespaces must be still registered using ::tixiRegisterNamespace manually
+ to be accessible via xPath.
+
+ In the example above, the namespace "http://www.w3.org/TR/html4/" would be registered with
+ the prefix "h" and a query to "/root/h:table" becomes successful.
+
+  <b>Fortran syntax:</b>
+
+  tixi_register_namespaces_from_document( integer handle, integer error )
 
   @param[in]  handle handle as returned by ::tixiCreateDocument, ::tixiOpenDocumentRecursive or ::tixiOpenDocumentFromHTTP
 
@@ -2568,6 +3386,31 @@ DLL_EXPORT ReturnCode tixiCheckDocumentHandle (const TixiDocumentHandle handle);
  */
 DLL_EXPORT ReturnCode tixiUsePrettyPrint(TixiDocumentHandle handle, int usePrettyPrint);
 
+/**
+  @brief Sets whether vectors are written base64 encoded.
+
+  If turned on, ::tixiAddFloatVector and ::tixiUpdateFloatVector write the values as
+  base64 encoded little endian doubles and mark the element with encoding="base64-le-f64".
+  The values are stored exactly and take about a third of the space of decimal text.
+  Vectors and arrays with this encoding are read by all vector and array functions,
+  whatever the setting is.
+  0 writes decimal text separated by ';', 1 writes base64.
+  By default, vectors are written as decimal text.
+
+  <b>Fortran syntax:</b>
+
+  tixi_use_base64_vectors( integer  handle, integer use_base64_vectors, integer error )
+
+  @param[in]  handle  handle as returned by ::tixiOpenDocument
+  @param[in]  useBase64Vectors flag if vectors should be written base64 encoded
+
+  @return
+    - SUCCESS if the setting was changed
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - FAILED if useBase64Vectors had wrong value
+ */
+DLL_EXPORT ReturnCode tixiUseBase64Vectors(TixiDocumentHandle handle, int useBase64Vectors);
+
 /**
   @brief Reroutes all messages of tixi to the message function func
 
@@ -2599,6 +3442,68 @@ DLL_EXPORT ReturnCode tixiSetPrintMsgFunc(TixiPrintMsgFnc func);
  */
 DLL_EXPORT TixiPrintMsgFnc tixiGetPrintMsgFunc();
 
+/**
+  @brief Marks the current state of the memory returned by the document.
+
+  Strings and arrays returned by the getters belong to the document and are
+  normally released when the document is closed. A document kept open for a long
+  time hence grows with each getter call. Together with ::tixiMemoryReleaseTo,
+  the memory returned after the checkpoint can be released earlier.
+
+  Checkpoints form a stack, i.e. they can be nested.
+
+  <b>Example of a loop with constant memory usage:</b>
+  @code{.c}
+  int mark;
+  tixiMemoryCheckpoint(handle, &mark);
+  for (i = 0; i < nIterations; ++i) {
+    char* text = NULL;
+    tixiGetTextElement(handle, "/plane/name", &text);
+    // ... use text
+    tixiMemoryReleaseTo(handle, mark);
+  }
+  @endcode
+
+  @param[in]  handle  handle as returned by ::tixiOpenDocument
+  @param[out] mark    Identifier of the checkpoint, to be passed to ::tixiMemoryReleaseTo
+
+  @return
+    - SUCCESS if the checkpoint was created
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - FAILED for internal errors
+ */
+DLL_EXPORT ReturnCode tixiMemoryCheckpoint(TixiDocumentHandle handle, int* mark);
+
+/**
+  @brief Releases all memory returned by the document after the checkpoint mark.
+
+  All strings and arrays returned after the checkpoint was created must not
+  be used anymore. Checkpoints created after mark are discarded, mark itself
+  remains valid and can be released again.
+
+  @param[in]  handle  handle as returned by ::tixiOpenDocument
+  @param[in]  mark    Checkpoint as returned by ::tixiMemoryCheckpoint
+
+  @return
+    - SUCCESS if the memory was released
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INDEX_OUT_OF_RANGE if mark is not a valid checkpoint or was discarded by the release of an outer checkpoint
+ */
+DLL_EXPORT ReturnCode tixiMemoryReleaseTo(TixiDocumentHandle handle, int mark);
+
+/**
+  @brief Returns how much memory returned by the getters is retained by the document.
+
+  @param[in]  handle  handle as returned by ::tixiOpenDocument
+  @param[out] bytes   Number of bytes returned to the user and not yet released
+  @param[out] entries Number of strings and arrays returned to the user and not yet released
+
+  @return
+    - SUCCESS
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+ */
+DLL_EXPORT ReturnCode tixiGetRetainedMemory(TixiDocumentHandle handle, size_t* bytes, size_t* entries);
+
 /*@}*/
 
 /**
@@ -2684,7 +3589,8 @@ DLL_EXPORT ReturnCode tixiGetVectorSize (const TixiDocumentHandle handle,
 
   A vector is read and its contents are stored into an 1D-array. The memory necessary
   for the array is automatically allocated. The number of elements in the vector
-  could be read via a call to "tixiGetVectorSize".
+  could be read via a call to "tixiGetVectorSize". Vectors with the attribute
+  encoding="base64-le-f64" are decoded from base64 (see ::tixiUseBase64Vectors).
 
   tixi_get_float_vector( integer handle, character*n vectorPath, real array, integer eNumber)
 
@@ -2709,6 +3615,45 @@ DLL_EXPORT ReturnCode tixiGetVectorSize (const TixiDocumentHandle handle,
 DLL_EXPORT ReturnCode tixiGetFloatVector (const TixiDocumentHandle handle, const char *vectorPath,
                                           double **vectorArray, const int eNumber);
 
+/**
+  @brief Reads a vector into an array supplied by the user.
+
+  Same as ::tixiGetFloatVector, but the values are parsed directly into values and
+  no memory is allocated by the document. This allows to read a vector repeatedly,
+  e.g. in each iteration of a solver, without the memory growing until the document
+  is closed. If the vector has more values than fit into the array, the first capacity
+  values are written and STRING_TRUNCATED is returned. In any case, nElements returns
+  the number of values of the vector.
+
+  Passing a NULL array only counts the values without parsing them (returning
+  STRING_TRUNCATED for a vector which is not empty), so the size of the array can
+  be queried first:
+  @code{.c}
+  int n = 0;
+  tixiGetFloatVectorInto(handle, "/a/vector", NULL, 0, &n);
+  values = (double*) malloc(n * sizeof(double));
+  tixiGetFloatVectorInto(handle, "/a/vector", values, n, &n);
+  @endcode
+
+  @param[in]  handle file handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  vectorPath an XPath compliant path to an element holding the vector in
+                         the document specified by handle (see section \ref XPathExamples).
+  @param[out] values array receiving the values of the vector, may be NULL
+  @param[in]  capacity number of values fitting into values
+  @param[out] nElements number of values of the vector, may be NULL
+
+  @return
+    - SUCCESS if successfully read the vector
+    - STRING_TRUNCATED if the array is too small for all values of the vector
+    - INVALID_HANDLE if the handle is not valid
+    - INVALID_XPATH if vectorPath is not a well-formed XPath-expression
+    - ELEMENT_PATH_NOT_UNIQUE if vectorPath resolves not to a single element but to a list of elements
+    - ELEMENT_NOT_FOUND if vectorPath points to a non-existing element or an element which is no vector
+    - ATTRIBUTE_NOT_FOUND if the element has no mapType attribute
+ */
+DLL_EXPORT ReturnCode tixiGetFloatVectorInto (const TixiDocumentHandle handle, const char *vectorPath,
+                                              double *values, int capacity, int *nElements);
+
 
 /**
   @brief Retrieves the number of dimensions of an Array.
@@ -2942,6 +3887,78 @@ DLL_EXPORT ReturnCode tixiGetArrayParameterNames (const TixiDocumentHandle handl
 DLL_EXPORT ReturnCode tixiGetArray (const TixiDocumentHandle handle, const char *arrayPath,
                                     const char *elementName, int arraySize, double **values);
 
+/**
+  @brief Reads an array into an array supplied by the user.
+
+  Same as ::tixiGetArray, but the values are parsed directly into values and no
+  memory is allocated by the document. If the array has more values than fit into
+  values, the first capacity values are written and STRING_TRUNCATED is returned.
+  In any case, arraySize returns the number of values of the array. Passing a NULL
+  array only counts the values, see ::tixiGetFloatVectorInto.
+
+  @param[in]  handle file handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  arrayPath an XPath compliant path to an element holding the sub-tags of the array definition in
+                        the document specified by handle (see section \ref XPathExamples).
+  @param[in]  elementName name of the sub tag that contains the array
+  @param[out] values array receiving the values, may be NULL
+  @param[in]  capacity number of values fitting into values
+  @param[out] arraySize number of values of the array, may be NULL
+
+  @return
+    - SUCCESS if successfully read the array
+    - STRING_TRUNCATED if values is too small for all values of the array
+    - INVALID_HANDLE if the handle is not valid
+    - INVALID_XPATH if arrayPath is not a well-formed XPath-expression
+    - ATTRIBUTE_NOT_FOUND if the given sub element has not mapType="array"
+    - ELEMENT_NOT_FOUND if arrayPath points to a element that is no array
+ */
+DLL_EXPORT ReturnCode tixiGetArrayInto (const TixiDocumentHandle handle, const char *arrayPath,
+                                        const char *elementName, double *values, int capacity, int *arraySize);
+
+/**
+  @brief Reads all dimensions and parameters of an array at once.
+
+  Returns what ::tixiGetArrayDimensions, ::tixiGetArrayDimensionNames, ::tixiGetArrayDimensionSizes,
+  ::tixiGetArrayDimensionValues, ::tixiGetArrayParameterNames and ::tixiGetArray return
+  for the array. The array is parsed only once and kept until the document is modified,
+  these functions are answered from the same data.
+
+  All returned arrays are allocated by the document and must not be freed by the user. Empty
+  arrays are returned as NULL.
+
+  @param[in]  handle file handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  arrayPath an XPath compliant path to an element holding the sub-tags of the array definition in
+                        the document specified by handle (see section \ref XPathExamples).
+  @param[out] nDimensions number of dimensions (elements with mapType="vector")
+  @param[out] dimensionNames names of the dimensions
+  @param[out] dimensionSizes number of values of each dimension
+  @param[out] dimensionValues values of all dimensions, one dimension after the other
+  @param[out] nParameters number of parameters (elements with mapType="array")
+  @param[out] parameterNames names of the parameters
+  @param[out] parameterValues values of all parameters, the values of parameter i start at
+                              i * arraySize. May be NULL if only the dimensions are needed.
+  @param[out] arraySize product of the dimension sizes, i.e. the number of values of each parameter
+
+  @return
+    - SUCCESS if successfully read the array
+    - FAILED internal error or null pointer arguments
+    - INVALID_HANDLE if the handle is not valid
+    - INVALID_XPATH if arrayPath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if arrayPath points to no element or to an element without dimensions,
+                        or if a dimension has no values
+    - ELEMENT_PATH_NOT_UNIQUE if arrayPath resolves not to a single element but to a list of elements
+    - NON_MATCHING_SIZE if parameterValues is requested and the number of values of a parameter
+                        does not match arraySize
+
+  @cond
+  #annotate out: 2, 3A(2), 4A(2), 5A(9), 6, 7A(6), 8A(9), 9#
+  @endcond
+ */
+DLL_EXPORT ReturnCode tixiGetArrayDescriptor (const TixiDocumentHandle handle, const char *arrayPath,
+                                              int *nDimensions, char ***dimensionNames, int **dimensionSizes,
+                                              double **dimensionValues, int *nParameters, char ***parameterNames,
+                                              double **parameterValues, int *arraySize);
+
 
 /**
   @brief Getter function to take one multidimensionally specified element from a complete array, retrieved earlier.
@@ -3220,6 +4237,115 @@ DLL_EXPORT ReturnCode tixiXPathExpressionGetXPath(TixiDocumentHandle handle, con
  */
 DLL_EXPORT ReturnCode tixiXPathExpressionGetTextByIndex(TixiDocumentHandle handle, const char *xPathExpression, int elementNumber, char **text);
 
+/**
+  @brief Evaluates a XPath expression and copies the text content of the resultnode into a buffer supplied by the user.
+
+  Same as ::tixiXPathExpressionGetTextByIndex, but the text is copied into buffer and no
+  memory is allocated for the result. Truncation and requiredSize are handled as in
+  ::tixiGetTextElementInto.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  xPathExpression The XPath Expression to evaluate.
+  @param[in]  elementNumber The (index)-number to get. Index must be between 1 and 'tixiXPathEvaluateNodeNumber()', inclusively.
+  @param[out] buffer buffer receiving the zero terminated text content of the node, may be NULL
+  @param[in]  bufferSize size of buffer in bytes
+  @param[out] requiredSize size of the buffer needed for the text, may be NULL
+
+  @return
+    - SUCCESS if successfully retrieve the text content of a single element.
+    - STRING_TRUNCATED if the buffer is too small for the text
+    - FAILED if the expression could not be evaluated, the index is out of range or
+      the node is neither an element nor an attribute
+ */
+DLL_EXPORT ReturnCode tixiXPathExpressionGetTextByIndexInto(TixiDocumentHandle handle, const char *xPathExpression, int elementNumber,
+                                                            char *buffer, int bufferSize, int *requiredSize);
+
+/**
+  @brief Evaluates a XPath expression once and calls a function for each result node.
+
+  Unlike looping over the indices with ::tixiXPathExpressionGetTextByIndex and
+  ::tixiXPathExpressionGetXPath, which evaluate the expression for every index, the
+  result is walked in a single pass. For each node, callback receives its index, its
+  name, its text content and its path as returned by ::tixiXPathExpressionGetXPath.
+  The strings are only valid during the call of the callback and no memory is
+  allocated in the document.
+
+  The document is locked for reading while the nodes are visited, so the callback
+  must not modify the document. Modifying functions called by the callback for the
+  same document fail with INVALID_HANDLE.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  xPathExpression The XPath Expression to evaluate.
+  @param[in]  callback function called for each node in document order, the iteration
+                       stops if it returns a value other than 0
+  @param[in]  userData pointer passed to each call of callback
+
+  @return
+    - SUCCESS if the expression was evaluated, also if its result is empty
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist.
+    - INVALID_XPATH if xPathExpression is not a well-formed XPath-expression
+    - FAILED if xPathExpression or callback is NULL
+ */
+DLL_EXPORT ReturnCode tixiXPathExpressionForEach(TixiDocumentHandle handle, const char *xPathExpression,
+                                                 TixiXPathNodeFnc callback, void *userData);
+
+/**
+  @brief Evaluates a XPath expression once and returns the text content of all result nodes.
+
+  Returns the same texts as ::tixiXPathExpressionGetTextByIndex for all indices, nodes
+  without text content, e.g. the document node, yield an empty string. On successful
+  return the memory used for texts is allocated internally and must not be released
+  by the user. The deallocation is handled when the document referred to by handle
+  is closed.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  xPathExpression The XPath Expression to evaluate.
+  @param[out] texts array of the texts of the result nodes in document order, NULL if the result is empty
+  @param[out] number the number of result nodes
+
+  @return
+    - SUCCESS if the expression was evaluated, also if its result is empty
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist.
+    - INVALID_XPATH if xPathExpression is not a well-formed XPath-expression
+    - FAILED if an internal error occured.
+
+  @cond
+  #annotate out: 2A(3), 3#
+  @endcond
+ */
+DLL_EXPORT ReturnCode tixiXPathExpressionGetAllTexts(TixiDocumentHandle handle, const char *xPathExpression,
+                                                     char ***texts, int *number);
+
+/**
+  @brief Sets the size of the cache of compiled XPath expressions.
+
+  All element paths and XPath expressions passed to TiXI are compiled before they are
+  evaluated. The compiled expressions are cached, so that a path queried repeatedly
+  is compiled only once. The cache is shared by all documents and threads and holds
+  up to size expressions (1024 by default). If it is full, the least recently used
+  expression is removed. A size of 0 disables the cache.
+
+  Setting the size also resets the counters returned by ::tixiGetXPathCacheStatistics.
+
+  @param[in]  size maximum number of cached expressions
+
+  @return
+    - SUCCESS if the size was set
+    - FAILED if size is negative
+ */
+DLL_EXPORT ReturnCode tixiSetXPathCacheSize(int size);
+
+/**
+  @brief Returns the hit and miss counters of the cache of compiled XPath expressions.
+
+  @param[out] hits   number of evaluations using a cached expression
+  @param[out] misses number of evaluations that had to compile the expression
+
+  @return
+    - SUCCESS
+ */
+DLL_EXPORT ReturnCode tixiGetXPathCacheStatistics(size_t *hits, size_t *misses);
+
 
 /*@}*/
 /**
@@ -3263,6 +4389,141 @@ DLL_EXPORT ReturnCode tixiUIDCheckDuplicates(TixiDocumentHandle handle);
  */
 DLL_EXPORT ReturnCode tixiUIDCheckLinks(TixiDocumentHandle handle);
 
+/**
+  @brief Returns all elements whose uID is also used by another element.
+
+  Unlike ::tixiUIDCheckDuplicates, which stops at the first duplicated uID, all
+  duplicates are returned. The elements are sorted by their uID, elements with
+  the same uID are in document order. On successful return the memory used for
+  uIDs and xPaths is allocated internally and must not be released by the user.
+  The deallocation is handled when the document referred to by handle is closed.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[out] uIDs array of the duplicated uIDs, one entry per element, NULL if all uIDs are unique
+  @param[out] xPaths array of the paths of the elements
+  @param[out] number the number of elements with a duplicated uID
+
+  @return
+    - SUCCESS if the check was performed, also if all uIDs are unique
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist.
+    - FAILED if reading of uids does not work
+
+  @cond
+  #annotate out: 1A(3), 2A(3), 3#
+  @endcond
+ */
+DLL_EXPORT ReturnCode tixiUIDGetDuplicates(TixiDocumentHandle handle, char ***uIDs, char ***xPaths, int *number);
+
+/**
+  @brief Returns all isLink attributes referring to a uID that does not exist.
+
+  Unlike ::tixiUIDCheckLinks, which only reports whether there are broken links,
+  all broken links are returned in document order. On successful return the memory
+  used for links and xPaths is allocated internally and must not be released by
+  the user. The deallocation is handled when the document referred to by handle
+  is closed.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[out] links array of the uIDs referred to by the broken links, NULL if there are no broken links
+  @param[out] xPaths array of the paths of the elements with the broken links
+  @param[out] number the number of broken links
+
+  @return
+    - SUCCESS if the check was performed, also if there are no broken links
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist.
+    - FAILED if reading of links or uids does not work
+
+  @cond
+  #annotate out: 1A(3), 2A(3), 3#
+  @endcond
+ */
+DLL_EXPORT ReturnCode tixiUIDGetBrokenLinks(TixiDocumentHandle handle, char ***links, char ***xPaths, int *number);
+
+/**
+  @brief Returns the paths of all elements referring to a uID.
+
+  A reference is either an isLink attribute or an element whose name ends with
+  "UID", e.g. fromSectionUID, containing the uID as text. The references of a
+  document are collected in one pass when one of the reference functions is
+  called first, the result is kept until the document is modified.
+  On successful return the memory used for xPaths is allocated internally and
+  must not be released by the user. The deallocation is handled when the document
+  referred to by handle is closed.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  uID the referenced uID
+  @param[out] xPaths array of the paths of the referring elements in document order, NULL if uID is not referenced
+  @param[out] number the number of references
+
+  @return
+    - SUCCESS if the references were determined, also if uID is not referenced
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist.
+    - FAILED if an internal error occured.
+
+  @cond
+  #annotate out: 2A(3), 3#
+  @endcond
+ */
+DLL_EXPORT ReturnCode tixiUIDGetIncomingReferences(TixiDocumentHandle handle, const char *uID, char ***xPaths, int *number);
+
+/**
+  @brief Returns the uIDs referred to by an element.
+
+  For an element with a uID, all references of its descendants are returned,
+  except those of descendants with a uID of their own. E.g. the uIDs referred to
+  by fromElementUID and toElementUID are returned for a wing segment. For other
+  elements, e.g. a fromElementUID element or an element with an isLink attribute,
+  the reference of the element itself is returned. See ::tixiUIDGetIncomingReferences
+  for the kinds of references. On successful return the memory used for uIDs is
+  allocated internally and must not be released by the user. The deallocation is
+  handled when the document referred to by handle is closed.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  elementPath an XPath compliant path to an element in the document
+  @param[out] uIDs array of the referenced uIDs in document order, NULL if the element has no references
+  @param[out] number the number of references
+
+  @return
+    - SUCCESS if the references were determined, also if there are none
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist.
+    - INVALID_XPATH if elementPath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if elementPath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if elementPath resolves not to a single element but to a list of elements
+    - FAILED if an internal error occured.
+
+  @cond
+  #annotate out: 2A(3), 3#
+  @endcond
+ */
+DLL_EXPORT ReturnCode tixiUIDGetOutgoingReferences(TixiDocumentHandle handle, const char *elementPath, char ***uIDs, int *number);
+
+/**
+  @brief Returns all uIDs ordered by their dependencies.
+
+  Each uID is placed after the uIDs referred to by its element, see
+  ::tixiUIDGetOutgoingReferences. Elements without dependencies keep their
+  document order, broken links are ignored. This is the order in which elements
+  have to be processed, if each one requires the elements it refers to.
+  On successful return the memory used for uIDs is allocated internally and must
+  not be released by the user. The deallocation is handled when the document
+  referred to by handle is closed.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[out] uIDs array of the uIDs, NULL if the document has no uIDs
+  @param[out] number the number of uIDs
+
+  @return
+    - SUCCESS if the uIDs were ordered
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist.
+    - UID_REFERENCE_CYCLE if the references contain a cycle, so no such order exists
+    - FAILED if an internal error occured.
+
+  @cond
+  #annotate out: 1A(2), 2#
+  @endcond
+ */
+DLL_EXPORT ReturnCode tixiUIDGetTopologicalOrder(TixiDocumentHandle handle, char ***uIDs, int *number);
+
 /**
   @brief Returns the XPath to given uID.
 
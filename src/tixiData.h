@@ -31,6 +31,8 @@
 #include "libxml/xmlreader.h"
 #include "libxml/xpath.h"
 
+#include "tixiThreads.h"
+
 #ifndef TIXI_VERSION
 #define TIXI_VERSION  "2.2"
 #endif
@@ -39,6 +41,7 @@
 #define CPACS_UID_XPATH                 "//@uID"
 #define CPACS_UID_LINK_XPATH            "//@isLink"
 #define CPACS_UID_LINK_ATTRIBUTE_STRING "isLink"
+#define CPACS_UID_REFERENCE_SUFFIX      "UID"
 
 #define EXTERNAL_DATA_NODE_NAME          "externaldata"
 #define EXTERNAL_DATA_NODE_NAME_PATH     "path"
@@ -55,6 +58,8 @@
 #define VECTOR_SEPARATOR ";"
 #define VECTOR_ATTRIBUTE_NAME "vector"
 #define MAPTYPE_IDENTIFIER "mapType"
+#define VECTOR_ENCODING_ATTRIBUTE "encoding"
+#define VECTOR_ENCODING_BASE64 "base64-le-f64"
 
 
 
@@ -107,27 +112,159 @@ typedef  enum DocumentStatusType
 
 
 /**
- * @brief Structure to build a link list of documents.
+ * @brief Chunk of the arena holding the memory returned to the user.
+ *
+ * The data follows the header. Chunks are linked from the newest to the oldest.
+ */
+typedef struct TixiMemoryChunk TixiMemoryChunk;
+struct TixiMemoryChunk
+{
+  TixiMemoryChunk* previous;    /**< Chunk allocated before this one */
+  size_t size;                  /**< Usable size of the chunk in bytes */
+  size_t used;                  /**< Bytes already handed out */
+};
+
+/**
+ * @brief State of the arena saved by tixiMemoryCheckpoint.
+ */
+typedef struct TixiMemoryMark TixiMemoryMark;
+struct TixiMemoryMark
+{
+  TixiMemoryChunk* chunk;        /**< Current chunk at the time of the checkpoint */
+  size_t used;                   /**< Bytes used in this chunk at the time of the checkpoint */
+  TixiMemoryChunk* largeBlocks;  /**< Newest large block at the time of the checkpoint */
+  size_t retainedBytes;          /**< Bytes handed out before the checkpoint */
+  size_t retainedEntries;        /**< Allocations handed out before the checkpoint */
+  unsigned int generation;       /**< Distinguishes checkpoints reusing the same position of the stack */
+};
+
+
+/**
+ * @brief Slot of the node cursor table of a document.
  *
+ * Cursors encode the slot index and the generation of the slot like
+ * document handles.
  */
-typedef struct TixiMemoryListEntry TixiMemoryListEntry;
-struct TixiMemoryListEntry
+typedef struct TixiNodeCursorSlot TixiNodeCursorSlot;
+struct TixiNodeCursorSlot
 {
-  void* memory;                        /**< Pointer to memory area allocated by libxml */
-  TixiMemoryListEntry* next;    /**< Pointer to next entry in the list */
+  xmlNodePtr node;          /**< Current node of the cursor, NULL if the node has been removed */
+  int inUse;                /**< 0 if the slot is free */
+  unsigned int generation;  /**< Number of times the slot has been released */
+  int nextFree;             /**< Index of the next free slot, -1 for the end of the free list */
 };
 
 
 /**
- * @brief Structure to build a link list of UIDs.
+ * @brief Index of the children of an element.
  *
+ * The index of a name lists the element children of that name without
+ * namespace, the index without name lists all children except DTD nodes.
+ * Indexes are created on first use and dropped whenever the children of the
+ * parent change.
  */
-typedef struct TixiUIDListEntry TixiUIDListEntry;
-struct TixiUIDListEntry
+typedef struct TixiChildIndex TixiChildIndex;
+struct TixiChildIndex
+{
+  xmlNodePtr parent;        /**< Node whose children are indexed */
+  char* name;               /**< Name of the indexed children, NULL for all children */
+  xmlNodePtr* children;     /**< Indexed children in document order */
+  int nChildren;            /**< Number of indexed children */
+  TixiChildIndex* next;     /**< Next index in the same bucket */
+};
+
+
+/**
+ * @brief Entry of the hash table of the UIDs.
+ *
+ */
+typedef struct TixiUIDEntry TixiUIDEntry;
+struct TixiUIDEntry
 {
   xmlNodePtr nodePtr;            /**< Pointer to the node with the UID */
-  char* uIDName;              /**< Name of this uID */
-  TixiUIDListEntry* next;        /**< Pointer to next entry in the list */
+  char* uIDName;                 /**< Name of this uID */
+  unsigned int hash;             /**< Hash of the name */
+  TixiUIDEntry* next;            /**< Pointer to next entry in the same bucket */
+};
+
+/**
+ * @brief Element with a uID in the reference graph.
+ */
+typedef struct
+{
+  xmlNodePtr node;               /**< Element with the uID */
+  char* uID;                     /**< The uID of the element */
+  unsigned int hash;             /**< Hash of the uID */
+  int nextInBucket;              /**< Next vertex in the same bucket, -1 for the end */
+  int firstOutgoing;             /**< First reference owned by the element, -1 if there is none */
+} TixiReferenceVertex;
+
+/**
+ * @brief Reference to a uID, i.e. an isLink attribute or the text of an element named ...UID.
+ */
+typedef struct
+{
+  xmlNodePtr node;               /**< Element with the isLink attribute or the ...UID element */
+  char* target;                  /**< The referenced uID */
+  unsigned int hash;             /**< Hash of the target */
+  int owner;                     /**< Vertex of the nearest ancestor-or-self with a uID, -1 if there is none */
+  int targetVertex;              /**< First vertex with the target uID in document order, -1 for a broken link */
+  int nextInBucket;              /**< Next reference with a target in the same bucket, -1 for the end */
+  int nextOutgoing;              /**< Next reference of the same owner, -1 for the end */
+} TixiReference;
+
+/**
+ * @brief References between the uIDs of a document.
+ *
+ * Vertices and references are stored in document order, the bucket chains
+ * keep this order. The graph is built on first use and dropped whenever the
+ * document is modified.
+ */
+typedef struct
+{
+  TixiReferenceVertex* vertices; /**< Elements with a uID */
+  int nVertices;                 /**< Number of vertices */
+  TixiReference* references;     /**< All references */
+  int nReferences;               /**< Number of references */
+  int* vertexBuckets;            /**< First vertex of each bucket, hashed by the uID */
+  int* referenceBuckets;         /**< First reference of each bucket, hashed by the target */
+  int bucketCount;               /**< Number of buckets, a power of two */
+} TixiReferenceGraph;
+
+/**
+ * @brief Parsed array, i.e. an element with vector children (mapType="vector")
+ * as dimensions and array children (mapType="array") as parameters.
+ *
+ * The descriptors are created by the array getters and dropped after each
+ * modification of the document.
+ */
+typedef struct TixiArrayDescriptor TixiArrayDescriptor;
+struct TixiArrayDescriptor
+{
+  xmlNodePtr element;            /**< Element holding the array */
+  int nDimensions;               /**< Number of vector children */
+  xmlNodePtr* dimensions;        /**< Vector children in document order */
+  int* dimensionSizes;           /**< Number of values of each dimension, -1 for a vector without text */
+  double** dimensionValues;      /**< Values of each dimension */
+  int arraySize;                 /**< Product of the dimension sizes */
+  int nParameters;               /**< Number of array children */
+  xmlNodePtr* parameters;        /**< Array children in document order */
+  int* parameterSizes;           /**< Number of values of each parameter, -1 for an array without text */
+  double** parameterValues;      /**< Values of each parameter, NULL until they are read */
+  TixiArrayDescriptor* next;     /**< Next descriptor in the same bucket */
+};
+
+/**
+ * @brief Structure to build a link list of the XPath contexts of the threads
+ * using a document.
+ *
+ */
+typedef struct TixiXPathContextEntry TixiXPathContextEntry;
+struct TixiXPathContextEntry
+{
+  const void* thread;                 /**< Identifies the thread owning the context */
+  xmlXPathContextPtr context;         /**< XPath context used only by this thread */
+  TixiXPathContextEntry* next;        /**< Pointer to next entry in the list */
 };
 
 /**
@@ -145,25 +282,79 @@ typedef struct
   char* validationFilename;     /**< Name of the file the document is validate against */
   DocumentStatus status;        /**< Status of the document: opened/saved/closed */
   TixiDocumentHandle handle;
-  TixiMemoryListEntry* memoryListHead; /**< Pointer to the head of the list of memory location */
-  TixiMemoryListEntry* memoryListTail; /**< Pointer to the tail of the list of memory location */
+  TixiMemoryChunk* memoryChunks;       /**< Current chunk of the arena for memory returned to the user */
+  TixiMemoryChunk* largeMemoryBlocks;  /**< Allocations too large for a chunk of the arena */
+  TixiMemoryMark* memoryMarks;         /**< Stack of checkpoints of the arena */
+  int nMemoryMarks;                    /**< Number of checkpoints on the stack */
+  int memoryMarksSize;                 /**< Capacity of the stack of checkpoints */
+  unsigned int memoryMarkGeneration;   /**< Generation of the next checkpoint */
+  size_t retainedBytes;                /**< Bytes currently handed out by the arena */
+  size_t retainedEntries;              /**< Allocations currently handed out by the arena */
   int hasIncludedExternalFiles;        /**< Flag to indicate if the master file includes external files */
   int usePrettyPrint;                  /**< if pretty print should used when saving a file */
-  TixiUIDListEntry* uidListHead;       /**< Pointer to the head of the list of uids */
-  xmlXPathContextPtr xpathContext;     /**< Pointer to the XPath Context */
+  int useBase64Vectors;                /**< if vectors are written base64 encoded */
+  int xmlParseOptions;                 /**< Options of libxml2 to parse the document and its external files */
+  int hasSkippedElements;              /**< Set if elements of the file were skipped when opening it, see
+                                            TixiOpenOptions::includePaths. Such documents cannot be saved */
+  int nPendingExternalData;            /**< Number of externaldata elements not yet included,
+                                            see OPENMODE_RECURSIVE_LAZY */
+  int externalDataChanged;             /**< Set when external files were included while reading */
+  TixiUIDEntry** uidBuckets;           /**< Hash table of the uids, NULL until it is used */
+  int uidBucketCount;                  /**< Number of buckets, a power of two */
+  int uidCount;                        /**< Number of elements with a uid */
+  int uidDuplicateCount;               /**< Number of entries repeating the uid of another entry */
+  int uidEmptyCount;                   /**< Number of empty uids */
+  TixiUIDEntry* uidDuplicate;          /**< Entry with a duplicated uid found last, may be NULL */
+  TixiMutex uidMutex;                  /**< Protects the uid table while readers build it */
+  TixiReferenceGraph* referenceGraph;  /**< References between the uids, NULL until it is used or after a modification */
+  TixiMutex referenceGraphMutex;       /**< Protects the reference graph while readers build it */
+  xmlXPathContextPtr xpathContext;     /**< XPath Context holding the registered namespaces, see XPathGetContext for evaluations */
+  TixiXPathContextEntry* threadContexts; /**< XPath contexts of the threads using the document */
+  TixiMutex threadContextsMutex;       /**< Protects the list of thread contexts */
+  unsigned int id;                     /**< Unique id of the document, never reused */
+  TixiRWLock lock;                     /**< Shared by readers, exclusive for modifications of the document */
+  TixiRWLock modificationLock;         /**< Shared by readers, exclusive for modifications. Keeps modifications out
+                                            while a reader upgrades its lock to include external files */
+  TixiMutex memoryMutex;               /**< Protects the arena, which is also used by readers */
+  TixiNodeCursorSlot* nodeCursors;     /**< Table of the node cursors */
+  int nodeCursorCount;                 /**< Number of slots ever used */
+  int nodeCursorCapacity;              /**< Number of allocated slots */
+  int freeNodeCursorHead;              /**< Head of the list of released slots */
+  TixiMutex nodeCursorsMutex;          /**< Protects the cursor table, which is also used by readers */
+  TixiChildIndex** childIndexBuckets;  /**< Hash table of the child indexes, hashed by the parent */
+  int childIndexBucketCount;           /**< Number of buckets, a power of two */
+  int childIndexCount;                 /**< Number of child indexes in the table */
+  TixiMutex childIndexMutex;           /**< Protects the child indexes, which are also created by readers */
+  TixiArrayDescriptor** arrayDescriptorBuckets; /**< Hash table of the arrays read since the last modification,
+                                                    hashed by the element */
+  int arrayDescriptorBucketCount;      /**< Number of buckets, a power of two */
+  int arrayDescriptorCount;            /**< Number of array descriptors in the table */
+  TixiMutex arrayDescriptorsMutex;     /**< Protects the array descriptors, which are created by readers */
+  volatile int refCount;               /**< References of the handle table and of the threads using the document */
 } TixiDocument;
 
-typedef struct TixiDocumentListEntry TixiDocumentListEntry;
-struct TixiDocumentListEntry
+/**
+ * @brief Slot of the document handle table.
+ *
+ * A handle encodes the slot index and the generation of the slot. The
+ * generation is increased whenever a document is removed, so a stale handle
+ * of a closed document never resolves to a document reusing the same slot.
+ */
+typedef struct TixiDocumentSlot TixiDocumentSlot;
+struct TixiDocumentSlot
 {
-  TixiDocument* document; /**< Document meta data */
-  TixiDocumentListEntry* next;    /**< Pointer to next document in the list */
+  TixiDocument* document;   /**< Document meta data, NULL if the slot is free */
+  unsigned int generation;  /**< Number of times the slot has been released */
+  int nextFree;             /**< Index of the next free slot, -1 for the end of the free list */
 };
 
 /**
-   Pointer to the head of the list of documents managed by TIXI
+ * Number of bits of a handle used for the slot index. The remaining bits
+ * (except the sign bit) hold the slot generation.
  */
-extern TixiDocumentListEntry* documentListHead;
+#define DOCUMENT_HANDLE_SLOT_BITS      18
+#define DOCUMENT_HANDLE_SLOT_MASK      ((1 << DOCUMENT_HANDLE_SLOT_BITS) - 1)
+#define DOCUMENT_HANDLE_GENERATION_MASK ((1 << (31 - DOCUMENT_HANDLE_SLOT_BITS)) - 1)
 
 /**
   Possible values how to save with/without external data.
@@ -180,9 +371,14 @@ typedef enum InternalSaveModeType
 #ifdef _WIN32
 /* this is the name for mingw gcc's and MSVC */
 #define VSNPRINTF _vsnprintf
+#define STRTOK_R strtok_s
+#define LOCALTIME_R(timer, result) (localtime_s((result), (timer)) == 0 ? (result) : NULL)
 #else
 /* this is the posix name */
 #define VSNPRINTF vsnprintf
+/* reentrant variants, tixi functions may run in parallel */
+#define STRTOK_R strtok_r
+#define LOCALTIME_R localtime_r
 #include <libgen.h>
 #endif
 
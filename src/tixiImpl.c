@@ -24,11 +24,14 @@
  */
 
 #include <assert.h>
+#include <ctype.h>
 #include <stdio.h>
 #include <time.h>
 #include <math.h>
+#include <limits.h>
 
 #include "libxml/parser.h"
+#include "libxml/parserInternals.h"
 #include "libxml/xpath.h"
 #include "libxml/xmlschemas.h"
 
@@ -41,16 +44,13 @@
 #include "tixi.h"
 #include "tixi_version.h"
 #include "namespaceFunctions.h"
+#include "arrayHelper.h"
+#include "streamReader.h"
 
 static xmlNsPtr nameSpace = NULL;
 
 void tixiDefaultMessageHandler(MessageType type, const char* msg);
 
-/**
-  Pointer to the head of the list of documents managed by TIXI
-*/
-TixiDocumentListEntry *documentListHead = NULL;
-
 TixiPrintMsgFnc tixiMessageHandler = tixiDefaultMessageHandler;
 
 /**
@@ -87,7 +87,7 @@ void printMsg(MessageType type, const char* message, ...)
   va_end(varArgs);
 }
 
-int _initialized = 0;
+static TixiOnce tixiInitOnceFlag = TIXI_ONCE_INITIALIZER;
 
 void xmlErrorHandler(void * ctx, const char *message, ...) {
   char buffer[2048];
@@ -115,14 +115,19 @@ void xmlErrorHandler(void * ctx, const char *message, ...) {
   va_end(varArgs);
 }
 
+static void tixiInitOnce(void)
+{
+  printMsg(MESSAGETYPE_STATUS, "TiXI initialized\n");
+  xmlInitParser();
+  /* the libxml error handler is thread local, set it also for new threads */
+  xmlThrDefSetGenericErrorFunc(NULL, xmlErrorHandler);
+  xmlSetGenericErrorFunc(NULL, xmlErrorHandler);
+  xsltSetGenericErrorFunc(NULL, xmlErrorHandler);
+}
+
 static void tixiInit(void)
 {
-  if (!_initialized) {
-    printMsg(MESSAGETYPE_STATUS, "TiXI initialized\n");
-    xmlSetGenericErrorFunc(NULL, xmlErrorHandler);
-    xsltSetGenericErrorFunc(NULL, xmlErrorHandler);
-    _initialized = 1;
-  }
+  thread_callOnce(&tixiInitOnceFlag, tixiInitOnce);
 }
 
 
@@ -255,38 +260,202 @@ void printError(ReturnCode error, char *function)
 }
 
 
+/* largest block read at once from a file to be parsed */
+#define MAX_READ_BLOCK_SIZE (16 * 1024 * 1024)
+
+/* file read by the parser, with a buffer of the size given by the open options */
+typedef struct OpenFileContext
+{
+  FILE *file;
+  char *buffer;
+} OpenFileContext;
+
+static int readOpenFile(void *context, char *buffer, int len)
+{
+  FILE *file = ((OpenFileContext *) context)->file;
+  size_t nRead = fread(buffer, 1, (size_t) len, file);
+
+  return nRead == 0 && ferror(file) ? -1 : (int) nRead;
+}
+
+static int closeOpenFile(void *context)
+{
+  OpenFileContext *fileContext = (OpenFileContext *) context;
+  int result = fclose(fileContext->file);
+
+  free(fileContext->buffer);
+  free(fileContext);
+  return result;
+}
+
+/* converts the flags of the open options to the options of the libxml2 parser */
+static int getXmlParseOptions(int flags)
+{
+  int xmlOptions = 0;
+
+  if (!(flags & OPENFLAG_KEEP_BLANKS)) {
+    xmlOptions |= XML_PARSE_NOBLANKS;
+  }
+  if (flags & OPENFLAG_COMPACT) {
+    xmlOptions |= XML_PARSE_COMPACT;
+  }
+  if (flags & OPENFLAG_HUGE) {
+    xmlOptions |= XML_PARSE_HUGE;
+  }
+  return xmlOptions;
+}
+
+/* parses the input of the context, skipping the elements rejected by the filter */
+static xmlDocPtr parseDocument(xmlParserCtxtPtr ctxt, const char *xmlFilename, int xmlOptions, StreamFilter *filter)
+{
+  xmlDocPtr xmlDocument = NULL;
+
+  xmlCtxtUseOptions(ctxt, xmlOptions);
+  if (filter) {
+    stream_installFilter(filter, ctxt);
+  }
+  if (ctxt->input && !ctxt->input->filename) {
+    ctxt->input->filename = (char *) xmlStrdup((const xmlChar *) xmlFilename);
+  }
+
+  xmlParseDocument(ctxt);
+  xmlDocument = ctxt->myDoc;
+  ctxt->myDoc = NULL;
+  if (xmlDocument && !ctxt->wellFormed) {
+    xmlFreeDoc(xmlDocument);
+    xmlDocument = NULL;
+  }
+  xmlFreeParserCtxt(ctxt);
+  return xmlDocument;
+}
+
+/* checks for the magic number of gzip, such files are decompressed by libxml2 */
+static int isGzipData(const unsigned char *data, size_t size)
+{
+  return size >= 2 && data[0] == 0x1f && data[1] == 0x8b;
+}
+
+/* parses the file read in blocks, or by libxml2 if it is compressed */
+static ReturnCode readDocumentStream(const char *xmlFilename, const TixiOpenOptions *options, int xmlOptions,
+                                     StreamFilter *filter, xmlDocPtr *xmlDocument)
+{
+  OpenFileContext *context = (OpenFileContext *) calloc(1, sizeof(OpenFileContext));
+  xmlParserCtxtPtr ctxt = NULL;
+  unsigned char magic[2];
+  size_t nMagic;
+
+  if (!context) {
+    return FAILED;
+  }
+  context->file = fopen(xmlFilename, "rb");
+  if (!context->file) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Unable to open file \"%s\".\n", xmlFilename);
+    free(context);
+    return OPEN_FAILED;
+  }
+  if (options->sizeHint > BUFSIZ) {
+    size_t blockSize = options->sizeHint < MAX_READ_BLOCK_SIZE ? options->sizeHint : MAX_READ_BLOCK_SIZE;
+    context->buffer = (char *) malloc(blockSize);
+    if (context->buffer) {
+      setvbuf(context->file, context->buffer, _IOFBF, blockSize);
+    }
+  }
+
+  nMagic = fread(magic, 1, sizeof(magic), context->file);
+  if (isGzipData(magic, nMagic)) {
+    /* compressed files are read like by xmlReadFile */
+    closeOpenFile(context);
+#if LIBXML_VERSION >= 21400
+    xmlOptions |= XML_PARSE_UNZIP;
+#endif
+    ctxt = xmlCreateURLParserCtxt(xmlFilename, xmlOptions);
+  }
+  else {
+    rewind(context->file);
+    /* closes the file also if the context cannot be created */
+    ctxt = xmlCreateIOParserCtxt(NULL, NULL, readOpenFile, closeOpenFile, context, XML_CHAR_ENCODING_NONE);
+  }
+  if (ctxt) {
+    *xmlDocument = parseDocument(ctxt, xmlFilename, xmlOptions, filter);
+  }
+  return SUCCESS;
+}
+
+/* parses the file mapped into memory or read in blocks */
+static ReturnCode readDocumentFile(const char *xmlFilename, const TixiOpenOptions *options, StreamFilter *filter,
+                                   xmlDocPtr *xmlDocument)
+{
+  int xmlOptions = getXmlParseOptions(options->flags);
+  ReturnCode error = SUCCESS;
+
+  *xmlDocument = NULL;
+  if (options->flags & OPENFLAG_MEMORY_MAP) {
+    size_t size = 0;
+    const char *data = mapFileToMemory(xmlFilename, &size);
+    xmlParserCtxtPtr ctxt = NULL;
+
+    /* files too large for the parser of a memory block and compressed files are read as stream */
+    if (data && size <= INT_MAX && !isGzipData((const unsigned char *) data, size)) {
+      ctxt = xmlCreateMemoryParserCtxt(data, (int) size);
+      if (ctxt) {
+        *xmlDocument = parseDocument(ctxt, xmlFilename, xmlOptions, filter);
+      }
+      unmapFileFromMemory(data, size);
+    }
+    else {
+      if (data) {
+        unmapFileFromMemory(data, size);
+      }
+      error = readDocumentStream(xmlFilename, options, xmlOptions, filter, xmlDocument);
+    }
+  }
+  else {
+    error = readDocumentStream(xmlFilename, options, xmlOptions, filter, xmlDocument);
+  }
+
+  if (error != SUCCESS) {
+    return error;
+  }
+  if (!*xmlDocument) {
+    printMsg(MESSAGETYPE_ERROR, "Error: \"%s\" is not a wellformed XML-file.\n", xmlFilename);
+    return NOT_WELL_FORMED;
+  }
+  return SUCCESS;
+}
+
 /**
  *  Opens the file and sets up the TixiDocument datastructure.
  */
-DLL_EXPORT ReturnCode tixiOpenDocumentRecursive(const char *xmlFilename, TixiDocumentHandle *handle, OpenMode oMode)
+DLL_EXPORT ReturnCode tixiOpenDocumentWithOptions(const char *xmlFilename, TixiDocumentHandle *handle,
+                                                  const TixiOpenOptions *options)
 {
   /* this opens the XML-file and checks if it is well formed */
 
   TixiDocument *document = NULL;
   xmlDocPtr xmlDocument = NULL;
-  FILE *file = NULL;
+  TixiOpenOptions defaultOptions = {OPENMODE_PLAIN, 0, 0, NULL, 0, NULL, 0};
+  StreamFilter *filter = NULL;
   ReturnCode returnValue = -1;
 
   tixiInit();
   checkLibxml2Version();
 
-  xmlKeepBlanksDefault(0);
-  xmlIndentTreeOutput = 1;
-
   assert(xmlFilename);
 
-  file = fopen(xmlFilename, "r");
-  if (!file) {
-    printMsg(MESSAGETYPE_ERROR, "Error: Unable to open file \"%s\".\n", xmlFilename);
-    return OPEN_FAILED;
-  }
-  else {
-    fclose(file);
+  if (!options) {
+    options = &defaultOptions;
   }
 
-  xmlDocument = xmlReadFile(xmlFilename, NULL, 0);
+  if ((options->includePaths && options->nIncludePaths > 0) || (options->excludePaths && options->nExcludePaths > 0)) {
+    returnValue = stream_createFilter(options->includePaths, options->includePaths ? options->nIncludePaths : 0,
+                                      options->excludePaths, options->excludePaths ? options->nExcludePaths : 0, &filter);
+    if (returnValue != SUCCESS) {
+      return returnValue;
+    }
+  }
 
-  if (xmlDocument) {
+  returnValue = readDocumentFile(xmlFilename, options, filter, &xmlDocument);
+  if (returnValue == SUCCESS) {
 
     document = (TixiDocument *) malloc(sizeof(TixiDocument));
     document->xmlFilename = (char *) malloc(strlen(xmlFilename) * sizeof(char) + 1);
@@ -297,17 +466,27 @@ DLL_EXPORT ReturnCode tixiOpenDocumentRecursive(const char *xmlFilename, TixiDoc
     document->currentNode = NULL;
     document->isValid = UNDEFINED;
     document->status = OPENED;
-    document->memoryListHead = NULL;
-    document->memoryListTail = NULL;
+    document->memoryChunks = NULL;
+    document->largeMemoryBlocks = NULL;
     document->hasIncludedExternalFiles = 1;
     document->usePrettyPrint = 1;
-    document->uidListHead = NULL;
+    document->useBase64Vectors = 0;
+    document->xmlParseOptions = getXmlParseOptions(options->flags);
+    document->hasSkippedElements = filter && stream_getSkippedCount(filter) > 0;
+    document->nPendingExternalData = 0;
+    document->externalDataChanged = 0;
+    document->uidBuckets = NULL;
     document->xpathContext = xmlXPathNewContext(xmlDocument);
-    addDocumentToList(document, &(document->handle));
+    if (addDocumentToList(document, &(document->handle)) != SUCESS) {
+      printMsg(MESSAGETYPE_ERROR, "Error: Failed  adding document to document list.\n");
+      freeTixiDocument(document);
+      stream_freeFilter(filter);
+      return FAILED;
+    }
     *handle = document->handle;
     returnValue = SUCCESS; /*?*/
 
-    if (oMode == OPENMODE_RECURSIVE) {
+    if (options->openMode == OPENMODE_RECURSIVE) {
       int count = 0;
       document->hasIncludedExternalFiles = 1;
 
@@ -315,18 +494,32 @@ DLL_EXPORT ReturnCode tixiOpenDocumentRecursive(const char *xmlFilename, TixiDoc
       if (returnValue != SUCCESS){
         printMsg(MESSAGETYPE_ERROR, "Error %d in including external files into tixiDoument.\n", returnValue);
         removeDocumentFromList(*handle);
-        freeTixiDocument(document);
+        document = NULL;
+      }
+    }
+    else if (options->openMode == OPENMODE_RECURSIVE_LAZY) {
+      document->hasIncludedExternalFiles = 1;
+
+      returnValue = openExternalFilesLazy(document);
+      if (returnValue != SUCCESS){
+        printMsg(MESSAGETYPE_ERROR, "Error %d in including external files into tixiDoument.\n", returnValue);
+        removeDocumentFromList(*handle);
         document = NULL;
       }
     }
   }
-  else {
-    printMsg(MESSAGETYPE_ERROR, "Error: \"%s\" is not a wellformed XML-file.\n", xmlFilename);
-    returnValue = NOT_WELL_FORMED;
-  }
+  stream_freeFilter(filter);
   return returnValue;
 }
 
+DLL_EXPORT ReturnCode tixiOpenDocumentRecursive(const char *xmlFilename, TixiDocumentHandle *handle, OpenMode oMode)
+{
+  TixiOpenOptions options = {OPENMODE_PLAIN, 0, 0, NULL, 0, NULL, 0};
+
+  options.openMode = oMode;
+  return tixiOpenDocumentWithOptions(xmlFilename, handle, &options);
+}
+
 
 DLL_EXPORT ReturnCode tixiOpenDocument(const char *xmlFilename, TixiDocumentHandle *handle)
 {
@@ -334,6 +527,56 @@ DLL_EXPORT ReturnCode tixiOpenDocument(const char *xmlFilename, TixiDocumentHand
 }
 
 
+static ReturnCode tixiResolveExternalUnlocked(const TixiDocumentHandle handle, const char *elementPath)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlXPathContextPtr xpathContext = NULL;
+  xmlXPathObjectPtr xpathObject = NULL;
+  ReturnCode resolveError = SUCCESS;
+  ReturnCode error = SUCCESS;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+  if (!elementPath) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null pointer argument in tixiResolveExternal.\n");
+    return FAILED;
+  }
+
+  /* the files are read before the path is checked, which would read only the files on the path */
+  xpathContext = XPathGetContext(document);
+  resolveError = XPathResolveExternalData(xpathContext, elementPath, 1);
+
+  error = checkExistence(xpathContext, elementPath, &xpathObject);
+  xmlXPathFreeObject(xpathObject);
+
+  return error != SUCCESS ? error : resolveError;
+}
+
+DLL_EXPORT ReturnCode tixiResolveExternal(const TixiDocumentHandle handle, const char *elementPath)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiResolveExternalUnlocked(handle, elementPath);
+  unlockDocument(document);
+  return error;
+}
+
+
+DLL_EXPORT ReturnCode tixiStreamDocument(const char *xmlFilename, OpenMode oMode, const char **paths, int nPaths,
+                                         TixiStreamValueFnc callback, void *userData)
+{
+  tixiInit();
+  checkLibxml2Version();
+
+  if (!xmlFilename || (!paths && nPaths > 0) || nPaths < 0 || !callback) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null pointer argument in tixiStreamDocument.\n");
+    return FAILED;
+  }
+  return stream_readDocument(xmlFilename, oMode, paths, nPaths, callback, userData);
+}
+
+
 
 DLL_EXPORT ReturnCode tixiOpenDocumentFromHTTP (const char *httpURL, TixiDocumentHandle *handle)
 {
@@ -341,9 +584,6 @@ DLL_EXPORT ReturnCode tixiOpenDocumentFromHTTP (const char *httpURL, TixiDocumen
   ReturnCode returnCode = FAILED;
 
   tixiInit();
-  xmlKeepBlanksDefault(0);
-  xmlIndentTreeOutput = 1;
-
   xmlDocument = curlGetURLInMemory(httpURL);
   if(xmlDocument == NULL) {
     return OPEN_FAILED;
@@ -362,9 +602,6 @@ DLL_EXPORT ReturnCode tixiCreateDocument(const char *rootElementName, TixiDocume
   xmlNodePtr rootNode = NULL;
 
   tixiInit();
-  xmlKeepBlanksDefault(0);
-  xmlIndentTreeOutput = 1;
-
   if (!rootElementName) {
     printMsg(MESSAGETYPE_ERROR, "Error: No root element name specified.\n");
     return NO_ELEMENT_NAME;
@@ -400,11 +637,16 @@ DLL_EXPORT ReturnCode tixiCreateDocument(const char *rootElementName, TixiDocume
   document->currentNode = rootNode;
   document->isValid = UNDEFINED;
   document->status = OPENED;
-  document->memoryListHead = NULL;
-  document->memoryListTail = NULL;
+  document->memoryChunks = NULL;
+  document->largeMemoryBlocks = NULL;
   document->hasIncludedExternalFiles = 1;
   document->usePrettyPrint = 1;
-  document->uidListHead = NULL;
+  document->useBase64Vectors = 0;
+  document->xmlParseOptions = XML_PARSE_NOBLANKS;
+  document->hasSkippedElements = 0;
+  document->nPendingExternalData = 0;
+  document->externalDataChanged = 0;
+  document->uidBuckets = NULL;
   document->xpathContext = xmlXPathNewContext(xmlDocument);
 
   if (addDocumentToList(document, &(document->handle)) != SUCESS) {
@@ -416,7 +658,7 @@ DLL_EXPORT ReturnCode tixiCreateDocument(const char *rootElementName, TixiDocume
   return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiGetDocumentPath(TixiDocumentHandle handle, char** documentPath)
+static ReturnCode tixiGetDocumentPathUnlocked(TixiDocumentHandle handle, char** documentPath)
 {
   TixiDocument *document = NULL;
 
@@ -436,27 +678,59 @@ DLL_EXPORT ReturnCode tixiGetDocumentPath(TixiDocumentHandle handle, char** docu
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiGetDocumentPath(TixiDocumentHandle handle, char** documentPath)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetDocumentPathUnlocked(handle, documentPath);
+  unlockDocument(document);
+  return error;
+}
+
 /*
 Distinguish internal/user/fatal errors!!!
 */
-DLL_EXPORT ReturnCode tixiSaveDocument(TixiDocumentHandle handle, const char *xmlFilename)
+static ReturnCode tixiSaveDocumentUnlocked(TixiDocumentHandle handle, const char *xmlFilename)
 {
   return saveDocument(handle, xmlFilename, SPLITTED);
 }
 
+DLL_EXPORT ReturnCode tixiSaveDocument(TixiDocumentHandle handle, const char *xmlFilename)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiSaveDocumentUnlocked(handle, xmlFilename);
+  unlockDocument(document);
+  return error;
+}
 
 
-DLL_EXPORT ReturnCode tixiSaveCompleteDocument(TixiDocumentHandle handle, const char *xmlFilename)
+
+static ReturnCode tixiSaveCompleteDocumentUnlocked(TixiDocumentHandle handle, const char *xmlFilename)
 {
   return saveDocument(handle, xmlFilename, COMPLETE);
 }
 
+DLL_EXPORT ReturnCode tixiSaveCompleteDocument(TixiDocumentHandle handle, const char *xmlFilename)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiSaveCompleteDocumentUnlocked(handle, xmlFilename);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiSaveAndRemoveDocument (TixiDocumentHandle handle, const char *xmlFilename)
+static ReturnCode tixiSaveAndRemoveDocumentUnlocked (TixiDocumentHandle handle, const char *xmlFilename)
 {
   return saveDocument(handle, xmlFilename, REMOVED);
 }
 
+DLL_EXPORT ReturnCode tixiSaveAndRemoveDocument (TixiDocumentHandle handle, const char *xmlFilename)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiSaveAndRemoveDocumentUnlocked(handle, xmlFilename);
+  unlockDocument(document);
+  return error;
+}
+
 
 DLL_EXPORT ReturnCode tixiCloseDocument(TixiDocumentHandle handle)
 {
@@ -467,19 +741,11 @@ DLL_EXPORT ReturnCode tixiCloseDocument(TixiDocumentHandle handle)
     return INVALID_HANDLE;
   }
 
+  /* the document is freed, when the last thread using it releases it */
   if (removeDocumentFromList(handle) == FAILED) {
-    if (document) {
-      freeTixiDocument(document);
-      document = NULL;
-    }
     return CLOSE_FAILED;
   }
 
-  if (document) {
-    freeTixiDocument(document);
-    document = NULL;
-  }
-
   return SUCCESS;
 }
 
@@ -487,8 +753,10 @@ DLL_EXPORT ReturnCode tixiCloseAllDocuments()
 {
   ReturnCode returnValue = SUCCESS;
 
-  while(documentListHead && documentListHead->document) {
-    TixiDocumentHandle handle = documentListHead->document->handle;
+  TixiDocumentHandle handle;
+  int slotIndex = 0;
+
+  while((handle = getNextDocumentHandle(&slotIndex)) >= 0) {
     returnValue = tixiCloseDocument(handle);
     if(returnValue != SUCCESS)
       return returnValue;
@@ -503,12 +771,13 @@ DLL_EXPORT ReturnCode tixiCleanup()
     return ret;
 
   // cleanup libxml, removes valgrind leaks
+  XPathClearCache();
   xmlCleanupParser();
   return SUCCESS;
 }
 
 
-DLL_EXPORT ReturnCode tixiExportDocumentAsString(const TixiDocumentHandle handle, char **text)
+static ReturnCode tixiExportDocumentAsStringUnlocked(const TixiDocumentHandle handle, char **text)
 {
   TixiDocument *document = getDocument(handle);
   xmlDocPtr xmlDocument = NULL;
@@ -528,22 +797,34 @@ DLL_EXPORT ReturnCode tixiExportDocumentAsString(const TixiDocumentHandle handle
     return FAILED;
   }
 
+  if (document->hasSkippedElements) {
+    printMsg(MESSAGETYPE_ERROR, "Error: The document was opened without some of its elements and cannot be exported.\n");
+    *text = NULL;
+    return FAILED;
+  }
+
   xmlDocument = document->docPtr;
 
   xmlDocDumpFormatMemory(xmlDocument, &xmlbuff, &buffersize, document->usePrettyPrint);
   textPtr = (char *) xmlbuff;
 
   if ( textPtr ) {
-    *text = (char *) malloc((strlen(textPtr) + 1) * sizeof(char));
-    strcpy(*text, textPtr);
+    *text = copyStringToDocument(document, textPtr);
     xmlFree(textPtr);
   }
   else {
-    *text = (char *) malloc(sizeof(char));
-    strcpy(*text, "");
+    *text = copyStringToDocument(document, "");
   }
-  error = addToMemoryList(document, (void *) *text);
+  error = *text ? SUCCESS : FAILED;
+
+  return error;
+}
 
+DLL_EXPORT ReturnCode tixiExportDocumentAsString(const TixiDocumentHandle handle, char **text)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiExportDocumentAsStringUnlocked(handle, text);
+  unlockDocument(document);
   return error;
 }
 
@@ -565,7 +846,7 @@ DLL_EXPORT ReturnCode tixiImportFromString (const char *xmlImportString, TixiDoc
   relativDirPath[0] = '\0';
   strcat(relativDirPath, "./");
 
-  xmlDocument = xmlReadMemory(xmlImportString, (int) strlen(xmlImportString), tixiFileName, NULL, 0);
+  xmlDocument = xmlReadMemory(xmlImportString, (int) strlen(xmlImportString), tixiFileName, NULL, XML_PARSE_NOBLANKS);
 
   if (xmlDocument) {
 
@@ -578,15 +859,26 @@ DLL_EXPORT ReturnCode tixiImportFromString (const char *xmlImportString, TixiDoc
     document->currentNode = NULL;
     document->isValid = UNDEFINED;
     document->status = OPENED;
-    document->memoryListHead = NULL;
-    document->memoryListTail = NULL;
+    document->memoryChunks = NULL;
+    document->largeMemoryBlocks = NULL;
     document->hasIncludedExternalFiles = 1;
     document->usePrettyPrint = 1;
-    document->uidListHead = NULL;
+    document->useBase64Vectors = 0;
+    document->xmlParseOptions = XML_PARSE_NOBLANKS;
+    document->hasSkippedElements = 0;
+    document->nPendingExternalData = 0;
+    document->externalDataChanged = 0;
+    document->uidBuckets = NULL;
     document->xpathContext = xmlXPathNewContext(xmlDocument);
-    addDocumentToList(document, &(document->handle));
-    *handle = document->handle;
-    returnValue = SUCCESS; /*?*/
+    if (addDocumentToList(document, &(document->handle)) != SUCESS) {
+      printMsg(MESSAGETYPE_ERROR, "Error: Failed  adding document to document list.\n");
+      freeTixiDocument(document);
+      returnValue = FAILED;
+    }
+    else {
+      *handle = document->handle;
+      returnValue = SUCCESS; /*?*/
+    }
   }
   else {
     printMsg(MESSAGETYPE_ERROR, "Error: XML-string to import is not wellformed!\n");
@@ -599,7 +891,7 @@ DLL_EXPORT ReturnCode tixiImportFromString (const char *xmlImportString, TixiDoc
 
 
 
-DLL_EXPORT ReturnCode tixiAddHeader(const TixiDocumentHandle handle, const char *toolName, const char *version, const char *authorName)
+static ReturnCode tixiAddHeaderUnlocked(const TixiDocumentHandle handle, const char *toolName, const char *version, const char *authorName)
 {
 
   TixiDocument *document = getDocument(handle);
@@ -656,7 +948,8 @@ DLL_EXPORT ReturnCode tixiAddHeader(const TixiDocumentHandle handle, const char
     /* Add date string */
     {
       time_t now = time(NULL);
-      struct tm *date = localtime(&now);
+      struct tm dateBuffer;
+      struct tm *date = LOCALTIME_R(&now, &dateBuffer);
       char timestamp[65];
       xmlNodePtr newChild = NULL;
 
@@ -684,6 +977,7 @@ DLL_EXPORT ReturnCode tixiAddHeader(const TixiDocumentHandle handle, const char
     return FAILED;
   }
 
+  invalidateChildIndex(document, rootElement);
   if (!xmlAddChild(rootElement, headerElement)) {
     printMsg(MESSAGETYPE_ERROR, "Error:  Failed to add header element.\n");
     return FAILED;
@@ -691,8 +985,16 @@ DLL_EXPORT ReturnCode tixiAddHeader(const TixiDocumentHandle handle, const char
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiAddHeader(const TixiDocumentHandle handle, const char *toolName, const char *version, const char *authorName)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddHeaderUnlocked(handle, toolName, version, authorName);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiAddCpacsHeader(const TixiDocumentHandle handle,
+static ReturnCode tixiAddCpacsHeaderUnlocked(const TixiDocumentHandle handle,
                                          const char *name, const char *creator, const char *version,
                                          const char *description, const char * cpacsVersion)
 {
@@ -762,7 +1064,8 @@ DLL_EXPORT ReturnCode tixiAddCpacsHeader(const TixiDocumentHandle handle,
     /* Add date string */
     {
       time_t now = time(NULL);
-      struct tm *date = localtime(&now);
+      struct tm dateBuffer;
+      struct tm *date = LOCALTIME_R(&now, &dateBuffer);
       char timestamp[65];
       xmlNodePtr newChild = NULL;
 
@@ -786,6 +1089,7 @@ DLL_EXPORT ReturnCode tixiAddCpacsHeader(const TixiDocumentHandle handle,
     return FAILED;
   }
 
+  invalidateChildIndex(document, rootElement);
   if (!xmlAddChild(rootElement, headerElement)) {
     printMsg(MESSAGETYPE_ERROR, "Error:  Failed to add header element.\n");
     return FAILED;
@@ -793,8 +1097,18 @@ DLL_EXPORT ReturnCode tixiAddCpacsHeader(const TixiDocumentHandle handle,
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiAddCpacsHeader(const TixiDocumentHandle handle,
+                                         const char *name, const char *creator, const char *version,
+                                         const char *description, const char * cpacsVersion)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddCpacsHeaderUnlocked(handle, name, creator, version, description, cpacsVersion);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiSchemaValidateFromFile(const TixiDocumentHandle handle, const char *xsdFilename)
+static ReturnCode tixiSchemaValidateFromFileUnlocked(const TixiDocumentHandle handle, const char *xsdFilename)
 {
   xmlDocPtr schema_doc;
 
@@ -802,7 +1116,15 @@ DLL_EXPORT ReturnCode tixiSchemaValidateFromFile(const TixiDocumentHandle handle
   return( validateSchema(handle, &schema_doc, 0));
 }
 
-DLL_EXPORT ReturnCode tixiSchemaValidateWithDefaultsFromFile(const TixiDocumentHandle handle, const char *xsdFilename)
+DLL_EXPORT ReturnCode tixiSchemaValidateFromFile(const TixiDocumentHandle handle, const char *xsdFilename)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiSchemaValidateFromFileUnlocked(handle, xsdFilename);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiSchemaValidateWithDefaultsFromFileUnlocked(const TixiDocumentHandle handle, const char *xsdFilename)
 {
   xmlDocPtr schema_doc;
 
@@ -810,7 +1132,15 @@ DLL_EXPORT ReturnCode tixiSchemaValidateWithDefaultsFromFile(const TixiDocumentH
   return( validateSchema(handle, &schema_doc, 1));
 }
 
-DLL_EXPORT ReturnCode tixiSchemaValidateFromString(const TixiDocumentHandle handle, const char *xsdString)
+DLL_EXPORT ReturnCode tixiSchemaValidateWithDefaultsFromFile(const TixiDocumentHandle handle, const char *xsdFilename)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiSchemaValidateWithDefaultsFromFileUnlocked(handle, xsdFilename);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiSchemaValidateFromStringUnlocked(const TixiDocumentHandle handle, const char *xsdString)
 {
   xmlDocPtr schema_doc;
 
@@ -818,8 +1148,16 @@ DLL_EXPORT ReturnCode tixiSchemaValidateFromString(const TixiDocumentHandle hand
   return(validateSchema(handle, &schema_doc, 0));
 }
 
+DLL_EXPORT ReturnCode tixiSchemaValidateFromString(const TixiDocumentHandle handle, const char *xsdString)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiSchemaValidateFromStringUnlocked(handle, xsdString);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiDTDValidate(const TixiDocumentHandle handle, const char *DTDFilename)
+static ReturnCode tixiDTDValidateUnlocked(const TixiDocumentHandle handle, const char *DTDFilename)
 {
 
   PRINT_DEBUG2("%s %d\n", DTDFilename, handle);
@@ -828,7 +1166,15 @@ DLL_EXPORT ReturnCode tixiDTDValidate(const TixiDocumentHandle handle, const cha
   return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiGetTextElement(const TixiDocumentHandle handle, const char *elementPath, char **text)
+DLL_EXPORT ReturnCode tixiDTDValidate(const TixiDocumentHandle handle, const char *DTDFilename)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiDTDValidateUnlocked(handle, DTDFilename);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiGetTextElementUnlocked(const TixiDocumentHandle handle, const char *elementPath, char **text)
 {
   TixiDocument *document = getDocument(handle);
   xmlNodePtr element = NULL;
@@ -839,65 +1185,150 @@ DLL_EXPORT ReturnCode tixiGetTextElement(const TixiDocumentHandle handle, const
     return INVALID_HANDLE;
   }
 
-  error = checkElement(document->xpathContext, elementPath, &element);
+  error = checkElement(XPathGetContext(document), elementPath, &element);
 
   if (!error) {
 
     xmlNodePtr children = element->children;
+    const char *directText = getNodeListTextDirect(document->docPtr, children, 1);
     char *textPtr = NULL;
 
-    textPtr = (char *) xmlNodeListGetString(document->docPtr, children, 0);
-    if ( textPtr ) {
-      *text = (char *) malloc((strlen(textPtr) + 1) * sizeof(char));
-      strcpy(*text, textPtr);
-      xmlFree(textPtr);
+    if ( directText ) {
+      /* the common case of a single text node, only one copy */
+      *text = copyStringToDocument(document, directText);
     } else {
-      *text = (char *) malloc(sizeof(char));
-      strcpy(*text, "");
+      textPtr = (char *) xmlNodeListGetString(document->docPtr, children, 0);
+      *text = copyStringToDocument(document, textPtr ? textPtr : "");
+      xmlFree(textPtr);
     }
-    error = addToMemoryList(document, (void *) *text);
+    error = *text ? SUCCESS : FAILED;
   }
 
   return error;
 }
 
-DLL_EXPORT ReturnCode tixiGetIntegerElement(const TixiDocumentHandle handle, const char *elementPath, int *number)
+DLL_EXPORT ReturnCode tixiGetTextElement(const TixiDocumentHandle handle, const char *elementPath, char **text)
 {
-  char *text;
-  ReturnCode error = 0;
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetTextElementUnlocked(handle, elementPath, text);
+  unlockDocument(document);
+  return error;
+}
 
-  error = tixiGetTextElement(handle, elementPath, &text);
+static ReturnCode tixiGetTextElementIntoUnlocked(const TixiDocumentHandle handle, const char *elementPath,
+                                                 char *buffer, int bufferSize, int *requiredSize)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
+  ReturnCode error = SUCCESS;
 
-  if (error) {
-    printMsg(MESSAGETYPE_STATUS, "Error: tixiGetTextElement returns %d in tixiGetIntegerElement.\n", error);
-    return error;
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
   }
 
-  *number = atoi(text);
+  error = checkElement(XPathGetContext(document), elementPath, &element);
+  if (!error) {
+    error = copyNodeListTextToBuffer(document->docPtr, element->children, 1, buffer, bufferSize, requiredSize);
+  }
 
-  return SUCCESS;
+  return error;
 }
 
-DLL_EXPORT ReturnCode tixiGetDoubleElement(const TixiDocumentHandle handle, const char *elementPath, double *number)
+DLL_EXPORT ReturnCode tixiGetTextElementInto(const TixiDocumentHandle handle, const char *elementPath,
+                                             char *buffer, int bufferSize, int *requiredSize)
 {
-  char *text = NULL;
-  ReturnCode error = 0;
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetTextElementIntoUnlocked(handle, elementPath, buffer, bufferSize, requiredSize);
+  unlockDocument(document);
+  return error;
+}
 
-  error = tixiGetTextElement(handle, elementPath, &text);
+static ReturnCode tixiGetTextElementBorrowedUnlocked(const TixiDocumentHandle handle, const char *elementPath, const char **text)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
+  ReturnCode error = SUCCESS;
 
-  if (error) {
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = checkElement(XPathGetContext(document), elementPath, &element);
+  if (!error) {
+    *text = getNodeListTextDirect(document->docPtr, element->children, 1);
+    if (!*text) {
+      /* the text has to be assembled, fall back to a copy owned by the document */
+      char *textPtr = (char *) xmlNodeListGetString(document->docPtr, element->children, 0);
+      *text = copyStringToDocument(document, textPtr ? textPtr : "");
+      xmlFree(textPtr);
+    }
+    error = *text ? SUCCESS : FAILED;
+  }
+
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiGetTextElementBorrowed(const TixiDocumentHandle handle, const char *elementPath, const char **text)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetTextElementBorrowedUnlocked(handle, elementPath, text);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiGetIntegerElementUnlocked(const TixiDocumentHandle handle, const char *elementPath, int *number)
+{
+  const char *text = NULL;
+  ReturnCode error = 0;
+
+  error = tixiGetTextElementBorrowedUnlocked(handle, elementPath, &text);
+
+  if (error) {
+    printMsg(MESSAGETYPE_STATUS, "Error: tixiGetTextElement returns %d in tixiGetIntegerElement.\n", error);
+    return error;
+  }
+
+  *number = atoi(text);
+
+  return SUCCESS;
+}
+
+DLL_EXPORT ReturnCode tixiGetIntegerElement(const TixiDocumentHandle handle, const char *elementPath, int *number)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetIntegerElementUnlocked(handle, elementPath, number);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiGetDoubleElementUnlocked(const TixiDocumentHandle handle, const char *elementPath, double *number)
+{
+  const char *text = NULL;
+  ReturnCode error = 0;
+
+  error = tixiGetTextElementBorrowedUnlocked(handle, elementPath, &text);
+
+  if (error) {
     printMsg(MESSAGETYPE_STATUS, "Error: tixiGetTextElement returns %d in tixiGetDoubleElement.\n", error);
     return error;
   }
 
-  *number = atof(text);
+  parseDouble(text, number);
   return SUCCESS;
+}
 
-  /* use   strtod(nptr, (char **)NULL); to check for errors */
+DLL_EXPORT ReturnCode tixiGetDoubleElement(const TixiDocumentHandle handle, const char *elementPath, double *number)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetDoubleElementUnlocked(handle, elementPath, number);
+  unlockDocument(document);
+  return error;
 }
 
 
-DLL_EXPORT ReturnCode tixiGetBooleanElement(const TixiDocumentHandle handle, const char *elementPath, int *boolean)
+static ReturnCode tixiGetBooleanElementUnlocked(const TixiDocumentHandle handle, const char *elementPath, int *boolean)
 {
   char *text = NULL;
   ReturnCode error = 0;
@@ -924,7 +1355,266 @@ DLL_EXPORT ReturnCode tixiGetBooleanElement(const TixiDocumentHandle handle, con
   return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiUpdateTextElement (const TixiDocumentHandle handle, const char *elementPath, const char *text)
+DLL_EXPORT ReturnCode tixiGetBooleanElement(const TixiDocumentHandle handle, const char *elementPath, int *boolean)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetBooleanElementUnlocked(handle, elementPath, boolean);
+  unlockDocument(document);
+  return error;
+}
+
+/**
+   Paths of a batch read are split into a prefix resolved once per batch and a last step
+   resolved relative to the prefix node, see ::tixiGetValues
+ */
+#define VALUE_PREFIX_CACHE_SIZE 64
+#define MAX_VALUE_PREFIX_LENGTH 1024
+
+typedef struct
+{
+  const char* prefix;            /* points into the paths array of the caller */
+  size_t length;
+  xmlNodePtr node;               /* NULL if the prefix does not resolve to a unique element */
+} ValuePrefixCacheEntry;
+
+/* returns the length of the prefix before the last step of path, or 0 if path is not split */
+static size_t findValuePathPrefix(const char *path)
+{
+  size_t i = 0, prefixLength = 0;
+  int depth = 0;
+  char quote = 0;
+
+  for (i = 0; path[i]; ++i) {
+    char c = path[i];
+    if (quote) {
+      if (c == quote) {
+        quote = 0;
+      }
+    }
+    else if (c == '"' || c == '\'') {
+      quote = c;
+    }
+    else if (c == '[' || c == '(') {
+      depth++;
+    }
+    else if (c == ']' || c == ')') {
+      depth--;
+    }
+    else if (c == '/' && depth == 0) {
+      prefixLength = i;
+    }
+  }
+
+  /* "/a" has no prefix, "//" and trailing slashes are left to the XPath engine */
+  if (prefixLength == 0 || path[prefixLength - 1] == '/' || path[prefixLength + 1] == '\0'
+      || prefixLength >= MAX_VALUE_PREFIX_LENGTH) {
+    return 0;
+  }
+  return prefixLength;
+}
+
+static unsigned int hashValuePathPrefix(const char *prefix, size_t length)
+{
+  unsigned int hash = 2166136261u;
+  size_t i = 0;
+  for (i = 0; i < length; ++i) {
+    hash = (hash ^ (unsigned char) prefix[i]) * 16777619u;
+  }
+  return hash;
+}
+
+/* resolves the prefix with the tree walker, returns NULL if it is not a unique element */
+static xmlNodePtr resolveValuePathPrefix(xmlXPathContextPtr xpathContext, ValuePrefixCacheEntry *cache,
+                                         const char *path, size_t length)
+{
+  ValuePrefixCacheEntry *entry = &cache[hashValuePathPrefix(path, length) % VALUE_PREFIX_CACHE_SIZE];
+  char prefix[MAX_VALUE_PREFIX_LENGTH];
+  xmlNodePtr node = NULL;
+
+  if (entry->prefix && entry->length == length && strncmp(entry->prefix, path, length) == 0) {
+    return entry->node;
+  }
+
+  memcpy(prefix, path, length);
+  prefix[length] = '\0';
+  if (XPathResolveSimplePath(xpathContext, prefix, &node) != 1 || node->type != XML_ELEMENT_NODE) {
+    node = NULL;
+  }
+
+  entry->prefix = path;
+  entry->length = length;
+  entry->node = node;
+  return node;
+}
+
+/* resolves an attribute step "@name" without evaluating XPath, returns -1 for other steps */
+static int resolveValueAttributeStep(xmlNodePtr element, const char *step, xmlNodePtr *node)
+{
+  xmlAttrPtr attribute = NULL;
+  const char *c = NULL;
+
+  if (step[0] != '@' || !step[1]) {
+    return -1;
+  }
+  for (c = step + 1; *c; ++c) {
+    if (!isalnum((unsigned char) *c) && *c != '_' && *c != '-' && *c != '.') {
+      return -1;
+    }
+  }
+
+  for (attribute = element->properties; attribute; attribute = attribute->next) {
+    if (attribute->ns == NULL && xmlStrEqual(attribute->name, (const xmlChar *) step + 1)) {
+      *node = (xmlNodePtr) attribute;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/* resolves a path of a batch read to a unique element or attribute node */
+static ReturnCode resolveValuePath(xmlXPathContextPtr xpathContext, ValuePrefixCacheEntry *cache,
+                                   const char *path, xmlNodePtr *node)
+{
+  xmlXPathObjectPtr xpathObject = NULL;
+  xmlNodePtr contextNode = xpathContext->node;
+  xmlElementType nodeType = XML_ELEMENT_NODE;
+  size_t prefixLength = findValuePathPrefix(path);
+  const char *step = path;
+  int nNodes = -1;
+
+  if (prefixLength > 0) {
+    xmlNodePtr prefixNode = resolveValuePathPrefix(xpathContext, cache, path, prefixLength);
+    if (prefixNode) {
+      step = path + prefixLength + 1;
+      xpathContext->node = prefixNode;
+      nNodes = resolveValueAttributeStep(prefixNode, step, node);
+    }
+  }
+
+  if (nNodes < 0) {
+    nNodes = XPathResolveSimplePath(xpathContext, step, node);
+  }
+  if (nNodes < 0) {
+    xpathObject = XPathEvaluate(xpathContext, step);
+    if (!xpathObject) {
+      xpathContext->node = contextNode;
+      return INVALID_XPATH;
+    }
+    nNodes = xmlXPathNodeSetGetLength(xpathObject->nodesetval);
+    if (nNodes > 0) {
+      *node = xmlXPathNodeSetItem(xpathObject->nodesetval, 0);
+      /* namespace nodes are copies owned by the node set */
+      nodeType = (*node)->type;
+    }
+    xmlXPathFreeObject(xpathObject);
+  }
+  else if (nNodes > 0) {
+    nodeType = (*node)->type;
+  }
+  xpathContext->node = contextNode;
+
+  if (nNodes == 0) {
+    return ELEMENT_NOT_FOUND;
+  }
+  if (nNodes > 1) {
+    return ELEMENT_PATH_NOT_UNIQUE;
+  }
+  if (nodeType != XML_ELEMENT_NODE && nodeType != XML_ATTRIBUTE_NODE) {
+    return NOT_AN_ELEMENT;
+  }
+  return SUCCESS;
+}
+
+/* converts the text of an element or attribute node according to type */
+static ReturnCode getNodeValue(xmlDocPtr doc, xmlNodePtr node, int type, double *value)
+{
+  const char *text = getNodeListTextDirect(doc, node->children, 1);
+  char *textPtr = NULL;
+  ReturnCode error = SUCCESS;
+
+  if (!text) {
+    textPtr = (char *) xmlNodeListGetString(doc, node->children, 0);
+    text = textPtr ? textPtr : "";
+  }
+
+  switch (type) {
+  case VALUETYPE_DOUBLE:
+    parseDouble(text, value);
+    break;
+  case VALUETYPE_INTEGER:
+    *value = atoi(text);
+    break;
+  case VALUETYPE_BOOLEAN:
+    if (strcmp(text, "true") == 0 || strcmp(text, "1") == 0) {
+      *value = 1.;
+    }
+    else if (strcmp(text, "false") == 0 || strcmp(text, "0") == 0) {
+      *value = 0.;
+    }
+    else {
+      error = FAILED;
+    }
+    break;
+  default:
+    error = FAILED;
+  }
+
+  xmlFree(textPtr);
+  return error;
+}
+
+static ReturnCode tixiGetValuesUnlocked(const TixiDocumentHandle handle, const char **paths, const int *types,
+                                        int nValues, double *values, ReturnCode *errors)
+{
+  TixiDocument *document = getDocument(handle);
+  ValuePrefixCacheEntry cache[VALUE_PREFIX_CACHE_SIZE];
+  xmlXPathContextPtr xpathContext = NULL;
+  int i = 0;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  if (nValues < 0 || (nValues > 0 && (!paths || !types || !values || !errors))) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid arguments in tixiGetValues.\n");
+    return FAILED;
+  }
+
+  xpathContext = XPathGetContext(document);
+  if (!xpathContext) {
+    return FAILED;
+  }
+
+  memset(cache, 0, sizeof(cache));
+  for (i = 0; i < nValues; ++i) {
+    xmlNodePtr node = NULL;
+
+    values[i] = 0.;
+    if (!paths[i]) {
+      errors[i] = FAILED;
+      continue;
+    }
+
+    errors[i] = resolveValuePath(xpathContext, cache, paths[i], &node);
+    if (errors[i] == SUCCESS) {
+      errors[i] = getNodeValue(document->docPtr, node, types[i], &values[i]);
+    }
+  }
+
+  return SUCCESS;
+}
+
+DLL_EXPORT ReturnCode tixiGetValues(const TixiDocumentHandle handle, const char **paths, const int *types,
+                                    int nValues, double *values, ReturnCode *errors)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetValuesUnlocked(handle, paths, types, nValues, values, errors);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiUpdateTextElementUnlocked (const TixiDocumentHandle handle, const char *elementPath, const char *text)
 {
   TixiDocument *document = getDocument(handle);
   xmlNodePtr element = NULL;
@@ -941,41 +1631,61 @@ DLL_EXPORT ReturnCode tixiUpdateTextElement (const TixiDocumentHandle handle, co
     return ALREADY_SAVED;
   }
 
-  error = checkElement(document->xpathContext, elementPath, &element);
+  error = checkElement(XPathGetContext(document), elementPath, &element);
 
   if (!error) {
     newElement = xmlNewText((xmlChar*) text);
+    uid_clearReferenceGraph(document);
     if(element->children) {
       xmlNodePtr nodeToReplace = element->children;
+      invalidateNodeCursors(document, nodeToReplace);
+      invalidateChildIndexesOfSubtree(document, nodeToReplace);
+      uid_removeSubtreeUIDs(document, nodeToReplace);
       xmlReplaceNode(nodeToReplace, newElement);
       xmlFreeNode(nodeToReplace);
     }
-    else
+    else {
+      invalidateChildIndex(document, element);
       xmlAddChild(element, newElement);
+    }
     return SUCCESS;
   }
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiUpdateTextElement (const TixiDocumentHandle handle, const char *elementPath, const char *text)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiUpdateTextElementUnlocked(handle, elementPath, text);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiUpdateDoubleElement (const TixiDocumentHandle handle, const char *elementPath, double number, const char *format)
+static ReturnCode tixiUpdateDoubleElementUnlocked (const TixiDocumentHandle handle, const char *elementPath, double number, const char *format)
 {
 
-  ReturnCode error = SUCCESS;
-  char *textBuffer = NULL;
+  ReturnCode error = FAILED;
+  TixiStringBuffer textBuffer;
 
-  if (!format) {
-    format = "%g";
-  };
+  stringBufferInit(&textBuffer);
+  if (stringBufferAppendDouble(&textBuffer, format, number)) {
+    error = tixiUpdateTextElement(handle, elementPath, textBuffer.data);
+  }
+  stringBufferFree(&textBuffer);
+  return error;
+}
 
-  textBuffer = buildString(format, number);
-  error = tixiUpdateTextElement(handle, elementPath, textBuffer);
-  free(textBuffer);
+DLL_EXPORT ReturnCode tixiUpdateDoubleElement (const TixiDocumentHandle handle, const char *elementPath, double number, const char *format)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiUpdateDoubleElementUnlocked(handle, elementPath, number, format);
+  unlockDocument(document);
   return error;
 }
 
 
-DLL_EXPORT ReturnCode tixiUpdateIntegerElement (const TixiDocumentHandle handle, const char *elementPath, int number, const char *format)
+static ReturnCode tixiUpdateIntegerElementUnlocked (const TixiDocumentHandle handle, const char *elementPath, int number, const char *format)
 {
   ReturnCode error = SUCCESS;
   char *textBuffer = NULL;
@@ -990,8 +1700,16 @@ DLL_EXPORT ReturnCode tixiUpdateIntegerElement (const TixiDocumentHandle handle,
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiUpdateIntegerElement (const TixiDocumentHandle handle, const char *elementPath, int number, const char *format)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiUpdateIntegerElementUnlocked(handle, elementPath, number, format);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiUpdateBooleanElement (const TixiDocumentHandle handle, const char *elementPath, int boolean)
+static ReturnCode tixiUpdateBooleanElementUnlocked (const TixiDocumentHandle handle, const char *elementPath, int boolean)
 {
   TixiDocument *document = getDocument(handle);
 
@@ -1015,8 +1733,16 @@ DLL_EXPORT ReturnCode tixiUpdateBooleanElement (const TixiDocumentHandle handle,
   }
 }
 
+DLL_EXPORT ReturnCode tixiUpdateBooleanElement (const TixiDocumentHandle handle, const char *elementPath, int boolean)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiUpdateBooleanElementUnlocked(handle, elementPath, boolean);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiGetTextAttribute(const TixiDocumentHandle handle, const char *elementPath,
+static ReturnCode tixiGetTextAttributeUnlocked(const TixiDocumentHandle handle, const char *elementPath,
                                            const char *attributeName, char **text)
 {
   TixiDocument *document = getDocument(handle);
@@ -1030,7 +1756,7 @@ DLL_EXPORT ReturnCode tixiGetTextAttribute(const TixiDocumentHandle handle, cons
     return INVALID_HANDLE;
   }
 
-  error = checkElement(document->xpathContext, elementPath, &element);
+  error = checkElement(XPathGetContext(document), elementPath, &element);
   if (!error) {
     char* prefix = NULL;
     char* name = NULL;
@@ -1059,11 +1785,9 @@ DLL_EXPORT ReturnCode tixiGetTextAttribute(const TixiDocumentHandle handle, cons
     free(name);
 
     if (textPtr) {
-      *text = (char *) malloc((strlen(textPtr) + 1) * sizeof(char));
-      strcpy(*text, textPtr);
+      *text = copyStringToDocument(document, textPtr);
       xmlFree(textPtr);
-      error = addToMemoryList(document, (void *) *text);
-      return error;
+      return *text ? SUCCESS : FAILED;
     }
     else {
       /*printMsg(MESSAGETYPE_ERROR,
@@ -1076,7 +1800,56 @@ DLL_EXPORT ReturnCode tixiGetTextAttribute(const TixiDocumentHandle handle, cons
   return error;
 }
 
-DLL_EXPORT ReturnCode tixiGetDoubleAttribute(const TixiDocumentHandle handle,
+DLL_EXPORT ReturnCode tixiGetTextAttribute(const TixiDocumentHandle handle, const char *elementPath,
+                                           const char *attributeName, char **text)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetTextAttributeUnlocked(handle, elementPath, attributeName, text);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiGetTextAttributeIntoUnlocked(const TixiDocumentHandle handle, const char *elementPath, const char *attributeName,
+                                                   char *buffer, int bufferSize, int *requiredSize)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
+  xmlAttrPtr attribute = NULL;
+  ReturnCode error = SUCCESS;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = checkElement(XPathGetContext(document), elementPath, &element);
+  if (!error) {
+    error = findAttribute(element, attributeName, &attribute);
+  }
+  if (!error) {
+    if (attribute->type == XML_ATTRIBUTE_DECL) {
+      /* default value declared in the DTD */
+      const xmlChar *defaultValue = ((xmlAttributePtr) attribute)->defaultValue;
+      error = copyTextToBuffer(defaultValue ? (const char *) defaultValue : "", buffer, bufferSize, requiredSize);
+    }
+    else {
+      error = copyNodeListTextToBuffer(document->docPtr, attribute->children, 0, buffer, bufferSize, requiredSize);
+    }
+  }
+
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiGetTextAttributeInto(const TixiDocumentHandle handle, const char *elementPath, const char *attributeName,
+                                               char *buffer, int bufferSize, int *requiredSize)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetTextAttributeIntoUnlocked(handle, elementPath, attributeName, buffer, bufferSize, requiredSize);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiGetDoubleAttributeUnlocked(const TixiDocumentHandle handle,
                                              const char *elementPath, const char *attributeName, double *number)
 {
   char *text;
@@ -1091,12 +1864,20 @@ DLL_EXPORT ReturnCode tixiGetDoubleAttribute(const TixiDocumentHandle handle,
     return error;
   }
 
-  *number = atof(text);
-  /* use   strtod(nptr, (char **)NULL); to check for errors */
+  parseDouble(text, number);
   return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiGetIntegerAttribute(const TixiDocumentHandle handle,
+DLL_EXPORT ReturnCode tixiGetDoubleAttribute(const TixiDocumentHandle handle,
+                                             const char *elementPath, const char *attributeName, double *number)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetDoubleAttributeUnlocked(handle, elementPath, attributeName, number);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiGetIntegerAttributeUnlocked(const TixiDocumentHandle handle,
                                               const char *elementPath, const char *attributeName, int *number)
 {
   char *text;
@@ -1116,7 +1897,16 @@ DLL_EXPORT ReturnCode tixiGetIntegerAttribute(const TixiDocumentHandle handle,
   return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiGetBooleanAttribute(const TixiDocumentHandle handle,
+DLL_EXPORT ReturnCode tixiGetIntegerAttribute(const TixiDocumentHandle handle,
+                                              const char *elementPath, const char *attributeName, int *number)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetIntegerAttributeUnlocked(handle, elementPath, attributeName, number);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiGetBooleanAttributeUnlocked(const TixiDocumentHandle handle,
                                               const char *elementPath, const char *attributeName, int *boolean)
 {
   char *text;
@@ -1148,21 +1938,48 @@ DLL_EXPORT ReturnCode tixiGetBooleanAttribute(const TixiDocumentHandle handle,
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiGetBooleanAttribute(const TixiDocumentHandle handle,
+                                              const char *elementPath, const char *attributeName, int *boolean)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetBooleanAttributeUnlocked(handle, elementPath, attributeName, boolean);
+  unlockDocument(document);
+  return error;
+}
+
 
 
-DLL_EXPORT ReturnCode tixiAddTextElement(const TixiDocumentHandle handle, const char *parentPath,
+static ReturnCode tixiAddTextElementUnlocked(const TixiDocumentHandle handle, const char *parentPath,
                                          const char *elementName, const char *text)
 {
   return tixiAddTextElementAtIndex(handle, parentPath, elementName, text, -1);
 }
 
-
-DLL_EXPORT ReturnCode tixiAddTextElementNS(const TixiDocumentHandle handle, const char *parentPath,
-                                         const char *qualifiedName, const char* namespaceURI, const char *text)
+DLL_EXPORT ReturnCode tixiAddTextElement(const TixiDocumentHandle handle, const char *parentPath,
+                                         const char *elementName, const char *text)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddTextElementUnlocked(handle, parentPath, elementName, text);
+  unlockDocument(document);
+  return error;
+}
+
+
+static ReturnCode tixiAddTextElementNSUnlocked(const TixiDocumentHandle handle, const char *parentPath,
+                                         const char *qualifiedName, const char* namespaceURI, const char *text)
 {
   return tixiAddTextElementNSAtIndex(handle, parentPath, qualifiedName, namespaceURI, text, -1);
 }
 
+DLL_EXPORT ReturnCode tixiAddTextElementNS(const TixiDocumentHandle handle, const char *parentPath,
+                                         const char *qualifiedName, const char* namespaceURI, const char *text)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddTextElementNSUnlocked(handle, parentPath, qualifiedName, namespaceURI, text);
+  unlockDocument(document);
+  return error;
+}
+
 
 ReturnCode tixiAddTextElementNSAtIndexImpl(const TixiDocumentHandle handle, const char *parentPath,
                                            const char *qualifiedName, const char* namespaceURI, const char *text, int index)
@@ -1205,7 +2022,7 @@ ReturnCode tixiAddTextElementNSAtIndexImpl(const TixiDocumentHandle handle, cons
   }
 
   /* Check parent element */
-  xpathObject = xmlXPathEvalExpression((xmlChar *) parentPath, document->xpathContext);
+  xpathObject = XPathEvaluate(XPathGetContext(document), parentPath);
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", parentPath);
@@ -1253,6 +2070,8 @@ ReturnCode tixiAddTextElementNSAtIndexImpl(const TixiDocumentHandle handle, cons
     xmlAddChild( child, headingChildNode );
   }
 
+  invalidateChildIndex(document, parent);
+  uid_clearReferenceGraph(document);
   if (targetNode != NULL && index > 0) {
     /* insert at position index */
     xmlAddPrevSibling(targetNode, child);
@@ -1274,7 +2093,7 @@ ReturnCode tixiAddTextElementNSAtIndexImpl(const TixiDocumentHandle handle, cons
   return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiAddTextElementNSAtIndex(const TixiDocumentHandle handle, const char *parentPath,
+static ReturnCode tixiAddTextElementNSAtIndexUnlocked(const TixiDocumentHandle handle, const char *parentPath,
                                                   const char *qualifiedName, const char* namespaceURI, const char *text, int index)
 {
   if (!namespaceURI) {
@@ -1285,14 +2104,32 @@ DLL_EXPORT ReturnCode tixiAddTextElementNSAtIndex(const TixiDocumentHandle handl
   return tixiAddTextElementNSAtIndexImpl(handle, parentPath, qualifiedName, namespaceURI, text, index);
 }
 
-DLL_EXPORT ReturnCode tixiAddTextElementAtIndex(const TixiDocumentHandle handle, const char *parentPath,
+DLL_EXPORT ReturnCode tixiAddTextElementNSAtIndex(const TixiDocumentHandle handle, const char *parentPath,
+                                                  const char *qualifiedName, const char* namespaceURI, const char *text, int index)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddTextElementNSAtIndexUnlocked(handle, parentPath, qualifiedName, namespaceURI, text, index);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiAddTextElementAtIndexUnlocked(const TixiDocumentHandle handle, const char *parentPath,
                                                const char *elementName, const char *text, int index)
 {
   return tixiAddTextElementNSAtIndexImpl(handle, parentPath, elementName, NULL, text, index);
 }
 
+DLL_EXPORT ReturnCode tixiAddTextElementAtIndex(const TixiDocumentHandle handle, const char *parentPath,
+                                               const char *elementName, const char *text, int index)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddTextElementAtIndexUnlocked(handle, parentPath, elementName, text, index);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiAddBooleanElement(const TixiDocumentHandle handle, const char *parentPath,
+static ReturnCode tixiAddBooleanElementUnlocked(const TixiDocumentHandle handle, const char *parentPath,
                                             const char *elementName, int boolean)
 {
   if( boolean == 0 ) {
@@ -1306,8 +2143,17 @@ DLL_EXPORT ReturnCode tixiAddBooleanElement(const TixiDocumentHandle handle, con
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiAddBooleanElement(const TixiDocumentHandle handle, const char *parentPath,
+                                            const char *elementName, int boolean)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddBooleanElementUnlocked(handle, parentPath, elementName, boolean);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiAddBooleanElementNS(const TixiDocumentHandle handle, const char *parentPath,
+static ReturnCode tixiAddBooleanElementNSUnlocked(const TixiDocumentHandle handle, const char *parentPath,
                                             const char *qualifiedName, const char* namespaceURI, int boolean)
 {
   if( boolean == 0 ) {
@@ -1321,23 +2167,26 @@ DLL_EXPORT ReturnCode tixiAddBooleanElementNS(const TixiDocumentHandle handle, c
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiAddBooleanElementNS(const TixiDocumentHandle handle, const char *parentPath,
+                                            const char *qualifiedName, const char* namespaceURI, int boolean)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddBooleanElementNSUnlocked(handle, parentPath, qualifiedName, namespaceURI, boolean);
+  unlockDocument(document);
+  return error;
+}
 
-DLL_EXPORT ReturnCode tixiAddDoubleElement(const TixiDocumentHandle handle, const char *parentPath,
+
+static ReturnCode tixiAddDoubleElementUnlocked(const TixiDocumentHandle handle, const char *parentPath,
                                            const char *elementName, double number, const char *format)
 {
   int error;
-  char *textBuffer = NULL;
-
-
-  if (!format) {
-    format = "%g";
-  };
-
-  textBuffer = buildString(format, number);
+  TixiStringBuffer textBuffer;
 
-  if (textBuffer) {
-    error = tixiAddTextElement(handle, parentPath, elementName, textBuffer);
-    free(textBuffer);
+  stringBufferInit(&textBuffer);
+  if (stringBufferAppendDouble(&textBuffer, format, number)) {
+    error = tixiAddTextElement(handle, parentPath, elementName, textBuffer.data);
+    stringBufferFree(&textBuffer);
   }
   else {
     printMsg(MESSAGETYPE_ERROR, "Internal Error: Failed to allocate memory in tixiAddDoubleElement.\n");
@@ -1347,24 +2196,27 @@ DLL_EXPORT ReturnCode tixiAddDoubleElement(const TixiDocumentHandle handle, cons
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiAddDoubleElement(const TixiDocumentHandle handle, const char *parentPath,
+                                           const char *elementName, double number, const char *format)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddDoubleElementUnlocked(handle, parentPath, elementName, number, format);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiAddDoubleElementNS(const TixiDocumentHandle handle, const char *parentPath,
+static ReturnCode tixiAddDoubleElementNSUnlocked(const TixiDocumentHandle handle, const char *parentPath,
                                              const char *qualifiedName,const char* namespaceURI,
                                              double number, const char *format)
 {
   int error;
-  char *textBuffer = NULL;
-
-
-  if (!format) {
-    format = "%g";
-  };
-
-  textBuffer = buildString(format, number);
+  TixiStringBuffer textBuffer;
 
-  if (textBuffer) {
-    error = tixiAddTextElementNS(handle, parentPath, qualifiedName, namespaceURI, textBuffer);
-    free(textBuffer);
+  stringBufferInit(&textBuffer);
+  if (stringBufferAppendDouble(&textBuffer, format, number)) {
+    error = tixiAddTextElementNS(handle, parentPath, qualifiedName, namespaceURI, textBuffer.data);
+    stringBufferFree(&textBuffer);
   }
   else {
     printMsg(MESSAGETYPE_ERROR, "Internal Error: Failed to allocate memory in tixiAddDoubleElementNS.\n");
@@ -1374,8 +2226,18 @@ DLL_EXPORT ReturnCode tixiAddDoubleElementNS(const TixiDocumentHandle handle, co
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiAddDoubleElementNS(const TixiDocumentHandle handle, const char *parentPath,
+                                             const char *qualifiedName,const char* namespaceURI,
+                                             double number, const char *format)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddDoubleElementNSUnlocked(handle, parentPath, qualifiedName, namespaceURI, number, format);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiAddIntegerElement(const TixiDocumentHandle handle, const char *parentPath,
+static ReturnCode tixiAddIntegerElementUnlocked(const TixiDocumentHandle handle, const char *parentPath,
                                             const char *elementName, int number, const char *format)
 {
   int error;
@@ -1401,8 +2263,17 @@ DLL_EXPORT ReturnCode tixiAddIntegerElement(const TixiDocumentHandle handle, con
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiAddIntegerElement(const TixiDocumentHandle handle, const char *parentPath,
+                                            const char *elementName, int number, const char *format)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddIntegerElementUnlocked(handle, parentPath, elementName, number, format);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiAddIntegerElementNS(const TixiDocumentHandle handle, const char *parentPath,
+static ReturnCode tixiAddIntegerElementNSUnlocked(const TixiDocumentHandle handle, const char *parentPath,
                                               const char *qualifiedName, const char* namespaceURI, int number, const char *format)
 {
   int error;
@@ -1428,8 +2299,17 @@ DLL_EXPORT ReturnCode tixiAddIntegerElementNS(const TixiDocumentHandle handle, c
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiAddIntegerElementNS(const TixiDocumentHandle handle, const char *parentPath,
+                                              const char *qualifiedName, const char* namespaceURI, int number, const char *format)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddIntegerElementNSUnlocked(handle, parentPath, qualifiedName, namespaceURI, number, format);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiAddTextAttribute(const TixiDocumentHandle handle, const char *elementPath,
+static ReturnCode tixiAddTextAttributeUnlocked(const TixiDocumentHandle handle, const char *elementPath,
                                            const char *attributeName, const char *attributeValue)
 {
   TixiDocument *document = getDocument(handle);
@@ -1444,26 +2324,29 @@ DLL_EXPORT ReturnCode tixiAddTextAttribute(const TixiDocumentHandle handle, cons
     return ALREADY_SAVED;
   }
 
-  return genericAddTextAttribute(document->xpathContext, elementPath, attributeName, attributeValue);
+  return genericAddTextAttribute(document, elementPath, attributeName, attributeValue);
 }
 
-DLL_EXPORT ReturnCode tixiAddDoubleAttribute(const TixiDocumentHandle handle,
+DLL_EXPORT ReturnCode tixiAddTextAttribute(const TixiDocumentHandle handle, const char *elementPath,
+                                           const char *attributeName, const char *attributeValue)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddTextAttributeUnlocked(handle, elementPath, attributeName, attributeValue);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiAddDoubleAttributeUnlocked(const TixiDocumentHandle handle,
                                              const char *elementPath, const char *attributeName,
                                              double number, const char *format)
 {
   int error;
-  char *textBuffer = NULL;
-
-
-  if (!format) {
-    format = "%g";
-  };
-
-  textBuffer = buildString(format, number);
+  TixiStringBuffer textBuffer;
 
-  if (textBuffer) {
-    error = tixiAddTextAttribute(handle, elementPath, attributeName, textBuffer);
-    free(textBuffer);
+  stringBufferInit(&textBuffer);
+  if (stringBufferAppendDouble(&textBuffer, format, number)) {
+    error = tixiAddTextAttribute(handle, elementPath, attributeName, textBuffer.data);
+    stringBufferFree(&textBuffer);
   }
   else {
     printMsg(MESSAGETYPE_ERROR, "Internal Error: Failed to allocate memory in tixiAddDoubleAttribute.\n");
@@ -1472,7 +2355,17 @@ DLL_EXPORT ReturnCode tixiAddDoubleAttribute(const TixiDocumentHandle handle,
   return error;
 }
 
-DLL_EXPORT ReturnCode tixiAddIntegerAttribute(const TixiDocumentHandle handle,
+DLL_EXPORT ReturnCode tixiAddDoubleAttribute(const TixiDocumentHandle handle,
+                                             const char *elementPath, const char *attributeName,
+                                             double number, const char *format)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddDoubleAttributeUnlocked(handle, elementPath, attributeName, number, format);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiAddIntegerAttributeUnlocked(const TixiDocumentHandle handle,
                                               const char *elementPath, const char *attributeName, int number, const char *format)
 {
   /* Here the format string should be parsed to determine the length of the string to be generated. Instead,
@@ -1497,114 +2390,143 @@ DLL_EXPORT ReturnCode tixiAddIntegerAttribute(const TixiDocumentHandle handle,
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiAddIntegerAttribute(const TixiDocumentHandle handle,
+                                              const char *elementPath, const char *attributeName, int number, const char *format)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddIntegerAttributeUnlocked(handle, elementPath, attributeName, number, format);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiAddFloatVector (const TixiDocumentHandle handle, const char *parentPath, const char *elementName, const double *vector, const int numElements, const char* format)
+/* writes the numbers separated by VECTOR_SEPARATOR into buffer, or base64 encoded ignoring the format */
+static int formatFloatVector(TixiStringBuffer *buffer, const double *vector, const int numElements, const char* format,
+                             int useBase64)
 {
-  ReturnCode error;
-  char *stringVector = NULL;
-  char *textBuffer = NULL;
   int i;
-  int stringSize = 0;
 
-  if(numElements < 1) {
-    return FAILED;
+  if (useBase64) {
+    stringBufferAppendBase64Doubles(buffer, vector, numElements);
+  }
+  else {
+    /* most numbers take at most 12 characters with "%g", otherwise the buffer grows */
+    stringBufferReserve(buffer, (size_t) numElements * 13);
+    for (i = 0; i < numElements; i++) {
+      if (i > 0) {
+        stringBufferAppend(buffer, VECTOR_SEPARATOR);
+      }
+      stringBufferAppendDouble(buffer, format, vector[i]);
+    }
   }
 
-  if (!format) {
-    format = "%g";
-  };
+  if (buffer->failed) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Failed to allocate memory for a vector of %d numbers.\n", numElements);
+    return 0;
+  }
+  return 1;
+}
 
-  /* calculate the size of the resulting string */
-  for(i=0; i<numElements; i++) {
-    textBuffer = buildString(format, vector[i]);
-    stringSize += (int) strlen(textBuffer);
-    free(textBuffer);
+static ReturnCode tixiAddFloatVectorUnlocked (const TixiDocumentHandle handle, const char *parentPath, const char *elementName, const double *vector, const int numElements, const char* format)
+{
+  TixiDocument *document = getDocument(handle);
+  ReturnCode error;
+  TixiStringBuffer stringVector;
+  char *textBuffer = NULL;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
   }
 
-  /* allocate memory */
-  stringVector = (char *) malloc(sizeof(char) * (stringSize + numElements + 1));
+  if(numElements < 1) {
+    return FAILED;
+  }
 
-  /* copy strings to stringVector */
-  stringVector[0] = '\0';
-  textBuffer = buildString(format, vector[0]);
-  strcat(stringVector, textBuffer);
-  free(textBuffer);
-  for(i=1; i<numElements; i++) {
-    textBuffer = buildString(format, vector[i]);
-    strcat(stringVector, VECTOR_SEPARATOR);
-    strcat(stringVector, textBuffer);
-    free(textBuffer);
+  stringBufferInit(&stringVector);
+  if (!formatFloatVector(&stringVector, vector, numElements, format, document->useBase64Vectors)) {
+    stringBufferFree(&stringVector);
+    return FAILED;
   }
 
   /* Add element */
-  error = tixiAddTextElement(handle, parentPath, elementName, stringVector);
+  error = tixiAddTextElement(handle, parentPath, elementName, stringVector.data);
+  stringBufferFree(&stringVector);
   if(error != SUCCESS) {
     return error;
   }
 
   /* add attribute */
-  textBuffer = (char *) malloc(sizeof(char) * (strlen(parentPath) + strlen(elementName) + 2));
-  textBuffer[0] = '\0';
-  strcat(textBuffer, parentPath);
-  strcat(textBuffer, "/");
-  strcat(textBuffer, elementName);
+  textBuffer = buildString("%s/%s", parentPath, elementName);
+  if (!textBuffer) {
+    return FAILED;
+  }
   error = tixiAddTextAttribute(handle, textBuffer, MAPTYPE_IDENTIFIER, VECTOR_ATTRIBUTE_NAME);
+  if (error == SUCCESS && document->useBase64Vectors) {
+    error = tixiAddTextAttribute(handle, textBuffer, VECTOR_ENCODING_ATTRIBUTE, VECTOR_ENCODING_BASE64);
+  }
+  free(textBuffer);
   if(error != SUCCESS) {
     return error;
   }
-  free(textBuffer);
-  free(stringVector);
 
   return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiUpdateFloatVector (const TixiDocumentHandle handle, const char *path, const double *vector, const int numElements, const char* format)
+DLL_EXPORT ReturnCode tixiAddFloatVector (const TixiDocumentHandle handle, const char *parentPath, const char *elementName, const double *vector, const int numElements, const char* format)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddFloatVectorUnlocked(handle, parentPath, elementName, vector, numElements, format);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiUpdateFloatVectorUnlocked (const TixiDocumentHandle handle, const char *path, const double *vector, const int numElements, const char* format)
 {
+  TixiDocument *document = getDocument(handle);
   ReturnCode error;
-  char *stringVector = NULL;
-  char *textBuffer = NULL;
-  int i;
-  int stringSize = 0;
+  TixiStringBuffer stringVector;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
 
   if(numElements < 1) {
     return FAILED;
   }
 
-  if (!format) {
-    format = "%g";
-  };
-
-  /* calculate the size of the resulting string */
-  for(i=0; i<numElements; i++) {
-    textBuffer = buildString(format, vector[i]);
-    stringSize += (int) strlen(textBuffer);
-    free(textBuffer);
+  stringBufferInit(&stringVector);
+  if (!formatFloatVector(&stringVector, vector, numElements, format, document->useBase64Vectors)) {
+    stringBufferFree(&stringVector);
+    return FAILED;
   }
 
-  /* allocate memory */
-  stringVector = (char *) malloc(sizeof(char) * (stringSize + numElements + 1));
+  error = tixiUpdateTextElement(handle, path, stringVector.data);
+  stringBufferFree(&stringVector);
 
-  /* copy strings to stringVector */
-  stringVector[0] = '\0';
-  textBuffer = buildString(format, vector[0]);
-  strcat(stringVector, textBuffer);
-  free(textBuffer);
-  for(i=1; i<numElements; i++) {
-    textBuffer = buildString(format, vector[i]);
-    strcat(stringVector, VECTOR_SEPARATOR);
-    strcat(stringVector, textBuffer);
-    free(textBuffer);
+  /* the encoding attribute follows the written text */
+  if (error == SUCCESS && document->useBase64Vectors) {
+    error = tixiAddTextAttribute(handle, path, VECTOR_ENCODING_ATTRIBUTE, VECTOR_ENCODING_BASE64);
+  }
+  else if (error == SUCCESS && tixiCheckAttribute(handle, path, VECTOR_ENCODING_ATTRIBUTE) == SUCCESS) {
+    error = tixiRemoveAttribute(handle, path, VECTOR_ENCODING_ATTRIBUTE);
   }
 
-  error = tixiUpdateTextElement(handle, path, stringVector);
-  free(stringVector);
+  return error;
+}
 
+DLL_EXPORT ReturnCode tixiUpdateFloatVector (const TixiDocumentHandle handle, const char *path, const double *vector, const int numElements, const char* format)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiUpdateFloatVectorUnlocked(handle, path, vector, numElements, format);
+  unlockDocument(document);
   return error;
 }
 
 
 
-DLL_EXPORT ReturnCode tixiRemoveAttribute(const TixiDocumentHandle handle, const char *elementPath, const char *attributeName)
+static ReturnCode tixiRemoveAttributeUnlocked(const TixiDocumentHandle handle, const char *elementPath, const char *attributeName)
 {
   xmlNodePtr parent;
   int retVal = 0;
@@ -1623,7 +2545,11 @@ DLL_EXPORT ReturnCode tixiRemoveAttribute(const TixiDocumentHandle handle, const
   }
 
   extractPrefixAndName(attributeName, &prefix, &name);
+  uid_clearReferenceGraph(getDocument(handle));
   if (!prefix) {
+    if (!strcmp(attributeName, CPACS_UID_ATTRIBUTE_STRING)) {
+      uid_removeNodeUID(getDocument(handle), parent);
+    }
     retVal = xmlUnsetProp(parent, (xmlChar *) attributeName);
   }
   else {
@@ -1652,8 +2578,16 @@ DLL_EXPORT ReturnCode tixiRemoveAttribute(const TixiDocumentHandle handle, const
   }
 }
 
+DLL_EXPORT ReturnCode tixiRemoveAttribute(const TixiDocumentHandle handle, const char *elementPath, const char *attributeName)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiRemoveAttributeUnlocked(handle, elementPath, attributeName);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiRemoveElement(const TixiDocumentHandle handle, const char *elementPath)
+static ReturnCode tixiRemoveElementUnlocked(const TixiDocumentHandle handle, const char *elementPath)
 {
   xmlNodePtr parent = NULL;
   ReturnCode retVal;
@@ -1661,6 +2595,10 @@ DLL_EXPORT ReturnCode tixiRemoveElement(const TixiDocumentHandle handle, const c
   retVal = getNodePtrFromElementPath(handle, elementPath, &parent);
 
   if(parent != NULL) {
+    invalidateNodeCursors(getDocument(handle), parent);
+    invalidateChildIndexesOfSubtree(getDocument(handle), parent);
+    uid_removeSubtreeUIDs(getDocument(handle), parent);
+    uid_clearReferenceGraph(getDocument(handle));
     xmlUnlinkNode(parent);
     xmlFreeNode(parent);
     return SUCCESS;
@@ -1670,17 +2608,44 @@ DLL_EXPORT ReturnCode tixiRemoveElement(const TixiDocumentHandle handle, const c
   }
 }
 
+DLL_EXPORT ReturnCode tixiRemoveElement(const TixiDocumentHandle handle, const char *elementPath)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiRemoveElementUnlocked(handle, elementPath);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiGetNamedChildrenCount(const TixiDocumentHandle handle,
+/* true for unprefixed element names, which are counted with the child index */
+static int isIndexedChildName(const char *childName)
+{
+  const char *c = NULL;
+
+  if (!isalpha((unsigned char) childName[0]) && childName[0] != '_') {
+    return 0;
+  }
+  for (c = childName + 1; *c; ++c) {
+    if (!isalnum((unsigned char) *c) && *c != '_' && *c != '-' && *c != '.') {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static ReturnCode tixiGetNamedChildrenCountUnlocked(const TixiDocumentHandle handle,
                                                 const char *elementPath, const char *childName, int *count)
 {
   TixiDocument *document = getDocument(handle);
   xmlXPathObjectPtr xpathObject = NULL;
   xmlNodeSetPtr nodes = NULL;
+  xmlNodePtr parent = NULL;
+  xmlElementType parentType = XML_ELEMENT_NODE;
   char * prefix = NULL;
   char * childTagName = NULL;
 
   int iNode;
+  int nNodes = 0;
   char *childElementPath =
       (char *) malloc(sizeof(char) * (strlen(elementPath) + strlen(childName) + 2));
   char *allChildren = (char *) malloc(sizeof(char) * (strlen(elementPath) + 3));
@@ -1707,40 +2672,59 @@ DLL_EXPORT ReturnCode tixiGetNamedChildrenCount(const TixiDocumentHandle handle,
   *count = 0;
 
   /* first check parent */
-  xpathObject = xmlXPathEvalExpression((xmlChar *) elementPath, document->xpathContext);
+  nNodes = XPathResolveSimplePath(XPathGetContext(document), elementPath, &parent);
+  if (nNodes < 0) {
+    xpathObject = XPathEvaluate(XPathGetContext(document), elementPath);
+
+    if (!xpathObject) {
+      printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", elementPath);
+      free(childElementPath);
+      free(allChildren);
+      return INVALID_XPATH;
+    }
 
-  if (!xpathObject) {
-    printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", elementPath);
-    free(childElementPath);
-    free(allChildren);
-    return INVALID_XPATH;
+    nNodes = xmlXPathNodeSetGetLength(xpathObject->nodesetval);
+    if (nNodes > 0) {
+      parent = xmlXPathNodeSetItem(xpathObject->nodesetval, 0);
+      /* namespace nodes are copies owned by the node set */
+      parentType = parent->type;
+    }
+    xmlXPathFreeObject(xpathObject);
+  }
+  else if (nNodes > 0) {
+    parentType = parent->type;
   }
 
-  if (xmlXPathNodeSetIsEmpty(xpathObject->nodesetval)) {
-    xmlXPathFreeObject(xpathObject);
+  if (nNodes == 0) {
     free(childElementPath);
     free(allChildren);
     return ELEMENT_NOT_FOUND;
   }
 
-  nodes = xpathObject->nodesetval;
-  assert(nodes);
-
-  if (nodes->nodeNr > 1) {
+  if (nNodes > 1) {
     printMsg(MESSAGETYPE_ERROR,
              "Error: Element chosen by XPath \"%s\" expression is not unique. \n", elementPath);
     free(childElementPath);
     free(allChildren);
-    xmlXPathFreeObject(xpathObject);
     return ELEMENT_PATH_NOT_UNIQUE;
   }
 
-  xmlXPathFreeObject(xpathObject);
+  /* unprefixed names are counted with the child index of the parent */
+  if (parentType == XML_ELEMENT_NODE && isIndexedChildName(childName)) {
+    xmlNodePtr child = NULL;
+    int nChildren = getIndexedChild(document, parent, childName, strlen(childName), 0, &child);
+    if (nChildren >= 0) {
+      *count = nChildren;
+      free(childElementPath);
+      free(allChildren);
+      return SUCCESS;
+    }
+  }
 
   /* check if there are children at all */
 
 
-  xpathObject = xmlXPathEvalExpression((xmlChar *) allChildren, document->xpathContext);
+  xpathObject = XPathEvaluate(XPathGetContext(document), allChildren);
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", allChildren);
@@ -1764,7 +2748,7 @@ DLL_EXPORT ReturnCode tixiGetNamedChildrenCount(const TixiDocumentHandle handle,
 
   /* now check child */
 
-  xpathObject = xmlXPathEvalExpression((xmlChar *) childElementPath, document->xpathContext);
+  xpathObject = XPathEvaluate(XPathGetContext(document), childElementPath);
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", childElementPath);
@@ -1811,7 +2795,16 @@ DLL_EXPORT ReturnCode tixiGetNamedChildrenCount(const TixiDocumentHandle handle,
   return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiAddDoubleListWithAttributes(const TixiDocumentHandle handle,
+DLL_EXPORT ReturnCode tixiGetNamedChildrenCount(const TixiDocumentHandle handle,
+                                                const char *elementPath, const char *childName, int *count)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetNamedChildrenCountUnlocked(handle, elementPath, childName, count);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiAddDoubleListWithAttributesUnlocked(const TixiDocumentHandle handle,
                                                       const char *parentPath, const char *listName,
                                                       const char *childName,
                                                       const char *attributeName,
@@ -1850,36 +2843,32 @@ DLL_EXPORT ReturnCode tixiAddDoubleListWithAttributes(const TixiDocumentHandle h
     return INVALID_XML_NAME;
   }
 
-  if (!format) {
-    format = "%g";
-  }
-
-  error = checkElement(document->xpathContext, parentPath, &parent);
+  error = checkElement(XPathGetContext(document), parentPath, &parent);
   if (!error) {
 
     /* create node containing the list */
     xmlNodePtr listNode = xmlNewNode(nameSpace, (xmlChar *) listName);
+    TixiStringBuffer textBuffer;
 
+    stringBufferInit(&textBuffer);
     for (iValue = 0; iValue < nValues; iValue++) {
 
       xmlNodePtr child;
-      char *textBuffer = buildString(format, values[iValue]);
 
-      if (!textBuffer) {
+      stringBufferClear(&textBuffer);
+      if (!stringBufferAppendDouble(&textBuffer, format, values[iValue])) {
         printMsg(MESSAGETYPE_ERROR,
                  "Internal Error: Failed to allocate memory in tixiAddDoubleListWithAttributes.\n");
         exit(1);
       }
 
-      child = xmlNewTextChild(listNode, nameSpace, (xmlChar *) childName, (xmlChar *) textBuffer);
-
-      free(textBuffer);
-      textBuffer = NULL;
+      child = xmlNewTextChild(listNode, nameSpace, (xmlChar *) childName, (xmlChar *) textBuffer.data);
 
       if (!child) {
         printMsg(MESSAGETYPE_ERROR,
                  "Error:  Failed to add child #%d to list  element \"%s\".\n", iValue + 1, listName);
         xmlFreeNode(listNode);
+        stringBufferFree(&textBuffer);
         return FAILED;
       }
 
@@ -1888,11 +2877,15 @@ DLL_EXPORT ReturnCode tixiAddDoubleListWithAttributes(const TixiDocumentHandle h
                  "Error:  Failed to add attribute \"%s\" to element \"%s/%-s%-s\".\n",
                  attributeName, parentPath, listName, childName);
         xmlFreeNode(listNode);
+        stringBufferFree(&textBuffer);
         return FAILED;
       }
     }
+    stringBufferFree(&textBuffer);
 
 
+    invalidateChildIndex(document, parent);
+    uid_clearReferenceGraph(document);
     if (!xmlAddChild(parent, listNode)) {
       printMsg(MESSAGETYPE_ERROR,
                "Error:  Failed to add list element \"%s\" to parent \"%s\".\n",
@@ -1901,6 +2894,7 @@ DLL_EXPORT ReturnCode tixiAddDoubleListWithAttributes(const TixiDocumentHandle h
       return FAILED;
     }
     else {
+      uid_addSubtreeUIDs(document, listNode);
       return SUCCESS;
     }
   }
@@ -1909,7 +2903,20 @@ DLL_EXPORT ReturnCode tixiAddDoubleListWithAttributes(const TixiDocumentHandle h
   }
 }
 
-DLL_EXPORT ReturnCode tixiAddPoint(const TixiDocumentHandle handle, const char *parentPath,
+DLL_EXPORT ReturnCode tixiAddDoubleListWithAttributes(const TixiDocumentHandle handle,
+                                                      const char *parentPath, const char *listName,
+                                                      const char *childName,
+                                                      const char *attributeName,
+                                                      const double *values, const char *format,
+                                                      const char **attributes, int nValues)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddDoubleListWithAttributesUnlocked(handle, parentPath, listName, childName, attributeName, values, format, attributes, nValues);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiAddPointUnlocked(const TixiDocumentHandle handle, const char *parentPath,
                                    double x, double y, double z, const char *format)
 {
   ReturnCode error = -1;
@@ -1930,7 +2937,7 @@ DLL_EXPORT ReturnCode tixiAddPoint(const TixiDocumentHandle handle, const char *
     format = "%g";
   }
 
-  error = checkElement(document->xpathContext, parentPath, &parent);
+  error = checkElement(XPathGetContext(document), parentPath, &parent);
 
   if (!error) {
 
@@ -1938,67 +2945,34 @@ DLL_EXPORT ReturnCode tixiAddPoint(const TixiDocumentHandle handle, const char *
 
     xmlNodePtr pointNode = parent;
     xmlNodePtr child = NULL;
+    const char *names[3] = {"x", "y", "z"};
+    double coordinates[3];
+    TixiStringBuffer textBuffer;
+    int i;
+
+    invalidateChildIndex(document, pointNode);
+
+    coordinates[0] = x;
+    coordinates[1] = y;
+    coordinates[2] = z;
+
+    stringBufferInit(&textBuffer);
+    for (i = 0; i < 3; i++) {
+      stringBufferClear(&textBuffer);
+      if (!stringBufferAppendDouble(&textBuffer, format, coordinates[i])) {
+        printMsg(MESSAGETYPE_ERROR, "Internal Error: Failed to allocate memory in tixiAddPoint.\n");
+        exit(1);
+      }
 
-    /* add x coordinate */
-    char *textBuffer = buildString(format, x);
-
-    if (textBuffer) {
-
-      child = xmlNewTextChild(pointNode, nameSpace, (xmlChar *) "x", (xmlChar *) textBuffer);
-      free(textBuffer);
-      textBuffer = NULL;
-
+      child = xmlNewTextChild(pointNode, nameSpace, (xmlChar *) names[i], (xmlChar *) textBuffer.data);
       if (!child) {
-        printMsg(MESSAGETYPE_ERROR, "Error:  Failed to add %1s coordinate to point element.\n", "x");
+        printMsg(MESSAGETYPE_ERROR, "Error:  Failed to add %1s coordinate to point element.\n", names[i]);
         xmlFreeNode(pointNode);
+        stringBufferFree(&textBuffer);
         return FAILED;
       }
     }
-    else {
-      printMsg(MESSAGETYPE_ERROR, "Internal Error: Failed to allocate memory in tixiAddPoint.\n");
-      exit(1);
-    }
-
-    /* add y coordinate */
-    textBuffer = buildString(format, y);
-
-    if (textBuffer) {
-
-      child = xmlNewTextChild(pointNode, nameSpace, (xmlChar *) "y", (xmlChar *) textBuffer);
-      free(textBuffer);
-      textBuffer = NULL;
-
-      if (!child) {
-        printMsg(MESSAGETYPE_ERROR, "Error:  Failed to add %1s coordinate to point element.\n", "y");
-        xmlFreeNode(pointNode);
-        return FAILED;
-      }
-    }
-    else {
-      printMsg(MESSAGETYPE_ERROR, "Internal Error: Failed to allocate memory in tixiAddPoint.\n");
-      exit(1);
-    }
-
-
-    /* add z coorinate */
-    textBuffer = buildString(format, z);
-
-    if (textBuffer) {
-
-      child = xmlNewTextChild(pointNode, nameSpace, (xmlChar *) "z", (xmlChar *) textBuffer);
-      free(textBuffer);
-      textBuffer = NULL;
-
-      if (!child) {
-        printMsg(MESSAGETYPE_ERROR, "Error:  Failed to add %1s coordinate to point element.\n", "z");
-        xmlFreeNode(pointNode);
-        return FAILED;
-      }
-    }
-    else {
-      printMsg(MESSAGETYPE_ERROR, "Internal Error: Failed to allocate memory in tixiAddPoint.\n");
-      exit(1);
-    }
+    stringBufferFree(&textBuffer);
   }
   else {
     return error;
@@ -2006,8 +2980,17 @@ DLL_EXPORT ReturnCode tixiAddPoint(const TixiDocumentHandle handle, const char *
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiAddPoint(const TixiDocumentHandle handle, const char *parentPath,
+                                   double x, double y, double z, const char *format)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddPointUnlocked(handle, parentPath, x, y, z, format);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiGetPoint(const TixiDocumentHandle handle, const char *parentPath,
+static ReturnCode tixiGetPointUnlocked(const TixiDocumentHandle handle, const char *parentPath,
                                    double *x, double *y, double *z)
 {
   int ignoreMissingElement = 1;
@@ -2020,7 +3003,16 @@ DLL_EXPORT ReturnCode tixiGetPoint(const TixiDocumentHandle handle, const char *
   return error;
 }
 
-DLL_EXPORT ReturnCode tixiAddExternalLink(const TixiDocumentHandle handle, const char *parentPath,
+DLL_EXPORT ReturnCode tixiGetPoint(const TixiDocumentHandle handle, const char *parentPath,
+                                   double *x, double *y, double *z)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetPointUnlocked(handle, parentPath, x, y, z);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiAddExternalLinkUnlocked(const TixiDocumentHandle handle, const char *parentPath,
                                           const char *url, const char *fileFormat)
 {
   ReturnCode error = tixiAddTextElement(handle, parentPath, "externalFile", url);
@@ -2049,8 +3041,17 @@ DLL_EXPORT ReturnCode tixiAddExternalLink(const TixiDocumentHandle handle, const
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiAddExternalLink(const TixiDocumentHandle handle, const char *parentPath,
+                                          const char *url, const char *fileFormat)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiAddExternalLinkUnlocked(handle, parentPath, url, fileFormat);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiUsePrettyPrint(TixiDocumentHandle handle, int usePrettyPrint)
+static ReturnCode tixiUsePrettyPrintUnlocked(TixiDocumentHandle handle, int usePrettyPrint)
 {
   TixiDocument *document = getDocument(handle);
 
@@ -2067,6 +3068,116 @@ DLL_EXPORT ReturnCode tixiUsePrettyPrint(TixiDocumentHandle handle, int usePrett
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiUsePrettyPrint(TixiDocumentHandle handle, int usePrettyPrint)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiUsePrettyPrintUnlocked(handle, usePrettyPrint);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiUseBase64VectorsUnlocked(TixiDocumentHandle handle, int useBase64Vectors)
+{
+  TixiDocument *document = getDocument(handle);
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  if ((useBase64Vectors > 1) || (useBase64Vectors < 0)) {
+    return FAILED;
+  }
+
+  document->useBase64Vectors = useBase64Vectors;
+  return SUCCESS;
+}
+
+DLL_EXPORT ReturnCode tixiUseBase64Vectors(TixiDocumentHandle handle, int useBase64Vectors)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiUseBase64VectorsUnlocked(handle, useBase64Vectors);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiMemoryCheckpointUnlocked(TixiDocumentHandle handle, int* mark)
+{
+  TixiDocument *document = getDocument(handle);
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  if (!mark) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null pointer argument for mark in tixiMemoryCheckpoint.\n");
+    return FAILED;
+  }
+
+  return checkpointDocumentMemory(document, mark);
+}
+
+DLL_EXPORT ReturnCode tixiMemoryCheckpoint(TixiDocumentHandle handle, int* mark)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiMemoryCheckpointUnlocked(handle, mark);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiMemoryReleaseToUnlocked(TixiDocumentHandle handle, int mark)
+{
+  TixiDocument *document = getDocument(handle);
+  ReturnCode error = SUCCESS;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = releaseDocumentMemoryTo(document, mark);
+  if (error == INDEX_OUT_OF_RANGE) {
+    printMsg(MESSAGETYPE_ERROR, "Error: %d is not a valid memory checkpoint.\n", mark);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiMemoryReleaseTo(TixiDocumentHandle handle, int mark)
+{
+  /* exclusive, getters running in parallel must not see their memory released */
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiMemoryReleaseToUnlocked(handle, mark);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiGetRetainedMemoryUnlocked(TixiDocumentHandle handle, size_t* bytes, size_t* entries)
+{
+  TixiDocument *document = getDocument(handle);
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  if (!bytes || !entries) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null pointer argument in tixiGetRetainedMemory.\n");
+    return FAILED;
+  }
+
+  getDocumentMemoryUsage(document, bytes, entries);
+  return SUCCESS;
+}
+
+DLL_EXPORT ReturnCode tixiGetRetainedMemory(TixiDocumentHandle handle, size_t* bytes, size_t* entries)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetRetainedMemoryUnlocked(handle, bytes, entries);
+  unlockDocument(document);
+  return error;
+}
+
 DLL_EXPORT ReturnCode tixiSetPrintMsgFunc(TixiPrintMsgFnc func)
 {
   tixiInit();
@@ -2087,45 +3198,133 @@ DLL_EXPORT TixiPrintMsgFnc tixiGetPrintMsgFunc()
 }
 
 
-DLL_EXPORT ReturnCode tixiGetVectorSize (const TixiDocumentHandle handle, const char *vectorPath, int *nElements)
+/* finds a vector element (mapType="vector") */
+static ReturnCode getVectorElement(TixiDocument *document, const char *vectorPath, xmlNodePtr *element)
+{
+  xmlChar *mapType = NULL;
+  ReturnCode error = SUCCESS;
+
+  error = checkElement(XPathGetContext(document), vectorPath, element);
+  if (error) {
+    return error;
+  }
+
+  mapType = xmlGetProp(*element, (xmlChar *) MAPTYPE_IDENTIFIER);
+  if (!mapType) {
+    return ATTRIBUTE_NOT_FOUND;
+  }
+  if (xmlStrcasecmp(mapType, (xmlChar *) VECTOR_ATTRIBUTE_NAME)) {   /* if not of type "vector": */
+    xmlFree(mapType);
+    return ELEMENT_NOT_FOUND;
+  }
+  xmlFree(mapType);
+  return SUCCESS;
+}
+
+/* reads the values of a vector or array element into values, which may be NULL to only count them */
+static ReturnCode readVectorInto(TixiDocument *document, xmlNodePtr element, double *values, int capacity, int *nElements)
+{
+  int count = readVectorNodeValues(document->docPtr, element, values, capacity);
+
+  if (count < 0) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid base64 data in element \"%s\".\n", (const char *) element->name);
+    return FAILED;
+  }
+  if (!values) {
+    capacity = 0;
+  }
+  if (nElements) {
+    *nElements = count;
+  }
+  return count <= capacity ? SUCCESS : STRING_TRUNCATED;
+}
+
+static ReturnCode tixiGetVectorSizeUnlocked (const TixiDocumentHandle handle, const char *vectorPath, int *nElements)
 {
+  TixiDocument *document = getDocument(handle);
   ReturnCode error = FAILED;
-  char *tmpString = NULL;
-  char *token = NULL;
+  xmlNodePtr element = NULL;
   *nElements = 0;
 
-  error = tixiGetTextAttribute(handle, vectorPath, MAPTYPE_IDENTIFIER, &tmpString);
-  if (error != SUCCESS) {
-    return error;
-  } else {
-    tmpString = stringToLower(tmpString);   /* side effect: changes original string anyway */
-    if ((strcmp(tmpString, VECTOR_ATTRIBUTE_NAME))) {   /* if not of type "vector": */
-      return ELEMENT_NOT_FOUND;
-    }
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
   }
 
-  error = tixiGetTextElement(handle, vectorPath, &tmpString);
+  error = getVectorElement(document, vectorPath, &element);
   if(error != SUCCESS) {
     return error;
   }
 
-  token = strtok(tmpString, VECTOR_SEPARATOR);
-  while(token != NULL) {
-    *nElements = *nElements + 1;
-    token = strtok(0, VECTOR_SEPARATOR);
+  error = readVectorInto(document, element, NULL, 0, nElements);
+  return error == STRING_TRUNCATED ? SUCCESS : error;
+}
+
+DLL_EXPORT ReturnCode tixiGetVectorSize (const TixiDocumentHandle handle, const char *vectorPath, int *nElements)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetVectorSizeUnlocked(handle, vectorPath, nElements);
+  unlockDocument(document);
+  return error;
+}
+
+/* returns the descriptor of the array at arrayPath, NULL if arrayPath does not
+   point to exactly one element, which is then handled by the XPath based code */
+static TixiArrayDescriptor* findArrayDescriptor(TixiDocument *document, const char *arrayPath)
+{
+  xmlXPathContextPtr xpathContext = XPathGetContext(document);
+  xmlNodePtr element = NULL;
+  int nNodes = XPathResolveSimplePath(xpathContext, arrayPath, &element);
+
+  if (nNodes < 0) {
+    xmlXPathObjectPtr xpathObject = XPathEvaluate(xpathContext, arrayPath);
+    nNodes = xpathObject ? xmlXPathNodeSetGetLength(xpathObject->nodesetval) : 0;
+    if (nNodes == 1) {
+      element = xmlXPathNodeSetItem(xpathObject->nodesetval, 0);
+    }
+    xmlXPathFreeObject(xpathObject);
+  }
+  if (nNodes != 1 || element->type != XML_ELEMENT_NODE) {
+    return NULL;
+  }
+  return array_getDescriptor(document, element);
+}
+
+/* returns the index of the parameter elementName in the descriptor, -1 if elementName
+   is no plain element name or no parameter, which is then handled by the XPath based code */
+static int findArrayParameter(const TixiArrayDescriptor *descriptor, const char *elementName)
+{
+  xmlNodePtr child = NULL;
+
+  if (xmlValidateNCName((const xmlChar *) elementName, 0) != 0) {
+    return -1;
   }
-  return SUCCESS;
+  for (child = descriptor->element->children; child; child = child->next) {
+    if (child->type == XML_ELEMENT_NODE && !child->ns && strcmp((const char *) child->name, elementName) == 0) {
+      return array_findParameter(descriptor, child);
+    }
+  }
+  return -1;
 }
 
-DLL_EXPORT ReturnCode tixiGetArrayDimensions (const TixiDocumentHandle handle,
+static ReturnCode tixiGetArrayDimensionsUnlocked (const TixiDocumentHandle handle,
                                               const char *arrayPath, int *dimensions)
 {
 
   return tixiGetArrayElementCount(handle, arrayPath, "vector", dimensions);
 }
 
+DLL_EXPORT ReturnCode tixiGetArrayDimensions (const TixiDocumentHandle handle,
+                                              const char *arrayPath, int *dimensions)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetArrayDimensionsUnlocked(handle, arrayPath, dimensions);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiGetArrayDimensionNames (const TixiDocumentHandle handle,
+static ReturnCode tixiGetArrayDimensionNamesUnlocked (const TixiDocumentHandle handle,
                                                   const char *arrayPath,
                                                   char **dimensionNames)
 {
@@ -2133,8 +3332,18 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensionNames (const TixiDocumentHandle handl
   return tixiGetArrayElementNames(handle, arrayPath, "vector", dimensionNames);
 }
 
+DLL_EXPORT ReturnCode tixiGetArrayDimensionNames (const TixiDocumentHandle handle,
+                                                  const char *arrayPath,
+                                                  char **dimensionNames)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetArrayDimensionNamesUnlocked(handle, arrayPath, dimensionNames);
+  unlockDocument(document);
+  return error;
+}
 
-DLL_EXPORT ReturnCode tixiGetArrayDimensionSizes (const TixiDocumentHandle handle, const char *arrayPath,
+
+static ReturnCode tixiGetArrayDimensionSizesUnlocked (const TixiDocumentHandle handle, const char *arrayPath,
                                                   int *sizes, int *arraySizes)
 {
   TixiDocument *document = getDocument(handle);
@@ -2143,11 +3352,9 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensionSizes (const TixiDocumentHandle handl
   xmlNodePtr node = NULL;
   char *suffix = "/*[@mapType=\"vector\"]";    /* find all vectors tag in subelements of the given path */
   char *xpathSubElementsName = (char *) malloc((strlen(arrayPath) + strlen(suffix) + 1) * sizeof(char));
-  char *tmpContent = NULL;
-  char *tmpContCpy = NULL;
-  char *token = NULL;
   int dimensions = 0;
   int dim = 0;
+  TixiArrayDescriptor *descriptor = NULL;
 
 
 
@@ -2161,7 +3368,28 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensionSizes (const TixiDocumentHandle handl
   strcpy(xpathSubElementsName, arrayPath);
   strcat(xpathSubElementsName, suffix);    /* meaning: find all vector sub elements */
 
-  xpathObject = xmlXPathEvalExpression((xmlChar *) xpathSubElementsName, document->xpathContext);
+  descriptor = findArrayDescriptor(document, arrayPath);
+  if (descriptor) {
+    if (descriptor->nDimensions == 0) {
+      printMsg(MESSAGETYPE_ERROR, "Error: No element found at XPath expression \"%s\"\n", xpathSubElementsName);
+      free(xpathSubElementsName);
+      return ELEMENT_NOT_FOUND;
+    }
+    *arraySizes = 1;    /* prepare product calculation */
+    for (dim = 0; dim < descriptor->nDimensions; dim ++) {
+      if (descriptor->dimensionSizes[dim] < 0) {
+        printMsg(MESSAGETYPE_ERROR, "Error: No string content in vector subelement at XPath expression \"%s\"\n", xpathSubElementsName);
+        free(xpathSubElementsName);
+        return ELEMENT_NOT_FOUND;
+      }
+      sizes[dim] = descriptor->dimensionSizes[dim];
+      *arraySizes *= sizes[dim];
+    }
+    free(xpathSubElementsName);
+    return SUCCESS;
+  }
+
+  xpathObject = XPathEvaluate(XPathGetContext(document), xpathSubElementsName);
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", xpathSubElementsName);
@@ -2191,26 +3419,11 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensionSizes (const TixiDocumentHandle handl
       xmlXPathFreeObject(xpathObject);
       return ELEMENT_NOT_FOUND;
     }
-    node = node->children;    /* get children, because there must be a node containing the string value */
-    assert(node);
-    tmpContent = (char *) xmlNodeListGetString(document->docPtr, node, 0);
-    if (tmpContent) {
-      tmpContCpy = (char *) malloc((strlen(tmpContent) + 1) * sizeof(char));
-      tmpContCpy[0] = '\0';
-      strcpy(tmpContCpy, tmpContent);
-    } else {
-      tmpContCpy = (char *) malloc(sizeof(char));
-      tmpContCpy[0] = '\0';
-    }
-    xmlFree(tmpContent);
-    /* tokenize string into distinct elements to count */
-    sizes[dim] = 0;    /* reset before increasing for each token */
-    token = strtok(tmpContCpy, VECTOR_SEPARATOR);
-    while (token != NULL) {
-      sizes[dim] ++;  /* count no. of values in dimension */
-      token = strtok(0, VECTOR_SEPARATOR);
-    }
-    free(tmpContCpy);
+    if (readVectorInto(document, node, NULL, 0, &sizes[dim]) == FAILED) {  /* count no. of values in dimension */
+      free(xpathSubElementsName);
+      xmlXPathFreeObject(xpathObject);
+      return FAILED;
+    }
     *arraySizes *= sizes[dim];    /* calculate product */
   }
   free(xpathSubElementsName);
@@ -2218,8 +3431,17 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensionSizes (const TixiDocumentHandle handl
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiGetArrayDimensionSizes (const TixiDocumentHandle handle, const char *arrayPath,
+                                                  int *sizes, int *arraySizes)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetArrayDimensionSizesUnlocked(handle, arrayPath, sizes, arraySizes);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiGetArrayDimensionValues (const TixiDocumentHandle handle, const char *arrayPath,
+static ReturnCode tixiGetArrayDimensionValuesUnlocked (const TixiDocumentHandle handle, const char *arrayPath,
                                                    const int dimension, double *dimensionValues)
 {
   TixiDocument *document = getDocument(handle);
@@ -2228,11 +3450,9 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensionValues (const TixiDocumentHandle hand
   xmlNodePtr node = NULL;
   const char *suffix = "/*[@mapType=\"vector\"]";
   char *xpathSubElementsName = (char *) malloc((strlen(arrayPath) + strlen(suffix)) * sizeof(char) + 4);
-  char *tmpContent = NULL;    /* reference copy */
-  char *tmpContCpy = NULL;    /* tokenizer */
-  char *token = NULL;
+  ReturnCode error = SUCCESS;
   int dimensions = 0;
-  int count = 0;
+  TixiArrayDescriptor *descriptor = NULL;
 
 
 
@@ -2246,7 +3466,26 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensionValues (const TixiDocumentHandle hand
   strcpy(xpathSubElementsName, arrayPath);
   strcat(xpathSubElementsName, suffix);    /* meaning: find all vector sub elements */
 
-  xpathObject = xmlXPathEvalExpression((xmlChar *) xpathSubElementsName, document->xpathContext);
+  descriptor = findArrayDescriptor(document, arrayPath);
+  if (descriptor) {
+    if (descriptor->nDimensions == 0) {
+      printMsg(MESSAGETYPE_ERROR, "Error: No element found at XPath expression \"%s\"\n", xpathSubElementsName);
+      free(xpathSubElementsName);
+      return ELEMENT_NOT_FOUND;
+    }
+    if (descriptor->nDimensions <= dimension || dimension < 0) {    /* check if there are enough elements to read from */
+      printMsg(MESSAGETYPE_ERROR, "Error: Not enough dimensions found for array \"%s\"\n", xpathSubElementsName);
+      free(xpathSubElementsName);
+      return ELEMENT_NOT_FOUND;
+    }
+    if (descriptor->dimensionSizes[dimension] > 0) {
+      memcpy(dimensionValues, descriptor->dimensionValues[dimension], descriptor->dimensionSizes[dimension] * sizeof(double));
+    }
+    free(xpathSubElementsName);
+    return SUCCESS;
+  }
+
+  xpathObject = XPathEvaluate(XPathGetContext(document), xpathSubElementsName);
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", xpathSubElementsName);
@@ -2276,42 +3515,45 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensionValues (const TixiDocumentHandle hand
 
   node = nodes->nodeTab[dimension];
   assert(node);
-  node = node->children;    /* get children, because there must be a node containing the string value */
-  assert(node);
-  tmpContent = (char *) xmlNodeListGetString(document->docPtr, node, 0);
-  if (tmpContent) {
-    tmpContCpy = (char *) malloc((strlen(tmpContent) + 1) * sizeof(char));
-    tmpContCpy[0] = '\0';
-    strcpy(tmpContCpy, tmpContent);
-  } else {
-    tmpContCpy = (char *) malloc(sizeof(char));
-    tmpContCpy[0] = '\0';
-  }
-  /* tokenize string into distinct elements to count */
-  token = strtok(tmpContCpy, VECTOR_SEPARATOR);
-  while (token != NULL) {
-    dimensionValues[count ++]= atof(token);
-    token = strtok(0, VECTOR_SEPARATOR);
+  /* parse the values in place, the size was determined by tixiGetArrayDimensionSizes */
+  if (readVectorInto(document, node, dimensionValues, INT_MAX, NULL) == FAILED) {
+    error = FAILED;
   }
-  free(tmpContCpy);
-  xmlFree(tmpContent);
 
   /* clean up */
   free(xpathSubElementsName);
   xmlXPathFreeObject(xpathObject);
-  return SUCCESS;
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiGetArrayDimensionValues (const TixiDocumentHandle handle, const char *arrayPath,
+                                                   const int dimension, double *dimensionValues)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetArrayDimensionValuesUnlocked(handle, arrayPath, dimension, dimensionValues);
+  unlockDocument(document);
+  return error;
 }
 
 
-DLL_EXPORT ReturnCode tixiGetArrayParameters (const TixiDocumentHandle handle,
+static ReturnCode tixiGetArrayParametersUnlocked (const TixiDocumentHandle handle,
                                               const char *arrayPath, int *parameters)
 {
 
   return tixiGetArrayElementCount(handle, arrayPath, "array", parameters);
 }
 
+DLL_EXPORT ReturnCode tixiGetArrayParameters (const TixiDocumentHandle handle,
+                                              const char *arrayPath, int *parameters)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetArrayParametersUnlocked(handle, arrayPath, parameters);
+  unlockDocument(document);
+  return error;
+}
 
-DLL_EXPORT ReturnCode tixiGetArrayParameterNames (const TixiDocumentHandle handle,
+
+static ReturnCode tixiGetArrayParameterNamesUnlocked (const TixiDocumentHandle handle,
                                                   const char *arrayPath,
                                                   char **parameterNames)
 {
@@ -2319,36 +3561,35 @@ DLL_EXPORT ReturnCode tixiGetArrayParameterNames (const TixiDocumentHandle handl
   return tixiGetArrayElementNames(handle, arrayPath, "array", parameterNames);
 }
 
+DLL_EXPORT ReturnCode tixiGetArrayParameterNames (const TixiDocumentHandle handle,
+                                                  const char *arrayPath,
+                                                  char **parameterNames)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetArrayParameterNamesUnlocked(handle, arrayPath, parameterNames);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiGetArray (const TixiDocumentHandle handle, const char *arrayPath,
-                                    const char *elementName, int arraySize, double **pValues)
+/* finds the element of an array (mapType="array") */
+static ReturnCode getArrayElement(TixiDocument *document, const char *arrayPath, const char *elementName,
+                                  xmlNodePtr *element)
 {
-  TixiDocument *document = getDocument(handle);
   xmlXPathObjectPtr xpathObject = NULL;
-  xmlNodeSetPtr nodes = NULL;
   xmlNodePtr node = NULL;
-  char *xpathSubElementsName = (char *) malloc((strlen(arrayPath) + strlen("/") + strlen(elementName)) * sizeof(char) + 1);
+  char *xpathSubElementsName = NULL;
   char *attributeName = NULL;
-  char *tmpContent = NULL;    /* reference copy */
-  char *tmpContCpy = NULL;    /* tokenizer */
-  char *token = NULL;
-  double * tmpArray = NULL;
-  int count = 0;
-
+  ReturnCode error = SUCCESS;
 
-  if (!document) {
-    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
-    free(xpathSubElementsName);
-    return INVALID_HANDLE;
-  }
 
   /* build xpath to the subelement requested */
-  xpathSubElementsName[0] = '\0';
-  strcpy(xpathSubElementsName, arrayPath);
-  strcat(xpathSubElementsName, "/");
-  strcat(xpathSubElementsName, elementName);
+  xpathSubElementsName = buildString("%s/%s", arrayPath, elementName);
+  if (!xpathSubElementsName) {
+    return FAILED;
+  }
 
-  xpathObject = xmlXPathEvalExpression((xmlChar *) xpathSubElementsName, document->xpathContext);
+  xpathObject = XPathEvaluate(XPathGetContext(document), xpathSubElementsName);
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", xpathSubElementsName);
@@ -2363,87 +3604,302 @@ DLL_EXPORT ReturnCode tixiGetArray (const TixiDocumentHandle handle, const char
     return ELEMENT_NOT_FOUND;
   }
 
-  nodes = xpathObject->nodesetval;
-  assert(nodes);
-
-  node = nodes->nodeTab[0];
+  node = xpathObject->nodesetval->nodeTab[0];
   assert(node);
 
   /* check if the element has the correct attribute and value */
   attributeName = (char *) xmlGetProp(node, (xmlChar *) "mapType");
 
-  if (attributeName) {
-    if (strcmp(attributeName, "array") != 0) {
-      printMsg(MESSAGETYPE_ERROR,
-               "Error: The given sub element is not of mapType= \"array\" in \"%s\": %s \n",
-               xpathSubElementsName,
-               attributeName);
-      free(xpathSubElementsName);
-      xmlFree(attributeName);
-      xmlXPathFreeObject(xpathObject);
-      return ATTRIBUTE_NOT_FOUND;
-    }
-  } else {
+  if (!attributeName) {
     printMsg(MESSAGETYPE_ERROR,
              "Error: The given sub element has no attribute mapType in \"%s\". \n",
              xpathSubElementsName);
-    free(xpathSubElementsName);
-    xmlXPathFreeObject(xpathObject);
-    return ATTRIBUTE_NOT_FOUND;
+    error = ATTRIBUTE_NOT_FOUND;
   }
-
-  node = node->children;    /* get children, because there must be a node containing the string value */
-  if(!(node)) {
+  else if (strcmp(attributeName, "array") != 0) {
+    printMsg(MESSAGETYPE_ERROR,
+             "Error: The given sub element is not of mapType= \"array\" in \"%s\": %s \n",
+             xpathSubElementsName,
+             attributeName);
+    error = ATTRIBUTE_NOT_FOUND;
+  }
+  else if (!node->children) {    /* there must be a node containing the string value */
     printMsg(MESSAGETYPE_ERROR,
              "Error: The given sub element has no children in \"%s\". \n",
              xpathSubElementsName);
-    free(xpathSubElementsName);
-    xmlFree(attributeName);
-    xmlXPathFreeObject(xpathObject);
-    return ATTRIBUTE_NOT_FOUND;
-  }
-  assert(node);
-  tmpContent = (char *) xmlNodeListGetString(document->docPtr, node, 0);
-  if (tmpContent) {
-    tmpContCpy = (char *) malloc((strlen(tmpContent) + 1) * sizeof(char));
-    tmpContCpy[0] = '\0';
-    strcpy(tmpContCpy, tmpContent);
-    xmlFree(tmpContent);
-  } else {
-    tmpContCpy = (char *) malloc(sizeof(char));
-    tmpContCpy[0] = '\0';
+    error = ATTRIBUTE_NOT_FOUND;
   }
-
-  /* allocate memory for array */
-  tmpArray = (double *) malloc(sizeof(double) * arraySize);
-
-  /* tokenize string into distinct elements to separate values */
-  token = strtok(tmpContCpy, VECTOR_SEPARATOR);
-  while (token != NULL && count < arraySize) {
-    tmpArray[count ++] = atof(token);
-    token = strtok(0, VECTOR_SEPARATOR);
+  else {
+    *element = node;
   }
-  free(tmpContCpy);
 
   /* clean up */
   free(xpathSubElementsName);
   xmlFree(attributeName);
   xmlXPathFreeObject(xpathObject);
+  return error;
+}
+
+static ReturnCode tixiGetArrayUnlocked (const TixiDocumentHandle handle, const char *arrayPath,
+                                    const char *elementName, int arraySize, double **pValues)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
+  double * tmpArray = NULL;
+  int count = 0;
+  ReturnCode error = SUCCESS;
+  TixiArrayDescriptor *descriptor = NULL;
+  int iParameter = -1;
+
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  descriptor = findArrayDescriptor(document, arrayPath);
+  iParameter = descriptor ? findArrayParameter(descriptor, elementName) : -1;
+  if (iParameter >= 0) {
+    const double *values = NULL;
+
+    count = descriptor->parameterSizes[iParameter];
+    if (count < 0) {
+      printMsg(MESSAGETYPE_ERROR,
+               "Error: The given sub element has no children in \"%s/%s\". \n",
+               arrayPath, elementName);
+      return ATTRIBUTE_NOT_FOUND;
+    }
+    if (count != arraySize) {
+      printMsg(MESSAGETYPE_ERROR,
+               "Error: the number of elements of array \"%s\" does not match the specified size of %d (should be %d)!\n",
+               elementName, arraySize, count);
+      return NON_MATCHING_SIZE;
+    }
+    values = array_getParameterValues(document, descriptor, iParameter);
+    tmpArray = (double *) allocateDocumentMemory(document, sizeof(double) * arraySize);
+    if (!values || !tmpArray) {
+      return FAILED;
+    }
+    memcpy(tmpArray, values, sizeof(double) * arraySize);
+    *pValues = tmpArray;
+    return SUCCESS;
+  }
+
+  error = getArrayElement(document, arrayPath, elementName, &element);
+  if (error) {
+    return error;
+  }
+
+  /* allocate memory for array */
+  tmpArray = (double *) allocateDocumentMemory(document, sizeof(double) * arraySize);
+  if (!tmpArray) {
+    return FAILED;
+  }
+
+  /* parse the values in place */
+  if (readVectorInto(document, element, tmpArray, arraySize, &count) == FAILED) {
+    return FAILED;
+  }
 
   //check if number of entries is the same as arraySize
-  if(count != arraySize || token != NULL){
+  if(count != arraySize){
     printMsg(MESSAGETYPE_ERROR,
              "Error: the number of elements of array \"%s\" does not match the specified size of %d (should be %d)!\n",
              elementName, arraySize, count);
-    free(tmpArray);
     return NON_MATCHING_SIZE;
   }
 
-  addToMemoryList(document, tmpArray);
   *pValues = tmpArray;
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiGetArray (const TixiDocumentHandle handle, const char *arrayPath,
+                                    const char *elementName, int arraySize, double **pValues)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetArrayUnlocked(handle, arrayPath, elementName, arraySize, pValues);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiGetArrayIntoUnlocked (const TixiDocumentHandle handle, const char *arrayPath,
+                                            const char *elementName, double *values, int capacity, int *arraySize)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
+  ReturnCode error = SUCCESS;
+  TixiArrayDescriptor *descriptor = NULL;
+  int iParameter = -1;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  descriptor = findArrayDescriptor(document, arrayPath);
+  iParameter = descriptor ? findArrayParameter(descriptor, elementName) : -1;
+  if (iParameter >= 0 && descriptor->parameterSizes[iParameter] >= 0) {
+    int count = descriptor->parameterSizes[iParameter];
+
+    if (arraySize) {
+      *arraySize = count;
+    }
+    if (!values) {
+      capacity = 0;
+    }
+    if (capacity > 0 && count > 0) {
+      const double *parameterValues = array_getParameterValues(document, descriptor, iParameter);
+      if (!parameterValues) {
+        return FAILED;
+      }
+      memcpy(values, parameterValues, (count < capacity ? count : capacity) * sizeof(double));
+    }
+    return count <= capacity ? SUCCESS : STRING_TRUNCATED;
+  }
+
+  error = getArrayElement(document, arrayPath, elementName, &element);
+  if (!error) {
+    error = readVectorInto(document, element, values, capacity, arraySize);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiGetArrayInto (const TixiDocumentHandle handle, const char *arrayPath,
+                                        const char *elementName, double *values, int capacity, int *arraySize)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetArrayIntoUnlocked(handle, arrayPath, elementName, values, capacity, arraySize);
+  unlockDocument(document);
+  return error;
+}
+
+/* copies the names of the elements into an array owned by the document */
+static char** copyElementNamesToDocument(TixiDocument *document, xmlNodePtr *elements, int nElements)
+{
+  char **names = NULL;
+  int i;
+
+  if (nElements == 0) {
+    return NULL;
+  }
+  names = (char **) allocateDocumentMemory(document, nElements * sizeof(char *));
+  for (i = 0; names && i < nElements; ++i) {
+    names[i] = copyStringToDocument(document, (const char *) elements[i]->name);
+    if (!names[i]) {
+      return NULL;
+    }
+  }
+  return names;
+}
+
+static ReturnCode tixiGetArrayDescriptorUnlocked (const TixiDocumentHandle handle, const char *arrayPath,
+                                                  int *nDimensions, char ***dimensionNames, int **dimensionSizes,
+                                                  double **dimensionValues, int *nParameters, char ***parameterNames,
+                                                  double **parameterValues, int *arraySize)
+{
+  TixiDocument *document = getDocument(handle);
+  TixiArrayDescriptor *descriptor = NULL;
+  xmlNodePtr element = NULL;
+  ReturnCode error = SUCCESS;
+  int nValues = 0;
+  int i;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  if (!arrayPath || !nDimensions || !dimensionNames || !dimensionSizes || !dimensionValues
+      || !nParameters || !parameterNames || !arraySize) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null pointer argument in tixiGetArrayDescriptor.\n");
+    return FAILED;
+  }
+
+  error = checkElement(XPathGetContext(document), arrayPath, &element);
+  if (error) {
+    return error;
+  }
+  descriptor = array_getDescriptor(document, element);
+  if (!descriptor) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Failed to read the array \"%s\".\n", arrayPath);
+    return FAILED;
+  }
+
+  if (descriptor->nDimensions == 0) {
+    printMsg(MESSAGETYPE_ERROR, "Error: The array \"%s\" has no elements with mapType=\"vector\".\n", arrayPath);
+    return ELEMENT_NOT_FOUND;
+  }
+  for (i = 0; i < descriptor->nDimensions; ++i) {
+    if (descriptor->dimensionSizes[i] < 0) {
+      printMsg(MESSAGETYPE_ERROR, "Error: No string content in vector \"%s\" of array \"%s\".\n",
+               (const char *) descriptor->dimensions[i]->name, arrayPath);
+      return ELEMENT_NOT_FOUND;
+    }
+    nValues += descriptor->dimensionSizes[i];
+  }
+  if (parameterValues) {
+    for (i = 0; i < descriptor->nParameters; ++i) {
+      if (descriptor->parameterSizes[i] != descriptor->arraySize) {
+        printMsg(MESSAGETYPE_ERROR,
+                 "Error: the number of elements of array \"%s\" does not match the size %d of the dimensions!\n",
+                 (const char *) descriptor->parameters[i]->name, descriptor->arraySize);
+        return NON_MATCHING_SIZE;
+      }
+    }
+  }
+
+  *nDimensions = descriptor->nDimensions;
+  *nParameters = descriptor->nParameters;
+  *arraySize = descriptor->arraySize;
+  *dimensionNames = copyElementNamesToDocument(document, descriptor->dimensions, descriptor->nDimensions);
+  *parameterNames = copyElementNamesToDocument(document, descriptor->parameters, descriptor->nParameters);
+  *dimensionSizes = (int *) allocateDocumentMemory(document, descriptor->nDimensions * sizeof(int));
+  *dimensionValues = nValues > 0 ? (double *) allocateDocumentMemory(document, nValues * sizeof(double)) : NULL;
+  if (!*dimensionNames || (descriptor->nParameters > 0 && !*parameterNames) || !*dimensionSizes
+      || (nValues > 0 && !*dimensionValues)) {
+    return FAILED;
+  }
+
+  memcpy(*dimensionSizes, descriptor->dimensionSizes, descriptor->nDimensions * sizeof(int));
+  nValues = 0;
+  for (i = 0; i < descriptor->nDimensions; ++i) {
+    memcpy(*dimensionValues + nValues, descriptor->dimensionValues[i], descriptor->dimensionSizes[i] * sizeof(double));
+    nValues += descriptor->dimensionSizes[i];
+  }
+
+  if (parameterValues) {
+    size_t parameterBytes = (size_t) descriptor->arraySize * sizeof(double);
+
+    *parameterValues = NULL;
+    if (descriptor->nParameters > 0 && parameterBytes > 0) {
+      *parameterValues = (double *) allocateDocumentMemory(document, descriptor->nParameters * parameterBytes);
+      if (!*parameterValues) {
+        return FAILED;
+      }
+    }
+    for (i = 0; *parameterValues && i < descriptor->nParameters; ++i) {
+      const double *values = array_getParameterValues(document, descriptor, i);
+      if (!values) {
+        return FAILED;
+      }
+      memcpy(*parameterValues + (size_t) i * descriptor->arraySize, values, parameterBytes);
+    }
+  }
+  return SUCCESS;
+}
+
+DLL_EXPORT ReturnCode tixiGetArrayDescriptor (const TixiDocumentHandle handle, const char *arrayPath,
+                                              int *nDimensions, char ***dimensionNames, int **dimensionSizes,
+                                              double **dimensionValues, int *nParameters, char ***parameterNames,
+                                              double **parameterValues, int *arraySize)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetArrayDescriptorUnlocked(handle, arrayPath, nDimensions, dimensionNames, dimensionSizes,
+                                                    dimensionValues, nParameters, parameterNames, parameterValues, arraySize);
+  unlockDocument(document);
+  return error;
+}
+
 
 DLL_EXPORT double tixiGetArrayValue(const double *array, const int *dimSize, const int *dimPos, const int dims)
 {
@@ -2467,7 +3923,7 @@ DLL_EXPORT double tixiGetArrayValue(const double *array, const int *dimSize, con
 }
 
 
-DLL_EXPORT ReturnCode tixiGetArrayElementCount (const TixiDocumentHandle handle, const char *arrayPath,
+static ReturnCode tixiGetArrayElementCountUnlocked (const TixiDocumentHandle handle, const char *arrayPath,
                                                 const char *elementType, int *elements)
 {
   TixiDocument *document = getDocument(handle);
@@ -2475,6 +3931,7 @@ DLL_EXPORT ReturnCode tixiGetArrayElementCount (const TixiDocumentHandle handle,
   xmlNodeSetPtr nodes = NULL;
   char *infix = "/*[@mapType=\"";
   char *xpathSubElementsName = NULL;
+  TixiArrayDescriptor *descriptor = NULL;
 
   if (!document || !document->docPtr) {
     printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
@@ -2489,7 +3946,22 @@ DLL_EXPORT ReturnCode tixiGetArrayElementCount (const TixiDocumentHandle handle,
   strcat(xpathSubElementsName, elementType);
   strcat(xpathSubElementsName, "\"]");
 
-  xpathObject = xmlXPathEvalExpression((xmlChar *) xpathSubElementsName, document->xpathContext);
+  /* vectors and arrays are counted by the descriptor of the array */
+  if (strcmp(elementType, VECTOR_ATTRIBUTE_NAME) == 0 || strcmp(elementType, "array") == 0) {
+    descriptor = findArrayDescriptor(document, arrayPath);
+  }
+  if (descriptor) {
+    *elements = strcmp(elementType, "array") == 0 ? descriptor->nParameters : descriptor->nDimensions;
+    if (*elements == 0) {
+      printMsg(MESSAGETYPE_ERROR, "Error: No element found at XPath expression \"%s\"\n", xpathSubElementsName);
+      free(xpathSubElementsName);
+      return ELEMENT_NOT_FOUND;
+    }
+    free(xpathSubElementsName);
+    return SUCCESS;
+  }
+
+  xpathObject = XPathEvaluate(XPathGetContext(document), xpathSubElementsName);
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", xpathSubElementsName);
@@ -2513,8 +3985,17 @@ DLL_EXPORT ReturnCode tixiGetArrayElementCount (const TixiDocumentHandle handle,
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiGetArrayElementCount (const TixiDocumentHandle handle, const char *arrayPath,
+                                                const char *elementType, int *elements)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetArrayElementCountUnlocked(handle, arrayPath, elementType, elements);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiGetArrayElementNames (const TixiDocumentHandle handle, const char *arrayPath,
+static ReturnCode tixiGetArrayElementNamesUnlocked (const TixiDocumentHandle handle, const char *arrayPath,
                                                 const char * elementType, char **elementNames)
 {
   TixiDocument *document = getDocument(handle);
@@ -2524,6 +4005,7 @@ DLL_EXPORT ReturnCode tixiGetArrayElementNames (const TixiDocumentHandle handle,
   char *infix = "/*[@mapType=\"";    /* find all arrays in subelements of the given path */
   int elements,elem = 0;
   char *xpathSubElementsName = NULL;
+  TixiArrayDescriptor *descriptor = NULL;
 
   if (!document) {
     printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
@@ -2537,7 +4019,27 @@ DLL_EXPORT ReturnCode tixiGetArrayElementNames (const TixiDocumentHandle handle,
   strcat(xpathSubElementsName, elementType);
   strcat(xpathSubElementsName, "\"]");
 
-  xpathObject = xmlXPathEvalExpression((xmlChar *) xpathSubElementsName, document->xpathContext);
+  if (strcmp(elementType, VECTOR_ATTRIBUTE_NAME) == 0 || strcmp(elementType, "array") == 0) {
+    descriptor = findArrayDescriptor(document, arrayPath);
+  }
+  if (descriptor) {
+    int isArray = strcmp(elementType, "array") == 0;
+    elements = isArray ? descriptor->nParameters : descriptor->nDimensions;
+    if (elements == 0) {
+      printMsg(MESSAGETYPE_ERROR, "Error: No element found at XPath expression \"%s\"\n", xpathSubElementsName);
+      free(xpathSubElementsName);
+      return ELEMENT_NOT_FOUND;
+    }
+    for (elem = 0; elem < elements; elem ++) {
+      node = isArray ? descriptor->parameters[elem] : descriptor->dimensions[elem];
+      elementNames[elem] = (char *) malloc((strlen((char*) node->name) + 1) * sizeof(char));
+      strcpy(elementNames[elem], (char*)node->name);    /* copy tag name */
+    }
+    free(xpathSubElementsName);
+    return SUCCESS;
+  }
+
+  xpathObject = XPathEvaluate(XPathGetContext(document), xpathSubElementsName);
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", xpathSubElementsName);
@@ -2569,76 +4071,146 @@ DLL_EXPORT ReturnCode tixiGetArrayElementNames (const TixiDocumentHandle handle,
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiGetArrayElementNames (const TixiDocumentHandle handle, const char *arrayPath,
+                                                const char * elementType, char **elementNames)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetArrayElementNamesUnlocked(handle, arrayPath, elementType, elementNames);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiGetFloatVector (const TixiDocumentHandle handle, const char *vectorPath,
+static ReturnCode tixiGetFloatVectorUnlocked (const TixiDocumentHandle handle, const char *vectorPath,
                                           double **vectorArray, const int eNumber)
 {
+  TixiDocument *document = getDocument(handle);
   ReturnCode error;
-  char *tmpString = NULL;
+  xmlNodePtr element = NULL;
   int count = 0;
-  char *token = NULL;
-  TixiDocument *document = NULL;
 
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
 
-  error = tixiGetTextAttribute(handle, vectorPath, MAPTYPE_IDENTIFIER, &tmpString);
+  error = getVectorElement(document, vectorPath, &element);
   if (error != SUCCESS) {
     return error;
-  } else {
-    tmpString = stringToLower(tmpString);
-    if ((strcmp(tmpString, VECTOR_ATTRIBUTE_NAME))) {
-      return ELEMENT_NOT_FOUND;
-    }
   }
 
-  error = tixiGetTextElement(handle, vectorPath, &tmpString); /* check if element is of right type */
-  if (error != SUCCESS) {
+  *vectorArray = (double *) allocateDocumentMemory(document, eNumber * sizeof(double));
+  if (!*vectorArray) {
+    return FAILED;
+  }
+
+  /* parse the values in place, without copying the text */
+  error = readVectorInto(document, element, *vectorArray, eNumber, &count);
+  if (error == FAILED) {
     return error;
   }
+  return count < eNumber ? INDEX_OUT_OF_RANGE : SUCCESS;
+}
 
-  *vectorArray = (double *) malloc(eNumber * sizeof(double));
-  document = getDocument(handle);
-  addToMemoryList(document, *vectorArray);
+DLL_EXPORT ReturnCode tixiGetFloatVector (const TixiDocumentHandle handle, const char *vectorPath,
+                                          double **vectorArray, const int eNumber)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetFloatVectorUnlocked(handle, vectorPath, vectorArray, eNumber);
+  unlockDocument(document);
+  return error;
+}
 
-  token = strtok(tmpString, VECTOR_SEPARATOR);    /* modifies tmpString */
-  while(token != NULL) {  /* as long as there are tokens */
-    if (count == eNumber) {
-      return SUCCESS;
-    }
-    (*vectorArray)[count ++] = atof(token);    /* starting with zero */
-    token = strtok(0, VECTOR_SEPARATOR);
+static ReturnCode tixiGetFloatVectorIntoUnlocked (const TixiDocumentHandle handle, const char *vectorPath,
+                                                  double *values, int capacity, int *nElements)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
+  ReturnCode error = SUCCESS;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
   }
-  return count < eNumber ? INDEX_OUT_OF_RANGE : SUCCESS;
+
+  error = getVectorElement(document, vectorPath, &element);
+  if (!error) {
+    error = readVectorInto(document, element, values, capacity, nElements);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiGetFloatVectorInto (const TixiDocumentHandle handle, const char *vectorPath,
+                                              double *values, int capacity, int *nElements)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetFloatVectorIntoUnlocked(handle, vectorPath, values, capacity, nElements);
+  unlockDocument(document);
+  return error;
 }
 
 
-DLL_EXPORT ReturnCode tixiCreateElement (const TixiDocumentHandle handle, const char *parentPath, const char *elementName)
+static ReturnCode tixiCreateElementUnlocked (const TixiDocumentHandle handle, const char *parentPath, const char *elementName)
 {
   char *text = NULL;
   return tixiAddTextElement(handle, parentPath, elementName, text);
 }
 
+DLL_EXPORT ReturnCode tixiCreateElement (const TixiDocumentHandle handle, const char *parentPath, const char *elementName)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiCreateElementUnlocked(handle, parentPath, elementName);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiCreateElementNS (const TixiDocumentHandle handle, const char *parentPath, const char *qualifiedName, const char* namespaceURI)
+static ReturnCode tixiCreateElementNSUnlocked (const TixiDocumentHandle handle, const char *parentPath, const char *qualifiedName, const char* namespaceURI)
 {
   char *text = NULL;
   return tixiAddTextElementNS(handle, parentPath, qualifiedName, namespaceURI, text);
 }
 
+DLL_EXPORT ReturnCode tixiCreateElementNS (const TixiDocumentHandle handle, const char *parentPath, const char *qualifiedName, const char* namespaceURI)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiCreateElementNSUnlocked(handle, parentPath, qualifiedName, namespaceURI);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiCreateElementAtIndex (const TixiDocumentHandle handle, const char *parentPath, const char *elementName, int index)
+static ReturnCode tixiCreateElementAtIndexUnlocked (const TixiDocumentHandle handle, const char *parentPath, const char *elementName, int index)
 {
   char *text = NULL;
   return tixiAddTextElementAtIndex(handle, parentPath, elementName, text,index);
 }
 
+DLL_EXPORT ReturnCode tixiCreateElementAtIndex (const TixiDocumentHandle handle, const char *parentPath, const char *elementName, int index)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiCreateElementAtIndexUnlocked(handle, parentPath, elementName, index);
+  unlockDocument(document);
+  return error;
+}
 
-DLL_EXPORT ReturnCode tixiCreateElementNSAtIndex (const TixiDocumentHandle handle, const char *parentPath,
+
+static ReturnCode tixiCreateElementNSAtIndexUnlocked (const TixiDocumentHandle handle, const char *parentPath,
                                                   const char *qualifiedName, int index, const char* namespaceURI)
 {
   char *text = NULL;
   return tixiAddTextElementNSAtIndex(handle, parentPath, qualifiedName, namespaceURI, text,index);
 }
 
+DLL_EXPORT ReturnCode tixiCreateElementNSAtIndex (const TixiDocumentHandle handle, const char *parentPath,
+                                                  const char *qualifiedName, int index, const char* namespaceURI)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiCreateElementNSAtIndexUnlocked(handle, parentPath, qualifiedName, index, namespaceURI);
+  unlockDocument(document);
+  return error;
+}
+
 
 DLL_EXPORT ReturnCode tixiCheckDocumentHandle(const TixiDocumentHandle handle)
 {
@@ -2652,7 +4224,7 @@ DLL_EXPORT ReturnCode tixiCheckDocumentHandle(const TixiDocumentHandle handle)
   }
 }
 
-DLL_EXPORT ReturnCode tixiCheckElement(const TixiDocumentHandle handle, const char *elementPath)
+static ReturnCode tixiCheckElementUnlocked(const TixiDocumentHandle handle, const char *elementPath)
 {
 
   TixiDocument *document = getDocument(handle);
@@ -2666,15 +4238,23 @@ DLL_EXPORT ReturnCode tixiCheckElement(const TixiDocumentHandle handle, const ch
     return INVALID_HANDLE;
   }
 
-  error = checkExistence(document->xpathContext, elementPath, &xpathObject);
+  error = checkExistence(XPathGetContext(document), elementPath, &xpathObject);
   xmlXPathFreeObject(xpathObject);
 
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiCheckElement(const TixiDocumentHandle handle, const char *elementPath)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiCheckElementUnlocked(handle, elementPath);
+  unlockDocument(document);
+  return error;
+}
+
 
 
-DLL_EXPORT ReturnCode tixiCheckAttribute(TixiDocumentHandle handle, const char *elementPath, const char *attributeName)
+static ReturnCode tixiCheckAttributeUnlocked(TixiDocumentHandle handle, const char *elementPath, const char *attributeName)
 {
   TixiDocument *document = getDocument(handle);
 
@@ -2687,7 +4267,7 @@ DLL_EXPORT ReturnCode tixiCheckAttribute(TixiDocumentHandle handle, const char *
     return INVALID_HANDLE;
   }
 
-  error = checkElement(document->xpathContext, elementPath, &element);
+  error = checkElement(XPathGetContext(document), elementPath, &element);
   if (!error) {
     char* name = NULL;
     char* prefix = NULL;
@@ -2719,31 +4299,43 @@ DLL_EXPORT ReturnCode tixiCheckAttribute(TixiDocumentHandle handle, const char *
   }
 }
 
-DLL_EXPORT ReturnCode tixiXSLTransformationToFile(TixiDocumentHandle handle, const char *xslFilename, const char *resultFilename)
+DLL_EXPORT ReturnCode tixiCheckAttribute(TixiDocumentHandle handle, const char *elementPath, const char *attributeName)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiCheckAttributeUnlocked(handle, elementPath, attributeName);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiXSLTransformationToFileUnlocked(TixiDocumentHandle handle, const char *xslFilename, const char *resultFilename)
 {
   TixiDocument *document = getDocument(handle);
 
   return xsltTransformToFile(document->docPtr, xslFilename, resultFilename);
 }
 
+DLL_EXPORT ReturnCode tixiXSLTransformationToFile(TixiDocumentHandle handle, const char *xslFilename, const char *resultFilename)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiXSLTransformationToFileUnlocked(handle, xslFilename, resultFilename);
+  unlockDocument(document);
+  return error;
+}
+
 
 /** -----------
  * UID Functions
  *--------------*/
 
 
-DLL_EXPORT ReturnCode tixiUIDCheckDuplicates(TixiDocumentHandle handle)
+static ReturnCode tixiUIDCheckDuplicatesUnlocked(TixiDocumentHandle handle)
 {
   TixiDocument *document = getDocument(handle);
 
   if(!document)
     return INVALID_HANDLE;
 
-  // if the UID list is already set, delete and rebuild it.
-  if(document->uidListHead) {
-    uid_clearUIDList(document);
-  }
-
+  // the UID table is built once and kept up to date afterwards
   if (uid_readDocumentUIDs(document) != SUCCESS) {
     return FAILED;
   }
@@ -2755,17 +4347,21 @@ DLL_EXPORT ReturnCode tixiUIDCheckDuplicates(TixiDocumentHandle handle)
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiUIDCheckDuplicates(TixiDocumentHandle handle)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiUIDCheckDuplicatesUnlocked(handle);
+  unlockDocument(document);
+  return error;
+}
+
 
 
-DLL_EXPORT ReturnCode tixiUIDCheckLinks(TixiDocumentHandle handle)
+static ReturnCode tixiUIDCheckLinksUnlocked(TixiDocumentHandle handle)
 {
   TixiDocument *document = getDocument(handle);
 
-  // if the UID list is already set, delete and rebuild it.
-  if(document->uidListHead) {
-    uid_clearUIDList(document);
-  }
-
+  // the UID table is built once and kept up to date afterwards
   if (uid_readDocumentUIDs(document) != SUCCESS) {
     return FAILED;
   }
@@ -2777,8 +4373,173 @@ DLL_EXPORT ReturnCode tixiUIDCheckLinks(TixiDocumentHandle handle)
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiUIDCheckLinks(TixiDocumentHandle handle)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiUIDCheckLinksUnlocked(handle);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiUIDGetXPath(TixiDocumentHandle handle, const char *uID, char **xPath)
+static ReturnCode tixiUIDGetDuplicatesUnlocked(TixiDocumentHandle handle, char ***uIDs, char ***xPaths, int *number)
+{
+  TixiDocument *document = getDocument(handle);
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  if (!uIDs || !xPaths || !number) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null pointer argument in tixiUIDGetDuplicates.\n");
+    return FAILED;
+  }
+
+  if (uid_readDocumentUIDs(document) != SUCCESS) {
+    return FAILED;
+  }
+
+  return uid_getDuplicates(document, uIDs, xPaths, number);
+}
+
+DLL_EXPORT ReturnCode tixiUIDGetDuplicates(TixiDocumentHandle handle, char ***uIDs, char ***xPaths, int *number)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiUIDGetDuplicatesUnlocked(handle, uIDs, xPaths, number);
+  unlockDocument(document);
+  return error;
+}
+
+
+static ReturnCode tixiUIDGetBrokenLinksUnlocked(TixiDocumentHandle handle, char ***links, char ***xPaths, int *number)
+{
+  TixiDocument *document = getDocument(handle);
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  if (!links || !xPaths || !number) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null pointer argument in tixiUIDGetBrokenLinks.\n");
+    return FAILED;
+  }
+
+  if (uid_readDocumentUIDs(document) != SUCCESS) {
+    return FAILED;
+  }
+
+  return uid_getBrokenLinks(document, links, xPaths, number);
+}
+
+DLL_EXPORT ReturnCode tixiUIDGetBrokenLinks(TixiDocumentHandle handle, char ***links, char ***xPaths, int *number)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiUIDGetBrokenLinksUnlocked(handle, links, xPaths, number);
+  unlockDocument(document);
+  return error;
+}
+
+
+static ReturnCode tixiUIDGetIncomingReferencesUnlocked(TixiDocumentHandle handle, const char *uID, char ***xPaths, int *number)
+{
+  TixiDocument *document = getDocument(handle);
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  if (!uID || !xPaths || !number) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null pointer argument in tixiUIDGetIncomingReferences.\n");
+    return FAILED;
+  }
+
+  if (uid_readReferenceGraph(document) != SUCCESS) {
+    return FAILED;
+  }
+
+  return uid_getIncomingReferences(document, uID, xPaths, number);
+}
+
+DLL_EXPORT ReturnCode tixiUIDGetIncomingReferences(TixiDocumentHandle handle, const char *uID, char ***xPaths, int *number)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiUIDGetIncomingReferencesUnlocked(handle, uID, xPaths, number);
+  unlockDocument(document);
+  return error;
+}
+
+
+static ReturnCode tixiUIDGetOutgoingReferencesUnlocked(TixiDocumentHandle handle, const char *elementPath, char ***uIDs, int *number)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
+  ReturnCode error = SUCCESS;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  if (!uIDs || !number) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null pointer argument in tixiUIDGetOutgoingReferences.\n");
+    return FAILED;
+  }
+
+  error = checkElement(XPathGetContext(document), elementPath, &element);
+  if (error) {
+    return error;
+  }
+
+  if (uid_readReferenceGraph(document) != SUCCESS) {
+    return FAILED;
+  }
+
+  return uid_getOutgoingReferences(document, element, uIDs, number);
+}
+
+DLL_EXPORT ReturnCode tixiUIDGetOutgoingReferences(TixiDocumentHandle handle, const char *elementPath, char ***uIDs, int *number)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiUIDGetOutgoingReferencesUnlocked(handle, elementPath, uIDs, number);
+  unlockDocument(document);
+  return error;
+}
+
+
+static ReturnCode tixiUIDGetTopologicalOrderUnlocked(TixiDocumentHandle handle, char ***uIDs, int *number)
+{
+  TixiDocument *document = getDocument(handle);
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  if (!uIDs || !number) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null pointer argument in tixiUIDGetTopologicalOrder.\n");
+    return FAILED;
+  }
+
+  if (uid_readReferenceGraph(document) != SUCCESS) {
+    return FAILED;
+  }
+
+  return uid_getTopologicalOrder(document, uIDs, number);
+}
+
+DLL_EXPORT ReturnCode tixiUIDGetTopologicalOrder(TixiDocumentHandle handle, char ***uIDs, int *number)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiUIDGetTopologicalOrderUnlocked(handle, uIDs, number);
+  unlockDocument(document);
+  return error;
+}
+
+
+static ReturnCode tixiUIDGetXPathUnlocked(TixiDocumentHandle handle, const char *uID, char **xPath)
 {
   ReturnCode error;
   TixiDocument *document = getDocument(handle);
@@ -2791,20 +4552,25 @@ DLL_EXPORT ReturnCode tixiUIDGetXPath(TixiDocumentHandle handle, const char *uID
 
   textPtr = (char *) uid_getXpath(document, uID);
   if ( textPtr ) {
-    *xPath = (char *) malloc((strlen(textPtr) + 1) * sizeof(char));
-    strcpy(*xPath, textPtr);
+    *xPath = copyStringToDocument(document, textPtr);
     xmlFree(textPtr);
   }
   else {
-    *xPath = (char *) malloc(sizeof(char));
-    strcpy(*xPath, "");
+    *xPath = copyStringToDocument(document, "");
   }
-  error = addToMemoryList(document, (void *) *xPath);
+  return *xPath ? SUCCESS : FAILED;
+}
+
+DLL_EXPORT ReturnCode tixiUIDGetXPath(TixiDocumentHandle handle, const char *uID, char **xPath)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiUIDGetXPathUnlocked(handle, uID, xPath);
+  unlockDocument(document);
   return error;
 }
 
 
-DLL_EXPORT ReturnCode tixiUIDCheckExists(TixiDocumentHandle handle, const char *uID)
+static ReturnCode tixiUIDCheckExistsUnlocked(TixiDocumentHandle handle, const char *uID)
 {
   TixiDocument *document = getDocument(handle);
   ReturnCode error = FAILED;
@@ -2823,8 +4589,16 @@ DLL_EXPORT ReturnCode tixiUIDCheckExists(TixiDocumentHandle handle, const char *
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiUIDCheckExists(TixiDocumentHandle handle, const char *uID)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiUIDCheckExistsUnlocked(handle, uID);
+  unlockDocument(document);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiUIDSetToXPath(TixiDocumentHandle handle, const char *xPath, const char *uID)
+static ReturnCode tixiUIDSetToXPathUnlocked(TixiDocumentHandle handle, const char *xPath, const char *uID)
 {
   ReturnCode error;
 
@@ -2836,8 +4610,16 @@ DLL_EXPORT ReturnCode tixiUIDSetToXPath(TixiDocumentHandle handle, const char *x
   return tixiAddTextAttribute (handle, xPath, CPACS_UID_ATTRIBUTE_STRING, uID);
 }
 
+DLL_EXPORT ReturnCode tixiUIDSetToXPath(TixiDocumentHandle handle, const char *xPath, const char *uID)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiUIDSetToXPathUnlocked(handle, xPath, uID);
+  unlockDocument(document);
+  return error;
+}
 
-DLL_EXPORT ReturnCode tixiXPathEvaluateNodeNumber(TixiDocumentHandle handle, const char *xPathExpression, int *number)
+
+static ReturnCode tixiXPathEvaluateNodeNumberUnlocked(TixiDocumentHandle handle, const char *xPathExpression, int *number)
 {
   TixiDocument *document = getDocument(handle);
   int error = SUCCESS;
@@ -2850,7 +4632,15 @@ DLL_EXPORT ReturnCode tixiXPathEvaluateNodeNumber(TixiDocumentHandle handle, con
   return error;
 }
 
-DLL_EXPORT ReturnCode tixiXPathExpressionGetXPath(TixiDocumentHandle handle, const char *xPathExpression, int index, char** xPath)
+DLL_EXPORT ReturnCode tixiXPathEvaluateNodeNumber(TixiDocumentHandle handle, const char *xPathExpression, int *number)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiXPathEvaluateNodeNumberUnlocked(handle, xPathExpression, number);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiXPathExpressionGetXPathUnlocked(TixiDocumentHandle handle, const char *xPathExpression, int index, char** xPath)
 {
   TixiDocument *document = getDocument(handle);
   char* tmpXPath = NULL;
@@ -2868,14 +4658,21 @@ DLL_EXPORT ReturnCode tixiXPathExpressionGetXPath(TixiDocumentHandle handle, con
   }
 
   // copy to output
-  *xPath = buildString("%s", tmpXPath);
+  *xPath = copyStringToDocument(document, tmpXPath ? tmpXPath : "");
   free(tmpXPath);
-  addToMemoryList(document, (void*) *xPath);
 
   return error;
 }
 
-DLL_EXPORT ReturnCode tixiXPathExpressionGetTextByIndex(TixiDocumentHandle handle, const char *xPathExpression, int elementNumber, char **text)
+DLL_EXPORT ReturnCode tixiXPathExpressionGetXPath(TixiDocumentHandle handle, const char *xPathExpression, int index, char** xPath)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiXPathExpressionGetXPathUnlocked(handle, xPathExpression, index, xPath);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiXPathExpressionGetTextByIndexUnlocked(TixiDocumentHandle handle, const char *xPathExpression, int elementNumber, char **text)
 {
   TixiDocument *document = getDocument(handle);
   int error = SUCCESS;
@@ -2883,9 +4680,9 @@ DLL_EXPORT ReturnCode tixiXPathExpressionGetTextByIndex(TixiDocumentHandle handl
 
   textPtr = XPathExpressionGetText(document, xPathExpression, elementNumber);
   if ( textPtr ) {
-    *text = (char *) malloc((strlen(textPtr) + 1) * sizeof(char));
-    strcpy(*text, textPtr);
-    error = addToMemoryList(document, (void *) *text);
+    *text = copyStringToDocument(document, textPtr);
+    xmlFree(textPtr);
+    error = *text ? SUCCESS : FAILED;
   } else {
     *text = NULL;
     error = FAILED;
@@ -2894,107 +4691,347 @@ DLL_EXPORT ReturnCode tixiXPathExpressionGetTextByIndex(TixiDocumentHandle handl
   return error;
 }
 
-DLL_EXPORT ReturnCode   tixiGetChildNodeName(const TixiDocumentHandle handle, const char *elementPath,  int index, char **text)
+DLL_EXPORT ReturnCode tixiXPathExpressionGetTextByIndex(TixiDocumentHandle handle, const char *xPathExpression, int elementNumber, char **text)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiXPathExpressionGetTextByIndexUnlocked(handle, xPathExpression, elementNumber, text);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiXPathExpressionGetTextByIndexIntoUnlocked(TixiDocumentHandle handle, const char *xPathExpression, int elementNumber,
+                                                                char *buffer, int bufferSize, int *requiredSize)
 {
   TixiDocument *document = getDocument(handle);
-  xmlNodePtr element = NULL;
-  int error = SUCCESS;
+  xmlNodePtr node = NULL;
 
   if (!document) {
     printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
     return INVALID_HANDLE;
   }
 
-  if(index <= 0){
-    return INDEX_OUT_OF_RANGE;
+  node = XPathExpressionGetNode(document, xPathExpression, elementNumber);
+  if (node && node->type == XML_ELEMENT_NODE) {
+    return copyNodeListTextToBuffer(document->docPtr, node->children, 1, buffer, bufferSize, requiredSize);
   }
+  else if (node && node->type == XML_ATTRIBUTE_NODE && node->children) {
+    return copyNodeListTextToBuffer(document->docPtr, node->children, 0, buffer, bufferSize, requiredSize);
+  }
+  return FAILED;
+}
 
-  error = checkElement(document->xpathContext, elementPath, &element);
-
-  if(!error){
-    xmlNodePtr child = element->children;
-    int pos = 1;
+DLL_EXPORT ReturnCode tixiXPathExpressionGetTextByIndexInto(TixiDocumentHandle handle, const char *xPathExpression, int elementNumber,
+                                                            char *buffer, int bufferSize, int *requiredSize)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiXPathExpressionGetTextByIndexIntoUnlocked(handle, xPathExpression, elementNumber, buffer, bufferSize, requiredSize);
+  unlockDocument(document);
+  return error;
+}
 
-    while(child && pos < index){
-      // Ignore DTD nodes
-      if (child->type != XML_DTD_NODE) {
-        pos++;
-      }
-      child = child->next;
+/* text of a node of an XPath result, assembled texts are returned in assembledText to be freed with xmlFree */
+static const char* getXPathNodeText(xmlDocPtr doc, xmlNodePtr node, xmlChar **assembledText)
+{
+  const char *text = NULL;
+
+  *assembledText = NULL;
+  switch (node->type) {
+  case XML_ELEMENT_NODE:
+    text = getNodeListTextDirect(doc, node->children, 1);
+    if (!text) {
+      *assembledText = xmlNodeListGetString(doc, node->children, 0);
     }
-
-    if(pos != index || !child){
-      return INDEX_OUT_OF_RANGE;
+    break;
+  case XML_ATTRIBUTE_NODE:
+    text = getNodeListTextDirect(doc, node->children, 0);
+    if (!text) {
+      *assembledText = xmlNodeListGetString(doc, node->children, 1);
     }
+    break;
+  case XML_TEXT_NODE:
+  case XML_CDATA_SECTION_NODE:
+  case XML_COMMENT_NODE:
+  case XML_PI_NODE:
+    return node->content ? (const char *) node->content : "";
+  default:
+    return NULL;
+  }
 
-    // return node value according to dom specification: http://www.w3schools.com/dom/dom_nodetype.asp
-    if(child->type == XML_TEXT_NODE){
-      *text = (char *) malloc(10 * sizeof(char));
-      strcpy(*text, "#text");
-    }
-    else if(child->type == XML_CDATA_SECTION_NODE){
-      *text = (char *) malloc(20 * sizeof(char));
-      strcpy(*text, "#cdata-section");
-    }
-    else if(child->type == XML_COMMENT_NODE){
-      *text = (char *) malloc(10 * sizeof(char));
-      strcpy(*text, "#comment");
-    }
-    else {
-      // get name
-      *text = (char *) malloc((strlen((char*)child->name) + 3) * sizeof(char));
-      strcpy(*text,  (char*) child->name);
-    }
-    error = addToMemoryList(document, (void *) *text);
+  if (*assembledText) {
+    return (const char *) *assembledText;
   }
-  return error;
+  return text ? text : "";
 }
 
-DLL_EXPORT ReturnCode tixiGetNumberOfChilds(const TixiDocumentHandle handle, const char *elementPath, int* nChilds)
+/* evaluates an XPath expression whose result is visited node by node */
+static ReturnCode evaluateXPathNodeSet(TixiDocument *document, const char *xPathExpression, xmlXPathObjectPtr *xpathObject)
 {
-  TixiDocument *document = getDocument(handle);
-  xmlNodePtr element = NULL;
-  ReturnCode error = SUCCESS;
+  xmlXPathContextPtr xpathContext = XPathGetContext(document);
 
-
-  if (!document) {
-    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
-    return INVALID_HANDLE;
-  }
-
-  error = checkElement(document->xpathContext, elementPath, &element);
-
-  if (!error) {
-    xmlNodePtr children = element->children;
-    *nChilds = 0;
-    while(children){
-      // Ignore DTD nodes, we don't select them with xpath
-      if (children->type != XML_DTD_NODE) {
-        (*nChilds)++;
-      }
-      children = children->next;
-    }
+  *xpathObject = xpathContext ? XPathEvaluate(xpathContext, xPathExpression) : NULL;
+  if (!*xpathObject) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid XPath expression \"%s\"\n", xPathExpression);
+    return INVALID_XPATH;
   }
-
-  return error;
+  return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiGetNumberOfAttributes(const TixiDocumentHandle handle, const char *elementPath, int* nAttributes)
+static ReturnCode tixiXPathExpressionForEachUnlocked(TixiDocumentHandle handle, const char *xPathExpression,
+                                                     TixiXPathNodeFnc callback, void *userData)
 {
   TixiDocument *document = getDocument(handle);
-  xmlNodePtr element = NULL;
+  xmlXPathObjectPtr xpathObject = NULL;
+  XPathNodePathBuilder pathBuilder;
   ReturnCode error = SUCCESS;
-
+  int nNodes = 0;
+  int i = 0;
 
   if (!document) {
     printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
     return INVALID_HANDLE;
   }
 
-  error = checkElement(document->xpathContext, elementPath, &element);
+  if (!xPathExpression || !callback) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null pointer argument in tixiXPathExpressionForEach.\n");
+    return FAILED;
+  }
 
-  if (!error) {
-    xmlAttrPtr attr = element->properties;
+  error = evaluateXPathNodeSet(document, xPathExpression, &xpathObject);
+  if (error) {
+    return error;
+  }
+
+  nNodes = xmlXPathNodeSetGetLength(xpathObject->nodesetval);
+  XPathInitNodePathBuilder(&pathBuilder);
+  for (i = 0; i < nNodes; ++i) {
+    xmlNodePtr node = xmlXPathNodeSetItem(xpathObject->nodesetval, i);
+    const char *name = NULL;
+    const char *text = NULL;
+    xmlChar *assembledText = NULL;
+    xmlChar *path = NULL;
+    int stop = 0;
+
+    if (node->type == XML_ELEMENT_NODE || node->type == XML_ATTRIBUTE_NODE) {
+      name = (const char *) node->name;
+    }
+    text = getXPathNodeText(document->docPtr, node, &assembledText);
+    path = XPathBuildNodePath(&pathBuilder, node);
+
+    stop = callback(i + 1, name, text, (const char *) path, userData);
+
+    xmlFree(path);
+    xmlFree(assembledText);
+    if (stop) {
+      break;
+    }
+  }
+  XPathFreeNodePathBuilder(&pathBuilder);
+  xmlXPathFreeObject(xpathObject);
+
+  return SUCCESS;
+}
+
+DLL_EXPORT ReturnCode tixiXPathExpressionForEach(TixiDocumentHandle handle, const char *xPathExpression,
+                                                 TixiXPathNodeFnc callback, void *userData)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiXPathExpressionForEachUnlocked(handle, xPathExpression, callback, userData);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiXPathExpressionGetAllTextsUnlocked(TixiDocumentHandle handle, const char *xPathExpression,
+                                                         char ***texts, int *number)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlXPathObjectPtr xpathObject = NULL;
+  ReturnCode error = SUCCESS;
+  char **result = NULL;
+  int nNodes = 0;
+  int i = 0;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  if (!xPathExpression || !texts || !number) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null pointer argument in tixiXPathExpressionGetAllTexts.\n");
+    return FAILED;
+  }
+
+  *texts = NULL;
+  *number = 0;
+
+  error = evaluateXPathNodeSet(document, xPathExpression, &xpathObject);
+  if (error) {
+    return error;
+  }
+
+  nNodes = xmlXPathNodeSetGetLength(xpathObject->nodesetval);
+  if (nNodes > 0) {
+    result = (char **) allocateDocumentMemory(document, nNodes * sizeof(char *));
+    error = result ? SUCCESS : FAILED;
+  }
+
+  for (i = 0; i < nNodes && !error; ++i) {
+    xmlChar *assembledText = NULL;
+    const char *text = getXPathNodeText(document->docPtr, xmlXPathNodeSetItem(xpathObject->nodesetval, i), &assembledText);
+
+    result[i] = copyStringToDocument(document, text ? text : "");
+    xmlFree(assembledText);
+    if (!result[i]) {
+      error = FAILED;
+    }
+  }
+  xmlXPathFreeObject(xpathObject);
+
+  if (!error) {
+    *texts = result;
+    *number = nNodes;
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiXPathExpressionGetAllTexts(TixiDocumentHandle handle, const char *xPathExpression,
+                                                     char ***texts, int *number)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiXPathExpressionGetAllTextsUnlocked(handle, xPathExpression, texts, number);
+  unlockDocument(document);
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiSetXPathCacheSize(int size)
+{
+  if (size < 0) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Negative size %d of the XPath cache.\n", size);
+    return FAILED;
+  }
+
+  XPathSetCacheSize(size);
+  return SUCCESS;
+}
+
+DLL_EXPORT ReturnCode tixiGetXPathCacheStatistics(size_t *hits, size_t *misses)
+{
+  if (!hits || !misses) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null pointer argument in tixiGetXPathCacheStatistics.\n");
+    return FAILED;
+  }
+
+  XPathGetCacheStatistics(hits, misses);
+  return SUCCESS;
+}
+
+static ReturnCode tixiGetChildNodeNameUnlocked(const TixiDocumentHandle handle, const char *elementPath,  int index, char **text)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
+  int error = SUCCESS;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  if(index <= 0){
+    return INDEX_OUT_OF_RANGE;
+  }
+
+  error = checkElement(XPathGetContext(document), elementPath, &element);
+
+  if(!error){
+    xmlNodePtr child = NULL;
+
+    // DTD nodes are not indexed
+    if (getIndexedChild(document, element, NULL, 0, index, &child) < 0) {
+      return FAILED;
+    }
+
+    if(!child){
+      return INDEX_OUT_OF_RANGE;
+    }
+
+    // return node value according to dom specification: http://www.w3schools.com/dom/dom_nodetype.asp
+    if(child->type == XML_TEXT_NODE){
+      *text = copyStringToDocument(document, "#text");
+    }
+    else if(child->type == XML_CDATA_SECTION_NODE){
+      *text = copyStringToDocument(document, "#cdata-section");
+    }
+    else if(child->type == XML_COMMENT_NODE){
+      *text = copyStringToDocument(document, "#comment");
+    }
+    else {
+      // get name
+      *text = copyStringToDocument(document, (char*)child->name);
+    }
+    error = *text ? SUCCESS : FAILED;
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode   tixiGetChildNodeName(const TixiDocumentHandle handle, const char *elementPath,  int index, char **text)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetChildNodeNameUnlocked(handle, elementPath, index, text);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiGetNumberOfChildsUnlocked(const TixiDocumentHandle handle, const char *elementPath, int* nChilds)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
+  ReturnCode error = SUCCESS;
+
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = checkElement(XPathGetContext(document), elementPath, &element);
+
+  if (!error) {
+    xmlNodePtr child = NULL;
+
+    // Ignore DTD nodes, we don't select them with xpath
+    *nChilds = getIndexedChild(document, element, NULL, 0, 0, &child);
+    if (*nChilds < 0) {
+      *nChilds = 0;
+      return FAILED;
+    }
+  }
+
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiGetNumberOfChilds(const TixiDocumentHandle handle, const char *elementPath, int* nChilds)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetNumberOfChildsUnlocked(handle, elementPath, nChilds);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiGetNumberOfAttributesUnlocked(const TixiDocumentHandle handle, const char *elementPath, int* nAttributes)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
+  ReturnCode error = SUCCESS;
+
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = checkElement(XPathGetContext(document), elementPath, &element);
+
+  if (!error) {
+    xmlAttrPtr attr = element->properties;
     *nAttributes = 0;
 
     while(attr){
@@ -3006,7 +5043,15 @@ DLL_EXPORT ReturnCode tixiGetNumberOfAttributes(const TixiDocumentHandle handle,
   return error;
 }
 
-DLL_EXPORT ReturnCode tixiGetAttributeName(const TixiDocumentHandle handle, const char *elementPath, int attrIndex, char** attrName)
+DLL_EXPORT ReturnCode tixiGetNumberOfAttributes(const TixiDocumentHandle handle, const char *elementPath, int* nAttributes)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetNumberOfAttributesUnlocked(handle, elementPath, nAttributes);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiGetAttributeNameUnlocked(const TixiDocumentHandle handle, const char *elementPath, int attrIndex, char** attrName)
 {
   TixiDocument *document = getDocument(handle);
   xmlNodePtr element = NULL;
@@ -3022,7 +5067,7 @@ DLL_EXPORT ReturnCode tixiGetAttributeName(const TixiDocumentHandle handle, cons
     return INDEX_OUT_OF_RANGE;
   }
 
-  error = checkElement(document->xpathContext, elementPath, &element);
+  error = checkElement(XPathGetContext(document), elementPath, &element);
 
   if (!error) {
     xmlAttrPtr attr = element->properties;
@@ -3038,22 +5083,31 @@ DLL_EXPORT ReturnCode tixiGetAttributeName(const TixiDocumentHandle handle, cons
     }
 
     if (attr->ns && attr->ns->prefix) {
-      *attrName = (char *) malloc((strlen((char*)attr->name) + strlen((char*)attr->ns->prefix) + 4) * sizeof(char));
-      sprintf(*attrName, "%s:%s", attr->ns->prefix, attr->name);
+      *attrName = (char *) allocateDocumentMemory(document, strlen((char*)attr->name) + strlen((char*)attr->ns->prefix) + 2);
+      if (*attrName) {
+        sprintf(*attrName, "%s:%s", attr->ns->prefix, attr->name);
+      }
     }
     else {
       // get name
-      *attrName = (char *) malloc((strlen((char*)attr->name) + 3) * sizeof(char));
-      strcpy(*attrName,  (char*)attr->name);
+      *attrName = copyStringToDocument(document, (char*)attr->name);
     }
-    error = addToMemoryList(document, (void *) *attrName);
+    error = *attrName ? SUCCESS : FAILED;
   }
 
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiGetAttributeName(const TixiDocumentHandle handle, const char *elementPath, int attrIndex, char** attrName)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetAttributeNameUnlocked(handle, elementPath, attrIndex, attrName);
+  unlockDocument(document);
+  return error;
+}
 
-DLL_EXPORT ReturnCode tixiGetNodeType(const TixiDocumentHandle handle, const char *nodePath, char **nodeType)
+
+static ReturnCode tixiGetNodeTypeUnlocked(const TixiDocumentHandle handle, const char *nodePath, char **nodeType)
 {
   TixiDocument *document = getDocument(handle);
   xmlNodePtr element     = NULL;
@@ -3064,81 +5118,76 @@ DLL_EXPORT ReturnCode tixiGetNodeType(const TixiDocumentHandle handle, const cha
     return INVALID_HANDLE;
   }
 
-  error = checkElement(document->xpathContext, nodePath, &element);
+  error = checkElement(XPathGetContext(document), nodePath, &element);
 
   if (!error) {
     switch (element->type) {
     case  XML_ELEMENT_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (12 + 3));
-      strcpy(*nodeType, "ELEMENT_NODE");
+      *nodeType = copyStringToDocument(document, "ELEMENT_NODE");
       break;
 
     case  XML_ATTRIBUTE_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (14 + 3));
-      strcpy(*nodeType, "ATTRIBUTE_NODE");
+      *nodeType = copyStringToDocument(document, "ATTRIBUTE_NODE");
       break;
 
     case  XML_TEXT_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (9 + 3));
-      strcpy(*nodeType, "TEXT_NODE");
+      *nodeType = copyStringToDocument(document, "TEXT_NODE");
       break;
 
     case  XML_CDATA_SECTION_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (18 + 3));
-      strcpy(*nodeType, "CDATA_SECTION_NODE");
+      *nodeType = copyStringToDocument(document, "CDATA_SECTION_NODE");
       break;
 
     case  XML_ENTITY_REF_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (21 + 3));
-      strcpy(*nodeType, "ENTITY_REFERENCE_NODE");
+      *nodeType = copyStringToDocument(document, "ENTITY_REFERENCE_NODE");
       break;
 
     case  XML_ENTITY_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (11 + 3));
-      strcpy(*nodeType, "ENTITY_NODE");
+      *nodeType = copyStringToDocument(document, "ENTITY_NODE");
       break;
 
     case  XML_PI_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (27 + 3));
-      strcpy(*nodeType, "PROCESSING_INSTRUCTION_NODE");
+      *nodeType = copyStringToDocument(document, "PROCESSING_INSTRUCTION_NODE");
       break;
 
     case  XML_COMMENT_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (12 + 3));
-      strcpy(*nodeType, "COMMENT_NODE");
+      *nodeType = copyStringToDocument(document, "COMMENT_NODE");
       break;
 
     case  XML_DOCUMENT_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (13 + 3));
-      strcpy(*nodeType, "DOCUMENT_NODE");
+      *nodeType = copyStringToDocument(document, "DOCUMENT_NODE");
       break;
 
     case  XML_DOCUMENT_TYPE_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (18 + 3));
-      strcpy(*nodeType, "DOCUMENT_TYPE_NODE");
+      *nodeType = copyStringToDocument(document, "DOCUMENT_TYPE_NODE");
       break;
 
     case XML_DOCUMENT_FRAG_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (22 + 3));
-      strcpy(*nodeType, "DOCUMENT_FRAGMENT_NODE");
+      *nodeType = copyStringToDocument(document, "DOCUMENT_FRAGMENT_NODE");
       break;
 
     case  XML_NOTATION_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (13 + 3));
-      strcpy(*nodeType, "NOTATION_NODE");
+      *nodeType = copyStringToDocument(document, "NOTATION_NODE");
       break;
 
     default:
-      *nodeType = (char*) malloc ( sizeof(char)* (12 + 3));
-      strcpy(*nodeType, "UNKNOWN_NODE");
+      *nodeType = copyStringToDocument(document, "UNKNOWN_NODE");
       break;
     }
 
-    error = addToMemoryList(document, (void *) *nodeType);
+    error = *nodeType ? SUCCESS : FAILED;
   }
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiGetNodeType(const TixiDocumentHandle handle, const char *nodePath, char **nodeType)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetNodeTypeUnlocked(handle, nodePath, nodeType);
+  unlockDocument(document);
+  return error;
+}
+
 void tixiDefaultMessageHandler(MessageType type, const char *message)
 {
   // only show errors and warnings by default
@@ -3147,7 +5196,7 @@ void tixiDefaultMessageHandler(MessageType type, const char *message)
   }
 }
 
-DLL_EXPORT ReturnCode tixiRegisterNamespace(const TixiDocumentHandle handle, const char* namespaceURI, const char* prefix)
+static ReturnCode tixiRegisterNamespaceUnlocked(const TixiDocumentHandle handle, const char* namespaceURI, const char* prefix)
 {
   TixiDocument *document = getDocument(handle);
   int code = 0;
@@ -3158,6 +5207,7 @@ DLL_EXPORT ReturnCode tixiRegisterNamespace(const TixiDocumentHandle handle, con
   }
 
   code = XPathRegisterNamespace(document->xpathContext, namespaceURI, prefix);
+  XPathUpdateThreadContexts(document);
   if (code == 0) {
     return SUCCESS;
   }
@@ -3166,7 +5216,15 @@ DLL_EXPORT ReturnCode tixiRegisterNamespace(const TixiDocumentHandle handle, con
   }
 }
 
-DLL_EXPORT ReturnCode tixiRegisterNamespacesFromDocument(const TixiDocumentHandle handle)
+DLL_EXPORT ReturnCode tixiRegisterNamespace(const TixiDocumentHandle handle, const char* namespaceURI, const char* prefix)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiRegisterNamespaceUnlocked(handle, namespaceURI, prefix);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiRegisterNamespacesFromDocumentUnlocked(const TixiDocumentHandle handle)
 {
   TixiDocument *document = getDocument(handle);
   int code = 0;
@@ -3177,6 +5235,7 @@ DLL_EXPORT ReturnCode tixiRegisterNamespacesFromDocument(const TixiDocumentHandl
   }
 
   code = XPathRegisterDocumentNamespaces(document->xpathContext);
+  XPathUpdateThreadContexts(document);
   if (code == 0) {
     return SUCCESS;
   }
@@ -3185,7 +5244,15 @@ DLL_EXPORT ReturnCode tixiRegisterNamespacesFromDocument(const TixiDocumentHandl
   }
 }
 
-DLL_EXPORT ReturnCode tixiSetElementNamespace(const TixiDocumentHandle handle, const char* elementPath, const char* namespaceURI, const char* prefix)
+DLL_EXPORT ReturnCode tixiRegisterNamespacesFromDocument(const TixiDocumentHandle handle)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiRegisterNamespacesFromDocumentUnlocked(handle);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiSetElementNamespaceUnlocked(const TixiDocumentHandle handle, const char* elementPath, const char* namespaceURI, const char* prefix)
 {
   xmlNodePtr node = NULL;
   ReturnCode retval = SUCCESS;
@@ -3211,6 +5278,8 @@ DLL_EXPORT ReturnCode tixiSetElementNamespace(const TixiDocumentHandle handle, c
     return INVALID_XPATH;
   }
 
+  /* the indexes of the parent contain only children without namespace */
+  invalidateChildIndex(document, node->parent);
   if (!nodeSetNamespace(document->docPtr, node, prefix, namespaceURI)) {
     return FAILED;
   }
@@ -3219,7 +5288,15 @@ DLL_EXPORT ReturnCode tixiSetElementNamespace(const TixiDocumentHandle handle, c
   }
 }
 
-DLL_EXPORT ReturnCode tixiDeclareNamespace(const TixiDocumentHandle handle, const char* elementPath, const char* namespaceURI, const char* prefix)
+DLL_EXPORT ReturnCode tixiSetElementNamespace(const TixiDocumentHandle handle, const char* elementPath, const char* namespaceURI, const char* prefix)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiSetElementNamespaceUnlocked(handle, elementPath, namespaceURI, prefix);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiDeclareNamespaceUnlocked(const TixiDocumentHandle handle, const char* elementPath, const char* namespaceURI, const char* prefix)
 {
   xmlNodePtr node = NULL;
   ReturnCode retval = SUCCESS;
@@ -3258,3 +5335,568 @@ DLL_EXPORT ReturnCode tixiDeclareNamespace(const TixiDocumentHandle handle, cons
     return SUCCESS;
   }
 }
+
+DLL_EXPORT ReturnCode tixiDeclareNamespace(const TixiDocumentHandle handle, const char* elementPath, const char* namespaceURI, const char* prefix)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiDeclareNamespaceUnlocked(handle, elementPath, namespaceURI, prefix);
+  unlockDocument(document);
+  return error;
+}
+
+
+/**
+  The relative paths of the cursor functions are evaluated from the element of
+  the cursor: it is the context node of the XPath context of the calling thread
+  for the duration of the call.
+ */
+static ReturnCode enterNodeCursor(const TixiDocumentHandle handle, TixiNodeCursor cursor, xmlNodePtr *previousNode)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlXPathContextPtr xpathContext = NULL;
+  xmlNodePtr node = NULL;
+  ReturnCode error = SUCCESS;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = getNodeCursorNode(document, cursor, &node);
+  if (error) {
+    return error;
+  }
+
+  xpathContext = XPathGetContext(document);
+  if (!xpathContext) {
+    return FAILED;
+  }
+  *previousNode = xpathContext->node;
+  xpathContext->node = node;
+  return SUCCESS;
+}
+
+static void leaveNodeCursor(const TixiDocumentHandle handle, xmlNodePtr previousNode)
+{
+  XPathGetContext(getDocument(handle))->node = previousNode;
+}
+
+/* NULL or "" select the element of the cursor itself */
+static const char* cursorPath(const char *relativePath)
+{
+  return (relativePath && relativePath[0] != '\0') ? relativePath : ".";
+}
+
+static ReturnCode tixiGetNodeCursorUnlocked(const TixiDocumentHandle handle, const char *elementPath, TixiNodeCursor *cursor)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
+  ReturnCode error = SUCCESS;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = checkElement(XPathGetContext(document), elementPath, &element);
+  if (!error) {
+    error = createNodeCursor(document, element, cursor);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiGetNodeCursor(const TixiDocumentHandle handle, const char *elementPath, TixiNodeCursor *cursor)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiGetNodeCursorUnlocked(handle, elementPath, cursor);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorGetNodeCursorUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                  TixiNodeCursor *newCursor)
+{
+  xmlNodePtr previousNode = NULL;
+  ReturnCode error = enterNodeCursor(handle, cursor, &previousNode);
+
+  if (!error) {
+    error = tixiGetNodeCursorUnlocked(handle, cursorPath(relativePath), newCursor);
+    leaveNodeCursor(handle, previousNode);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiCursorGetNodeCursor(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                              TixiNodeCursor *newCursor)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiCursorGetNodeCursorUnlocked(handle, cursor, relativePath, newCursor);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiReleaseNodeCursorUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor)
+{
+  TixiDocument *document = getDocument(handle);
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  return releaseNodeCursor(document, cursor);
+}
+
+DLL_EXPORT ReturnCode tixiReleaseNodeCursor(const TixiDocumentHandle handle, TixiNodeCursor cursor)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiReleaseNodeCursorUnlocked(handle, cursor);
+  unlockDocument(document);
+  return error;
+}
+
+/* returns the first element of the node list or NULL */
+static xmlNodePtr firstElement(xmlNodePtr node)
+{
+  while (node && node->type != XML_ELEMENT_NODE) {
+    node = node->next;
+  }
+  return node;
+}
+
+static ReturnCode tixiCursorMoveToFirstChildUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr node = NULL;
+  ReturnCode error = SUCCESS;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = getNodeCursorNode(document, cursor, &node);
+  if (error) {
+    return error;
+  }
+
+  /* errors are reported by printMsg, the externaldata elements are kept */
+  resolveExternalData(document, node, 0);
+
+  node = firstElement(node->children);
+  if (!node) {
+    return NO_CHILDREN;
+  }
+  return setNodeCursorNode(document, cursor, node);
+}
+
+DLL_EXPORT ReturnCode tixiCursorMoveToFirstChild(const TixiDocumentHandle handle, TixiNodeCursor cursor)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiCursorMoveToFirstChildUnlocked(handle, cursor);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorMoveToNextSiblingUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr node = NULL;
+  ReturnCode error = SUCCESS;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = getNodeCursorNode(document, cursor, &node);
+  if (error) {
+    return error;
+  }
+
+  /* the following siblings may be externaldata elements, the node itself is not */
+  if (node->parent) {
+    resolveExternalData(document, node->parent, 0);
+  }
+
+  node = firstElement(node->next);
+  if (!node) {
+    return ELEMENT_NOT_FOUND;
+  }
+  return setNodeCursorNode(document, cursor, node);
+}
+
+DLL_EXPORT ReturnCode tixiCursorMoveToNextSibling(const TixiDocumentHandle handle, TixiNodeCursor cursor)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiCursorMoveToNextSiblingUnlocked(handle, cursor);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorMoveToParentUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr node = NULL;
+  ReturnCode error = SUCCESS;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = getNodeCursorNode(document, cursor, &node);
+  if (error) {
+    return error;
+  }
+
+  node = node->parent;
+  if (!node || node->type != XML_ELEMENT_NODE) {
+    return ELEMENT_NOT_FOUND;
+  }
+  return setNodeCursorNode(document, cursor, node);
+}
+
+DLL_EXPORT ReturnCode tixiCursorMoveToParent(const TixiDocumentHandle handle, TixiNodeCursor cursor)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiCursorMoveToParentUnlocked(handle, cursor);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorGetElementNameUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor, char **name)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr node = NULL;
+  ReturnCode error = SUCCESS;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = getNodeCursorNode(document, cursor, &node);
+  if (error) {
+    return error;
+  }
+
+  *name = copyStringToDocument(document, node->type == XML_ELEMENT_NODE ? (const char *) node->name : "");
+  return *name ? SUCCESS : FAILED;
+}
+
+DLL_EXPORT ReturnCode tixiCursorGetElementName(const TixiDocumentHandle handle, TixiNodeCursor cursor, char **name)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiCursorGetElementNameUnlocked(handle, cursor, name);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorGetPathUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor, char **path)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr node = NULL;
+  xmlChar *nodePath = NULL;
+  ReturnCode error = SUCCESS;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = getNodeCursorNode(document, cursor, &node);
+  if (error) {
+    return error;
+  }
+
+  nodePath = xmlGetNodePath(node);
+  if (!nodePath) {
+    return FAILED;
+  }
+  *path = copyStringToDocument(document, (char *) nodePath);
+  xmlFree(nodePath);
+  return *path ? SUCCESS : FAILED;
+}
+
+DLL_EXPORT ReturnCode tixiCursorGetPath(const TixiDocumentHandle handle, TixiNodeCursor cursor, char **path)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiCursorGetPathUnlocked(handle, cursor, path);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorCheckElementUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath)
+{
+  xmlNodePtr previousNode = NULL;
+  ReturnCode error = enterNodeCursor(handle, cursor, &previousNode);
+
+  if (!error) {
+    error = tixiCheckElementUnlocked(handle, cursorPath(relativePath));
+    leaveNodeCursor(handle, previousNode);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiCursorCheckElement(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiCursorCheckElementUnlocked(handle, cursor, relativePath);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorGetTextElementUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath, char **text)
+{
+  xmlNodePtr previousNode = NULL;
+  ReturnCode error = enterNodeCursor(handle, cursor, &previousNode);
+
+  if (!error) {
+    error = tixiGetTextElementUnlocked(handle, cursorPath(relativePath), text);
+    leaveNodeCursor(handle, previousNode);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiCursorGetTextElement(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath, char **text)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiCursorGetTextElementUnlocked(handle, cursor, relativePath, text);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorGetIntegerElementUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath, int *number)
+{
+  xmlNodePtr previousNode = NULL;
+  ReturnCode error = enterNodeCursor(handle, cursor, &previousNode);
+
+  if (!error) {
+    error = tixiGetIntegerElementUnlocked(handle, cursorPath(relativePath), number);
+    leaveNodeCursor(handle, previousNode);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiCursorGetIntegerElement(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath, int *number)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiCursorGetIntegerElementUnlocked(handle, cursor, relativePath, number);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorGetDoubleElementUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath, double *number)
+{
+  xmlNodePtr previousNode = NULL;
+  ReturnCode error = enterNodeCursor(handle, cursor, &previousNode);
+
+  if (!error) {
+    error = tixiGetDoubleElementUnlocked(handle, cursorPath(relativePath), number);
+    leaveNodeCursor(handle, previousNode);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiCursorGetDoubleElement(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath, double *number)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiCursorGetDoubleElementUnlocked(handle, cursor, relativePath, number);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorGetBooleanElementUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath, int *boolean)
+{
+  xmlNodePtr previousNode = NULL;
+  ReturnCode error = enterNodeCursor(handle, cursor, &previousNode);
+
+  if (!error) {
+    error = tixiGetBooleanElementUnlocked(handle, cursorPath(relativePath), boolean);
+    leaveNodeCursor(handle, previousNode);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiCursorGetBooleanElement(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath, int *boolean)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiCursorGetBooleanElementUnlocked(handle, cursor, relativePath, boolean);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorGetTextAttributeUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                     const char *attributeName, char **text)
+{
+  xmlNodePtr previousNode = NULL;
+  ReturnCode error = enterNodeCursor(handle, cursor, &previousNode);
+
+  if (!error) {
+    error = tixiGetTextAttributeUnlocked(handle, cursorPath(relativePath), attributeName, text);
+    leaveNodeCursor(handle, previousNode);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiCursorGetTextAttribute(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                 const char *attributeName, char **text)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiCursorGetTextAttributeUnlocked(handle, cursor, relativePath, attributeName, text);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorGetDoubleAttributeUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                       const char *attributeName, double *number)
+{
+  xmlNodePtr previousNode = NULL;
+  ReturnCode error = enterNodeCursor(handle, cursor, &previousNode);
+
+  if (!error) {
+    error = tixiGetDoubleAttributeUnlocked(handle, cursorPath(relativePath), attributeName, number);
+    leaveNodeCursor(handle, previousNode);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiCursorGetDoubleAttribute(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                   const char *attributeName, double *number)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiCursorGetDoubleAttributeUnlocked(handle, cursor, relativePath, attributeName, number);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorGetIntegerAttributeUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                        const char *attributeName, int *number)
+{
+  xmlNodePtr previousNode = NULL;
+  ReturnCode error = enterNodeCursor(handle, cursor, &previousNode);
+
+  if (!error) {
+    error = tixiGetIntegerAttributeUnlocked(handle, cursorPath(relativePath), attributeName, number);
+    leaveNodeCursor(handle, previousNode);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiCursorGetIntegerAttribute(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                    const char *attributeName, int *number)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_READ);
+  ReturnCode error = tixiCursorGetIntegerAttributeUnlocked(handle, cursor, relativePath, attributeName, number);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorUpdateTextElementUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath, const char *text)
+{
+  xmlNodePtr previousNode = NULL;
+  ReturnCode error = enterNodeCursor(handle, cursor, &previousNode);
+
+  if (!error) {
+    error = tixiUpdateTextElementUnlocked(handle, cursorPath(relativePath), text);
+    leaveNodeCursor(handle, previousNode);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiCursorUpdateTextElement(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath, const char *text)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiCursorUpdateTextElementUnlocked(handle, cursor, relativePath, text);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorUpdateDoubleElementUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                        double number, const char *format)
+{
+  xmlNodePtr previousNode = NULL;
+  ReturnCode error = enterNodeCursor(handle, cursor, &previousNode);
+
+  if (!error) {
+    error = tixiUpdateDoubleElementUnlocked(handle, cursorPath(relativePath), number, format);
+    leaveNodeCursor(handle, previousNode);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiCursorUpdateDoubleElement(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                    double number, const char *format)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiCursorUpdateDoubleElementUnlocked(handle, cursor, relativePath, number, format);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorUpdateIntegerElementUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                         int number, const char *format)
+{
+  xmlNodePtr previousNode = NULL;
+  ReturnCode error = enterNodeCursor(handle, cursor, &previousNode);
+
+  if (!error) {
+    error = tixiUpdateIntegerElementUnlocked(handle, cursorPath(relativePath), number, format);
+    leaveNodeCursor(handle, previousNode);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiCursorUpdateIntegerElement(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                     int number, const char *format)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiCursorUpdateIntegerElementUnlocked(handle, cursor, relativePath, number, format);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorAddTextAttributeUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                     const char *attributeName, const char *attributeValue)
+{
+  xmlNodePtr previousNode = NULL;
+  ReturnCode error = enterNodeCursor(handle, cursor, &previousNode);
+
+  if (!error) {
+    error = tixiAddTextAttributeUnlocked(handle, cursorPath(relativePath), attributeName, attributeValue);
+    leaveNodeCursor(handle, previousNode);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiCursorAddTextAttribute(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                 const char *attributeName, const char *attributeValue)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiCursorAddTextAttributeUnlocked(handle, cursor, relativePath, attributeName, attributeValue);
+  unlockDocument(document);
+  return error;
+}
+
+static ReturnCode tixiCursorAddDoubleAttributeUnlocked(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                       const char *attributeName, double number, const char *format)
+{
+  xmlNodePtr previousNode = NULL;
+  ReturnCode error = enterNodeCursor(handle, cursor, &previousNode);
+
+  if (!error) {
+    error = tixiAddDoubleAttributeUnlocked(handle, cursorPath(relativePath), attributeName, number, format);
+    leaveNodeCursor(handle, previousNode);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiCursorAddDoubleAttribute(const TixiDocumentHandle handle, TixiNodeCursor cursor, const char *relativePath,
+                                                   const char *attributeName, double number, const char *format)
+{
+  TixiDocument *document = lockDocument(handle, DOCUMENT_WRITE);
+  ReturnCode error = tixiCursorAddDoubleAttributeUnlocked(handle, cursor, relativePath, attributeName, number, format);
+  unlockDocument(document);
+  return error;
+}
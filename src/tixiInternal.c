@@ -23,12 +23,15 @@
 #include <stdlib.h>
 #include <stdarg.h>
 #include <ctype.h>
+#include <locale.h>
+#include <limits.h>
 
 #include "tixi.h"
 #include "tixiData.h"
 #include "tixiInternal.h"
 #include "xpathFunctions.h"
 #include "uidHelper.h"
+#include "arrayHelper.h"
 #include "tixiUtils.h"
 #include "webMethods.h"
 #include "namespaceFunctions.h"
@@ -46,682 +49,2700 @@
 
 extern void printMsg(MessageType type, const char* message, ...);
 
-InternalReturnCode clearMemoryList(TixiDocument* document)
+/**
+   Layout of the arena of memory returned to the user
+ */
+#define MEMORY_ALIGNMENT 16
+#define MEMORY_ALIGN(size) (((size) + MEMORY_ALIGNMENT - 1) & ~((size_t) MEMORY_ALIGNMENT - 1))
+#define MEMORY_CHUNK_HEADER MEMORY_ALIGN(sizeof(TixiMemoryChunk))
+#define MEMORY_CHUNK_SIZE (64 * 1024)
+#define MEMORY_LARGE_BLOCK (MEMORY_CHUNK_SIZE / 4)
+
+/* frees the chunks from the given one back to (excluding) the last one */
+static void freeMemoryChunks(TixiMemoryChunk* chunk, TixiMemoryChunk* last)
 {
-
-  TixiMemoryListEntry* current = document->memoryListHead;
-
-  while (current) {
-
-    TixiMemoryListEntry* next = (TixiMemoryListEntry*) current->next;
-    free(current->memory);
-    free(current);
-    current = next;
+  while (chunk != last) {
+    TixiMemoryChunk* previous = chunk->previous;
+    free(chunk);
+    chunk = previous;
   }
-  document->memoryListHead = NULL;
-  document->memoryListTail = NULL;
-  return SUCCESS;
 }
 
-void freeTixiDocument(TixiDocument* document)
+static TixiMemoryChunk* addMemoryChunk(TixiDocument* document)
 {
-  if (document->xmlFilename) {
-    free(document->xmlFilename);
-    document->xmlFilename = NULL;
-  }
+  TixiMemoryChunk* chunk = (TixiMemoryChunk*) malloc(MEMORY_CHUNK_HEADER + MEMORY_CHUNK_SIZE);
 
-  if (document->validationFilename) {
-    free(document->validationFilename);
-    document->validationFilename = NULL;
+  if (chunk) {
+    chunk->size = MEMORY_CHUNK_SIZE;
+    chunk->used = 0;
+    chunk->previous = document->memoryChunks;
+    document->memoryChunks = chunk;
   }
+  return chunk;
+}
 
-  if (document->dirname) {
-    free(document->dirname);
-    document->dirname = NULL;
-  }
+void clearDocumentMemory(TixiDocument* document)
+{
+  freeMemoryChunks(document->memoryChunks, NULL);
+  freeMemoryChunks(document->largeMemoryBlocks, NULL);
+  free(document->memoryMarks);
+  document->memoryChunks = NULL;
+  document->largeMemoryBlocks = NULL;
+  document->memoryMarks = NULL;
+  document->nMemoryMarks = 0;
+  document->memoryMarksSize = 0;
+  document->retainedBytes = 0;
+  document->retainedEntries = 0;
+}
 
-  if (document->filename) {
-    free(document->filename);
-    document->filename = NULL;
+void* allocateDocumentMemory(TixiDocument* document, size_t size)
+{
+  TixiMemoryChunk* chunk = NULL;
+  void* memory = NULL;
+
+  size = MEMORY_ALIGN(size > 0 ? size : 1);
+
+  /* getters running in parallel on the same document allocate too */
+  mutex_lock(&document->memoryMutex);
+
+  if (size > MEMORY_LARGE_BLOCK) {
+    /* large blocks get their own allocation, not to waste the current chunk */
+    chunk = (TixiMemoryChunk*) malloc(MEMORY_CHUNK_HEADER + size);
+    if (chunk) {
+      chunk->size = size;
+      chunk->used = size;
+      chunk->previous = document->largeMemoryBlocks;
+      document->largeMemoryBlocks = chunk;
+      document->retainedBytes += size;
+      document->retainedEntries++;
+      memory = (char*) chunk + MEMORY_CHUNK_HEADER;
+    }
+    mutex_unlock(&document->memoryMutex);
+    return memory;
   }
-  clearMemoryList(document);
-  uid_clearUIDList(document);
 
-  if (document->xpathContext) {
-      xmlXPathFreeContext(document->xpathContext);
-      document->xpathContext = NULL;
+  chunk = document->memoryChunks;
+  if (!chunk || chunk->size - chunk->used < size) {
+    chunk = addMemoryChunk(document);
+    if (!chunk) {
+      mutex_unlock(&document->memoryMutex);
+      return NULL;
+    }
   }
 
-  xmlFreeDoc(document->docPtr);
+  memory = (char*) chunk + MEMORY_CHUNK_HEADER + chunk->used;
+  chunk->used += size;
+  document->retainedBytes += size;
+  document->retainedEntries++;
 
-  free(document);
+  mutex_unlock(&document->memoryMutex);
+  return memory;
 }
 
-InternalReturnCode addDocumentToList(TixiDocument* document, TixiDocumentHandle* handle)
+ReturnCode checkpointDocumentMemory(TixiDocument* document, int* mark)
 {
+  TixiMemoryMark* memoryMark = NULL;
 
-  TixiDocumentListEntry* currentEntry = documentListHead;
-  static int handleCounter = 0;
+  mutex_lock(&document->memoryMutex);
 
-  if (documentListHead) {
+  if (document->nMemoryMarks >= DOCUMENT_HANDLE_SLOT_MASK) {
+    mutex_unlock(&document->memoryMutex);
+    return FAILED;
+  }
 
-    while (currentEntry->next) {
-      currentEntry = (TixiDocumentListEntry*) currentEntry->next;
+  if (document->nMemoryMarks == document->memoryMarksSize) {
+    int newSize = document->memoryMarksSize > 0 ? 2 * document->memoryMarksSize : 8;
+    TixiMemoryMark* newMarks = (TixiMemoryMark*) realloc(document->memoryMarks, newSize * sizeof(TixiMemoryMark));
+    if (!newMarks) {
+      mutex_unlock(&document->memoryMutex);
+      return FAILED;
     }
+    document->memoryMarks = newMarks;
+    document->memoryMarksSize = newSize;
+  }
 
-    currentEntry->next = (struct TixiDocumentListEntry*)
-        malloc(sizeof(TixiDocumentListEntry));
+  /* a current chunk for the mark, it is reused after each release */
+  if (!document->memoryChunks && !addMemoryChunk(document)) {
+    mutex_unlock(&document->memoryMutex);
+    return FAILED;
+  }
 
-    if (!currentEntry->next) {
+  memoryMark = &document->memoryMarks[document->nMemoryMarks];
+  memoryMark->chunk = document->memoryChunks;
+  memoryMark->used = document->memoryChunks->used;
+  memoryMark->largeBlocks = document->largeMemoryBlocks;
+  memoryMark->retainedBytes = document->retainedBytes;
+  memoryMark->retainedEntries = document->retainedEntries;
+  memoryMark->generation = document->memoryMarkGeneration++;
 
-      return MEMORY_ALLOCATION_FAILED;
-    }
+  /* like document handles, marks encode the position and the generation, so a mark
+     discarded by a release is not mistaken for a later checkpoint at its position */
+  *mark = (int) ((memoryMark->generation & DOCUMENT_HANDLE_GENERATION_MASK) << DOCUMENT_HANDLE_SLOT_BITS)
+          | (document->nMemoryMarks + 1);
+  document->nMemoryMarks++;
 
-    currentEntry = (TixiDocumentListEntry*) currentEntry->next;
-  }
-  else {
+  mutex_unlock(&document->memoryMutex);
+  return SUCCESS;
+}
 
-    currentEntry = (TixiDocumentListEntry*) malloc(sizeof(TixiDocumentListEntry));
+ReturnCode releaseDocumentMemoryTo(TixiDocument* document, int mark)
+{
+  TixiMemoryMark* memoryMark = NULL;
+  int index = (mark & DOCUMENT_HANDLE_SLOT_MASK) - 1;
 
-    if (currentEntry) {
-      documentListHead = currentEntry;
-    }
-    else {
-      return MEMORY_ALLOCATION_FAILED;
-    }
+  mutex_lock(&document->memoryMutex);
+
+  if (mark <= 0 || index < 0 || index >= document->nMemoryMarks ||
+      (unsigned int) (mark >> DOCUMENT_HANDLE_SLOT_BITS)
+          != (document->memoryMarks[index].generation & DOCUMENT_HANDLE_GENERATION_MASK)) {
+    mutex_unlock(&document->memoryMutex);
+    return INDEX_OUT_OF_RANGE;
   }
 
-  currentEntry->document = document;
-  currentEntry->next = NULL;
+  memoryMark = &document->memoryMarks[index];
+  freeMemoryChunks(document->memoryChunks, memoryMark->chunk);
+  freeMemoryChunks(document->largeMemoryBlocks, memoryMark->largeBlocks);
+  document->memoryChunks = memoryMark->chunk;
+  document->memoryChunks->used = memoryMark->used;
+  document->largeMemoryBlocks = memoryMark->largeBlocks;
+  document->retainedBytes = memoryMark->retainedBytes;
+  document->retainedEntries = memoryMark->retainedEntries;
 
-  handleCounter++;
-  *handle = handleCounter;
+  /* later marks point to released memory, the mark itself can be reused */
+  document->nMemoryMarks = index + 1;
 
+  mutex_unlock(&document->memoryMutex);
   return SUCCESS;
 }
 
-ReturnCode removeDocumentFromList(TixiDocumentHandle handle)
+void getDocumentMemoryUsage(TixiDocument* document, size_t* bytes, size_t* entries)
 {
+  mutex_lock(&document->memoryMutex);
+  *bytes = document->retainedBytes;
+  *entries = document->retainedEntries;
+  mutex_unlock(&document->memoryMutex);
+}
 
-  TixiDocumentListEntry* currentEntry = documentListHead;
-  TixiDocumentListEntry* previousEntry = NULL;
+ReturnCode createNodeCursor(TixiDocument* document, xmlNodePtr node, TixiNodeCursor* cursor)
+{
+  TixiNodeCursorSlot* slot = NULL;
+  int index = -1;
 
-  ReturnCode returnValue = SUCCESS;
+  mutex_lock(&document->nodeCursorsMutex);
 
-  if (documentListHead) {
+  if (document->freeNodeCursorHead >= 0) {
+    /* reuse a released slot */
+    index = document->freeNodeCursorHead;
+    document->freeNodeCursorHead = document->nodeCursors[index].nextFree;
+  }
+  else {
+    if (document->nodeCursorCount >= DOCUMENT_HANDLE_SLOT_MASK) {
+      mutex_unlock(&document->nodeCursorsMutex);
+      return FAILED;
+    }
 
-    while (currentEntry) {
+    if (document->nodeCursorCount == document->nodeCursorCapacity) {
+      int newCapacity = document->nodeCursorCapacity > 0 ? 2 * document->nodeCursorCapacity : 16;
+      TixiNodeCursorSlot* newSlots = NULL;
 
-      if (currentEntry->document->handle != handle) {
-        previousEntry = currentEntry;
-        currentEntry = (TixiDocumentListEntry*) currentEntry->next;
-      }
-      else {
-        if (previousEntry) {
-          previousEntry->next = currentEntry->next;
-          free(currentEntry);
-          currentEntry = NULL;
-          returnValue = SUCCESS;
-        }
-        else {
-          documentListHead = (TixiDocumentListEntry*) currentEntry->next;
-          free(currentEntry);
-          currentEntry = NULL;
-          returnValue = SUCCESS;
-        }
+      newSlots = (TixiNodeCursorSlot*) realloc(document->nodeCursors, newCapacity * sizeof(TixiNodeCursorSlot));
+      if (!newSlots) {
+        mutex_unlock(&document->nodeCursorsMutex);
+        return FAILED;
       }
+      document->nodeCursors = newSlots;
+      document->nodeCursorCapacity = newCapacity;
     }
-  }
-  else {
-    returnValue = FAILED;
+
+    index = document->nodeCursorCount++;
+    document->nodeCursors[index].generation = 0;
   }
 
-  return returnValue;
-}
+  slot = &document->nodeCursors[index];
+  slot->node = node;
+  slot->inUse = 1;
+  slot->nextFree = -1;
 
-TixiDocument* getDocument(TixiDocumentHandle handle)
-{
+  *cursor = (int) ((slot->generation & DOCUMENT_HANDLE_GENERATION_MASK) << DOCUMENT_HANDLE_SLOT_BITS)
+            | (index + 1);
 
-  TixiDocumentListEntry* currentEntry = documentListHead;
-  TixiDocument* returnValue = NULL;
+  mutex_unlock(&document->nodeCursorsMutex);
+  return SUCCESS;
+}
 
-  if (currentEntry) {
-    while (currentEntry && returnValue == NULL) {
+/* returns the slot of the cursor or NULL, nodeCursorsMutex has to be locked */
+static TixiNodeCursorSlot* lookupNodeCursor(TixiDocument* document, TixiNodeCursor cursor)
+{
+  int index = (cursor & DOCUMENT_HANDLE_SLOT_MASK) - 1;
+  TixiNodeCursorSlot* slot = NULL;
 
-      if (currentEntry->document->handle != handle) {
-        currentEntry = (TixiDocumentListEntry*) currentEntry->next;
-      }
-      else {
-        returnValue = currentEntry->document;
-      }
-    }
+  if (cursor <= 0 || index < 0 || index >= document->nodeCursorCount) {
+    return NULL;
   }
-  else {
-    returnValue = NULL;
+
+  slot = &document->nodeCursors[index];
+  if (!slot->inUse ||
+      (unsigned int) (cursor >> DOCUMENT_HANDLE_SLOT_BITS) != (slot->generation & DOCUMENT_HANDLE_GENERATION_MASK)) {
+    return NULL;
   }
 
-  return returnValue;
+  return slot;
 }
 
-InternalReturnCode addToMemoryList(TixiDocument* document, void* memory)
+ReturnCode releaseNodeCursor(TixiDocument* document, TixiNodeCursor cursor)
 {
+  TixiNodeCursorSlot* slot = NULL;
 
-  TixiMemoryListEntry* currentEntry = document->memoryListTail;
+  mutex_lock(&document->nodeCursorsMutex);
 
-  if (currentEntry) {
+  slot = lookupNodeCursor(document, cursor);
+  if (!slot) {
+    mutex_unlock(&document->nodeCursorsMutex);
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid node cursor.\n");
+    return INVALID_CURSOR;
+  }
 
-    currentEntry->next = (struct TixiMemoryListEntry*) malloc(sizeof(TixiMemoryListEntry));
+  slot->node = NULL;
+  slot->inUse = 0;
+  slot->generation++;
+  slot->nextFree = document->freeNodeCursorHead;
+  document->freeNodeCursorHead = (int) (slot - document->nodeCursors);
 
-    if (currentEntry->next) {
-      currentEntry = (TixiMemoryListEntry*) currentEntry->next;
-      document->memoryListTail = currentEntry;
-    }
-    else {
-      return MEMORY_ALLOCATION_FAILED;
-    }
-  }
-  else {
+  mutex_unlock(&document->nodeCursorsMutex);
+  return SUCCESS;
+}
+
+ReturnCode getNodeCursorNode(TixiDocument* document, TixiNodeCursor cursor, xmlNodePtr* node)
+{
+  TixiNodeCursorSlot* slot = NULL;
 
-    currentEntry = (TixiMemoryListEntry*) malloc(sizeof(TixiMemoryListEntry));
+  mutex_lock(&document->nodeCursorsMutex);
 
-    if (currentEntry) {
-      document->memoryListHead = currentEntry;
-      document->memoryListTail = currentEntry;
+  slot = lookupNodeCursor(document, cursor);
+  if (!slot || !slot->node) {
+    mutex_unlock(&document->nodeCursorsMutex);
+    if (slot) {
+      printMsg(MESSAGETYPE_ERROR, "Error: The element of the node cursor has been removed.\n");
     }
     else {
-      return MEMORY_ALLOCATION_FAILED;
+      printMsg(MESSAGETYPE_ERROR, "Error: Invalid node cursor.\n");
     }
+    return INVALID_CURSOR;
   }
+  *node = slot->node;
 
-  currentEntry->memory = memory;
-  currentEntry->next = NULL;
-
+  mutex_unlock(&document->nodeCursorsMutex);
   return SUCCESS;
 }
 
-ReturnCode checkExistence(const xmlXPathContextPtr xpathContext, const char* elementPath, xmlXPathObjectPtr* xpathObject)
+ReturnCode setNodeCursorNode(TixiDocument* document, TixiNodeCursor cursor, xmlNodePtr node)
 {
+  TixiNodeCursorSlot* slot = NULL;
 
-  *xpathObject = NULL;
-
-  *xpathObject = xmlXPathEvalExpression((const xmlChar*) elementPath, xpathContext);
-  if (!(*xpathObject)) {
-    printMsg(MESSAGETYPE_ERROR, "Error: Invalid XPath expression \"%s\"\n", elementPath);
-    //xmlXPathFreeObject(*xpathObject);
-    *xpathObject = NULL;
-    return INVALID_XPATH;
-  }
+  mutex_lock(&document->nodeCursorsMutex);
 
-  if (xmlXPathNodeSetIsEmpty((*xpathObject)->nodesetval)) {
-    xmlXPathFreeObject(*xpathObject);
-    *xpathObject = NULL;
-    return ELEMENT_NOT_FOUND;
+  slot = lookupNodeCursor(document, cursor);
+  if (!slot || !slot->node) {
+    mutex_unlock(&document->nodeCursorsMutex);
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid node cursor.\n");
+    return INVALID_CURSOR;
   }
+  slot->node = node;
 
+  mutex_unlock(&document->nodeCursorsMutex);
   return SUCCESS;
 }
 
-
-
-ReturnCode checkExternalNode(const xmlNodePtr element)
+void invalidateNodeCursors(TixiDocument* document, xmlNodePtr removedNode)
 {
-  ReturnCode error = FAILED;
-  xmlChar* xmlAttribute = NULL;
+  int index;
 
-  /* check attribute externalDataNodePath */
-  xmlAttribute = xmlGetProp(element, (const xmlChar*) EXTERNAL_DATA_XML_ATTR_NODEPATH);
-  if (xmlAttribute != NULL) {
-    error = SUCCESS;
-  }
-  else {
-    return FAILED;
+  /* cursors point to elements only, text and attributes do not contain elements */
+  if (removedNode->type != XML_ELEMENT_NODE) {
+    return;
   }
-  xmlFree(xmlAttribute);
 
-  /* check attribute externalFileName */
-  xmlAttribute = xmlGetProp(element, (const xmlChar*) EXTERNAL_DATA_XML_ATTR_FILENAME);
-  if (xmlAttribute != NULL) {
-    error = SUCCESS;
-  }
-  else {
-    return FAILED;
+  mutex_lock(&document->nodeCursorsMutex);
+
+  for (index = 0; index < document->nodeCursorCount; ++index) {
+    TixiNodeCursorSlot* slot = &document->nodeCursors[index];
+    xmlNodePtr node = NULL;
+
+    /* the cursor is invalid, if its node is inside of the removed subtree */
+    for (node = slot->node; node; node = node->parent) {
+      if (node == removedNode) {
+        slot->node = NULL;
+        break;
+      }
+    }
   }
-  xmlFree(xmlAttribute);
 
-  /* check attribute externalDataDirectory */
-  xmlAttribute = xmlGetProp(element, (const xmlChar*) EXTERNAL_DATA_XML_ATTR_DIRECTORY);
-  if (xmlAttribute != NULL) {
-    error = SUCCESS;
+  mutex_unlock(&document->nodeCursorsMutex);
+}
+
+#define INITIAL_CHILD_INDEX_BUCKETS 64
+
+static size_t hashChildIndexParent(xmlNodePtr parent, int bucketCount)
+{
+  size_t key = (size_t) parent >> 4;
+  return (size_t) ((key * 2654435761u) ^ (key >> 16)) & (size_t) (bucketCount - 1);
+}
+
+static int childIndexNameEquals(const char* indexName, const char* name, size_t nameLength)
+{
+  if (!indexName || !name) {
+    return indexName == name;
   }
-  else {
-    return FAILED;
+  return strncmp(indexName, name, nameLength) == 0 && indexName[nameLength] == '\0';
+}
+
+static int isIndexedChild(xmlNodePtr child, const char* name, size_t nameLength)
+{
+  if (!name) {
+    /* DTD nodes are not selected by XPath */
+    return child->type != XML_DTD_NODE;
   }
-  xmlFree(xmlAttribute);
-  return error;
+  return child->type == XML_ELEMENT_NODE && !child->ns
+      && strncmp((const char*) child->name, name, nameLength) == 0 && child->name[nameLength] == '\0';
 }
 
+static void freeChildIndex(TixiChildIndex* index)
+{
+  free(index->name);
+  free(index->children);
+  free(index);
+}
 
-ReturnCode checkElement(const xmlXPathContextPtr xpathContext, const char* elementPathDirty,
-                        xmlNodePtr* element)
+/* doubles the number of buckets, childIndexMutex has to be locked */
+static int growChildIndexTable(TixiDocument* document)
 {
+  int newCount = document->childIndexBucketCount > 0 ? 2 * document->childIndexBucketCount : INITIAL_CHILD_INDEX_BUCKETS;
+  TixiChildIndex** newBuckets = (TixiChildIndex**) calloc((size_t) newCount, sizeof(TixiChildIndex*));
+  int iBucket;
+
+  if (!newBuckets) {
+    return 0;
+  }
+
+  for (iBucket = 0; iBucket < document->childIndexBucketCount; ++iBucket) {
+    TixiChildIndex* index = document->childIndexBuckets[iBucket];
+    while (index) {
+      TixiChildIndex* next = index->next;
+      size_t bucket = hashChildIndexParent(index->parent, newCount);
+      index->next = newBuckets[bucket];
+      newBuckets[bucket] = index;
+      index = next;
+    }
+  }
 
-  xmlNodeSetPtr nodes = NULL;
-  char elementPath[1024];
+  free(document->childIndexBuckets);
+  document->childIndexBuckets = newBuckets;
+  document->childIndexBucketCount = newCount;
+  return 1;
+}
 
-  xmlXPathObjectPtr xpathObject = NULL;
+/* creates the index of the children of parent, childIndexMutex has to be locked */
+static TixiChildIndex* createChildIndex(TixiDocument* document, xmlNodePtr parent, const char* name, size_t nameLength)
+{
+  TixiChildIndex* index = NULL;
+  xmlNodePtr child = NULL;
+  size_t bucket;
+  int nChildren = 0;
 
-  /* remove trailing slash */
-  strncpy(elementPath, elementPathDirty, 1024);
-  if(strlen(elementPath) > 1 && elementPath[strlen(elementPath)-1] == '/') {
-    elementPath[strlen(elementPath)-1] = '\0';
+  if (document->childIndexCount >= document->childIndexBucketCount && !growChildIndexTable(document)) {
+    return NULL;
   }
 
-  /* Evaluate Expression */
-  xpathObject = xmlXPathEvalExpression((xmlChar*) elementPath, xpathContext);
-  if (!xpathObject) {
-    printMsg(MESSAGETYPE_ERROR, "Error: Invalid XPath expression \"%s\"\n", elementPath);
-    return INVALID_XPATH;
+  for (child = parent->children; child; child = child->next) {
+    if (isIndexedChild(child, name, nameLength)) {
+      nChildren++;
+    }
   }
 
-  if (xmlXPathNodeSetIsEmpty(xpathObject->nodesetval)) {
-    char * errorStr = buildString("Error: element %s not found!", elementPath);
-    xmlXPathFreeObject(xpathObject);
+  index = (TixiChildIndex*) calloc(1, sizeof(TixiChildIndex));
+  if (!index) {
+    return NULL;
+  }
+  if (name) {
+    index->name = (char*) malloc(nameLength + 1);
+  }
+  if (nChildren > 0) {
+    index->children = (xmlNodePtr*) malloc((size_t) nChildren * sizeof(xmlNodePtr));
+  }
+  if ((name && !index->name) || (nChildren > 0 && !index->children)) {
+    freeChildIndex(index);
+    return NULL;
+  }
+  if (name) {
+    memcpy(index->name, name, nameLength);
+    index->name[nameLength] = '\0';
+  }
 
-    printMsg(MESSAGETYPE_STATUS, errorStr);
-    free(errorStr);
-    return ELEMENT_NOT_FOUND;
+  for (child = parent->children; child; child = child->next) {
+    if (isIndexedChild(child, name, nameLength)) {
+      index->children[index->nChildren++] = child;
+    }
   }
 
-  nodes = xpathObject->nodesetval;
-  assert(nodes);
+  index->parent = parent;
+  bucket = hashChildIndexParent(parent, document->childIndexBucketCount);
+  index->next = document->childIndexBuckets[bucket];
+  document->childIndexBuckets[bucket] = index;
+  document->childIndexCount++;
+  return index;
+}
 
-  if (nodes->nodeNr > 1) {
-    printMsg(MESSAGETYPE_ERROR,
-             "Error: Element chosen by XPath \"%s\" expression is not unique. \n", elementPath);
-    xmlXPathFreeObject(xpathObject);
-    return ELEMENT_PATH_NOT_UNIQUE;
-  }
+int getIndexedChild(TixiDocument* document, xmlNodePtr parent, const char* name, size_t nameLength,
+                    int position, xmlNodePtr* child)
+{
+  TixiChildIndex* index = NULL;
+  int nChildren = -1;
 
-  assert(nodes->nodeTab[0]);
+  mutex_lock(&document->childIndexMutex);
 
-  if (nodes->nodeTab[0]->type == XML_ELEMENT_NODE || nodes->nodeTab[0]->type == XML_DOCUMENT_NODE) {
-    *element = nodes->nodeTab[0];
-    xmlXPathFreeObject(xpathObject);
-    return SUCCESS;
+  if (document->childIndexBucketCount > 0) {
+    index = document->childIndexBuckets[hashChildIndexParent(parent, document->childIndexBucketCount)];
+    while (index && (index->parent != parent || !childIndexNameEquals(index->name, name, nameLength))) {
+      index = index->next;
+    }
   }
-  else {
-    printMsg(MESSAGETYPE_ERROR,
-             "Error: XPath expression \"%s\"does not point to an element node.\n", elementPath);
-    xmlXPathFreeObject(xpathObject);
-    return NOT_AN_ELEMENT;
+  if (!index) {
+    index = createChildIndex(document, parent, name, nameLength);
   }
-}
 
+  if (index) {
+    nChildren = index->nChildren;
+    *child = position > 0 && position <= nChildren ? index->children[position - 1] : NULL;
+  }
 
-ReturnCode getCoordinateValue(TixiDocument* document, char* pointPath,
-                              int pointIndex, char* name, int ignoreError, double* value)
+  mutex_unlock(&document->childIndexMutex);
+  return nChildren;
+}
+
+/* removes the indexes of the children of parent, childIndexMutex has to be locked */
+static void removeChildIndexes(TixiDocument* document, xmlNodePtr parent)
 {
-  xmlNodePtr coordinate = NULL;
-  ReturnCode error = -1;
-  size_t suffixStringLength = 0;
-  size_t pointPathLength = strlen(pointPath);
-  size_t coordinatePathStringLength = 0;
-  char* coordinatePath = NULL;
-  char* suffixString = buildString("[%d]/%1s", pointIndex, name);
+  TixiChildIndex** bucket = NULL;
 
-  if (!suffixString) {
-    printMsg(MESSAGETYPE_ERROR, "Internal Error: Failed to allocate memory in getCoordinateValue.\n");
-    exit(1);
+  if (document->childIndexCount == 0) {
+    return;
   }
 
-  suffixStringLength = strlen(suffixString);
+  bucket = &document->childIndexBuckets[hashChildIndexParent(parent, document->childIndexBucketCount)];
+  while (*bucket) {
+    TixiChildIndex* index = *bucket;
+    if (index->parent == parent) {
+      *bucket = index->next;
+      freeChildIndex(index);
+      document->childIndexCount--;
+    }
+    else {
+      bucket = &index->next;
+    }
+  }
+}
 
-  coordinatePathStringLength = suffixStringLength + pointPathLength + 1;
+void invalidateChildIndex(TixiDocument* document, xmlNodePtr parent)
+{
+  if (!parent) {
+    return;
+  }
 
-  coordinatePath = (char*) malloc(coordinatePathStringLength * sizeof(char));
-  strcpy(coordinatePath, pointPath);
-  strcat(coordinatePath, suffixString);
+  mutex_lock(&document->childIndexMutex);
+  removeChildIndexes(document, parent);
+  mutex_unlock(&document->childIndexMutex);
+}
 
-  error = checkElement(document->xpathContext, coordinatePath, &coordinate);
+void invalidateChildIndexesOfSubtree(TixiDocument* document, xmlNodePtr removedNode)
+{
+  xmlNodePtr node = removedNode;
 
-  free(coordinatePath);
-  free(suffixString);
-  coordinatePath = NULL;
-  suffixString = NULL;
-  if (!error) {
+  mutex_lock(&document->childIndexMutex);
 
-    char* textPtr = (char*) xmlNodeListGetString(document->docPtr, coordinate->children, 0);
+  if (removedNode->parent) {
+    removeChildIndexes(document, removedNode->parent);
+  }
 
-    if (textPtr) {
-      *value = atof(textPtr);
-      xmlFree(textPtr);
-    }
-    else {
-      error = FAILED;
+  /* walk the removed subtree only, leaves may have an index of their (zero) children as well */
+  while (node && document->childIndexCount > 0) {
+    removeChildIndexes(document, node);
+
+    if (node->children && node->type != XML_ENTITY_REF_NODE) {
+      node = node->children;
+      continue;
     }
-  }
-  else {
-    if (!ignoreError) {
-      printMsg(MESSAGETYPE_ERROR,
-               "Internal Error: point element \"%s\" has no %s-coordinate.\n", pointPath, name);
+    while (node != removedNode && !node->next) {
+      node = node->parent;
     }
-    error = COORDINATE_NOT_FOUND;
+    node = node == removedNode ? NULL : node->next;
   }
 
-  return error;
+  mutex_unlock(&document->childIndexMutex);
 }
 
-ReturnCode getPoint(const TixiDocumentHandle handle, const char* parentPath, const int pointIndex,
-                    int ignoreMissingElements, double* x, double* y, double* z)
+static void freeChildIndexes(TixiDocument* document)
 {
-  ReturnCode error = -1;
-  ReturnCode errorX = -1;
-  ReturnCode errorY = -1;
-  ReturnCode errorZ = -1;
+  int iBucket;
+
+  for (iBucket = 0; iBucket < document->childIndexBucketCount; ++iBucket) {
+    TixiChildIndex* index = document->childIndexBuckets[iBucket];
+    while (index) {
+      TixiChildIndex* next = index->next;
+      freeChildIndex(index);
+      index = next;
+    }
+  }
+  free(document->childIndexBuckets);
+  document->childIndexBuckets = NULL;
+  document->childIndexBucketCount = 0;
+  document->childIndexCount = 0;
+}
 
-  TixiDocument* document = getDocument(handle);
-  xmlNodePtr parent = NULL;
-  char* pointPath = NULL;
-  char* coordinatePathBuffer = NULL;
-  int nPointElements = 0;
+char* copyStringToDocument(TixiDocument* document, const char* string)
+{
+  size_t length = strlen(string) + 1;
+  char* copy = (char*) allocateDocumentMemory(document, length);
+
+  if (copy) {
+    memcpy(copy, string, length);
+  }
+  return copy;
+}
+
+/* true if xmlEncodeEntitiesReentrant would not change the text */
+static int isPlainText(xmlDocPtr doc, const xmlChar* text)
+{
+  int keepNonAscii = doc && doc->encoding;
+
+  for (; *text; ++text) {
+    if (*text == '&' || *text == '<' || *text == '>' || *text == '\r' || (*text >= 0x80 && !keepNonAscii)) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+const char* getNodeListTextDirect(xmlDocPtr doc, xmlNodePtr list, int escape)
+{
+  if (!list) {
+    return "";
+  }
+  if (list->next || (list->type != XML_TEXT_NODE && list->type != XML_CDATA_SECTION_NODE) || !list->content) {
+    return NULL;
+  }
+  if (escape && !isPlainText(doc, list->content)) {
+    return NULL;
+  }
+  return (const char*) list->content;
+}
+
+ReturnCode copyTextToBuffer(const char* text, char* buffer, int bufferSize, int* requiredSize)
+{
+  size_t length = strlen(text);
+
+  if (requiredSize) {
+    *requiredSize = (int) length + 1;
+  }
+  if (!buffer || bufferSize <= 0) {
+    return STRING_TRUNCATED;
+  }
+  if (length >= (size_t) bufferSize) {
+    memcpy(buffer, text, bufferSize - 1);
+    buffer[bufferSize - 1] = '\0';
+    return STRING_TRUNCATED;
+  }
+  memcpy(buffer, text, length + 1);
+  return SUCCESS;
+}
+
+ReturnCode copyNodeListTextToBuffer(xmlDocPtr doc, xmlNodePtr list, int escape, char* buffer, int bufferSize, int* requiredSize)
+{
+  const char* directText = getNodeListTextDirect(doc, list, escape);
+  char* listText = NULL;
+  ReturnCode error = SUCCESS;
+
+  if (directText) {
+    return copyTextToBuffer(directText, buffer, bufferSize, requiredSize);
+  }
+
+  /* several nodes, entities or characters to escape */
+  listText = (char*) xmlNodeListGetString(doc, list, escape ? 0 : 1);
+  error = copyTextToBuffer(listText ? listText : "", buffer, bufferSize, requiredSize);
+  xmlFree(listText);
+  return error;
+}
+
+ReturnCode findAttribute(xmlNodePtr element, const char* attributeName, xmlAttrPtr* attribute)
+{
+  char* prefix = NULL;
+  char* name = NULL;
+  ReturnCode error = SUCCESS;
+
+  extractPrefixAndName(attributeName, &prefix, &name);
+
+  if (prefix) {
+    xmlNsPtr ns = xmlSearchNs(element->doc, element, (xmlChar*) prefix);
+    if (!ns) {
+      printMsg(MESSAGETYPE_ERROR, "Error: unknown namespace prefix \"%s\".\n", prefix);
+      error = INVALID_NAMESPACE_PREFIX;
+    }
+    else {
+      *attribute = xmlHasNsProp(element, (xmlChar*) name, ns->href);
+    }
+    free(prefix);
+  }
+  else {
+    /* same lookup as xmlGetProp */
+    *attribute = xmlHasNsProp(element, (xmlChar*) name, NULL);
+  }
+  free(name);
+
+  if (!error && !*attribute) {
+    error = ATTRIBUTE_NOT_FOUND;
+  }
+  return error;
+}
+
+void freeTixiDocument(TixiDocument* document)
+{
+  if (document->xmlFilename) {
+    free(document->xmlFilename);
+    document->xmlFilename = NULL;
+  }
+
+  if (document->validationFilename) {
+    free(document->validationFilename);
+    document->validationFilename = NULL;
+  }
+
+  if (document->dirname) {
+    free(document->dirname);
+    document->dirname = NULL;
+  }
+
+  if (document->filename) {
+    free(document->filename);
+    document->filename = NULL;
+  }
+  clearDocumentMemory(document);
+  uid_clearUIDTable(document);
+  uid_clearReferenceGraph(document);
+  free(document->nodeCursors);
+  document->nodeCursors = NULL;
+  freeChildIndexes(document);
+  array_clearDescriptors(document);
+
+  XPathFreeThreadContexts(document);
+  if (document->xpathContext) {
+      xmlXPathFreeContext(document->xpathContext);
+      document->xpathContext = NULL;
+  }
+
+  xmlFreeDoc(document->docPtr);
+
+  rwlock_destroy(&document->lock);
+  rwlock_destroy(&document->modificationLock);
+  mutex_destroy(&document->memoryMutex);
+  mutex_destroy(&document->threadContextsMutex);
+  mutex_destroy(&document->nodeCursorsMutex);
+  mutex_destroy(&document->childIndexMutex);
+  mutex_destroy(&document->arrayDescriptorsMutex);
+  mutex_destroy(&document->uidMutex);
+  mutex_destroy(&document->referenceGraphMutex);
+
+  free(document);
+}
+
+/**
+   Handle table of the documents managed by TIXI. The table is protected by
+   documentSlotsLock, the documents itself by their own reader/writer lock.
+ */
+static TixiDocumentSlot* documentSlots = NULL;
+static int documentSlotCapacity = 0;   /* number of allocated slots */
+static int documentSlotCount = 0;      /* number of slots ever used */
+static int freeSlotHead = -1;          /* head of the list of released slots */
+static int openDocumentCount = 0;
+static TixiRWLock documentSlotsLock = TIXI_RWLOCK_INITIALIZER;
+static volatile int documentIdCounter = 0;
+
+/**
+   Document locks held by the current thread. Public functions call each
+   other, so a thread may lock the same document several times. Callbacks
+   like the one of tixiXPathExpressionForEach may lock further documents,
+   the table is moved to the heap if the inline entries are not sufficient.
+ */
+#define INLINE_HELD_DOCUMENT_LOCKS 16
+
+typedef struct
+{
+  TixiDocument* document;
+  DocumentAccessMode mode;
+  int exclusiveRead;      /* read lock upgraded to include external files, see upgradeDocumentLock */
+  int depth;
+} HeldDocumentLock;
+
+static TIXI_THREAD_LOCAL HeldDocumentLock inlineHeldDocumentLocks[INLINE_HELD_DOCUMENT_LOCKS];
+static TIXI_THREAD_LOCAL HeldDocumentLock* allocatedHeldDocumentLocks = NULL;
+static TIXI_THREAD_LOCAL int allocatedHeldDocumentLocksSize = 0;
+static TIXI_THREAD_LOCAL int nHeldDocumentLocks = 0;
+
+/* document, whose lock failed in the current thread, is not returned by getDocument */
+static TIXI_THREAD_LOCAL TixiDocument* failedLockDocument = NULL;
+
+static HeldDocumentLock* getHeldDocumentLocks(void)
+{
+  return allocatedHeldDocumentLocks ? allocatedHeldDocumentLocks : inlineHeldDocumentLocks;
+}
+
+/* makes room for one more held lock, returns 0 if the memory could not be allocated */
+static int reserveHeldDocumentLock(void)
+{
+  HeldDocumentLock* newLocks = NULL;
+  int newSize;
+
+  if (!allocatedHeldDocumentLocks && nHeldDocumentLocks < INLINE_HELD_DOCUMENT_LOCKS) {
+    return 1;
+  }
+  if (allocatedHeldDocumentLocks && nHeldDocumentLocks < allocatedHeldDocumentLocksSize) {
+    return 1;
+  }
+
+  newSize = 2 * nHeldDocumentLocks;
+  newLocks = (HeldDocumentLock*) realloc(allocatedHeldDocumentLocks, newSize * sizeof(HeldDocumentLock));
+  if (!newLocks) {
+    return 0;
+  }
+  if (!allocatedHeldDocumentLocks) {
+    memcpy(newLocks, inlineHeldDocumentLocks, nHeldDocumentLocks * sizeof(HeldDocumentLock));
+  }
+  allocatedHeldDocumentLocks = newLocks;
+  allocatedHeldDocumentLocksSize = newSize;
+  return 1;
+}
+
+/* returns the document of the handle without locking the handle table */
+static TixiDocument* lookupDocument(TixiDocumentHandle handle)
+{
+  int index = (handle & DOCUMENT_HANDLE_SLOT_MASK) - 1;
+  TixiDocumentSlot* slot = NULL;
+
+  if (handle <= 0 || index < 0 || index >= documentSlotCount) {
+    return NULL;
+  }
+
+  slot = &documentSlots[index];
+  if (!slot->document ||
+      (unsigned int) (handle >> DOCUMENT_HANDLE_SLOT_BITS) != (slot->generation & DOCUMENT_HANDLE_GENERATION_MASK)) {
+    return NULL;
+  }
+
+  return slot->document;
+}
+
+/* drops a reference to the document and frees it, if it was the last one */
+static void releaseDocumentReference(TixiDocument* document)
+{
+  if (atomic_decrement(&document->refCount) == 0) {
+    freeTixiDocument(document);
+  }
+}
 
+InternalReturnCode addDocumentToList(TixiDocument* document, TixiDocumentHandle* handle)
+{
+  int index = -1;
+  TixiDocumentSlot* slot = NULL;
+
+  rwlock_init(&document->lock);
+  rwlock_init(&document->modificationLock);
+  mutex_init(&document->memoryMutex);
+  mutex_init(&document->threadContextsMutex);
+  mutex_init(&document->nodeCursorsMutex);
+  mutex_init(&document->childIndexMutex);
+  mutex_init(&document->arrayDescriptorsMutex);
+  mutex_init(&document->uidMutex);
+  mutex_init(&document->referenceGraphMutex);
+  document->threadContexts = NULL;
+  document->arrayDescriptorBuckets = NULL;
+  document->arrayDescriptorBucketCount = 0;
+  document->arrayDescriptorCount = 0;
+  document->nodeCursors = NULL;
+  document->nodeCursorCount = 0;
+  document->nodeCursorCapacity = 0;
+  document->freeNodeCursorHead = -1;
+  document->childIndexBuckets = NULL;
+  document->childIndexBucketCount = 0;
+  document->childIndexCount = 0;
+  document->uidBucketCount = 0;
+  document->uidCount = 0;
+  document->uidDuplicateCount = 0;
+  document->uidEmptyCount = 0;
+  document->uidDuplicate = NULL;
+  document->referenceGraph = NULL;
+  document->memoryMarks = NULL;
+  document->nMemoryMarks = 0;
+  document->memoryMarksSize = 0;
+  document->memoryMarkGeneration = 0;
+  document->retainedBytes = 0;
+  document->retainedEntries = 0;
+  document->id = (unsigned int) atomic_increment(&documentIdCounter);
+  document->refCount = 1; /* reference of the handle table */
+
+  rwlock_writeLock(&documentSlotsLock);
+
+  if (freeSlotHead >= 0) {
+    /* reuse a released slot */
+    index = freeSlotHead;
+    freeSlotHead = documentSlots[index].nextFree;
+  }
+  else {
+    if (documentSlotCount >= DOCUMENT_HANDLE_SLOT_MASK) {
+      rwlock_writeUnlock(&documentSlotsLock);
+      return MEMORY_ALLOCATION_FAILED;
+    }
+
+    if (documentSlotCount == documentSlotCapacity) {
+      int newCapacity = documentSlotCapacity > 0 ? 2 * documentSlotCapacity : 16;
+      TixiDocumentSlot* newSlots = NULL;
+
+      if (newCapacity > DOCUMENT_HANDLE_SLOT_MASK) {
+        newCapacity = DOCUMENT_HANDLE_SLOT_MASK;
+      }
+
+      newSlots = (TixiDocumentSlot*) realloc(documentSlots, newCapacity * sizeof(TixiDocumentSlot));
+      if (!newSlots) {
+        rwlock_writeUnlock(&documentSlotsLock);
+        return MEMORY_ALLOCATION_FAILED;
+      }
+      documentSlots = newSlots;
+      documentSlotCapacity = newCapacity;
+    }
+
+    index = documentSlotCount++;
+    documentSlots[index].generation = 0;
+  }
+
+  slot = &documentSlots[index];
+  slot->nextFree = -1;
+  openDocumentCount++;
+
+  *handle = (int) ((slot->generation & DOCUMENT_HANDLE_GENERATION_MASK) << DOCUMENT_HANDLE_SLOT_BITS)
+            | (index + 1);
+
+  /* the handle must be valid before other threads can find the document */
+  document->handle = *handle;
+  slot->document = document;
+
+  rwlock_writeUnlock(&documentSlotsLock);
+
+  return SUCESS;
+}
+
+ReturnCode removeDocumentFromList(TixiDocumentHandle handle)
+{
+  TixiDocument* document = NULL;
+  TixiDocumentSlot* slot = NULL;
+  int index = (handle & DOCUMENT_HANDLE_SLOT_MASK) - 1;
+
+  rwlock_writeLock(&documentSlotsLock);
+
+  document = lookupDocument(handle);
   if (!document) {
-    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
-    return INVALID_HANDLE;
+    rwlock_writeUnlock(&documentSlotsLock);
+    return FAILED;
   }
 
-  if (pointIndex < 1) {
-    printMsg(MESSAGETYPE_ERROR, "Error: Invalid point index %d\n", pointIndex);
-    return INDEX_OUT_OF_RANGE;
+  slot = &documentSlots[index];
+  slot->document = NULL;
+  slot->generation++;
+  slot->nextFree = freeSlotHead;
+  freeSlotHead = index;
+  openDocumentCount--;
+
+  rwlock_writeUnlock(&documentSlotsLock);
+
+  /* threads still working on the document keep it alive */
+  releaseDocumentReference(document);
+
+  return SUCCESS;
+}
+
+TixiDocument* getDocument(TixiDocumentHandle handle)
+{
+  TixiDocument* document = NULL;
+
+  rwlock_readLock(&documentSlotsLock);
+  document = lookupDocument(handle);
+  rwlock_readUnlock(&documentSlotsLock);
+
+  if (document && document == failedLockDocument) {
+    return NULL;
   }
+  return document;
+}
 
-  error = checkElement(document->xpathContext, parentPath, &parent);
+TixiDocument* lockDocument(TixiDocumentHandle handle, DocumentAccessMode mode)
+{
+  TixiDocument* document = NULL;
+  HeldDocumentLock* heldLocks = getHeldDocumentLocks();
+  int i;
 
-  if (!error) {
+  rwlock_readLock(&documentSlotsLock);
+  document = lookupDocument(handle);
+  if (document) {
+    atomic_increment(&document->refCount);
+  }
+  rwlock_readUnlock(&documentSlotsLock);
 
-    xmlXPathObjectPtr xpathPointObject = NULL;
+  if (!document) {
+    return NULL;
+  }
 
-    size_t lengthPointPath = (strlen(parentPath) +      /* length of path to parent   */
-                              1);      				    /* trailing \0                */
+  for (i = 0; i < nHeldDocumentLocks; ++i) {
+    if (heldLocks[i].document == document) {
+      /* a read lock can not be upgraded, e.g. by a callback modifying the document it is called for */
+      if (mode == DOCUMENT_WRITE && heldLocks[i].mode != DOCUMENT_WRITE) {
+        printMsg(MESSAGETYPE_ERROR, "Error: Document is locked for reading and can not be modified.\n");
+        failedLockDocument = document;
+        releaseDocumentReference(document);
+        return NULL;
+      }
+      heldLocks[i].depth++;
+      return document;
+    }
+  }
 
-    pointPath = (char*) malloc(sizeof(char) * lengthPointPath);
+  /* never hold a lock without recording it, unlockDocument would not release it */
+  if (!reserveHeldDocumentLock()) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Failed allocating memory for the locks of the thread.\n");
+    failedLockDocument = document;
+    releaseDocumentReference(document);
+    return NULL;
+  }
+  heldLocks = getHeldDocumentLocks();
 
-    strcpy(pointPath, parentPath);
+  if (mode == DOCUMENT_WRITE) {
+    rwlock_writeLock(&document->modificationLock);
+    rwlock_writeLock(&document->lock);
+  }
+  else {
+    rwlock_readLock(&document->modificationLock);
+    rwlock_readLock(&document->lock);
+  }
+
+  heldLocks[nHeldDocumentLocks].document = document;
+  heldLocks[nHeldDocumentLocks].mode = mode;
+  heldLocks[nHeldDocumentLocks].exclusiveRead = 0;
+  heldLocks[nHeldDocumentLocks].depth = 1;
+  nHeldDocumentLocks++;
+
+  return document;
+}
+
+void unlockDocument(TixiDocument* document)
+{
+  HeldDocumentLock* heldLocks = getHeldDocumentLocks();
+  int i;
+
+  if (!document) {
+    /* the call of a failed lockDocument */
+    failedLockDocument = NULL;
+    return;
+  }
+
+  for (i = nHeldDocumentLocks - 1; i >= 0; --i) {
+    if (heldLocks[i].document == document) {
+      if (--heldLocks[i].depth == 0) {
+        if (heldLocks[i].mode == DOCUMENT_WRITE) {
+          /* the texts of arrays may have been modified */
+          array_clearDescriptors(document);
+          rwlock_writeUnlock(&document->lock);
+          rwlock_writeUnlock(&document->modificationLock);
+        }
+        else if (heldLocks[i].exclusiveRead) {
+          if (document->externalDataChanged) {
+            array_clearDescriptors(document);
+            document->externalDataChanged = 0;
+          }
+          rwlock_writeUnlock(&document->lock);
+          rwlock_readUnlock(&document->modificationLock);
+        }
+        else {
+          rwlock_readUnlock(&document->lock);
+          rwlock_readUnlock(&document->modificationLock);
+        }
+        heldLocks[i] = heldLocks[--nHeldDocumentLocks];
+        if (nHeldDocumentLocks == 0 && allocatedHeldDocumentLocks) {
+          free(allocatedHeldDocumentLocks);
+          allocatedHeldDocumentLocks = NULL;
+          allocatedHeldDocumentLocksSize = 0;
+        }
+      }
+      break;
+    }
+  }
+
+  releaseDocumentReference(document);
+}
+
+/**
+   Upgrades the read lock of the current thread on the document to an exclusive
+   lock, so that it can include external files. Returns 1 if the lock was released
+   in between. The thread keeps the modificationLock, so only other readers
+   including external files may get in between, which never free the elements
+   of the document other than pending externaldata elements.
+ */
+static int upgradeDocumentLock(TixiDocument* document)
+{
+  HeldDocumentLock* heldLocks = getHeldDocumentLocks();
+  int i;
+
+  for (i = 0; i < nHeldDocumentLocks; ++i) {
+    if (heldLocks[i].document == document) {
+      if (heldLocks[i].mode == DOCUMENT_WRITE || heldLocks[i].exclusiveRead) {
+        return 0;
+      }
+      rwlock_readUnlock(&document->lock);
+      rwlock_writeLock(&document->lock);
+      heldLocks[i].exclusiveRead = 1;
+      return 1;
+    }
+  }
+
+  /* documents not locked by the thread are not shared yet, e.g. while they are opened */
+  return 0;
+}
+
+TixiDocumentHandle getNextDocumentHandle(int* slotIndex)
+{
+  TixiDocumentHandle handle = -1;
+  int index;
+
+  rwlock_readLock(&documentSlotsLock);
+  for (index = *slotIndex; index < documentSlotCount && openDocumentCount > 0; ++index) {
+    if (documentSlots[index].document) {
+      handle = documentSlots[index].document->handle;
+      break;
+    }
+  }
+  *slotIndex = index + 1;
+  rwlock_readUnlock(&documentSlotsLock);
+
+  return handle;
+}
+
+ReturnCode checkExistence(const xmlXPathContextPtr xpathContext, const char* elementPath, xmlXPathObjectPtr* xpathObject)
+{
+
+  *xpathObject = NULL;
+
+  *xpathObject = XPathEvaluate(xpathContext, elementPath);
+  if (!(*xpathObject)) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid XPath expression \"%s\"\n", elementPath);
+    //xmlXPathFreeObject(*xpathObject);
+    *xpathObject = NULL;
+    return INVALID_XPATH;
+  }
+
+  if (xmlXPathNodeSetIsEmpty((*xpathObject)->nodesetval)) {
+    xmlXPathFreeObject(*xpathObject);
+    *xpathObject = NULL;
+    return ELEMENT_NOT_FOUND;
+  }
+
+  return SUCCESS;
+}
+
+
+
+ReturnCode checkExternalNode(const xmlNodePtr element)
+{
+  ReturnCode error = FAILED;
+  xmlChar* xmlAttribute = NULL;
+
+  /* check attribute externalDataNodePath */
+  xmlAttribute = xmlGetProp(element, (const xmlChar*) EXTERNAL_DATA_XML_ATTR_NODEPATH);
+  if (xmlAttribute != NULL) {
+    error = SUCCESS;
+  }
+  else {
+    return FAILED;
+  }
+  xmlFree(xmlAttribute);
+
+  /* check attribute externalFileName */
+  xmlAttribute = xmlGetProp(element, (const xmlChar*) EXTERNAL_DATA_XML_ATTR_FILENAME);
+  if (xmlAttribute != NULL) {
+    error = SUCCESS;
+  }
+  else {
+    return FAILED;
+  }
+  xmlFree(xmlAttribute);
+
+  /* check attribute externalDataDirectory */
+  xmlAttribute = xmlGetProp(element, (const xmlChar*) EXTERNAL_DATA_XML_ATTR_DIRECTORY);
+  if (xmlAttribute != NULL) {
+    error = SUCCESS;
+  }
+  else {
+    return FAILED;
+  }
+  xmlFree(xmlAttribute);
+  return error;
+}
+
+
+ReturnCode checkElement(const xmlXPathContextPtr xpathContext, const char* elementPathDirty,
+                        xmlNodePtr* element)
+{
+
+  xmlNodePtr node = NULL;
+  xmlElementType nodeType = XML_ELEMENT_NODE;
+  int nNodes = 0;
+  char elementPath[1024];
+
+  xmlXPathObjectPtr xpathObject = NULL;
+
+  /* remove trailing slash */
+  strncpy(elementPath, elementPathDirty, 1024);
+  if(strlen(elementPath) > 1 && elementPath[strlen(elementPath)-1] == '/') {
+    elementPath[strlen(elementPath)-1] = '\0';
+  }
+
+  /* simple paths like /a/b[2]/c[@uID="x"] are resolved by walking the tree */
+  nNodes = XPathResolveSimplePath(xpathContext, elementPath, &node);
+  if (nNodes < 0) {
+    /* Evaluate Expression */
+    xpathObject = XPathEvaluate(xpathContext, elementPath);
+    if (!xpathObject) {
+      printMsg(MESSAGETYPE_ERROR, "Error: Invalid XPath expression \"%s\"\n", elementPath);
+      return INVALID_XPATH;
+    }
+    nNodes = xmlXPathNodeSetGetLength(xpathObject->nodesetval);
+    if (nNodes > 0) {
+      node = xmlXPathNodeSetItem(xpathObject->nodesetval, 0);
+      /* namespace nodes are copies owned by the node set */
+      nodeType = node->type;
+    }
+    xmlXPathFreeObject(xpathObject);
+  }
+  else if (nNodes > 0) {
+    nodeType = node->type;
+  }
+
+  if (nNodes == 0) {
+    char * errorStr = buildString("Error: element %s not found!", elementPath);
+
+    printMsg(MESSAGETYPE_STATUS, errorStr);
+    free(errorStr);
+    return ELEMENT_NOT_FOUND;
+  }
+
+  if (nNodes > 1) {
+    printMsg(MESSAGETYPE_ERROR,
+             "Error: Element chosen by XPath \"%s\" expression is not unique. \n", elementPath);
+    return ELEMENT_PATH_NOT_UNIQUE;
+  }
+
+  assert(node);
+
+  if (nodeType == XML_ELEMENT_NODE || nodeType == XML_DOCUMENT_NODE) {
+    *element = node;
+    return SUCCESS;
+  }
+  else {
+    printMsg(MESSAGETYPE_ERROR,
+             "Error: XPath expression \"%s\"does not point to an element node.\n", elementPath);
+    return NOT_AN_ELEMENT;
+  }
+}
+
+
+ReturnCode getCoordinateValue(TixiDocument* document, char* pointPath,
+                              int pointIndex, char* name, int ignoreError, double* value)
+{
+  xmlNodePtr coordinate = NULL;
+  ReturnCode error = -1;
+  size_t suffixStringLength = 0;
+  size_t pointPathLength = strlen(pointPath);
+  size_t coordinatePathStringLength = 0;
+  char* coordinatePath = NULL;
+  char* suffixString = buildString("[%d]/%1s", pointIndex, name);
+
+  if (!suffixString) {
+    printMsg(MESSAGETYPE_ERROR, "Internal Error: Failed to allocate memory in getCoordinateValue.\n");
+    exit(1);
+  }
+
+  suffixStringLength = strlen(suffixString);
+
+  coordinatePathStringLength = suffixStringLength + pointPathLength + 1;
+
+  coordinatePath = (char*) malloc(coordinatePathStringLength * sizeof(char));
+  strcpy(coordinatePath, pointPath);
+  strcat(coordinatePath, suffixString);
+
+  error = checkElement(XPathGetContext(document), coordinatePath, &coordinate);
+
+  free(coordinatePath);
+  free(suffixString);
+  coordinatePath = NULL;
+  suffixString = NULL;
+  if (!error) {
+
+    char* textPtr = (char*) xmlNodeListGetString(document->docPtr, coordinate->children, 0);
+
+    if (textPtr) {
+      parseDouble(textPtr, value);
+      xmlFree(textPtr);
+    }
+    else {
+      error = FAILED;
+    }
+  }
+  else {
+    if (!ignoreError) {
+      printMsg(MESSAGETYPE_ERROR,
+               "Internal Error: point element \"%s\" has no %s-coordinate.\n", pointPath, name);
+    }
+    error = COORDINATE_NOT_FOUND;
+  }
+
+  return error;
+}
+
+ReturnCode getPoint(const TixiDocumentHandle handle, const char* parentPath, const int pointIndex,
+                    int ignoreMissingElements, double* x, double* y, double* z)
+{
+  ReturnCode error = -1;
+  ReturnCode errorX = -1;
+  ReturnCode errorY = -1;
+  ReturnCode errorZ = -1;
+
+  TixiDocument* document = getDocument(handle);
+  xmlNodePtr parent = NULL;
+  char* pointPath = NULL;
+  char* coordinatePathBuffer = NULL;
+  int nPointElements = 0;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  if (pointIndex < 1) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid point index %d\n", pointIndex);
+    return INDEX_OUT_OF_RANGE;
+  }
+
+  error = checkElement(XPathGetContext(document), parentPath, &parent);
+
+  if (!error) {
+
+    xmlXPathObjectPtr xpathPointObject = NULL;
+
+    size_t lengthPointPath = (strlen(parentPath) +      /* length of path to parent   */
+                              1);      				    /* trailing \0                */
+
+    pointPath = (char*) malloc(sizeof(char) * lengthPointPath);
+
+    strcpy(pointPath, parentPath);
+
+    /* pad with trailing blanks, so we can check for the size in getCoordinateValue */
+
+    error = checkExistence(XPathGetContext(document), pointPath, &xpathPointObject);
+
+    if (xpathPointObject) {
+      nPointElements = xpathPointObject->nodesetval->nodeNr;
+      xmlXPathFreeObject(xpathPointObject);
+    }
+
+    if (error == ELEMENT_NOT_FOUND) {
+      printMsg(MESSAGETYPE_ERROR, "Error: No point element found in element \"%s\".\n", parentPath);
+      error = NO_POINT_FOUND;
+    }
+    else if (!error) {
+      if (pointIndex > nPointElements) {
+        printMsg(MESSAGETYPE_ERROR, "Error: Index (%d) larger than number of point elements.\n", pointIndex);
+        error = INDEX_OUT_OF_RANGE;
+      }
+      else {
+        errorX = getCoordinateValue(document, pointPath, pointIndex, "x", ignoreMissingElements, x);
+        errorY = getCoordinateValue(document, pointPath, pointIndex, "y", ignoreMissingElements, y);
+        errorZ = getCoordinateValue(document, pointPath, pointIndex, "z", ignoreMissingElements, z);
+
+        if( errorX && errorY && errorZ) {
+          error = NO_POINT_FOUND;
+        }
+        else {
+          error = SUCCESS;
+        }
+      }
+
+    }
+  }
+
+  free(coordinatePathBuffer);
+  free(pointPath);
+  return error;
+}
+
+
+
+void checkLibxml2Version()
+{
+
+  static int testPerformed = 0;
+
+  if (!testPerformed) {
+    LIBXML_TEST_VERSION;
+  }
+
+}
+
+
+char* buildString(const char* format, ...)
+{
+
+  int bufferLength = 10;        /* initial guess for the buffer length */
+  int nChars = -1;
+  va_list variableList;
+  char* buffer = NULL;
+
+  buffer = (char*) malloc(bufferLength * sizeof(char));
+
+  if (buffer) {
+
+    while (nChars < 0) {
+
+      /* try to print into buffer */
+
+      va_start(variableList, format);
+      nChars = VSNPRINTF(buffer, bufferLength, format, variableList);
+      va_end(variableList);
+
+      if (nChars < bufferLength && nChars > -1) {
+        break;
+      }
+
+      /* msvc and glibc < 2.1: VSNPRINTF returns a negative integer on failure */
+      if (nChars < 0) {
+
+        bufferLength *= 2;
+        //PRINT_DEBUG2("nChar = %d buffer length = %d, reallocating\n", nChars, bufferLength);
+      }
+      /*
+               glibc 2.0: VSNPRINTF returns the length ( numbers of chars) of the result
+               without the trailing \0 if the length would not exceed bufferLength.
+            */
+      else {
+
+        bufferLength = nChars + 1;
+        //PRINT_DEBUG2("nChar = %d buffer length = %d, reallocating\n", nChars, bufferLength);
+      }
+
+      nChars = -1;
+      buffer = (char*) realloc(buffer, bufferLength * sizeof(char));
+
+      if (!buffer) {
+        break;
+      }
+    }
+  }
+  return buffer;
+}
+
+void stringBufferInit(TixiStringBuffer* buffer)
+{
+  buffer->data = buffer->localData;
+  buffer->data[0] = '\0';
+  buffer->length = 0;
+  buffer->capacity = sizeof(buffer->localData);
+  buffer->failed = 0;
+}
+
+void stringBufferFree(TixiStringBuffer* buffer)
+{
+  if (buffer->data != buffer->localData) {
+    free(buffer->data);
+  }
+  stringBufferInit(buffer);
+}
+
+void stringBufferClear(TixiStringBuffer* buffer)
+{
+  buffer->length = 0;
+  buffer->data[0] = '\0';
+}
+
+int stringBufferReserve(TixiStringBuffer* buffer, size_t size)
+{
+  size_t capacity = buffer->capacity;
+  char* data = NULL;
+
+  if (buffer->failed) {
+    return 0;
+  }
+  if (buffer->length + size < buffer->capacity) {
+    return 1;
+  }
+
+  while (capacity <= buffer->length + size) {
+    capacity *= 2;
+  }
+  if (buffer->data == buffer->localData) {
+    data = (char*) malloc(capacity);
+    if (data) {
+      memcpy(data, buffer->data, buffer->length + 1);
+    }
+  }
+  else {
+    data = (char*) realloc(buffer->data, capacity);
+  }
+
+  if (!data) {
+    buffer->failed = 1;
+    return 0;
+  }
+  buffer->data = data;
+  buffer->capacity = capacity;
+  return 1;
+}
+
+int stringBufferAppend(TixiStringBuffer* buffer, const char* text)
+{
+  size_t length = strlen(text);
+
+  if (!stringBufferReserve(buffer, length)) {
+    return 0;
+  }
+  memcpy(buffer->data + buffer->length, text, length + 1);
+  buffer->length += length;
+  return 1;
+}
+
+int stringBufferAppendFormat(TixiStringBuffer* buffer, const char* format, ...)
+{
+  size_t size = 32;             /* initial guess for the length */
+
+  while (stringBufferReserve(buffer, size)) {
+    size_t available = buffer->capacity - buffer->length;
+    va_list variableList;
+    int nChars;
+
+    va_start(variableList, format);
+    nChars = VSNPRINTF(buffer->data + buffer->length, available, format, variableList);
+    va_end(variableList);
+
+    if (nChars > -1 && (size_t) nChars < available) {
+      buffer->length += (size_t) nChars;
+      return 1;
+    }
+
+    /* msvc and glibc < 2.1 return a negative number, if the buffer is too small */
+    size = nChars < 0 ? 2 * available : (size_t) nChars + 1;
+    buffer->data[buffer->length] = '\0';
+  }
+  return 0;
+}
+
+static const double powersOfTen[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+  1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/**
+  @brief Formats number like "%g" into text (at least 16 bytes).
+
+  The six significant digits are rounded from the scaled number, which is exact
+  up to an error far below the rounding position. Numbers close to a tie, out of
+  the range of the exact powers of ten, zero, infinity and NaN are left to snprintf.
+
+  @return the length of the text or -1, if the number has to be formatted by snprintf
+*/
+static int formatDoubleG(double number, char* text)
+{
+  double magnitude = number < 0. ? -number : number;
+  double scaled = 0.;
+  double fraction = 0.;
+  long mantissa = 0;
+  char digits[6];
+  int nDigits = 6;
+  int exponent = 0;
+  int length = 0;
+  int i;
+
+  if (!(magnitude >= 1e-5 && magnitude < 1e20)) {
+    return -1;
+  }
+
+  /* estimate the decimal exponent from the binary one and correct it */
+  frexp(magnitude, &exponent);
+  exponent = (int) floor((exponent - 1) * 0.30102999566398120);
+  for (i = 0; i < 3; ++i) {
+    scaled = exponent <= 5 ? magnitude * powersOfTen[5 - exponent] : magnitude / powersOfTen[exponent - 5];
+    if (scaled < 100000. && exponent > -5) {
+      exponent--;
+    }
+    else if (scaled >= 1000000. && exponent < 19) {
+      exponent++;
+    }
+    else {
+      break;
+    }
+  }
+  if (scaled < 100000. || scaled >= 1000000.) {
+    return -1;
+  }
+
+  mantissa = (long) scaled;
+  fraction = scaled - (double) mantissa;
+  if (fabs(fraction - 0.5) < 1e-9) {
+    return -1;
+  }
+  if (fraction > 0.5) {
+    mantissa++;
+    if (mantissa == 1000000) {
+      mantissa = 100000;
+      exponent++;
+    }
+  }
+
+  for (i = 5; i >= 0; --i) {
+    digits[i] = (char) ('0' + mantissa % 10);
+    mantissa /= 10;
+  }
+  while (nDigits > 1 && digits[nDigits - 1] == '0') {
+    nDigits--;
+  }
+
+  if (number < 0.) {
+    text[length++] = '-';
+  }
+  if (exponent < -4 || exponent >= 6) {
+    int absExponent = exponent < 0 ? -exponent : exponent;
+    text[length++] = digits[0];
+    if (nDigits > 1) {
+      text[length++] = '.';
+      for (i = 1; i < nDigits; ++i) {
+        text[length++] = digits[i];
+      }
+    }
+    text[length++] = 'e';
+    text[length++] = exponent < 0 ? '-' : '+';
+    text[length++] = (char) ('0' + absExponent / 10);
+    text[length++] = (char) ('0' + absExponent % 10);
+  }
+  else if (exponent >= 0) {
+    for (i = 0; i <= exponent; ++i) {
+      text[length++] = i < nDigits ? digits[i] : '0';
+    }
+    if (nDigits > exponent + 1) {
+      text[length++] = '.';
+      for (i = exponent + 1; i < nDigits; ++i) {
+        text[length++] = digits[i];
+      }
+    }
+  }
+  else {
+    text[length++] = '0';
+    text[length++] = '.';
+    for (i = exponent + 1; i < 0; ++i) {
+      text[length++] = '0';
+    }
+    for (i = 0; i < nDigits; ++i) {
+      text[length++] = digits[i];
+    }
+  }
+  text[length] = '\0';
+  return length;
+}
+
+int stringBufferAppendDouble(TixiStringBuffer* buffer, const char* format, double number)
+{
+  if (!format || !strcmp(format, "%g")) {
+    int length;
+
+    if (!stringBufferReserve(buffer, 16)) {
+      return 0;
+    }
+    length = formatDoubleG(number, buffer->data + buffer->length);
+    if (length >= 0) {
+      buffer->length += (size_t) length;
+      return 1;
+    }
+    format = "%g";
+  }
+  return stringBufferAppendFormat(buffer, format, number);
+}
+
+/**
+  @brief Parses a number with strtod after replacing the point by the decimal
+  point of the current locale, which gives the result of strtod in the "C" locale.
+*/
+static const char* parseDoubleWithStrtod(const char* text, double* value)
+{
+  const char* decimalPoint = localeconv()->decimal_point;
+  size_t pointLength = 0;
+  size_t textLength = 0;
+  size_t nPoints = 0;
+  size_t consumed = 0;
+  size_t length = 0;
+  char shortText[128];
+  char* localText = shortText;
+  char* end = NULL;
+  const char* p = NULL;
+
+  if (!decimalPoint || !*decimalPoint) {
+    decimalPoint = ".";
+  }
+  pointLength = strlen(decimalPoint);
+
+  /* the characters, which may belong to a number of the "C" locale */
+  while (text[textLength] && (isalnum((unsigned char) text[textLength]) || strchr("+-.()_", text[textLength]))) {
+    nPoints += text[textLength] == '.';
+    textLength++;
+  }
+  if (textLength + nPoints * pointLength >= sizeof(shortText)) {
+    localText = (char*) malloc(textLength + nPoints * pointLength + 1);
+    if (!localText) {
+      *value = 0.;
+      return text;
+    }
+  }
+  for (p = text; p < text + textLength; ++p) {
+    if (*p == '.') {
+      memcpy(localText + length, decimalPoint, pointLength);
+      length += pointLength;
+    }
+    else {
+      localText[length++] = *p;
+    }
+  }
+  localText[length] = '\0';
+
+  *value = strtod(localText, &end);
+
+  /* map the end of the localized number back to text */
+  for (p = text; localText + consumed < end; ++p) {
+    consumed += *p == '.' ? pointLength : 1;
+  }
+  if (localText != shortText) {
+    free(localText);
+  }
+  return p;
+}
+
+const char* parseDouble(const char* text, double* value)
+{
+  const char* p = text;
+  const char* digitsStart = NULL;
+  unsigned long long mantissa = 0;
+  int nDigits = 0, nFractionDigits = 0, exponent = 0, negative = 0;
+  int hasDigits = 0;
+
+  while (isspace((unsigned char) *p)) {
+    p++;
+  }
+  digitsStart = p;
+  if (*p == '-' || *p == '+') {
+    negative = *p == '-';
+    p++;
+  }
+  while (*p == '0') {
+    hasDigits = 1;
+    p++;
+  }
+  while (*p >= '0' && *p <= '9') {
+    mantissa = 10 * mantissa + (unsigned long long) (*p - '0');
+    nDigits++;
+    hasDigits = 1;
+    p++;
+  }
+  if (*p == '.') {
+    p++;
+    if (mantissa == 0) {
+      while (*p == '0') {
+        nFractionDigits++;
+        hasDigits = 1;
+        p++;
+      }
+    }
+    while (*p >= '0' && *p <= '9') {
+      mantissa = 10 * mantissa + (unsigned long long) (*p - '0');
+      nDigits++;
+      nFractionDigits++;
+      hasDigits = 1;
+      p++;
+    }
+  }
+  if (!hasDigits) {
+    /* inf, nan, hexadecimal numbers or no number at all */
+    const char* end = parseDoubleWithStrtod(digitsStart, value);
+    return end == digitsStart ? text : end;
+  }
+  if (*p == 'e' || *p == 'E') {
+    const char* exponentStart = p++;
+    int exponentSign = 1;
+    int explicitExponent = 0;
+
+    if (*p == '-' || *p == '+') {
+      exponentSign = *p == '-' ? -1 : 1;
+      p++;
+    }
+    if (*p >= '0' && *p <= '9') {
+      while (*p >= '0' && *p <= '9') {
+        if (explicitExponent < 100000) {
+          explicitExponent = 10 * explicitExponent + (*p - '0');
+        }
+        p++;
+      }
+      exponent = exponentSign * explicitExponent;
+    }
+    else {
+      p = exponentStart;
+    }
+  }
+  if (*p == 'x' || *p == 'X' || nDigits > 19) {
+    return parseDoubleWithStrtod(digitsStart, value);
+  }
+
+  /* mantissa and power of ten are exact, the single operation rounds correctly */
+  exponent -= nFractionDigits;
+  if (mantissa == 0) {
+    *value = negative ? -0. : 0.;
+  }
+  else if (mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+    *value = (double) mantissa;
+    *value = exponent < 0 ? *value / powersOfTen[-exponent] : *value * powersOfTen[exponent];
+    if (negative) {
+      *value = -*value;
+    }
+  }
+  else {
+    return parseDoubleWithStrtod(digitsStart, value);
+  }
+  return p;
+}
+
+const char* parseNextVectorValue(const char* text, double* value)
+{
+  const char* p = text;
+  const char* end = NULL;
+
+  while (*p == VECTOR_SEPARATOR[0]) {
+    p++;
+  }
+  if (*p == '\0') {
+    return NULL;
+  }
+  end = parseDouble(p, value);
+  if (end == p) {
+    *value = 0.;
+  }
+  p = end;
+  while (*p && *p != VECTOR_SEPARATOR[0]) {
+    p++;
+  }
+  return p;
+}
+
+int countVectorValues(const char* text)
+{
+  const char* p = text;
+  int count = 0;
+
+  for (;;) {
+    while (*p == VECTOR_SEPARATOR[0]) {
+      p++;
+    }
+    if (*p == '\0') {
+      return count;
+    }
+    count++;
+    p = strchr(p, VECTOR_SEPARATOR[0]);
+    if (!p) {
+      return count;
+    }
+  }
+}
+
+static const char base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+#define BASE64_SPACE   64
+#define BASE64_PADDING 65
+#define BASE64_INVALID 255
+
+/* values of the base64 characters, BASE64_SPACE for white space */
+static const unsigned char base64Values[256] = {
+  255, 255, 255, 255, 255, 255, 255, 255, 255,  64,  64, 255, 255,  64, 255, 255,
+  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+   64, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255, 255, 255,  63,
+   52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255, 255,  65, 255, 255,
+  255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
+   15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255, 255,
+  255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
+   41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255,
+  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
+};
+
+static int isLittleEndian(void)
+{
+  const unsigned int one = 1;
+  return *(const unsigned char*) &one == 1;
+}
+
+/* reverses the bytes of each double, converting between little endian and the host */
+static void swapDoubleBytes(unsigned char* bytes, size_t nValues)
+{
+  size_t i, j;
+
+  for (i = 0; i < nValues; ++i, bytes += sizeof(double)) {
+    for (j = 0; j < sizeof(double) / 2; ++j) {
+      unsigned char tmp = bytes[j];
+      bytes[j] = bytes[sizeof(double) - 1 - j];
+      bytes[sizeof(double) - 1 - j] = tmp;
+    }
+  }
+}
+
+int stringBufferAppendBase64Doubles(TixiStringBuffer* buffer, const double* values, int nValues)
+{
+  size_t nBytes = (size_t) nValues * sizeof(double);
+  const unsigned char* bytes = (const unsigned char*) values;
+  unsigned char* swapped = NULL;
+  char* out = NULL;
+  size_t i;
+
+  if (!stringBufferReserve(buffer, (nBytes + 2) / 3 * 4)) {
+    return 0;
+  }
+  if (!isLittleEndian()) {
+    swapped = (unsigned char*) malloc(nBytes > 0 ? nBytes : 1);
+    if (!swapped) {
+      buffer->failed = 1;
+      return 0;
+    }
+    memcpy(swapped, values, nBytes);
+    swapDoubleBytes(swapped, (size_t) nValues);
+    bytes = swapped;
+  }
+
+  out = buffer->data + buffer->length;
+  for (i = 0; i + 3 <= nBytes; i += 3) {
+    unsigned long group = ((unsigned long) bytes[i] << 16) | ((unsigned long) bytes[i + 1] << 8) | bytes[i + 2];
+    out[0] = base64Alphabet[(group >> 18) & 63];
+    out[1] = base64Alphabet[(group >> 12) & 63];
+    out[2] = base64Alphabet[(group >> 6) & 63];
+    out[3] = base64Alphabet[group & 63];
+    out += 4;
+  }
+  if (i < nBytes) {
+    unsigned long group = (unsigned long) bytes[i] << 16;
+    if (i + 1 < nBytes) {
+      group |= (unsigned long) bytes[i + 1] << 8;
+    }
+    out[0] = base64Alphabet[(group >> 18) & 63];
+    out[1] = base64Alphabet[(group >> 12) & 63];
+    out[2] = i + 1 < nBytes ? base64Alphabet[(group >> 6) & 63] : '=';
+    out[3] = '=';
+    out += 4;
+  }
+  *out = '\0';
+  buffer->length = (size_t) (out - buffer->data);
+
+  free(swapped);
+  return 1;
+}
+
+/* returns the number of doubles encoded in text, -1 if text is no valid base64 */
+static int countBase64Doubles(const char* text)
+{
+  const unsigned char* p = (const unsigned char*) text;
+  size_t nChars = 0;
+  size_t nPadding = 0;
+  size_t nBytes = 0;
+
+  for (; *p; ++p) {
+    unsigned char value = base64Values[*p];
+    if (value < 64 && nPadding == 0) {
+      nChars++;
+    }
+    else if (value == BASE64_PADDING) {
+      nPadding++;
+      nChars++;
+    }
+    else if (value != BASE64_SPACE) {
+      return -1;
+    }
+  }
+  if (nChars % 4 != 0 || nPadding > 2) {
+    return -1;
+  }
+  nBytes = nChars / 4 * 3 - nPadding;
+  if (nBytes % sizeof(double) != 0 || nBytes / sizeof(double) > INT_MAX) {
+    return -1;
+  }
+  return (int) (nBytes / sizeof(double));
+}
+
+/* decodes the first nValues doubles of a valid base64 text */
+static void decodeBase64Doubles(const char* text, double* values, int nValues)
+{
+  const unsigned char* p = (const unsigned char*) text;
+  unsigned char* out = (unsigned char*) values;
+  size_t nBytes = (size_t) nValues * sizeof(double);
+  size_t n = 0;
+  unsigned long group = 0;
+  int nGroupChars = 0;
+
+  while (n < nBytes) {
+    unsigned char a, b, c, d;
+
+    /* four characters without white space, the usual case */
+    if (nGroupChars == 0 && n + 3 <= nBytes
+        && (a = base64Values[p[0]]) < 64 && (b = base64Values[p[1]]) < 64
+        && (c = base64Values[p[2]]) < 64 && (d = base64Values[p[3]]) < 64) {
+      group = ((unsigned long) a << 18) | ((unsigned long) b << 12) | ((unsigned long) c << 6) | d;
+      out[n] = (unsigned char) (group >> 16);
+      out[n + 1] = (unsigned char) (group >> 8);
+      out[n + 2] = (unsigned char) group;
+      n += 3;
+      p += 4;
+      continue;
+    }
+
+    a = base64Values[*p++];
+    if (a < 64) {
+      group = (group << 6) | a;
+      nGroupChars++;
+    }
+    else if (a != BASE64_SPACE) {
+      break;    /* padding */
+    }
+    if (nGroupChars == 4) {
+      out[n++] = (unsigned char) (group >> 16);
+      if (n < nBytes) {
+        out[n++] = (unsigned char) (group >> 8);
+      }
+      if (n < nBytes) {
+        out[n++] = (unsigned char) group;
+      }
+      group = 0;
+      nGroupChars = 0;
+    }
+  }
+  if (n < nBytes && nGroupChars > 1) {
+    group <<= 6 * (4 - nGroupChars);
+    out[n++] = (unsigned char) (group >> 16);
+    if (n < nBytes && nGroupChars > 2) {
+      out[n++] = (unsigned char) (group >> 8);
+    }
+  }
+
+  if (!isLittleEndian()) {
+    swapDoubleBytes((unsigned char*) values, (size_t) nValues);
+  }
+}
+
+int isBase64Vector(xmlNodePtr node)
+{
+  xmlAttrPtr attribute = xmlHasNsProp(node, (const xmlChar*) VECTOR_ENCODING_ATTRIBUTE, NULL);
+  xmlChar* encoding = NULL;
+  int result = 0;
+
+  if (!attribute) {
+    return 0;
+  }
+  encoding = xmlNodeListGetString(node->doc, attribute->children, 1);
+  result = encoding && strcmp((const char*) encoding, VECTOR_ENCODING_BASE64) == 0;
+  xmlFree(encoding);
+  return result;
+}
+
+int readVectorTextValues(const char* text, int isBase64, double* values, int capacity)
+{
+  int count = 0;
+
+  if (!values) {
+    capacity = 0;
+  }
+
+  if (isBase64) {
+    count = countBase64Doubles(text);
+    if (count > 0 && capacity > 0) {
+      decodeBase64Doubles(text, values, count < capacity ? count : capacity);
+    }
+  }
+  else {
+    while (count < capacity && (text = parseNextVectorValue(text, &values[count])) != NULL) {
+      count++;
+    }
+    if (text) {
+      count += countVectorValues(text);    /* the values not fitting into values */
+    }
+  }
+  return count;
+}
+
+int readVectorNodeValues(xmlDocPtr doc, xmlNodePtr node, double* values, int capacity)
+{
+  const char* text = getNodeListTextDirect(doc, node->children, 1);
+  char* copy = NULL;
+  int count = 0;
+
+  if (!text) {
+    copy = (char*) xmlNodeListGetString(doc, node->children, 0);
+    text = copy ? copy : "";
+  }
+  count = readVectorTextValues(text, isBase64Vector(node), values, capacity);
+
+  xmlFree(copy);
+  return count;
+}
+
+char* loadExternalFileToString(const char* filename)
+{
+  if (isURIPath(filename) != 0) {
+    // local file
+    return loadFileToString(filename);
+  }
+  else if (string_startsWith(filename, "file://") == 0) {
+    char* localPath = uriToLocalPath(filename);
+    char* result = NULL;
+    if (!localPath) {
+      return NULL;
+    }
+    result = loadFileToString(localPath);
+
+    free(localPath);
+    return result;
+  }
+  else {
+    return curlGetURLInMemory(filename);
+  }
+}
+
+
+/* upper limit of the threads loading external files */
+#define MAX_EXTERNAL_FILE_THREADS 8
+
+/* _private of the externaldata elements kept by OPENMODE_RECURSIVE_LAZY until they are included */
+static char pendingExternalDataMarker;
+
+/* an external file of an externaldata element */
+typedef struct
+{
+  char* fileName;       /* text of the filename element */
+  char* fullFileName;   /* file name appended to the resolved directory */
+  int isRemote;         /* fetched with curl, which must stay on the opening thread */
+  int fetched;          /* 0, if the file could not be read */
+  xmlDocPtr document;   /* parsed file, NULL if it is no valid xml document */
+} ExternalFile;
+
+/* an externaldata element with its external files */
+typedef struct
+{
+  xmlNodePtr node;
+  char* directory;      /* text of the path element */
+  int firstFile;
+  int nFiles;
+  ReturnCode error;     /* OPEN_FAILED if the element is invalid or a file could not be read */
+} ExternalDataSite;
+
+/* the external files of one round, shared by the loading threads */
+typedef struct
+{
+  ExternalFile* files;
+  int nFiles;
+  int parseOptions;
+  volatile int nextFile;
+} ExternalFileQueue;
+
+static void loadExternalFile(ExternalFile* file, int parseOptions)
+{
+  char* documentString = loadExternalFileToString(file->fullFileName);
 
-    /* pad with trailing blanks, so we can check for the size in getCoordinateValue */
+  if (!documentString) {
+    return;
+  }
+  file->fetched = 1;
+  file->document = xmlReadMemory(documentString, (int) strlen(documentString), "urlResource", NULL, parseOptions);
+  free(documentString);
+}
 
-    error = checkExistence(document->xpathContext, pointPath, &xpathPointObject);
+/* loads the local files of the queue until all are taken */
+static void loadLocalExternalFiles(void* argument)
+{
+  ExternalFileQueue* queue = (ExternalFileQueue*) argument;
+  int iFile;
 
-    if (xpathPointObject) {
-      nPointElements = xpathPointObject->nodesetval->nodeNr;
-      xmlXPathFreeObject(xpathPointObject);
+  while ((iFile = atomic_increment(&queue->nextFile) - 1) < queue->nFiles) {
+    if (!queue->files[iFile].isRemote) {
+      loadExternalFile(&queue->files[iFile], queue->parseOptions);
     }
+  }
+}
 
-    if (error == ELEMENT_NOT_FOUND) {
-      printMsg(MESSAGETYPE_ERROR, "Error: No point element found in element \"%s\".\n", parentPath);
-      error = NO_POINT_FOUND;
+/* loads remote files on the calling thread and the local files on up to MAX_EXTERNAL_FILE_THREADS threads */
+static void loadExternalFiles(ExternalFile* files, int nFiles, int parseOptions)
+{
+  ExternalFileQueue queue;
+  TixiThread threads[MAX_EXTERNAL_FILE_THREADS - 1];
+  int nLocalFiles = 0;
+  int nThreads = 0;
+  int nExtraThreads = 0;
+  int iFile;
+
+  queue.files = files;
+  queue.nFiles = nFiles;
+  queue.parseOptions = parseOptions;
+  queue.nextFile = 0;
+
+  for (iFile = 0; iFile < nFiles; ++iFile) {
+    if (!files[iFile].isRemote) {
+      nLocalFiles++;
     }
-    else if (!error) {
-      if (pointIndex > nPointElements) {
-        printMsg(MESSAGETYPE_ERROR, "Error: Index (%d) larger than number of point elements.\n", pointIndex);
-        error = INDEX_OUT_OF_RANGE;
-      }
-      else {
-        errorX = getCoordinateValue(document, pointPath, pointIndex, "x", ignoreMissingElements, x);
-        errorY = getCoordinateValue(document, pointPath, pointIndex, "y", ignoreMissingElements, y);
-        errorZ = getCoordinateValue(document, pointPath, pointIndex, "z", ignoreMissingElements, z);
+  }
 
-        if( errorX && errorY && errorZ) {
-          error = NO_POINT_FOUND;
-        }
-        else {
-          error = SUCCESS;
-        }
-      }
+  nThreads = thread_getProcessorCount();
+  if (nThreads > MAX_EXTERNAL_FILE_THREADS) {
+    nThreads = MAX_EXTERNAL_FILE_THREADS;
+  }
+  if (nThreads > nLocalFiles) {
+    nThreads = nLocalFiles;
+  }
+  for (; nExtraThreads < nThreads - 1; ++nExtraThreads) {
+    if (thread_create(&threads[nExtraThreads], loadLocalExternalFiles, &queue) != 0) {
+      /* the remaining files are loaded by the other threads */
+      break;
+    }
+  }
 
+  for (iFile = 0; iFile < nFiles; ++iFile) {
+    if (files[iFile].isRemote) {
+      loadExternalFile(&files[iFile], parseOptions);
     }
   }
+  loadLocalExternalFiles(&queue);
 
-  free(coordinatePathBuffer);
-  free(pointPath);
-  return error;
+  for (iFile = 0; iFile < nExtraThreads; ++iFile) {
+    thread_join(&threads[iFile]);
+  }
 }
 
+static int isExternalDataNode(xmlNodePtr node)
+{
+  return node->type == XML_ELEMENT_NODE && !node->ns && !strcmp((const char*) node->name, EXTERNAL_DATA_NODE_NAME);
+}
 
+static int isPendingExternalDataNode(xmlNodePtr node)
+{
+  return node->_private == &pendingExternalDataMarker && isExternalDataNode(node);
+}
 
-void checkLibxml2Version()
+/* appends a node to a growing array */
+static ReturnCode appendNode(xmlNodePtr node, xmlNodePtr** nodes, int* nNodes, int* capacity)
 {
+  if (*nNodes == *capacity) {
+    int newCapacity = *capacity ? 2 * *capacity : 16;
+    xmlNodePtr* newNodes = (xmlNodePtr*) realloc(*nodes, newCapacity * sizeof(xmlNodePtr));
+    if (!newNodes) {
+      return FAILED;
+    }
+    *nodes = newNodes;
+    *capacity = newCapacity;
+  }
+  (*nodes)[(*nNodes)++] = node;
+  return SUCCESS;
+}
 
-  static int testPerformed = 0;
+/* appends the externaldata elements on and below node in document order, only the pending ones if onlyPending is set */
+static ReturnCode collectExternalDataNodes(xmlNodePtr node, int onlyPending, xmlNodePtr** nodes, int* nNodes,
+                                           int* capacity)
+{
+  xmlNodePtr child = NULL;
 
-  if (!testPerformed) {
-    LIBXML_TEST_VERSION;
+  if (isExternalDataNode(node)) {
+    if (onlyPending && !isPendingExternalDataNode(node)) {
+      return SUCCESS;
+    }
+    return appendNode(node, nodes, nNodes, capacity);
   }
 
+  for (child = node->children; child; child = child->next) {
+    if (child->type == XML_ELEMENT_NODE
+        && collectExternalDataNodes(child, onlyPending, nodes, nNodes, capacity) != SUCCESS) {
+      return FAILED;
+    }
+  }
+  return SUCCESS;
 }
 
-
-char* buildString(const char* format, ...)
+/* marks the externaldata elements on and below node as pending */
+static ReturnCode markPendingExternalData(TixiDocument* aTixiDocument, xmlNodePtr node)
 {
+  xmlNodePtr* nodes = NULL;
+  int nNodes = 0;
+  int capacity = 0;
+  int iNode;
 
-  int bufferLength = 10;        /* initial guess for the buffer length */
-  int nChars = -1;
-  va_list variableList;
-  char* buffer = NULL;
+  if (collectExternalDataNodes(node, 0, &nodes, &nNodes, &capacity) != SUCCESS) {
+    free(nodes);
+    return FAILED;
+  }
+  for (iNode = 0; iNode < nNodes; ++iNode) {
+    nodes[iNode]->_private = &pendingExternalDataMarker;
+  }
+  aTixiDocument->nPendingExternalData += nNodes;
+  free(nodes);
+  return SUCCESS;
+}
 
-  buffer = (char*) malloc(bufferLength * sizeof(char));
+/* the externaldata element is not pending anymore */
+static void unmarkPendingExternalData(TixiDocument* aTixiDocument, xmlNodePtr node)
+{
+  if (node->_private == &pendingExternalDataMarker) {
+    node->_private = NULL;
+    aTixiDocument->nPendingExternalData--;
+  }
+}
 
-  if (buffer) {
+static char* getChildText(xmlNodePtr node)
+{
+  char* text = (char*) xmlNodeListGetString(node->doc, node->children, 1);
+  char* result = buildString("%s", text ? text : "");
 
-    while (nChars < 0) {
+  xmlFree(text);
+  return result;
+}
 
-      /* try to print into buffer */
+static void freeExternalDataSites(ExternalDataSite* sites, int nSites, ExternalFile* files, int nFiles)
+{
+  int i;
 
-      va_start(variableList, format);
-      nChars = VSNPRINTF(buffer, bufferLength, format, variableList);
-      va_end(variableList);
+  for (i = 0; i < nSites; ++i) {
+    free(sites[i].directory);
+  }
+  for (i = 0; i < nFiles; ++i) {
+    free(files[i].fileName);
+    free(files[i].fullFileName);
+    if (files[i].document) {
+      xmlFreeDoc(files[i].document);
+    }
+  }
+  free(sites);
+  free(files);
+}
 
-      if (nChars < bufferLength && nChars > -1) {
-        break;
-      }
+/* reads the path and the file names of an externaldata element and appends its files */
+static ReturnCode readExternalDataSite(TixiDocument* aTixiDocument, ExternalDataSite* site, ExternalFile** files,
+                                       int* nFiles, int* capacity)
+{
+  xmlNodePtr pathNode = NULL;
+  xmlNodePtr child = NULL;
+  char* resolvedDirectory = NULL;
+
+  site->firstFile = *nFiles;
+  for (child = site->node->children; child && !pathNode; child = child->next) {
+    if (child->type == XML_ELEMENT_NODE && !strcmp((const char*) child->name, EXTERNAL_DATA_NODE_NAME_PATH)) {
+      pathNode = child;
+    }
+  }
+  if (!pathNode) {
+    printMsg(MESSAGETYPE_ERROR, "Error: openExternalFiles returns %d. No path defined in externaldata node!\n",
+             ELEMENT_NOT_FOUND);
+    site->error = OPEN_FAILED;
+    return SUCCESS;
+  }
+  site->directory = getChildText(pathNode);
 
-      /* msvc and glibc < 2.1: VSNPRINTF returns a negative integer on failure */
-      if (nChars < 0) {
+  // resolv data directory (in case of relative paths)
+  resolvedDirectory = resolveDirectory(aTixiDocument->dirname, site->directory);
 
-        bufferLength *= 2;
-        //PRINT_DEBUG2("nChar = %d buffer length = %d, reallocating\n", nChars, bufferLength);
-      }
-      /*
-               glibc 2.0: VSNPRINTF returns the length ( numbers of chars) of the result
-               without the trailing \0 if the length would not exceed bufferLength.
-            */
-      else {
+  for (child = site->node->children; child; child = child->next) {
+    ExternalFile* file = NULL;
 
-        bufferLength = nChars + 1;
-        //PRINT_DEBUG2("nChar = %d buffer length = %d, reallocating\n", nChars, bufferLength);
+    if (child->type != XML_ELEMENT_NODE || strcmp((const char*) child->name, EXTERNAL_DATA_NODE_NAME_FILENAME)) {
+      continue;
+    }
+    if (*nFiles == *capacity) {
+      int newCapacity = *capacity ? 2 * *capacity : 16;
+      ExternalFile* newFiles = (ExternalFile*) realloc(*files, newCapacity * sizeof(ExternalFile));
+      if (!newFiles) {
+        free(resolvedDirectory);
+        return FAILED;
       }
+      *files = newFiles;
+      *capacity = newCapacity;
+    }
+    file = &(*files)[(*nFiles)++];
+    file->fileName = getChildText(child);
+    file->fullFileName = buildString("%s%s", resolvedDirectory, file->fileName);
+    file->isRemote = isURIPath(file->fullFileName) == 0 && string_startsWith(file->fullFileName, "file://") != 0;
+    file->fetched = 0;
+    file->document = NULL;
+    site->nFiles++;
+  }
+  free(resolvedDirectory);
 
-      nChars = -1;
-      buffer = (char*) realloc(buffer, bufferLength * sizeof(char));
+  if (site->nFiles == 0) {
+    printMsg(MESSAGETYPE_ERROR, "Error: no filename nodes defined in externalData node.\n");
+    site->error = OPEN_FAILED;
+  }
+  return SUCCESS;
+}
 
-      if (!buffer) {
-        break;
-      }
+/* moves the root elements of the loaded files of the site in place of its externaldata element */
+static void spliceExternalFiles(TixiDocument* aTixiDocument, ExternalDataSite* site, ExternalFile* files,
+                                xmlNodePtr* roots, int* nRoots, int* number)
+{
+  xmlNodePtr cur = site->node;
+  xmlNodePtr parent = cur->parent;
+  char* dataURI = localPathToURI(site->directory);
+  int iFile;
+
+  invalidateChildIndex(aTixiDocument, parent);
+  uid_removeSubtreeUIDs(aTixiDocument, cur);
+  uid_clearReferenceGraph(aTixiDocument);
+
+  for (iFile = site->firstFile; iFile < site->firstFile + site->nFiles; ++iFile) {
+    ExternalFile* file = &files[iFile];
+    xmlNodePtr rootToInsert = NULL;
+    xmlChar* nodePathNew = NULL;
+
+    if (!file->document) {
+      printMsg(MESSAGETYPE_WARNING,
+               "Document %s will be ignored. No valid XML document!\n",
+               file->fullFileName);
+      continue;
     }
-  }
-  return buffer;
+
+    /* take the root out of the parsed file instead of copying it */
+    rootToInsert = xmlDocGetRootElement(file->document);
+    xmlUnlinkNode(rootToInsert);
+    xmlDOMWrapAdoptNode(NULL, file->document, rootToInsert, aTixiDocument->docPtr,
+                        parent->type == XML_ELEMENT_NODE ? parent : NULL, 0);
+    xmlFreeDoc(file->document);
+    file->document = NULL;
+
+    /* add metadata to node, to allow saving external node data */
+    xmlSetProp(rootToInsert, (xmlChar*) EXTERNAL_DATA_XML_ATTR_FILENAME, (xmlChar*) file->fileName);
+
+    /* save the sub-directory */
+    xmlSetProp(rootToInsert, (xmlChar*) EXTERNAL_DATA_XML_ATTR_DIRECTORY, (xmlChar*) dataURI);
+
+    /* save the external data node position */
+    nodePathNew = xmlGetNodePath(parent);
+    xmlSetProp(rootToInsert, (xmlChar*) EXTERNAL_DATA_XML_ATTR_NODEPATH, nodePathNew);
+    xmlFree(nodePathNew);
+
+    xmlAddPrevSibling(cur, rootToInsert);
+    uid_addSubtreeUIDs(aTixiDocument, rootToInsert);
+    roots[(*nRoots)++] = rootToInsert;
+
+    /* file could be loaded and parsed, increase the counter */
+    (*number)++;
+  }
+  free(dataURI);
+
+  /* remove external data node */
+  unmarkPendingExternalData(aTixiDocument, cur);
+  xmlUnlinkNode(cur);
+  invalidateNodeCursors(aTixiDocument, cur);
+  invalidateChildIndexesOfSubtree(aTixiDocument, cur);
+  xmlFreeNode(cur);
+  aTixiDocument->externalDataChanged = 1;
 }
 
-char* loadExternalFileToString(const char* filename)
+/**
+ * Includes the files of the externaldata elements, the included root elements are returned in roots.
+ * With stopAtError, nothing is included if an element is invalid or a file cannot be read. Otherwise
+ * the failed externaldata elements are kept and the others are included.
+ */
+static ReturnCode includeExternalFiles(TixiDocument* aTixiDocument, xmlNodePtr* nodes, int nNodes, int stopAtError,
+                                       xmlNodePtr** roots, int* nRoots, int* number)
 {
-  if (isURIPath(filename) != 0) {
-    // local file
-    return loadFileToString(filename);
+  ExternalDataSite* sites = (ExternalDataSite*) calloc(nNodes, sizeof(ExternalDataSite));
+  ExternalFile* files = NULL;
+  int nFiles = 0;
+  int capacity = 0;
+  int iSite, iFile;
+  ReturnCode error = SUCCESS;
+
+  *roots = NULL;
+  *nRoots = 0;
+  if (!sites) {
+    return FAILED;
   }
-  else if (string_startsWith(filename, "file://") == 0) {
-    char* localPath = uriToLocalPath(filename);
-    char* result = NULL;
-    if (!localPath) {
-      return NULL;
+
+  for (iSite = 0; iSite < nNodes && error == SUCCESS; ++iSite) {
+    sites[iSite].node = nodes[iSite];
+    if (readExternalDataSite(aTixiDocument, &sites[iSite], &files, &nFiles, &capacity) != SUCCESS) {
+      error = FAILED;
     }
-    result = loadFileToString(localPath);
+    else if (stopAtError) {
+      error = sites[iSite].error;
+    }
+  }
 
-    free(localPath);
-    return result;
+  if (error == SUCCESS) {
+    loadExternalFiles(files, nFiles, aTixiDocument->xmlParseOptions);
+    for (iSite = 0; iSite < nNodes && error == SUCCESS; ++iSite) {
+      ExternalDataSite* site = &sites[iSite];
+      for (iFile = site->firstFile; iFile < site->firstFile + site->nFiles && !site->error; ++iFile) {
+        if (!files[iFile].fetched) {
+          printMsg(MESSAGETYPE_ERROR, "\nError in fetching external file \"%s\".\n", files[iFile].fullFileName);
+          site->error = OPEN_FAILED;
+        }
+      }
+      if (stopAtError) {
+        error = site->error;
+      }
+    }
   }
-  else {
-    return curlGetURLInMemory(filename);
+
+  if (error == SUCCESS) {
+    *roots = (xmlNodePtr*) malloc((nFiles > 0 ? nFiles : 1) * sizeof(xmlNodePtr));
+    if (!*roots) {
+      error = FAILED;
+    }
+  }
+  for (iSite = 0; iSite < nNodes && error == SUCCESS; ++iSite) {
+    if (!sites[iSite].error) {
+      spliceExternalFiles(aTixiDocument, &sites[iSite], files, *roots, nRoots, number);
+    }
+  }
+  for (iSite = 0; iSite < nNodes && !stopAtError; ++iSite) {
+    if (sites[iSite].error) {
+      /* the externaldata element is kept, it is not tried again */
+      unmarkPendingExternalData(aTixiDocument, sites[iSite].node);
+      if (error == SUCCESS) {
+        error = sites[iSite].error;
+      }
+    }
   }
-}
 
+  freeExternalDataSites(sites, nNodes, files, nFiles);
+  return error;
+}
 
 ReturnCode openExternalFiles(TixiDocument* aTixiDocument, int* number)
 {
-  int iNode = 0;
-  int handle = aTixiDocument->handle;
-  xmlNodePtr cur = NULL;
+  xmlNodePtr* nodes = NULL;
+  int nNodes = 0;
+  int nodesCapacity = 0;
   ReturnCode error = SUCCESS;
 
   assert(aTixiDocument != NULL);
   *number = 0;
 
-  while(1) {
-    // loop until there are no externaldata nodes included
+  if (!xmlDocGetRootElement(aTixiDocument->docPtr)) {
+    return SUCCESS;
+  }
+  error = collectExternalDataNodes(xmlDocGetRootElement(aTixiDocument->docPtr), 0, &nodes, &nNodes, &nodesCapacity);
 
-    xmlXPathObjectPtr xpathObject = XPathEvaluateExpression(aTixiDocument->xpathContext, "//externaldata");
-    xmlNodeSetPtr nodeset = NULL;
-    char* externalDataNodeXPath, *externalDataDirectoryXPath, *externalDataDirectory, *resolvedDirectory;
-    int externalFileCount = 0;
+  while (error == SUCCESS && nNodes > 0) {
+    // loop until the included files contain no more externaldata nodes
+    xmlNodePtr* roots = NULL;
+    int nRoots = 0;
+    int iRoot;
 
-    if (!xpathObject) {
-      // no more external data, stop
-      break;
-    }
+    error = includeExternalFiles(aTixiDocument, nodes, nNodes, 1, &roots, &nRoots, number);
 
-    nodeset = xpathObject->nodesetval;
-    if (!nodeset || nodeset->nodeNr < 1) {
-      break;
+    /* only the included files can contain further externaldata nodes */
+    nNodes = 0;
+    for (iRoot = 0; error == SUCCESS && iRoot < nRoots; ++iRoot) {
+      error = collectExternalDataNodes(roots[iRoot], 0, &nodes, &nNodes, &nodesCapacity);
     }
+    free(roots);
+  }
 
-    // goto the first node that is an element
-    for (iNode = 0; iNode < nodeset->nodeNr; ++iNode) {
-      cur = nodeset->nodeTab[iNode];
-      if (cur->type == XML_ELEMENT_NODE) {
-        break; // for loop
-      }
-    }
-    if (iNode == nodeset->nodeNr) {
-      // no element node found
-      xmlXPathFreeObject(xpathObject);
-      break; // while loop
-    }
+  free(nodes);
+  return error;
+}
 
-    // found external data node
-    xmlXPathFreeObject(xpathObject);
+ReturnCode openExternalFilesLazy(TixiDocument* aTixiDocument)
+{
+  assert(aTixiDocument != NULL);
 
-    /* get nodes XPath */
-    externalDataNodeXPath = (char*) xmlGetNodePath(cur);
+  if (!xmlDocGetRootElement(aTixiDocument->docPtr)) {
+    return SUCCESS;
+  }
+  return markPendingExternalData(aTixiDocument, xmlDocGetRootElement(aTixiDocument->docPtr));
+}
 
+ReturnCode resolveExternalData(TixiDocument* aTixiDocument, xmlNodePtr parent, int wholeSubtree)
+{
+  xmlNodePtr* nodes = NULL;
+  int nNodes = 0;
+  int nodesCapacity = 0;
+  ReturnCode error = SUCCESS;
 
-    /* now get the subdirectory */
-    externalDataDirectoryXPath = buildString("%s/%s", externalDataNodeXPath, EXTERNAL_DATA_NODE_NAME_PATH);
+  while (aTixiDocument->nPendingExternalData > 0) {
+    xmlNodePtr* roots = NULL;
+    xmlNodePtr child = NULL;
+    int nRoots = 0;
+    int number = 0;
+    int iRoot;
+    ReturnCode includeError;
+
+    nNodes = 0;
+    for (child = parent->children; child; child = child->next) {
+      if (child->type != XML_ELEMENT_NODE) {
+        continue;
+      }
+      if (isPendingExternalDataNode(child)) {
+        error = appendNode(child, &nodes, &nNodes, &nodesCapacity);
+      }
+      else if (wholeSubtree) {
+        error = collectExternalDataNodes(child, 1, &nodes, &nNodes, &nodesCapacity);
+      }
+      if (error != SUCCESS) {
+        break;
+      }
+    }
+    if (error != SUCCESS || nNodes == 0) {
+      break;
+    }
 
-    error = tixiGetTextElement(handle, externalDataDirectoryXPath, &externalDataDirectory);
-    free(externalDataDirectoryXPath);
-    if (error) {
-      printMsg(MESSAGETYPE_ERROR, "Error: openExternalFiles returns %d. No path defined in externaldata node!\n", error);
-      xmlFree(externalDataNodeXPath);
-      return OPEN_FAILED;
+    /* readers share the document until they reach a pending externaldata element */
+    if (upgradeDocumentLock(aTixiDocument)) {
+      /* other readers may have included the files meanwhile, the elements are collected again */
+      continue;
     }
 
-    // resolv data directory (in case of relative paths)
-    resolvedDirectory = resolveDirectory(aTixiDocument->dirname, externalDataDirectory);
+    includeError = includeExternalFiles(aTixiDocument, nodes, nNodes, 0, &roots, &nRoots, &number);
+    if (includeError != SUCCESS) {
+      error = includeError;
+    }
+    /* the included files are resolved on their first use as well */
+    for (iRoot = 0; iRoot < nRoots; ++iRoot) {
+      if (markPendingExternalData(aTixiDocument, roots[iRoot]) != SUCCESS) {
+        error = FAILED;
+      }
+    }
+    free(roots);
 
-    /* now get number and names of all external files */
-    tixiGetNamedChildrenCount(handle, externalDataNodeXPath, EXTERNAL_DATA_NODE_NAME_FILENAME, &externalFileCount);
-    if (externalFileCount == 0) {
-      printMsg(MESSAGETYPE_ERROR, "Error: no filename nodes defined in externalData node.\n");
-      xmlFree(externalDataNodeXPath);
-      free(resolvedDirectory);
-      return OPEN_FAILED;
+    if (!wholeSubtree || error == FAILED) {
+      break;
     }
+  }
 
-    for (iNode = 1; iNode <= externalFileCount; iNode++) {
-      char* externalFileName, *externalFullFileName, *newDocumentString, *fileNameXPath;
-      xmlDocPtr xmlDocument = NULL;
+  free(nodes);
+  return error;
+}
 
-      fileNameXPath = buildString("%s/filename[%d]", externalDataNodeXPath, iNode);
 
-      tixiGetTextElement(handle, fileNameXPath, &externalFileName);
-      free(fileNameXPath);
+/* returns the position of the externaldata child of parent reading from directory, 0 if there is none */
+static int findExternalDataElement(xmlNodePtr parent, const char* directory, int* count)
+{
+  xmlNodePtr child = NULL;
+  int position = 0;
 
-      /* Build complete filename */
-      externalFullFileName = buildString("%s%s", resolvedDirectory, externalFileName);
+  *count = 0;
+  for (child = parent->children; child; child = child->next) {
+    xmlNodePtr pathNode = NULL;
 
-      /* open files */
-      newDocumentString = loadExternalFileToString(externalFullFileName);
-      if (newDocumentString == NULL) {
-        printMsg(MESSAGETYPE_ERROR, "\nError in fetching external file \"%s\".\n", externalFullFileName);
-        free(externalFullFileName);
-        xmlFree(externalDataNodeXPath);
-        free(resolvedDirectory);
-        return OPEN_FAILED;
+    if (!isExternalDataNode(child)) {
+      continue;
+    }
+    (*count)++;
+    for (pathNode = child->children; pathNode && directory; pathNode = pathNode->next) {
+      if (pathNode->type == XML_ELEMENT_NODE && !strcmp((const char*) pathNode->name, EXTERNAL_DATA_NODE_NAME_PATH)) {
+        char* path = getChildText(pathNode);
+        char* dataURI = localPathToURI(path);
+        int equal = dataURI && !strcmp(dataURI, directory);
+
+        free(path);
+        free(dataURI);
+        if (equal && position == 0) {
+          position = *count;
+        }
+        break;
       }
+    }
+  }
+  return position;
+}
 
-      /* now parse the file to DOM */
-      xmlDocument = xmlReadMemory(newDocumentString, (int) strlen(newDocumentString), "urlResource", NULL, 0);
-      free(newDocumentString);
-
-      if (xmlDocument) {
-        xmlNodePtr rootToInsert = xmlDocGetRootElement(xmlDocument);
-
-        xmlNodePtr parent = cur->parent;
-        if (parent) {
-          xmlChar* nodePathNew = NULL;
-          char* dataURI = localPathToURI(externalDataDirectory);
-          xmlNodePtr nodeToInsert = xmlDocCopyNode(rootToInsert, aTixiDocument->docPtr, 1);
-
-          /* add metadata to node, to allow saving external node data */
-          xmlSetProp(nodeToInsert, (xmlChar*) EXTERNAL_DATA_XML_ATTR_FILENAME, (xmlChar*) externalFileName);
+/* returns the absolute path of a local directory ending with "/", NULL if it does not exist */
+static char* getAbsoluteDirectory(const char* directory)
+{
+  char* absolutePath = getAbsolutePath(directory && directory[0] != '\0' ? directory : "./");
+  char* absoluteDirectory = NULL;
 
-          /* save the sub-directory */
-          xmlSetProp(nodeToInsert, (xmlChar*) EXTERNAL_DATA_XML_ATTR_DIRECTORY, (xmlChar*) dataURI);
-          free(dataURI);
+  if (!absolutePath) {
+    return NULL;
+  }
+  absoluteDirectory = buildString(string_endsWith(absolutePath, "/") == 0 ? "%s" : "%s/", absolutePath);
+  free(absolutePath);
+  return absoluteDirectory;
+}
 
-          /* save the external data node position */
-          nodePathNew = xmlGetNodePath(parent);
-          xmlSetProp(nodeToInsert, (xmlChar*) EXTERNAL_DATA_XML_ATTR_NODEPATH, nodePathNew);
-          xmlFree(nodePathNew);
+/**
+ * The kept externaldata elements of OPENMODE_RECURSIVE_LAZY read from paths relative to the
+ * directory of the opened file. If the document is saved to another directory, their relative
+ * paths are replaced by absolute ones, so that they still point to the files.
+ */
+static ReturnCode relocateExternalDataPaths(TixiDocument* aTixiDocument, const char* fromDirectory,
+                                            const char* toDirectory)
+{
+  char* absoluteFrom = getAbsoluteDirectory(fromDirectory);
+  char* absoluteTo = getAbsoluteDirectory(toDirectory);
+  xmlNodePtr* nodes = NULL;
+  int nNodes = 0;
+  int capacity = 0;
+  int iNode;
+  ReturnCode error = SUCCESS;
 
-          /* replace externalData node with xml file's content */
-          xmlReplaceNode(cur, nodeToInsert);
+  if (!absoluteFrom || !absoluteTo || strcmp(absoluteFrom, absoluteTo) == 0
+      || !xmlDocGetRootElement(aTixiDocument->docPtr)) {
+    free(absoluteFrom);
+    free(absoluteTo);
+    return SUCCESS;
+  }
 
-          /* file could be loaded and parsed, increase the counter */
-          (*number)++;
-        }
+  error = collectExternalDataNodes(xmlDocGetRootElement(aTixiDocument->docPtr), 0, &nodes, &nNodes, &capacity);
+  for (iNode = 0; iNode < nNodes && error == SUCCESS; ++iNode) {
+    xmlNodePtr pathNode = NULL;
 
-        xmlFreeDoc(xmlDocument);
+    for (pathNode = nodes[iNode]->children; pathNode; pathNode = pathNode->next) {
+      if (pathNode->type == XML_ELEMENT_NODE && !strcmp((const char*) pathNode->name, EXTERNAL_DATA_NODE_NAME_PATH)) {
+        break;
       }
-      else {
-        printMsg(MESSAGETYPE_WARNING,
-                 "Document %s will be ignored. No valid XML document!\n",
-                 externalFullFileName);
-
-        /* remove external data node */
-        xmlUnlinkNode(cur);
+    }
+    if (pathNode) {
+      char* path = getChildText(pathNode);
+      char* localPath = isPathRelative(path) == 0 ? uriToLocalPath(path) : buildString("%s", path);
+
+      /* absolute paths and remote URIs do not depend on the directory of the document */
+      if (localPath && isURIPath(localPath) != 0 && isLocalPathRelative(localPath) == 0) {
+        char* absolutePath = buildString("%s%s", absoluteFrom, localPath);
+
+        invalidateChildIndex(aTixiDocument, pathNode);
+        xmlNodeSetContent(pathNode, NULL);
+        xmlNodeAddContent(pathNode, (xmlChar*) absolutePath);
+        free(absolutePath);
       }
-      free(externalFullFileName);
-    } /* end for files */
-
-    free(resolvedDirectory);
-    free(externalDataNodeXPath);
-    xmlFreeNode(cur);
+      free(localPath);
+      free(path);
+    }
   }
 
-  return SUCCESS;
+  free(nodes);
+  free(absoluteFrom);
+  free(absoluteTo);
+  return error;
 }
 
-
 ReturnCode saveExternalFiles(xmlNodePtr aNodePtr, TixiDocument* aTixiDocument)
 {
   TixiDocumentHandle handle = aTixiDocument->handle;
@@ -733,9 +2754,12 @@ ReturnCode saveExternalFiles(xmlNodePtr aNodePtr, TixiDocument* aTixiDocument)
   char* externalDataNodePath = NULL;
   char* fullExternalDataNodePath = NULL;
   xmlDocPtr xmlDocument = NULL;
+  xmlNodePtr parentNode = NULL;
+  xmlNodePtr nextNode = NULL;
 
   /* find external data nodes */
-  for (cur_node = aNodePtr; cur_node; cur_node = cur_node->next) {
+  for (cur_node = aNodePtr; cur_node; cur_node = nextNode) {
+    nextNode = cur_node->next;
 
     /* recurse down with the next element */
     saveExternalFiles(cur_node->children, aTixiDocument);
@@ -747,6 +2771,8 @@ ReturnCode saveExternalFiles(xmlNodePtr aNodePtr, TixiDocument* aTixiDocument)
     if ( cur_node->type == XML_ELEMENT_NODE ) {
       char* dirResolved = NULL;
       char* includetNodeName = (char*) xmlGetNodePath(cur_node);
+      int externalDataIndex = 0;
+      int externalDataCount = 0;
 
       /* collect node information - externalFileName */
       tixiGetTextAttribute(handle, includetNodeName,
@@ -796,11 +2822,16 @@ ReturnCode saveExternalFiles(xmlNodePtr aNodePtr, TixiDocument* aTixiDocument)
       free(dirResolved);
       xmlFreeDoc(xmlDocument);
 
-      /* create external data node structure */
-      fullExternalDataNodePath = buildString("%s/%s", externalDataNodePath, EXTERNAL_DATA_NODE_NAME);
+      /* create external data node structure, the kept externaldata nodes of
+         OPENMODE_RECURSIVE_LAZY may read from other directories */
+      if (checkElement(XPathGetContext(aTixiDocument), externalDataNodePath, &parentNode) == SUCCESS) {
+        externalDataIndex = findExternalDataElement(parentNode, externalDataDirectory, &externalDataCount);
+      }
+      fullExternalDataNodePath = buildString("%s/%s[%d]", externalDataNodePath, EXTERNAL_DATA_NODE_NAME,
+                                             externalDataIndex > 0 ? externalDataIndex : externalDataCount + 1);
 
       /* add parent node if not exists */
-      if(tixiCheckElement(handle, fullExternalDataNodePath) != SUCCESS) {
+      if (externalDataIndex == 0) {
         tixiAddTextElement(handle, externalDataNodePath, EXTERNAL_DATA_NODE_NAME, "");
         tixiAddTextElement(handle, fullExternalDataNodePath, EXTERNAL_DATA_NODE_NAME_PATH, externalDataDirectory);
       }
@@ -809,11 +2840,12 @@ ReturnCode saveExternalFiles(xmlNodePtr aNodePtr, TixiDocument* aTixiDocument)
       tixiAddTextElement(handle, fullExternalDataNodePath, EXTERNAL_DATA_NODE_NAME_FILENAME, externalFileName);
 
       /* remove the copied nodes from document*/
-      copiedNode = cur_node->prev;
+      invalidateChildIndexesOfSubtree(aTixiDocument, cur_node);
+      uid_removeSubtreeUIDs(aTixiDocument, cur_node);
+      uid_clearReferenceGraph(aTixiDocument);
       xmlUnlinkNode(cur_node);
       xmlFreeNode(cur_node);
       free(fullExternalDataNodePath);
-      cur_node = copiedNode;
     }
   }
   return SUCCESS;
@@ -831,6 +2863,9 @@ void removeExternalNodes(xmlNodePtr aNodePtr, TixiDocument* aTixiDocument)
 
     if ( checkExternalNode( cur_node ) == SUCCESS && cur_node->type == XML_ELEMENT_NODE ) {
       xmlNodePtr next = cur_node->next;
+      invalidateChildIndexesOfSubtree(aTixiDocument, cur_node);
+      uid_removeSubtreeUIDs(aTixiDocument, cur_node);
+      uid_clearReferenceGraph(aTixiDocument);
       xmlUnlinkNode(cur_node);
       xmlFreeNode(cur_node);
       cur_node = next;
@@ -856,7 +2891,7 @@ xmlNodePtr getParentNodeToXPath(TixiDocumentHandle handle, const char* elementPa
     return parent;
   }
 
-  xpathObject = xmlXPathEvalExpression((xmlChar*) elementPath, document->xpathContext);
+  xpathObject = XPathEvaluate(XPathGetContext(document), elementPath);
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", elementPath);
@@ -887,7 +2922,7 @@ xmlNodePtr getParentNodeToXPath(TixiDocumentHandle handle, const char* elementPa
 }
 
 
-ReturnCode genericAddTextAttribute(xmlXPathContextPtr xpathContext, const char* elementPath,
+ReturnCode genericAddTextAttribute(TixiDocument* document, const char* elementPath,
                                    const char* attributeName, const char* attributeValue)
 {
   ReturnCode error = -1;
@@ -904,7 +2939,7 @@ ReturnCode genericAddTextAttribute(xmlXPathContextPtr xpathContext, const char*
     return INVALID_XML_NAME;
   }
 
-  error = checkElement(xpathContext, elementPath, &parent);
+  error = checkElement(XPathGetContext(document), elementPath, &parent);
   if (!error) {
     char* prefix = NULL;
     char* name = NULL;
@@ -912,7 +2947,13 @@ ReturnCode genericAddTextAttribute(xmlXPathContextPtr xpathContext, const char*
 
     extractPrefixAndName(attributeName, &prefix, &name);
 
-    if (!prefix) {
+    uid_clearReferenceGraph(document);
+    if (!prefix && !strcmp(attributeName, CPACS_UID_ATTRIBUTE_STRING)) {
+      uid_removeNodeUID(document, parent);
+      attributePtr = xmlSetProp(parent, (xmlChar*) attributeName, (xmlChar*) attributeValue);
+      uid_addNodeUID(document, parent);
+    }
+    else if (!prefix) {
       attributePtr = xmlSetProp(parent, (xmlChar*) attributeName, (xmlChar*) attributeValue);
     }
     else {
@@ -950,39 +2991,42 @@ ReturnCode getNodePtrFromElementPath(TixiDocumentHandle handle, const char* elem
 {
   TixiDocument* document = getDocument(handle);
   xmlXPathObjectPtr xpathObject = NULL;
-  xmlNodeSetPtr nodes = NULL;
+  xmlNodePtr node = NULL;
+  int nNodes = 0;
 
   if (!document) {
     printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
     return INVALID_HANDLE;
   }
 
-  xpathObject = xmlXPathEvalExpression((xmlChar*) elementPath, document->xpathContext);
+  /* simple paths like /a/b[2]/c[@uID="x"] are resolved by walking the tree */
+  nNodes = XPathResolveSimplePath(XPathGetContext(document), elementPath, &node);
+  if (nNodes < 0) {
+    xpathObject = XPathEvaluate(XPathGetContext(document), elementPath);
 
-  if (!xpathObject) {
-    printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", elementPath);
-    return INVALID_XPATH;
+    if (!xpathObject) {
+      printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", elementPath);
+      return INVALID_XPATH;
+    }
+    nNodes = xmlXPathNodeSetGetLength(xpathObject->nodesetval);
+    if (nNodes > 0) {
+      node = xmlXPathNodeSetItem(xpathObject->nodesetval, 0);
+    }
+    xmlXPathFreeObject(xpathObject);
   }
 
-  if (xmlXPathNodeSetIsEmpty(xpathObject->nodesetval)) {
+  if (nNodes == 0) {
     printMsg(MESSAGETYPE_ERROR, "Error: No element found at XPath expression \"%s\"\n", elementPath);
-    xmlXPathFreeObject(xpathObject);
     return ELEMENT_NOT_FOUND;
   }
 
-  nodes = xpathObject->nodesetval;
-
-  assert(nodes);
-
-  if (nodes->nodeNr > 1) {
+  if (nNodes > 1) {
     printMsg(MESSAGETYPE_ERROR,
              "Error: Element chosen by XPath \"%s\" expression is not unique. \n", elementPath);
-    xmlXPathFreeObject(xpathObject);
     return ELEMENT_PATH_NOT_UNIQUE;
   }
 
-  *pNodePrt = nodes->nodeTab[0];
-  xmlXPathFreeObject(xpathObject);
+  *pNodePrt = node;
 
   return SUCCESS;
 }
@@ -1053,11 +3097,17 @@ int copyDocument(const TixiDocumentHandle oldTixiDocumentHandle, TixiDocumentHan
   dstDocument->currentNode = rootNode;
   dstDocument->isValid = srcDocument->isValid;
   dstDocument->status = srcDocument->status;
-  dstDocument->memoryListHead = NULL;
-  dstDocument->memoryListTail = NULL;
-  dstDocument->uidListHead = NULL;
+  dstDocument->memoryChunks = NULL;
+  dstDocument->largeMemoryBlocks = NULL;
+  dstDocument->uidBuckets = NULL;
   dstDocument->hasIncludedExternalFiles = srcDocument->hasIncludedExternalFiles;
   dstDocument->usePrettyPrint = srcDocument->usePrettyPrint;
+  dstDocument->useBase64Vectors = srcDocument->useBase64Vectors;
+  dstDocument->xmlParseOptions = srcDocument->xmlParseOptions;
+  dstDocument->hasSkippedElements = srcDocument->hasSkippedElements;
+  /* the copied externaldata elements are not marked as pending */
+  dstDocument->nPendingExternalData = 0;
+  dstDocument->externalDataChanged = 0;
   dstDocument->xpathContext = xmlXPathNewContext(xmlDocument);
 
   if (addDocumentToList(dstDocument, &(dstDocument->handle)) != SUCESS) {
@@ -1087,7 +3137,17 @@ ReturnCode saveDocument (TixiDocumentHandle handle, const char* xmlFilename, Int
     return INVALID_HANDLE;
   }
 
+  if (document->hasSkippedElements) {
+    printMsg(MESSAGETYPE_ERROR, "Error: The document was opened without some of its elements and cannot be saved.\n");
+    return FAILED;
+  }
+
   if (saveMode == COMPLETE) {
+    /* the document is saved with all external files of OPENMODE_RECURSIVE_LAZY */
+    ReturnCode error = resolveExternalData(document, (xmlNodePtr) document->docPtr, 1);
+    if (error != SUCCESS) {
+      return error;
+    }
     if (xmlSaveFormatFileEnc(xmlFilename, document->docPtr, "utf-8", document->usePrettyPrint) == -1) {
       printMsg(MESSAGETYPE_ERROR, "Error: Failed in writing document to file.\n");
       return FAILED;
@@ -1108,6 +3168,7 @@ ReturnCode saveDocument (TixiDocumentHandle handle, const char* xmlFilename, Int
       free(cpyDoc->filename);
     }
     strip_dirname(xmlFilename, &cpyDoc->dirname, &cpyDoc->filename);
+    relocateExternalDataPaths(cpyDoc, document->dirname, cpyDoc->dirname);
 
     rootNode = xmlDocGetRootElement(cpyDoc->docPtr);
     saveExternalFiles(rootNode, cpyDoc);
@@ -1117,13 +3178,20 @@ ReturnCode saveDocument (TixiDocumentHandle handle, const char* xmlFilename, Int
       return FAILED;
     };
     removeDocumentFromList(newHandle);
-    freeTixiDocument(cpyDoc);
 
   }
   else if (saveMode == REMOVED) {
+    char* dirname = NULL;
+    char* filename = NULL;
+
     copyDocument(handle, &newHandle);
     cpyDoc = getDocument(newHandle);
 
+    strip_dirname(xmlFilename, &dirname, &filename);
+    relocateExternalDataPaths(cpyDoc, document->dirname, dirname);
+    free(dirname);
+    free(filename);
+
     rootNode = xmlDocGetRootElement(cpyDoc->docPtr);
     removeExternalNodes(rootNode, cpyDoc);
 
@@ -1243,6 +3311,8 @@ char* generateXPathFromNodePtr(TixiDocumentHandle handle, xmlNodePtr aNodePtr)
     nodePtr = nodePtr->parent;
   }
 
-  addToMemoryList(document, (void*) generatedXPath);
-  return generatedXPath;
+  /* return a copy owned by the document */
+  textPtr = copyStringToDocument(document, generatedXPath);
+  free(generatedXPath);
+  return textPtr;
 }
@@ -19,9 +19,6 @@
 #ifndef TIXI_INTERNAL_H
 #define TIXI_INTERNAL_H
 
-#ifdef __cplusplus
-extern "C" {
-#endif
 
 /**
  * @file   tixiInternal.h
@@ -37,6 +34,10 @@ extern "C" {
 #include "tixi.h"
 #include "tixiData.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 
 
 typedef enum {
@@ -57,8 +58,9 @@ InternalReturnCode addDocumentToList(TixiDocument* document, TixiDocumentHandle*
 /**
  * @brief Removes document from the list of managed documents.
  *
+ * The document is freed as soon as no other thread uses it anymore.
  *
- * @param document pointer to the document to be added to the list of managed documents
+ * @param handle handle of the document to be removed
  *
  * @return error code
  */
@@ -75,19 +77,237 @@ ReturnCode removeDocumentFromList(TixiDocumentHandle handle);
 DLL_EXPORT TixiDocument* getDocument(TixiDocumentHandle handle);
 
 /**
- @brief Adds pointer to memory allcoated by libxml to list of managed memory.
+ * @brief Returns the handle of the next open document in the handle table.
+ *
+ * @param slotIndex Index of the slot to start the search at, 0 for the first call.
+ *                  Is set behind the slot of the returned document.
+ * @return handle of an open document or -1 if no further document is open
+ */
+TixiDocumentHandle getNextDocumentHandle(int* slotIndex);
+
+/**
+  Kind of access to a document, see ::lockDocument.
+ */
+typedef enum
+{
+  DOCUMENT_READ,  /**< Shared access, the document is not modified */
+  DOCUMENT_WRITE  /**< Exclusive access */
+} DocumentAccessMode;
+
+/**
+ * @brief Retrieves a document and locks it for the calling thread.
+ *
+ * Any number of threads can hold a read lock on the same document, a write
+ * lock is exclusive. A read lock becomes exclusive only when the reader reaches
+ * a pending externaldata element (OPENMODE_RECURSIVE_LAZY) and includes its
+ * files, see ::resolveExternalData. The document is kept alive until
+ * ::unlockDocument is called, even if it is closed by another thread meanwhile.
+ * Locks are reentrant, a thread holding a write lock may lock the document again.
+ * A read lock can not be upgraded to a write lock. If the lock fails,
+ * ::getDocument returns NULL for the document until ::unlockDocument is
+ * called with NULL, so the function called under the lock fails with
+ * INVALID_HANDLE.
+ *
+ * @param (in) handle
+ * @param (in) mode DOCUMENT_READ or DOCUMENT_WRITE
+ *
+ * @return the locked document or NULL if handle not in the list or the lock failed
+ */
+TixiDocument* lockDocument(TixiDocumentHandle handle, DocumentAccessMode mode);
+
+/**
+ * @brief Releases a document locked with ::lockDocument. Does nothing for NULL.
+ */
+void unlockDocument(TixiDocument* document);
+
+/**
+ @brief Allocates memory returned to the user, which is owned by the document.
+
+ The memory is taken from an arena of large chunks and released all at once
+ when the document is closed. The memory is aligned for any numeric type.
+
+ @param document (in) a pointer to a TixiDocument structure
+ @param size (in) number of bytes
 
- @param (in) memory pointer to the memory location
+ @return pointer to the memory or NULL if the allocation failed
  */
-InternalReturnCode addToMemoryList(TixiDocument* document, void* memory);
+void* allocateDocumentMemory(TixiDocument* document, size_t size);
 
 /**
-  @brief Frees all memory locations pointed to by the pointers in the list
-         and removes all list entries.
+ @brief Copies a string into memory owned by the document, see ::allocateDocumentMemory.
+
+ @return the copy or NULL if the allocation failed
+ */
+char* copyStringToDocument(TixiDocument* document, const char* string);
+
+/**
+ @brief Returns the text of the node list without copying it, if possible.
+
+ This is possible if the list consists of a single text or CDATA node and,
+ with escape set, the text contains no characters to be escaped.
+
+ @param doc (in) the document of the nodes
+ @param list (in) the first node of the list, e.g. the first child of an element
+ @param escape (in) if set, the text as returned by xmlNodeListGetString(doc, list, 0)
+                    is requested, otherwise as returned by xmlNodeListGetString(doc, list, 1)
+
+ @return the text of the node, an empty string for an empty list, NULL if the text
+         has to be assembled by xmlNodeListGetString
+ */
+const char* getNodeListTextDirect(xmlDocPtr doc, xmlNodePtr list, int escape);
+
+/**
+ @brief Copies a string into a buffer supplied by the user.
+
+ If the buffer is too small, the string is truncated.
+
+ @param text (in) the string to copy
+ @param buffer (out) the buffer, may be NULL to only query the required size
+ @param bufferSize (in) size of the buffer in bytes
+ @param requiredSize (out) size of the string including the terminating zero, may be NULL
+
+ @return
+  - SUCCESS
+  - STRING_TRUNCATED if the buffer is too small
+ */
+ReturnCode copyTextToBuffer(const char* text, char* buffer, int bufferSize, int* requiredSize);
+
+/**
+ @brief Copies the text of a node list into a buffer supplied by the user,
+ see ::getNodeListTextDirect and ::copyTextToBuffer.
+ */
+ReturnCode copyNodeListTextToBuffer(xmlDocPtr doc, xmlNodePtr list, int escape, char* buffer, int bufferSize, int* requiredSize);
+
+/**
+ @brief Looks up an attribute of an element by its (optionally prefixed) name.
+
+ The attribute may also be a default attribute declared in the DTD (type XML_ATTRIBUTE_DECL).
+
+ @return
+  - SUCCESS
+  - ATTRIBUTE_NOT_FOUND
+  - INVALID_NAMESPACE_PREFIX
+ */
+ReturnCode findAttribute(xmlNodePtr element, const char* attributeName, xmlAttrPtr* attribute);
+
+/**
+ @brief Saves the state of the arena of the document.
+
+ @param document (in) a pointer to a TixiDocument structure
+ @param mark (out) position and generation of the checkpoint, see ::releaseDocumentMemoryTo
+
+ @return
+  - SUCCESS
+  - FAILED if the allocation of the checkpoint failed
+ */
+ReturnCode checkpointDocumentMemory(TixiDocument* document, int* mark);
+
+/**
+ @brief Frees all memory of the arena allocated after the checkpoint mark.
+
+ Checkpoints created after mark are discarded, mark itself remains valid.
+
+ @param document (in) a pointer to a TixiDocument structure
+ @param mark (in) checkpoint as returned by ::checkpointDocumentMemory
+
+ @return
+  - SUCCESS
+  - INDEX_OUT_OF_RANGE if there is no such checkpoint or it has been discarded
+ */
+ReturnCode releaseDocumentMemoryTo(TixiDocument* document, int mark);
+
+/**
+ @brief Returns the bytes and the number of allocations handed out by the arena.
+ */
+void getDocumentMemoryUsage(TixiDocument* document, size_t* bytes, size_t* entries);
+
+/**
+ @brief Creates a node cursor pointing to node.
+
+ @param document (in) a pointer to a TixiDocument structure
+ @param node (in) the element of the cursor
+ @param cursor (out) the new cursor
+
+ @return
+  - SUCCESS
+  - FAILED if the allocation of the cursor failed
+ */
+ReturnCode createNodeCursor(TixiDocument* document, xmlNodePtr node, TixiNodeCursor* cursor);
+
+/**
+ @brief Releases the slot of the cursor, the cursor must not be used anymore.
+
+ @return
+  - SUCCESS
+  - INVALID_CURSOR if there is no such cursor
+ */
+ReturnCode releaseNodeCursor(TixiDocument* document, TixiNodeCursor cursor);
+
+/**
+ @brief Returns the current node of the cursor.
+
+ @return
+  - SUCCESS
+  - INVALID_CURSOR if there is no such cursor or its node has been removed
+ */
+ReturnCode getNodeCursorNode(TixiDocument* document, TixiNodeCursor cursor, xmlNodePtr* node);
+
+/**
+ @brief Moves the cursor to node.
+
+ @return
+  - SUCCESS
+  - INVALID_CURSOR if there is no such cursor or its node has been removed
+ */
+ReturnCode setNodeCursorNode(TixiDocument* document, TixiNodeCursor cursor, xmlNodePtr node);
+
+/**
+ @brief Invalidates all cursors pointing into the subtree of removedNode.
+
+ Has to be called before the node is freed.
+ */
+void invalidateNodeCursors(TixiDocument* document, xmlNodePtr removedNode);
+
+/**
+ @brief Returns a child of parent from the index of its children.
+
+ The index is created on the first use. If name is NULL, all children except
+ DTD nodes are indexed, otherwise the element children named name without
+ namespace.
+
+ @param document (in) a pointer to a TixiDocument structure
+ @param parent (in) the node whose children are indexed
+ @param name (in) name of the children, does not have to be null terminated
+ @param nameLength (in) length of name
+ @param position (in) position of the child starting with 1, 0 to only count the children
+ @param child (out) the child at position or NULL if there is no such child
+
+ @return the number of indexed children or -1 if the index could not be created
+ */
+int getIndexedChild(TixiDocument* document, xmlNodePtr parent, const char* name, size_t nameLength,
+                    int position, xmlNodePtr* child);
+
+/**
+ @brief Drops the indexes of the children of parent.
+
+ Has to be called whenever children are added to or removed from parent.
+ */
+void invalidateChildIndex(TixiDocument* document, xmlNodePtr parent);
+
+/**
+ @brief Drops the indexes of the parent of removedNode and of all nodes inside its subtree.
+
+ Has to be called before the node is freed. Only the removed subtree is walked, so
+ replacing a text node costs two lookups in the table of the indexes.
+ */
+void invalidateChildIndexesOfSubtree(TixiDocument* document, xmlNodePtr removedNode);
+
+/**
+  @brief Frees all memory returned to the user.
 
   @param document (in) a pointer to a TixiDocument structure
  */
-InternalReturnCode clearMemoryList(TixiDocument* document);
+void clearDocumentMemory(TixiDocument* document);
 
 /**
   @brief Frees the memory used by the document
@@ -196,6 +416,107 @@ void checkLibxml2Version();
 */
 DLL_EXPORT char* buildString(const char* format, ...);
 
+/**
+  @brief Growable string buffer for writing many numbers into one text.
+
+  Short texts are written into the buffer itself, longer ones grow the buffer
+  geometrically. If an allocation fails, failed is set and further writes are
+  ignored, so the caller has to check only once.
+*/
+typedef struct
+{
+  char* data;               /**< The text, always terminated */
+  size_t length;            /**< Length of the text without the terminating zero */
+  size_t capacity;          /**< Size of data in bytes */
+  int failed;               /**< Set if an allocation failed */
+  char localData[64];       /**< Storage of short texts */
+} TixiStringBuffer;
+
+void stringBufferInit(TixiStringBuffer* buffer);
+
+void stringBufferFree(TixiStringBuffer* buffer);
+
+/**
+  @brief Empties the buffer, keeping its memory.
+*/
+void stringBufferClear(TixiStringBuffer* buffer);
+
+/**
+  @brief Ensures that size more bytes can be appended without growing the buffer.
+*/
+int stringBufferReserve(TixiStringBuffer* buffer, size_t size);
+
+int stringBufferAppend(TixiStringBuffer* buffer, const char* text);
+
+int stringBufferAppendFormat(TixiStringBuffer* buffer, const char* format, ...);
+
+/**
+  @brief Appends number formatted with format, NULL selects "%g".
+
+  "%g" is formatted without snprintf, the result is the same, except that
+  the decimal separator is always a point.
+*/
+int stringBufferAppendDouble(TixiStringBuffer* buffer, const char* format, double number);
+
+/**
+  @brief Parses a number at the beginning of text like strtod in the "C" locale,
+  independent of the locale set by the application.
+
+  Leading white space is skipped. Numbers with up to 19 digits and small exponents
+  are converted directly, all others by strtod.
+
+  @return the first character after the number, text if there is no number (value is then 0)
+*/
+const char* parseDouble(const char* text, double* value);
+
+/**
+  @brief Parses the next value of a vector, i.e. a list of numbers separated by VECTOR_SEPARATOR.
+
+  Empty values are skipped like by strtok, values which are no numbers are read as 0.
+
+  @return the position after the value to continue with, NULL if there are no more values
+*/
+const char* parseNextVectorValue(const char* text, double* value);
+
+/**
+  @brief Returns the number of values of a vector, see ::parseNextVectorValue.
+*/
+int countVectorValues(const char* text);
+
+/**
+  @brief Appends the values base64 encoded as little endian doubles (encoding VECTOR_ENCODING_BASE64).
+*/
+int stringBufferAppendBase64Doubles(TixiStringBuffer* buffer, const double* values, int nValues);
+
+/**
+  @brief Returns 1 if the values of the vector or array element are stored base64 encoded,
+  i.e. the element has the attribute encoding="base64-le-f64".
+*/
+int isBase64Vector(xmlNodePtr node);
+
+/**
+  @brief Reads the values of a vector or array element into values.
+
+  Base64 encoded elements are decoded, the text of all others is parsed with ::parseNextVectorValue.
+  At most capacity values are stored, values may be NULL to only count the values.
+
+  @return the number of values of the element, -1 if the base64 data is invalid
+*/
+int readVectorNodeValues(xmlDocPtr doc, xmlNodePtr node, double* values, int capacity);
+
+/**
+  @brief Reads the values of the text of a vector or array element like ::readVectorNodeValues,
+  isBase64 selects the encoding.
+*/
+int readVectorTextValues(const char* text, int isBase64, double* values, int capacity);
+
+/**
+  @brief Loads a local file, a file:// URI or a web resource into a string.
+
+  @return the content of the file, to be freed with free, NULL if it could not be loaded
+*/
+char* loadExternalFileToString(const char* filename);
+
 
 /**
   @brief Open external xml files and merge them into the tree.
@@ -233,6 +554,36 @@ DLL_EXPORT char* buildString(const char* format, ...);
 */
 ReturnCode openExternalFiles(TixiDocument* aTixiDocument, int* number);
 
+/**
+  @brief Keeps the externaldata elements of the document for OPENMODE_RECURSIVE_LAZY.
+
+  The elements are marked as pending and counted in nPendingExternalData, their
+  files are included by ::resolveExternalData.
+
+  @return
+    - SUCCESS
+    - FAILED internal error
+*/
+ReturnCode openExternalFilesLazy(TixiDocument* aTixiDocument);
+
+/**
+  @brief Includes the files of the pending externaldata elements among the children of parent,
+  see ::openExternalFilesLazy. The externaldata elements of the included files are pending again,
+  unless wholeSubtree is set, which includes all pending elements below parent.
+
+  Modifies the tree. If there are files to include, a read lock of the calling thread on the
+  document is upgraded to an exclusive lock, which it keeps until the lock is released. Other
+  readers may include files meanwhile, so the caller must not keep pointers to pending
+  externaldata elements.
+
+  @return
+    - SUCCESS
+    - FAILED internal error
+    - OPEN_FAILED if an externaldata element is invalid or a file cannot be read,
+      the element is kept and not tried again
+*/
+ReturnCode resolveExternalData(TixiDocument* aTixiDocument, xmlNodePtr parent, int wholeSubtree);
+
 
 /**
   @brief Searches the tree for node that have to be saved in external files again.
@@ -266,7 +617,7 @@ xmlNodePtr getParentNodeToXPath(TixiDocumentHandle handle, const char* elementPa
   to an element specified by the elementPath expression. If the
   attribute already exists its previous value is replaced by text.
 
-  @param xpathContext (in) libxml2 pointer to the xpath context.
+  @param document (in) a pointer to a TixiDocument structure.
   @param elementPath (in) a xpath to a xml element.
   @param attributeName (in) the name of the attribute to set.
   @param attributeValue (in) the value of the attribute to set.
@@ -275,7 +626,7 @@ xmlNodePtr getParentNodeToXPath(TixiDocumentHandle handle, const char* elementPa
     - INVALID_XML_NAME
     - SUCCESS
  */
-ReturnCode genericAddTextAttribute(xmlXPathContextPtr xpathContext, const char* elementPath,
+ReturnCode genericAddTextAttribute(TixiDocument* document, const char* elementPath,
                                    const char* attributeName, const char* attributeValue);
 
 
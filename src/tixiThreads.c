@@ -0,0 +1,260 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "tixiThreads.h"
+
+#include <stdlib.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+/* function and argument of a new thread */
+typedef struct
+{
+  void (*function)(void*);
+  void* argument;
+} ThreadStart;
+
+static ThreadStart* newThreadStart(void (*function)(void*), void* argument)
+{
+  ThreadStart* start = (ThreadStart*) malloc(sizeof(ThreadStart));
+
+  if (start) {
+    start->function = function;
+    start->argument = argument;
+  }
+  return start;
+}
+
+#ifdef _WIN32
+
+static DWORD WINAPI threadTrampoline(LPVOID parameter)
+{
+  ThreadStart start = *(ThreadStart*) parameter;
+
+  free(parameter);
+  start.function(start.argument);
+  return 0;
+}
+
+int thread_create(TixiThread* thread, void (*function)(void*), void* argument)
+{
+  ThreadStart* start = newThreadStart(function, argument);
+
+  if (!start) {
+    return -1;
+  }
+  *thread = CreateThread(NULL, 0, threadTrampoline, start, 0, NULL);
+  if (!*thread) {
+    free(start);
+    return -1;
+  }
+  return 0;
+}
+
+void thread_join(TixiThread* thread)
+{
+  WaitForSingleObject(*thread, INFINITE);
+  CloseHandle(*thread);
+}
+
+int thread_getProcessorCount(void)
+{
+  SYSTEM_INFO info;
+
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors > 0 ? (int) info.dwNumberOfProcessors : 1;
+}
+
+static BOOL CALLBACK callOnceTrampoline(PINIT_ONCE once, PVOID parameter, PVOID* context)
+{
+  void (*initFunction)(void) = *(void (**)(void)) parameter;
+  (void) once;
+  (void) context;
+  initFunction();
+  return TRUE;
+}
+
+void thread_callOnce(TixiOnce* once, void (*initFunction)(void))
+{
+  InitOnceExecuteOnce(once, callOnceTrampoline, (PVOID) &initFunction, NULL);
+}
+
+void mutex_init(TixiMutex* mutex)
+{
+  InitializeSRWLock(mutex);
+}
+
+void mutex_lock(TixiMutex* mutex)
+{
+  AcquireSRWLockExclusive(mutex);
+}
+
+void mutex_unlock(TixiMutex* mutex)
+{
+  ReleaseSRWLockExclusive(mutex);
+}
+
+void mutex_destroy(TixiMutex* mutex)
+{
+  /* slim locks do not own resources */
+  (void) mutex;
+}
+
+void rwlock_init(TixiRWLock* lock)
+{
+  InitializeSRWLock(lock);
+}
+
+void rwlock_readLock(TixiRWLock* lock)
+{
+  AcquireSRWLockShared(lock);
+}
+
+void rwlock_writeLock(TixiRWLock* lock)
+{
+  AcquireSRWLockExclusive(lock);
+}
+
+void rwlock_readUnlock(TixiRWLock* lock)
+{
+  ReleaseSRWLockShared(lock);
+}
+
+void rwlock_writeUnlock(TixiRWLock* lock)
+{
+  ReleaseSRWLockExclusive(lock);
+}
+
+void rwlock_destroy(TixiRWLock* lock)
+{
+  (void) lock;
+}
+
+int atomic_increment(volatile int* value)
+{
+  return (int) InterlockedIncrement((volatile LONG*) value);
+}
+
+int atomic_decrement(volatile int* value)
+{
+  return (int) InterlockedDecrement((volatile LONG*) value);
+}
+
+#else /* POSIX */
+
+static void* threadTrampoline(void* parameter)
+{
+  ThreadStart start = *(ThreadStart*) parameter;
+
+  free(parameter);
+  start.function(start.argument);
+  return NULL;
+}
+
+int thread_create(TixiThread* thread, void (*function)(void*), void* argument)
+{
+  ThreadStart* start = newThreadStart(function, argument);
+
+  if (!start) {
+    return -1;
+  }
+  if (pthread_create(thread, NULL, threadTrampoline, start) != 0) {
+    free(start);
+    return -1;
+  }
+  return 0;
+}
+
+void thread_join(TixiThread* thread)
+{
+  pthread_join(*thread, NULL);
+}
+
+int thread_getProcessorCount(void)
+{
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+  return count > 0 ? (int) count : 1;
+}
+
+void thread_callOnce(TixiOnce* once, void (*initFunction)(void))
+{
+  pthread_once(once, initFunction);
+}
+
+void mutex_init(TixiMutex* mutex)
+{
+  pthread_mutex_init(mutex, NULL);
+}
+
+void mutex_lock(TixiMutex* mutex)
+{
+  pthread_mutex_lock(mutex);
+}
+
+void mutex_unlock(TixiMutex* mutex)
+{
+  pthread_mutex_unlock(mutex);
+}
+
+void mutex_destroy(TixiMutex* mutex)
+{
+  pthread_mutex_destroy(mutex);
+}
+
+void rwlock_init(TixiRWLock* lock)
+{
+  pthread_rwlock_init(lock, NULL);
+}
+
+void rwlock_readLock(TixiRWLock* lock)
+{
+  pthread_rwlock_rdlock(lock);
+}
+
+void rwlock_writeLock(TixiRWLock* lock)
+{
+  pthread_rwlock_wrlock(lock);
+}
+
+void rwlock_readUnlock(TixiRWLock* lock)
+{
+  pthread_rwlock_unlock(lock);
+}
+
+void rwlock_writeUnlock(TixiRWLock* lock)
+{
+  pthread_rwlock_unlock(lock);
+}
+
+void rwlock_destroy(TixiRWLock* lock)
+{
+  pthread_rwlock_destroy(lock);
+}
+
+int atomic_increment(volatile int* value)
+{
+  return __sync_add_and_fetch(value, 1);
+}
+
+int atomic_decrement(volatile int* value)
+{
+  return __sync_sub_and_fetch(value, 1);
+}
+
+#endif
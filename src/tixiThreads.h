@@ -0,0 +1,109 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/**
+ * @file   tixiThreads.h
+ * @brief  Portable wrappers of the synchronization primitives used by tixi.
+ *
+ * POSIX threads are used on unix like systems, slim reader/writer locks
+ * and one-time initialization on windows.
+ */
+
+#ifndef TIXI_THREADS_H
+#define TIXI_THREADS_H
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef _WIN32
+typedef HANDLE TixiThread;
+typedef SRWLOCK TixiMutex;
+typedef SRWLOCK TixiRWLock;
+typedef INIT_ONCE TixiOnce;
+#define TIXI_MUTEX_INITIALIZER  SRWLOCK_INIT
+#define TIXI_RWLOCK_INITIALIZER SRWLOCK_INIT
+#define TIXI_ONCE_INITIALIZER   INIT_ONCE_STATIC_INIT
+#define TIXI_THREAD_LOCAL __declspec(thread)
+#else
+typedef pthread_t TixiThread;
+typedef pthread_mutex_t TixiMutex;
+typedef pthread_rwlock_t TixiRWLock;
+typedef pthread_once_t TixiOnce;
+#define TIXI_MUTEX_INITIALIZER  PTHREAD_MUTEX_INITIALIZER
+#define TIXI_RWLOCK_INITIALIZER PTHREAD_RWLOCK_INITIALIZER
+#define TIXI_ONCE_INITIALIZER   PTHREAD_ONCE_INIT
+#define TIXI_THREAD_LOCAL __thread
+#endif
+
+/**
+ * @brief Starts a thread calling function(argument).
+ *
+ * @return 0 if the thread was started
+ */
+int thread_create(TixiThread* thread, void (*function)(void*), void* argument);
+
+/**
+ * @brief Waits until the thread has finished.
+ */
+void thread_join(TixiThread* thread);
+
+/**
+ * @brief Returns the number of processors available to the process, at least 1.
+ */
+int thread_getProcessorCount(void);
+
+/**
+ * @brief Calls initFunction exactly once, even if called from several threads.
+ */
+void thread_callOnce(TixiOnce* once, void (*initFunction)(void));
+
+void mutex_init(TixiMutex* mutex);
+void mutex_lock(TixiMutex* mutex);
+void mutex_unlock(TixiMutex* mutex);
+void mutex_destroy(TixiMutex* mutex);
+
+void rwlock_init(TixiRWLock* lock);
+void rwlock_readLock(TixiRWLock* lock);
+void rwlock_writeLock(TixiRWLock* lock);
+void rwlock_readUnlock(TixiRWLock* lock);
+void rwlock_writeUnlock(TixiRWLock* lock);
+void rwlock_destroy(TixiRWLock* lock);
+
+/**
+ * @brief Atomically increments the value and returns the new value.
+ */
+int atomic_increment(volatile int* value);
+
+/**
+ * @brief Atomically decrements the value and returns the new value.
+ */
+int atomic_decrement(volatile int* value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIXI_THREADS_H */
@@ -24,12 +24,15 @@
 
 #include <ctype.h>
 #ifdef _WIN32
+  #include <windows.h>
   #include <direct.h>
   #include <Shlwapi.h>
   #define mkdir(dir, attr) _mkdir((dir))
   #define rmdir(dir) _rmdir((dir))
 #else
   #include <sys/stat.h>
+  #include <sys/mman.h>
+  #include <fcntl.h>
   #include <unistd.h>
 #endif
 
@@ -290,6 +293,97 @@ char* localPathToURI(const char* path)
   }
 }
 
+char* getAbsolutePath(const char* path)
+{
+#ifdef _WIN32
+  char absolutePath[_MAX_PATH];
+
+  if (GetFileAttributesA(path) == INVALID_FILE_ATTRIBUTES || !_fullpath(absolutePath, path, _MAX_PATH)) {
+    return NULL;
+  }
+  return buildString("%s", absolutePath);
+#else
+  char* absolutePath = realpath(path, NULL);
+  char* result = NULL;
+
+  if (!absolutePath) {
+    return NULL;
+  }
+  result = buildString("%s", absolutePath);
+  free(absolutePath);
+  return result;
+#endif
+}
+
+const char* mapFileToMemory(const char* path, size_t* size)
+{
+  static const char emptyFile[] = "";
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  HANDLE mapping = NULL;
+  LARGE_INTEGER fileSize;
+  const char* data = NULL;
+
+  if (file == INVALID_HANDLE_VALUE) {
+    return NULL;
+  }
+  if (!GetFileSizeEx(file, &fileSize)) {
+    CloseHandle(file);
+    return NULL;
+  }
+  *size = (size_t) fileSize.QuadPart;
+  if (*size == 0) {
+    CloseHandle(file);
+    return emptyFile;
+  }
+  mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping) {
+    data = (const char*) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);    /* the view keeps the mapping */
+  }
+  CloseHandle(file);
+  return data;
+#else
+  struct stat status;
+  void* data = NULL;
+  int file = open(path, O_RDONLY);
+
+  if (file < 0) {
+    return NULL;
+  }
+  if (fstat(file, &status) != 0) {
+    close(file);
+    return NULL;
+  }
+  *size = (size_t) status.st_size;
+  if (*size == 0) {
+    close(file);
+    return emptyFile;
+  }
+  data = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file);    /* the mapping keeps the file */
+  if (data == MAP_FAILED) {
+    return NULL;
+  }
+#ifdef MADV_SEQUENTIAL
+  madvise(data, *size, MADV_SEQUENTIAL);
+#endif
+  return (const char*) data;
+#endif
+}
+
+void unmapFileFromMemory(const char* data, size_t size)
+{
+  if (!data || size == 0) {
+    return;
+  }
+#ifdef _WIN32
+  UnmapViewOfFile(data);
+#else
+  munmap((void*) data, size);
+#endif
+}
+
 char* loadFileToString(const char* path)
 {
   char* buffer = 0;
@@ -19,9 +19,6 @@
 #ifndef TIXI_UTILS_H
 #define TIXI_UTILS_H
 
-#ifdef __cplusplus
-extern "C" {
-#endif
 
 /**
  * @file   tixiUtils.h
@@ -38,6 +35,10 @@ extern "C" {
 #include "tixi.h"
 #include "tixiData.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
   @brief compares up to <[length]> characters
   from the string at <[a]> to the string at <[b]> in a
@@ -154,6 +155,15 @@ char* uriToLocalPath(const char* uri);
  */
 char* localPathToURI(const char* path);
 
+/**
+  @brief Returns the absolute path of an existing local file or directory, e.g. /data/TestData
+  for TestData in the working directory /data.
+  @param path The local path (no URI)
+  @return
+    The absolute path or a NULL pointer, if the path does not exist.
+ */
+char* getAbsolutePath(const char* path);
+
 
 /**
   @brief loadFileToString Loads a file from disk and returns it as a string.
@@ -163,6 +173,21 @@ char* localPathToURI(const char* path);
  */
 char* loadFileToString(const char* path);
 
+/**
+  @brief Maps a file read-only into memory.
+  @param path The local path to the file (no URI).
+  @param size (out) The size of the file in bytes.
+  @return
+    The contents of the file, which are not null terminated, or a NULL pointer if the
+    file could not be mapped. The mapping is released with ::unmapFileFromMemory.
+ */
+const char* mapFileToMemory(const char* path, size_t* size);
+
+/**
+  @brief Releases a mapping returned by ::mapFileToMemory.
+ */
+void unmapFileFromMemory(const char* data, size_t size);
+
 /**
   @brief Converts all chars of a string to lower case.
 
@@ -17,24 +17,134 @@
 */
 #include "uidHelper.h"
 #include "tixiInternal.h"
+#include "xpathFunctions.h"
+
+#include <ctype.h>
+#include <string.h>
 
 extern void printMsg(MessageType type, const char* message, ...);
 
-int uid_readDocumentUIDs(TixiDocument* tixiDocument)
+#define INITIAL_UID_BUCKETS 256
+
+static unsigned int hashUID(const char* uID)
+{
+  unsigned int hash = 2166136261u;
+  while (*uID) {
+    hash ^= (unsigned char) *uID++;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/* returns an entry with the uID other than except or NULL */
+static TixiUIDEntry* findUIDEntry(TixiDocument* document, const char* uID, unsigned int hash,
+                                  const TixiUIDEntry* except)
+{
+  TixiUIDEntry* entry = document->uidBuckets[hash & (unsigned int) (document->uidBucketCount - 1)];
+
+  while (entry) {
+    if (entry != except && entry->hash == hash && !strcmp(entry->uIDName, uID)) {
+      return entry;
+    }
+    entry = entry->next;
+  }
+  return NULL;
+}
+
+/* doubles the number of buckets */
+static int growUIDTable(TixiDocument* document)
+{
+  int newCount = document->uidBucketCount > 0 ? 2 * document->uidBucketCount : INITIAL_UID_BUCKETS;
+  TixiUIDEntry** newBuckets = (TixiUIDEntry**) calloc((size_t) newCount, sizeof(TixiUIDEntry*));
+  int iBucket;
+
+  if (!newBuckets) {
+    return 0;
+  }
+
+  for (iBucket = 0; iBucket < document->uidBucketCount; ++iBucket) {
+    TixiUIDEntry* entry = document->uidBuckets[iBucket];
+    while (entry) {
+      TixiUIDEntry* next = entry->next;
+      unsigned int bucket = entry->hash & (unsigned int) (newCount - 1);
+      entry->next = newBuckets[bucket];
+      newBuckets[bucket] = entry;
+      entry = next;
+    }
+  }
+
+  free(document->uidBuckets);
+  document->uidBuckets = newBuckets;
+  document->uidBucketCount = newCount;
+  return 1;
+}
+
+/* adds the uID of element to the table, the table takes the ownership of uID */
+static int addUIDEntry(TixiDocument* document, xmlNodePtr element, char* uID)
+{
+  TixiUIDEntry* entry = NULL;
+  unsigned int bucket;
+
+  if (document->uidCount >= document->uidBucketCount && !growUIDTable(document)) {
+    xmlFree(uID);
+    return 0;
+  }
+
+  entry = (TixiUIDEntry*) malloc(sizeof(TixiUIDEntry));
+  if (!entry) {
+    xmlFree(uID);
+    return 0;
+  }
+  entry->nodePtr = element;
+  entry->uIDName = uID;
+  entry->hash = hashUID(uID);
+
+  if (uID[0] == '\0') {
+    document->uidEmptyCount++;
+  }
+  else if (findUIDEntry(document, uID, entry->hash, NULL)) {
+    document->uidDuplicateCount++;
+    document->uidDuplicate = entry;
+  }
+
+  bucket = entry->hash & (unsigned int) (document->uidBucketCount - 1);
+  entry->next = document->uidBuckets[bucket];
+  document->uidBuckets[bucket] = entry;
+  document->uidCount++;
+  return 1;
+}
+
+/* builds the table, the uidMutex has to be locked */
+static int buildUIDTable(TixiDocument* tixiDocument)
 {
   xmlXPathObjectPtr xpathObj;
+  xmlNodeSetPtr nodes;
+  int i;
 
   /* Evaluate xpath expression */
-  xpathObj = xmlXPathEvalExpression((xmlChar*) CPACS_UID_XPATH, tixiDocument->xpathContext);
+  xpathObj = XPathEvaluate(XPathGetContext(tixiDocument), CPACS_UID_XPATH);
   if (xpathObj == NULL) {
     printMsg(MESSAGETYPE_ERROR,"Error: unable to evaluate xpath expression \"%s\"\n", CPACS_UID_XPATH);
     return(FAILED);
   }
 
-  /* Build List of results */
-  if (uid_buildUIDNodeList(tixiDocument, xpathObj->nodesetval) != SUCCESS) {
+  /* Build table of results */
+  nodes = xpathObj->nodesetval;
+  if (!growUIDTable(tixiDocument)) {
+    xmlXPathFreeObject(xpathObj);
     return FAILED;
   }
+  for (i = 0; nodes && i < nodes->nodeNr; ++i) {
+    xmlNodePtr element = nodes->nodeTab[i]->parent;
+    char* uID = (char*) xmlGetNoNsProp(element, (xmlChar*) CPACS_UID_ATTRIBUTE_STRING);
+
+    if (!uID || !addUIDEntry(tixiDocument, element, uID)) {
+      printMsg(MESSAGETYPE_ERROR, "Error: Memory allocation failed in uidHelper::readDocumentUIDs");
+      xmlXPathFreeObject(xpathObj);
+      uid_clearUIDTable(tixiDocument);
+      return MEMORY_ALLOCATION_FAILED;
+    }
+  }
 
   /* Cleanup */
   xmlXPathFreeObject(xpathObj);
@@ -42,131 +152,188 @@ int uid_readDocumentUIDs(TixiDocument* tixiDocument)
   return(SUCCESS);
 }
 
+int uid_readDocumentUIDs(TixiDocument* tixiDocument)
+{
+  int error = SUCCESS;
+
+  /* the uids may be in external files which were not read yet. They are included before
+     the mutex is locked, because that upgrades the lock of the document */
+  if (resolveExternalData(tixiDocument, (xmlNodePtr) tixiDocument->docPtr, 1) == FAILED) {
+    return FAILED;
+  }
+
+  /* readers share the document, the first one builds the table. It is kept up to date afterwards */
+  mutex_lock(&tixiDocument->uidMutex);
+  if (!tixiDocument->uidBuckets) {
+    error = buildUIDTable(tixiDocument);
+  }
+  mutex_unlock(&tixiDocument->uidMutex);
+
+  return error;
+}
+
+void uid_addNodeUID(TixiDocument* document, xmlNodePtr element)
+{
+  char* uID = NULL;
 
+  if (!document->uidBuckets || element->type != XML_ELEMENT_NODE) {
+    return;
+  }
 
-int uid_buildUIDNodeList(TixiDocument* tixiDocument, xmlNodeSetPtr nodes)
+  uID = (char*) xmlGetNoNsProp(element, (xmlChar*) CPACS_UID_ATTRIBUTE_STRING);
+  if (uID && !addUIDEntry(document, element, uID)) {
+    /* the table is built again on its next use */
+    uid_clearUIDTable(document);
+  }
+}
+
+void uid_removeNodeUID(TixiDocument* document, xmlNodePtr element)
 {
-  xmlNodePtr cur;
-  int size;
-  int i;
-  TixiUIDListEntry* currentEntry;
-  size = (nodes) ? nodes->nodeNr : 0;
+  TixiUIDEntry** link = NULL;
+  char* uID = NULL;
 
-  tixiDocument->uidListHead = (TixiUIDListEntry *) malloc(sizeof(TixiUIDListEntry));
-  currentEntry = tixiDocument->uidListHead;
+  if (!document->uidBuckets || element->type != XML_ELEMENT_NODE) {
+    return;
+  }
 
-  if (nodes->nodeNr == 0) {
-    free(tixiDocument->uidListHead);
-    tixiDocument->uidListHead = NULL;
-    return SUCCESS;
+  uID = (char*) xmlGetNoNsProp(element, (xmlChar*) CPACS_UID_ATTRIBUTE_STRING);
+  if (!uID) {
+    return;
   }
 
-  cur = nodes->nodeTab[0];
-  currentEntry->nodePtr = cur->parent;
-  currentEntry->uIDName = (char *) xmlGetProp(cur->parent, (xmlChar *) CPACS_UID_ATTRIBUTE_STRING);
-  currentEntry->next = NULL;
+  link = &document->uidBuckets[hashUID(uID) & (unsigned int) (document->uidBucketCount - 1)];
+  while (*link && (*link)->nodePtr != element) {
+    link = &(*link)->next;
+  }
 
-  for (i = 1; i < size; ++i) {
-    cur = nodes->nodeTab[i];
+  if (*link) {
+    TixiUIDEntry* entry = *link;
+    *link = entry->next;
 
-    // add new uid entry
-    currentEntry->next = malloc(sizeof(TixiUIDListEntry));
-    if (!currentEntry) {
-      printMsg(MESSAGETYPE_ERROR, "Error: Memory allocation failed in uidHelper::buildUIDNodeList");
-      return MEMORY_ALLOCATION_FAILED;
+    if (entry->uIDName[0] == '\0') {
+      document->uidEmptyCount--;
+    }
+    else if (findUIDEntry(document, entry->uIDName, entry->hash, NULL)) {
+      document->uidDuplicateCount--;
     }
-    currentEntry = (TixiUIDListEntry *) currentEntry->next;
-    currentEntry->nodePtr = cur->parent;
-    currentEntry->uIDName = (char *) xmlGetProp(cur->parent, (xmlChar *) CPACS_UID_ATTRIBUTE_STRING);
-    currentEntry->next = NULL;
+    if (document->uidDuplicate == entry) {
+      document->uidDuplicate = NULL;
+    }
+    document->uidCount--;
+    xmlFree(entry->uIDName);
+    free(entry);
   }
+  xmlFree(uID);
+}
 
-  return SUCCESS;
+void uid_addSubtreeUIDs(TixiDocument* document, xmlNodePtr node)
+{
+  xmlNodePtr child = NULL;
+
+  if (!document->uidBuckets || node->type != XML_ELEMENT_NODE) {
+    return;
+  }
+
+  uid_addNodeUID(document, node);
+  for (child = node->children; child; child = child->next) {
+    uid_addSubtreeUIDs(document, child);
+  }
 }
 
-int uid_checkForDuplicates(TixiDocument *document)
+void uid_removeSubtreeUIDs(TixiDocument* document, xmlNodePtr node)
 {
-  int alreadyDisplayed = -1;
-  TixiUIDListEntry* currentEntry;
-  TixiUIDListEntry* compareElement;
-
-  currentEntry = document->uidListHead;
-  while (currentEntry) {
-    if (currentEntry->next) {
-      compareElement = document->uidListHead;
-      while (compareElement) {
-        if (compareElement == currentEntry) {
-          compareElement = (TixiUIDListEntry *) compareElement->next;
-          continue;
-        }
-        if (!strcmp("", currentEntry->uIDName)) {
-          // if we found an emtpy uid, we only warn about that.
-          if (alreadyDisplayed) {
-            printMsg(MESSAGETYPE_WARNING, "Warning: Empty uID found! This might lead to unknown errors!\n");
-          }
-          alreadyDisplayed=0;
-        }
-        else if (!strcmp(compareElement->uIDName, currentEntry->uIDName)) {
-          printMsg(MESSAGETYPE_ERROR, "Error: duplicated uID '%s' found!\n", currentEntry->uIDName);
-          return FAILED;
-        }
-        compareElement = (TixiUIDListEntry *) compareElement->next;
+  xmlNodePtr child = NULL;
+
+  if (!document->uidBuckets || node->type != XML_ELEMENT_NODE) {
+    return;
+  }
+
+  uid_removeNodeUID(document, node);
+  for (child = node->children; child; child = child->next) {
+    uid_removeSubtreeUIDs(document, child);
+  }
+}
+
+/* returns an entry whose uID is used by another entry too */
+static TixiUIDEntry* findDuplicatedUID(TixiDocument* document)
+{
+  TixiUIDEntry* entry = document->uidDuplicate;
+  int iBucket;
+
+  if (entry && findUIDEntry(document, entry->uIDName, entry->hash, entry)) {
+    return entry;
+  }
+
+  for (iBucket = 0; iBucket < document->uidBucketCount; ++iBucket) {
+    for (entry = document->uidBuckets[iBucket]; entry; entry = entry->next) {
+      if (entry->uIDName[0] != '\0' && findUIDEntry(document, entry->uIDName, entry->hash, entry)) {
+        document->uidDuplicate = entry;
+        return entry;
       }
     }
-    currentEntry = (TixiUIDListEntry *) currentEntry->next;
+  }
+  return NULL;
+}
+
+int uid_checkForDuplicates(TixiDocument *document)
+{
+  if (document->uidEmptyCount > 0 && document->uidCount > 1) {
+    // if we found an emtpy uid, we only warn about that.
+    printMsg(MESSAGETYPE_WARNING, "Warning: Empty uID found! This might lead to unknown errors!\n");
+  }
+
+  if (document->uidDuplicateCount > 0) {
+    TixiUIDEntry* duplicate = NULL;
+
+    /* the duplicate found is remembered for the next check */
+    mutex_lock(&document->uidMutex);
+    duplicate = findDuplicatedUID(document);
+    mutex_unlock(&document->uidMutex);
+
+    printMsg(MESSAGETYPE_ERROR, "Error: duplicated uID '%s' found!\n", duplicate ? duplicate->uIDName : "");
+    return FAILED;
   }
   return SUCCESS;
 }
 
 
 
-int uid_checkForBrokenLinks(TixiDocument *document)
+/* calls reportLink for each link without a corresponding uid, returns the number of broken links or -1 */
+static int findBrokenLinks(TixiDocument *document,
+                           int (*reportLink)(xmlNodePtr, const char*, int, void*), void* data)
 {
-  TixiUIDListEntry* currentEntry;
   xmlXPathObjectPtr xpathObj;
   xmlNodePtr cur;
   int size;
   int i;
+  int nBroken = 0;
   char *linkName;
   xmlNodeSetPtr nodes;
-  ReturnCode foundUID = FAILED;
 
   /* Evaluate xpath expression */
-  xpathObj = xmlXPathEvalExpression((xmlChar*) CPACS_UID_LINK_XPATH, document->xpathContext);
+  xpathObj = XPathEvaluate(XPathGetContext(document), CPACS_UID_LINK_XPATH);
   if (xpathObj == NULL) {
     printMsg(MESSAGETYPE_ERROR,"Error: unable to evaluate xpath expression \"%s\"\n", CPACS_UID_LINK_XPATH);
-    return(FAILED);
+    return -1;
   }
 
   /* Build List of results */
   nodes = xpathObj->nodesetval;
   size = (nodes) ? nodes->nodeNr : 0;
 
-  if (size == 0) {
-    xmlXPathFreeObject(xpathObj);
-    return SUCCESS;
-  }
-
   // iterate through all links
   for (i = 0; i < size; ++i) {
     cur = nodes->nodeTab[i];
     linkName = (char*) xmlGetProp(cur->parent, (xmlChar*) CPACS_UID_LINK_ATTRIBUTE_STRING);
 
     // now check if a corresponding uid exists
-    currentEntry = document->uidListHead;
-    foundUID = FAILED;
-    while (currentEntry) {
-      if (!strcmp(linkName, currentEntry->uIDName)) {
-        foundUID = SUCCESS;
-        break;
+    if (!findUIDEntry(document, linkName, hashUID(linkName), NULL)) {
+      if (reportLink && !reportLink(cur->parent, linkName, nBroken, data)) {
+        xmlFree(linkName);
+        xmlXPathFreeObject(xpathObj);
+        return -1;
       }
-      currentEntry = (TixiUIDListEntry *) currentEntry->next;
-    }
-    if (foundUID == FAILED) {
-      printMsg(MESSAGETYPE_ERROR, "Error: Broken link, UID '%s' not found!", linkName);
-      xmlXPathFreeObject(xpathObj);
-      xmlFree(linkName);
-      return UID_LINK_BROKEN;
+      nBroken++;
     }
     xmlFree(linkName);
   }
@@ -174,52 +341,723 @@ int uid_checkForBrokenLinks(TixiDocument *document)
   /* Cleanup */
   xmlXPathFreeObject(xpathObj);
 
+  return nBroken;
+}
+
+static int printBrokenLink(xmlNodePtr element, const char *linkName, int index, void *data)
+{
+  (void) element;
+  (void) index;
+  (void) data;
+  printMsg(MESSAGETYPE_ERROR, "Error: Broken link, UID '%s' not found!\n", linkName);
+  return 1;
+}
+
+int uid_checkForBrokenLinks(TixiDocument *document)
+{
+  int nBroken = findBrokenLinks(document, printBrokenLink, NULL);
+
+  if (nBroken < 0) {
+    return FAILED;
+  }
+  return nBroken == 0 ? SUCCESS : UID_LINK_BROKEN;
+}
+
+typedef struct
+{
+  xmlNodePtr *elements;
+  int capacity;
+} BrokenLinkList;
+
+static int addBrokenLink(xmlNodePtr element, const char *linkName, int index, void *data)
+{
+  BrokenLinkList *list = (BrokenLinkList*) data;
+  (void) linkName;
+
+  if (index == list->capacity) {
+    int capacity = list->capacity > 0 ? 2 * list->capacity : 64;
+    xmlNodePtr *elements = (xmlNodePtr*) realloc(list->elements, capacity * sizeof(xmlNodePtr));
+    if (!elements) {
+      return 0;
+    }
+    list->elements = elements;
+    list->capacity = capacity;
+  }
+  list->elements[index] = element;
+  return 1;
+}
+
+ReturnCode uid_getBrokenLinks(TixiDocument *document, char ***links, char ***xPaths, int *number)
+{
+  BrokenLinkList list;
+  XPathNodePathBuilder pathBuilder;
+  ReturnCode error = SUCCESS;
+  int nBroken;
+  int i;
+
+  *links = NULL;
+  *xPaths = NULL;
+  *number = 0;
+
+  list.elements = NULL;
+  list.capacity = 0;
+  nBroken = findBrokenLinks(document, addBrokenLink, &list);
+  if (nBroken <= 0) {
+    free(list.elements);
+    return nBroken == 0 ? SUCCESS : FAILED;
+  }
+
+  *links = (char**) allocateDocumentMemory(document, nBroken * sizeof(char*));
+  *xPaths = (char**) allocateDocumentMemory(document, nBroken * sizeof(char*));
+  if (!*links || !*xPaths) {
+    error = FAILED;
+  }
+
+  /* the links are found in document order, so the paths share the work for common ancestors */
+  XPathInitNodePathBuilder(&pathBuilder);
+  for (i = 0; i < nBroken && !error; ++i) {
+    xmlChar *linkName = xmlGetProp(list.elements[i], (xmlChar*) CPACS_UID_LINK_ATTRIBUTE_STRING);
+    xmlChar *path = XPathBuildNodePath(&pathBuilder, list.elements[i]);
+    (*links)[i] = linkName ? copyStringToDocument(document, (char*) linkName) : NULL;
+    (*xPaths)[i] = path ? copyStringToDocument(document, (char*) path) : NULL;
+    xmlFree(linkName);
+    xmlFree(path);
+    if (!(*links)[i] || !(*xPaths)[i]) {
+      error = FAILED;
+    }
+  }
+  XPathFreeNodePathBuilder(&pathBuilder);
+  free(list.elements);
+
+  if (error) {
+    *links = NULL;
+    *xPaths = NULL;
+    return error;
+  }
+  *number = nBroken;
   return SUCCESS;
 }
 
+/* returns the table entry of element or NULL */
+static TixiUIDEntry* findNodeUIDEntry(TixiDocument *document, xmlNodePtr element, const char *uID)
+{
+  TixiUIDEntry *entry = document->uidBuckets[hashUID(uID) & (unsigned int) (document->uidBucketCount - 1)];
 
+  while (entry && entry->nodePtr != element) {
+    entry = entry->next;
+  }
+  return entry;
+}
 
-int uid_clearUIDList(TixiDocument *document)
+typedef struct
 {
-  TixiUIDListEntry *current = document->uidListHead;
-  while (current) {
-    TixiUIDListEntry *next = (TixiUIDListEntry *) current->next;
-    if (current->uIDName) {
-      xmlFree(current->uIDName);
-      current->uIDName = NULL;
+  const char *uID;
+  int position;               /* position in document order */
+} DuplicateUID;
+
+/* orders duplicates by their uID, duplicates with the same uID in document order */
+static int compareDuplicateUIDs(const void *a, const void *b)
+{
+  const DuplicateUID *duplicateA = (const DuplicateUID*) a;
+  const DuplicateUID *duplicateB = (const DuplicateUID*) b;
+  int result = strcmp(duplicateA->uID, duplicateB->uID);
+
+  if (result == 0) {
+    result = duplicateA->position - duplicateB->position;
+  }
+  return result;
+}
+
+ReturnCode uid_getDuplicates(TixiDocument *document, char ***uIDs, char ***xPaths, int *number)
+{
+  xmlXPathObjectPtr xpathObj;
+  xmlNodeSetPtr nodes;
+  XPathNodePathBuilder pathBuilder;
+  DuplicateUID *duplicates = NULL;
+  char **paths = NULL;
+  ReturnCode error = SUCCESS;
+  int nDuplicates = 0;
+  int i;
+
+  *uIDs = NULL;
+  *xPaths = NULL;
+  *number = 0;
+  if (document->uidDuplicateCount == 0) {
+    return SUCCESS;
+  }
+
+  xpathObj = XPathEvaluate(XPathGetContext(document), CPACS_UID_XPATH);
+  if (xpathObj == NULL) {
+    printMsg(MESSAGETYPE_ERROR,"Error: unable to evaluate xpath expression \"%s\"\n", CPACS_UID_XPATH);
+    return FAILED;
+  }
+  nodes = xpathObj->nodesetval;
+
+  /* every duplicated uID is used by at least two elements */
+  duplicates = (DuplicateUID*) malloc(2 * document->uidDuplicateCount * sizeof(DuplicateUID));
+  paths = (char**) malloc(2 * document->uidDuplicateCount * sizeof(char*));
+  if (!duplicates || !paths) {
+    free(duplicates);
+    free(paths);
+    xmlXPathFreeObject(xpathObj);
+    return FAILED;
+  }
+
+  /* the uIDs are found in document order, so the paths share the work for common ancestors */
+  XPathInitNodePathBuilder(&pathBuilder);
+  for (i = 0; nodes && i < nodes->nodeNr && !error; ++i) {
+    xmlNodePtr element = nodes->nodeTab[i]->parent;
+    char *uID = (char*) xmlGetNoNsProp(element, (xmlChar*) CPACS_UID_ATTRIBUTE_STRING);
+    TixiUIDEntry *entry = uID ? findNodeUIDEntry(document, element, uID) : NULL;
+
+    if (entry && entry->uIDName[0] != '\0' && findUIDEntry(document, entry->uIDName, entry->hash, entry)
+        && nDuplicates < 2 * document->uidDuplicateCount) {
+      xmlChar *path = XPathBuildNodePath(&pathBuilder, element);
+      paths[nDuplicates] = path ? copyStringToDocument(document, (char*) path) : NULL;
+      duplicates[nDuplicates].uID = entry->uIDName;
+      duplicates[nDuplicates].position = nDuplicates;
+      xmlFree(path);
+      if (!paths[nDuplicates]) {
+        error = FAILED;
+      }
+      nDuplicates++;
     }
-    free(current);
-    current = next;
+    xmlFree(uID);
   }
-  document->uidListHead = NULL;
+  XPathFreeNodePathBuilder(&pathBuilder);
+  xmlXPathFreeObject(xpathObj);
+
+  if (!error && nDuplicates > 0) {
+    qsort(duplicates, (size_t) nDuplicates, sizeof(DuplicateUID), compareDuplicateUIDs);
+    *uIDs = (char**) allocateDocumentMemory(document, nDuplicates * sizeof(char*));
+    *xPaths = (char**) allocateDocumentMemory(document, nDuplicates * sizeof(char*));
+    if (!*uIDs || !*xPaths) {
+      error = FAILED;
+    }
+    for (i = 0; i < nDuplicates && !error; ++i) {
+      (*uIDs)[i] = copyStringToDocument(document, duplicates[i].uID);
+      (*xPaths)[i] = paths[duplicates[i].position];
+      if (!(*uIDs)[i]) {
+        error = FAILED;
+      }
+    }
+  }
+  free(duplicates);
+  free(paths);
+
+  if (error) {
+    *uIDs = NULL;
+    *xPaths = NULL;
+    return error;
+  }
+  *number = nDuplicates;
   return SUCCESS;
 }
 
 
-char* uid_getXpath(TixiDocument *document, const char *uID)
+
+typedef struct
+{
+  TixiReferenceGraph *graph;
+  int verticesCapacity;
+  int referencesCapacity;
+} ReferenceGraphBuilder;
+
+/* returns 1 for elements named ...UID holding a uID as text */
+static int isReferenceElement(xmlNodePtr element)
 {
-  TixiUIDListEntry *current = document->uidListHead;
+  size_t length = strlen((const char*) element->name);
+  xmlNodePtr child = NULL;
 
-  while (current) {
-    if (!strcmp(current->uIDName, uID)) {
-      return (char*) xmlGetNodePath(current->nodePtr);
+  if (length < strlen(CPACS_UID_REFERENCE_SUFFIX)
+      || strcmp((const char*) element->name + length - strlen(CPACS_UID_REFERENCE_SUFFIX), CPACS_UID_REFERENCE_SUFFIX)) {
+    return 0;
+  }
+  for (child = element->children; child; child = child->next) {
+    if (child->type == XML_ELEMENT_NODE) {
+      return 0;
     }
-    current = (TixiUIDListEntry *) current->next;
   }
-  return NULL;
+  return 1;
 }
 
+/* removes leading and trailing whitespace in place */
+static void trimReference(char *text)
+{
+  size_t begin = 0;
+  size_t end = strlen(text);
 
-int uid_checkExists(TixiDocument *document, const char *uID)
+  while (begin < end && isspace((unsigned char) text[begin])) {
+    begin++;
+  }
+  while (end > begin && isspace((unsigned char) text[end - 1])) {
+    end--;
+  }
+  memmove(text, text + begin, end - begin);
+  text[end - begin] = '\0';
+}
+
+/* adds a vertex taking the ownership of uID, returns its index or -1 */
+static int addReferenceVertex(ReferenceGraphBuilder *builder, xmlNodePtr element, char *uID)
+{
+  TixiReferenceGraph *graph = builder->graph;
+  TixiReferenceVertex *vertex = NULL;
+
+  if (graph->nVertices == builder->verticesCapacity) {
+    int capacity = builder->verticesCapacity > 0 ? 2 * builder->verticesCapacity : 64;
+    TixiReferenceVertex *vertices = (TixiReferenceVertex*) realloc(graph->vertices, capacity * sizeof(TixiReferenceVertex));
+    if (!vertices) {
+      xmlFree(uID);
+      return -1;
+    }
+    graph->vertices = vertices;
+    builder->verticesCapacity = capacity;
+  }
+
+  vertex = &graph->vertices[graph->nVertices];
+  vertex->node = element;
+  vertex->uID = uID;
+  vertex->hash = hashUID(uID);
+  vertex->nextInBucket = -1;
+  vertex->firstOutgoing = -1;
+  return graph->nVertices++;
+}
+
+/* adds a reference taking the ownership of target */
+static int addReference(ReferenceGraphBuilder *builder, xmlNodePtr element, char *target, int owner)
+{
+  TixiReferenceGraph *graph = builder->graph;
+  TixiReference *reference = NULL;
+
+  if (graph->nReferences == builder->referencesCapacity) {
+    int capacity = builder->referencesCapacity > 0 ? 2 * builder->referencesCapacity : 64;
+    TixiReference *references = (TixiReference*) realloc(graph->references, capacity * sizeof(TixiReference));
+    if (!references) {
+      xmlFree(target);
+      return 0;
+    }
+    graph->references = references;
+    builder->referencesCapacity = capacity;
+  }
+
+  reference = &graph->references[graph->nReferences++];
+  reference->node = element;
+  reference->target = target;
+  reference->hash = hashUID(target);
+  reference->owner = owner;
+  reference->targetVertex = -1;
+  reference->nextInBucket = -1;
+  reference->nextOutgoing = -1;
+  return 1;
+}
+
+/* collects the vertices and references of node, its siblings and their descendants in document order */
+static int collectReferences(ReferenceGraphBuilder *builder, xmlNodePtr node, int owner)
 {
-  TixiUIDListEntry *current = document->uidListHead;
+  for (; node; node = node->next) {
+    int elementOwner = owner;
+    char *value = NULL;
+
+    if (node->type != XML_ELEMENT_NODE) {
+      continue;
+    }
 
-  while (current) {
-    if (!strcmp(current->uIDName, uID)) {
+    value = (char*) xmlGetNoNsProp(node, (xmlChar*) CPACS_UID_ATTRIBUTE_STRING);
+    if (value && value[0] == '\0') {
+      xmlFree(value);
+    }
+    else if (value) {
+      elementOwner = addReferenceVertex(builder, node, value);
+      if (elementOwner < 0) {
+        return 0;
+      }
+    }
+
+    value = (char*) xmlGetNoNsProp(node, (xmlChar*) CPACS_UID_LINK_ATTRIBUTE_STRING);
+    if (value && !addReference(builder, node, value, elementOwner)) {
       return 0;
     }
-    current = (TixiUIDListEntry *) current->next;
+
+    if (isReferenceElement(node)) {
+      value = (char*) xmlNodeGetContent(node);
+      if (value) {
+        trimReference(value);
+        if (value[0] == '\0') {
+          xmlFree(value);
+        }
+        else if (!addReference(builder, node, value, elementOwner)) {
+          return 0;
+        }
+      }
+    }
+
+    if (!collectReferences(builder, node->children, elementOwner)) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/* returns the first vertex with the uID in document order or -1 */
+static int findReferenceVertex(const TixiReferenceGraph *graph, const char *uID, unsigned int hash)
+{
+  int iVertex = graph->vertexBuckets[hash & (unsigned int) (graph->bucketCount - 1)];
+
+  while (iVertex >= 0) {
+    const TixiReferenceVertex *vertex = &graph->vertices[iVertex];
+    if (vertex->hash == hash && !strcmp(vertex->uID, uID)) {
+      return iVertex;
+    }
+    iVertex = vertex->nextInBucket;
   }
   return -1;
 }
 
+/* links the vertices and references, the chains are built backwards to keep the document order */
+static int linkReferenceGraph(TixiReferenceGraph *graph)
+{
+  int size = graph->nVertices > graph->nReferences ? graph->nVertices : graph->nReferences;
+  int i;
+
+  graph->bucketCount = 16;
+  while (graph->bucketCount < size) {
+    graph->bucketCount *= 2;
+  }
+  graph->vertexBuckets = (int*) malloc(graph->bucketCount * sizeof(int));
+  graph->referenceBuckets = (int*) malloc(graph->bucketCount * sizeof(int));
+  if (!graph->vertexBuckets || !graph->referenceBuckets) {
+    return 0;
+  }
+  for (i = 0; i < graph->bucketCount; ++i) {
+    graph->vertexBuckets[i] = -1;
+    graph->referenceBuckets[i] = -1;
+  }
+
+  for (i = graph->nVertices - 1; i >= 0; --i) {
+    int *bucket = &graph->vertexBuckets[graph->vertices[i].hash & (unsigned int) (graph->bucketCount - 1)];
+    graph->vertices[i].nextInBucket = *bucket;
+    *bucket = i;
+  }
+
+  for (i = graph->nReferences - 1; i >= 0; --i) {
+    TixiReference *reference = &graph->references[i];
+    int *bucket = &graph->referenceBuckets[reference->hash & (unsigned int) (graph->bucketCount - 1)];
+    reference->nextInBucket = *bucket;
+    *bucket = i;
+    if (reference->owner >= 0) {
+      reference->nextOutgoing = graph->vertices[reference->owner].firstOutgoing;
+      graph->vertices[reference->owner].firstOutgoing = i;
+    }
+    reference->targetVertex = findReferenceVertex(graph, reference->target, reference->hash);
+  }
+  return 1;
+}
+
+static void freeReferenceGraph(TixiReferenceGraph *graph)
+{
+  int i;
+
+  for (i = 0; i < graph->nVertices; ++i) {
+    xmlFree(graph->vertices[i].uID);
+  }
+  for (i = 0; i < graph->nReferences; ++i) {
+    xmlFree(graph->references[i].target);
+  }
+  free(graph->vertices);
+  free(graph->references);
+  free(graph->vertexBuckets);
+  free(graph->referenceBuckets);
+  free(graph);
+}
+
+/* builds the graph, the referenceGraphMutex has to be locked */
+static int buildReferenceGraph(TixiDocument *document)
+{
+  ReferenceGraphBuilder builder;
+  TixiReferenceGraph *graph = NULL;
+
+  graph = (TixiReferenceGraph*) calloc(1, sizeof(TixiReferenceGraph));
+  if (!graph) {
+    return MEMORY_ALLOCATION_FAILED;
+  }
+  builder.graph = graph;
+  builder.verticesCapacity = 0;
+  builder.referencesCapacity = 0;
+
+  if (!collectReferences(&builder, xmlDocGetRootElement(document->docPtr), -1) || !linkReferenceGraph(graph)) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Memory allocation failed in uidHelper::readReferenceGraph.\n");
+    freeReferenceGraph(graph);
+    return MEMORY_ALLOCATION_FAILED;
+  }
+
+  document->referenceGraph = graph;
+  return SUCCESS;
+}
+
+int uid_readReferenceGraph(TixiDocument *document)
+{
+  int error = SUCCESS;
+
+  /* references may point into external files which were not read yet */
+  resolveExternalData(document, (xmlNodePtr) document->docPtr, 1);
+
+  /* readers share the document, the first one builds the graph */
+  mutex_lock(&document->referenceGraphMutex);
+  if (!document->referenceGraph) {
+    error = buildReferenceGraph(document);
+  }
+  mutex_unlock(&document->referenceGraphMutex);
+
+  return error;
+}
+
+void uid_clearReferenceGraph(TixiDocument *document)
+{
+  if (document && document->referenceGraph) {
+    freeReferenceGraph(document->referenceGraph);
+    document->referenceGraph = NULL;
+  }
+}
+
+ReturnCode uid_getIncomingReferences(TixiDocument *document, const char *uID, char ***xPaths, int *number)
+{
+  const TixiReferenceGraph *graph = document->referenceGraph;
+  unsigned int hash = hashUID(uID);
+  XPathNodePathBuilder pathBuilder;
+  ReturnCode error = SUCCESS;
+  int first = graph->referenceBuckets[hash & (unsigned int) (graph->bucketCount - 1)];
+  int nReferences = 0;
+  int iReference;
+
+  *xPaths = NULL;
+  *number = 0;
+
+  for (iReference = first; iReference >= 0; iReference = graph->references[iReference].nextInBucket) {
+    const TixiReference *reference = &graph->references[iReference];
+    if (reference->hash == hash && !strcmp(reference->target, uID)) {
+      nReferences++;
+    }
+  }
+  if (nReferences == 0) {
+    return SUCCESS;
+  }
+
+  *xPaths = (char**) allocateDocumentMemory(document, nReferences * sizeof(char*));
+  if (!*xPaths) {
+    return FAILED;
+  }
+
+  /* the chain is in document order, so the paths share the work for common ancestors */
+  XPathInitNodePathBuilder(&pathBuilder);
+  nReferences = 0;
+  for (iReference = first; iReference >= 0 && !error; iReference = graph->references[iReference].nextInBucket) {
+    const TixiReference *reference = &graph->references[iReference];
+    if (reference->hash == hash && !strcmp(reference->target, uID)) {
+      xmlChar *path = XPathBuildNodePath(&pathBuilder, reference->node);
+      (*xPaths)[nReferences] = path ? copyStringToDocument(document, (char*) path) : NULL;
+      xmlFree(path);
+      if (!(*xPaths)[nReferences++]) {
+        error = FAILED;
+      }
+    }
+  }
+  XPathFreeNodePathBuilder(&pathBuilder);
+
+  if (error) {
+    *xPaths = NULL;
+    return error;
+  }
+  *number = nReferences;
+  return SUCCESS;
+}
+
+/* returns 1, if the reference belongs to element */
+static int isOutgoingReference(const TixiReferenceGraph *graph, const TixiReference *reference, xmlNodePtr element)
+{
+  return reference->node == element || (reference->owner >= 0 && graph->vertices[reference->owner].node == element);
+}
+
+ReturnCode uid_getOutgoingReferences(TixiDocument *document, xmlNodePtr element, char ***uIDs, int *number)
+{
+  const TixiReferenceGraph *graph = document->referenceGraph;
+  xmlNodePtr ancestor = NULL;
+  int owner = -1;
+  int nReferences = 0;
+  int pass;
+
+  *uIDs = NULL;
+  *number = 0;
+
+  /* the references of element are owned by its nearest ancestor-or-self with a uID */
+  for (ancestor = element; ancestor && ancestor->type == XML_ELEMENT_NODE && owner < 0; ancestor = ancestor->parent) {
+    char *uID = (char*) xmlGetNoNsProp(ancestor, (xmlChar*) CPACS_UID_ATTRIBUTE_STRING);
+    if (uID && uID[0] != '\0') {
+      int iVertex = graph->vertexBuckets[hashUID(uID) & (unsigned int) (graph->bucketCount - 1)];
+      while (iVertex >= 0 && graph->vertices[iVertex].node != ancestor) {
+        iVertex = graph->vertices[iVertex].nextInBucket;
+      }
+      owner = iVertex;
+    }
+    xmlFree(uID);
+  }
+
+  /* the first pass counts the references, the second one copies their targets */
+  for (pass = 0; pass < 2; ++pass) {
+    int iReference = owner >= 0 ? graph->vertices[owner].firstOutgoing : 0;
+    int nCopied = 0;
+
+    while (iReference >= 0 && iReference < graph->nReferences) {
+      const TixiReference *reference = &graph->references[iReference];
+
+      if (isOutgoingReference(graph, reference, element) && (owner >= 0 || reference->owner < 0)) {
+        if (pass == 1) {
+          (*uIDs)[nCopied] = copyStringToDocument(document, reference->target);
+          if (!(*uIDs)[nCopied]) {
+            *uIDs = NULL;
+            return FAILED;
+          }
+        }
+        nCopied++;
+      }
+      /* references without owner are only found by a scan of all references */
+      iReference = owner >= 0 ? reference->nextOutgoing : iReference + 1;
+    }
+
+    nReferences = nCopied;
+    if (nReferences == 0) {
+      return SUCCESS;
+    }
+    if (pass == 0) {
+      *uIDs = (char**) allocateDocumentMemory(document, nReferences * sizeof(char*));
+      if (!*uIDs) {
+        return FAILED;
+      }
+    }
+  }
+
+  *number = nReferences;
+  return SUCCESS;
+}
+
+ReturnCode uid_getTopologicalOrder(TixiDocument *document, char ***uIDs, int *number)
+{
+  const TixiReferenceGraph *graph = document->referenceGraph;
+  int *remaining = NULL;
+  int *order = NULL;
+  int nOrdered = 0;
+  int nQueued = 0;
+  int iVertex;
+  int i;
+
+  *uIDs = NULL;
+  *number = 0;
+  if (graph->nVertices == 0) {
+    return SUCCESS;
+  }
+
+  remaining = (int*) calloc((size_t) graph->nVertices, sizeof(int));
+  order = (int*) malloc(graph->nVertices * sizeof(int));
+  if (!remaining || !order) {
+    free(remaining);
+    free(order);
+    return FAILED;
+  }
+
+  /* a vertex is ready, when all uIDs referenced by it are ordered. Broken links are ignored */
+  for (i = 0; i < graph->nReferences; ++i) {
+    if (graph->references[i].owner >= 0 && graph->references[i].targetVertex >= 0) {
+      remaining[graph->references[i].owner]++;
+    }
+  }
+  for (iVertex = 0; iVertex < graph->nVertices; ++iVertex) {
+    if (remaining[iVertex] == 0) {
+      order[nQueued++] = iVertex;
+    }
+  }
+
+  for (nOrdered = 0; nOrdered < nQueued; ++nOrdered) {
+    const TixiReferenceVertex *vertex = &graph->vertices[order[nOrdered]];
+    int iReference = graph->referenceBuckets[vertex->hash & (unsigned int) (graph->bucketCount - 1)];
+
+    for (; iReference >= 0; iReference = graph->references[iReference].nextInBucket) {
+      const TixiReference *reference = &graph->references[iReference];
+      if (reference->targetVertex == order[nOrdered] && reference->owner >= 0
+          && --remaining[reference->owner] == 0) {
+        order[nQueued++] = reference->owner;
+      }
+    }
+  }
+
+  if (nOrdered < graph->nVertices) {
+    for (iVertex = 0; remaining[iVertex] == 0; ++iVertex) {
+    }
+    printMsg(MESSAGETYPE_ERROR, "Error: cyclic references of uID '%s' found!\n", graph->vertices[iVertex].uID);
+    free(remaining);
+    free(order);
+    return UID_REFERENCE_CYCLE;
+  }
+
+  *uIDs = (char**) allocateDocumentMemory(document, nOrdered * sizeof(char*));
+  for (i = 0; *uIDs && i < nOrdered; ++i) {
+    (*uIDs)[i] = copyStringToDocument(document, graph->vertices[order[i]].uID);
+    if (!(*uIDs)[i]) {
+      *uIDs = NULL;
+    }
+  }
+  free(remaining);
+  free(order);
+
+  if (!*uIDs) {
+    return FAILED;
+  }
+  *number = nOrdered;
+  return SUCCESS;
+}
+
+
+
+int uid_clearUIDTable(TixiDocument *document)
+{
+  int iBucket;
+
+  for (iBucket = 0; iBucket < document->uidBucketCount; ++iBucket) {
+    TixiUIDEntry *current = document->uidBuckets[iBucket];
+    while (current) {
+      TixiUIDEntry *next = current->next;
+      xmlFree(current->uIDName);
+      free(current);
+      current = next;
+    }
+  }
+  free(document->uidBuckets);
+  document->uidBuckets = NULL;
+  document->uidBucketCount = 0;
+  document->uidCount = 0;
+  document->uidDuplicateCount = 0;
+  document->uidEmptyCount = 0;
+  document->uidDuplicate = NULL;
+  return SUCCESS;
+}
+
+
+char* uid_getXpath(TixiDocument *document, const char *uID)
+{
+  unsigned int hash = hashUID(uID);
+  TixiUIDEntry *current = document->uidBuckets[hash & (unsigned int) (document->uidBucketCount - 1)];
+  TixiUIDEntry *first = NULL;
+
+  /* duplicated uIDs resolve to the first element in document order */
+  for (; current; current = current->next) {
+    if (current->hash == hash && !strcmp(current->uIDName, uID)
+        && (!first || xmlXPathCmpNodes(current->nodePtr, first->nodePtr) == 1)) {
+      first = current;
+    }
+  }
+  return first ? (char*) xmlGetNodePath(first->nodePtr) : NULL;
+}
+
+
+int uid_checkExists(TixiDocument *document, const char *uID)
+{
+  return findUIDEntry(document, uID, hashUID(uID), NULL) ? 0 : -1;
+}
@@ -30,14 +30,32 @@
 #include "tixiData.h"
 
 /**
- * Builds an internal structure of all uids.
+ * Builds the hash table of all uids, if it does not exist yet. The table can
+ * be built by several readers of the document at the same time, the first one
+ * builds it. Once built, the table is kept up to date by the functions below,
+ * which are called by writers only.
  */
 int uid_readDocumentUIDs(TixiDocument* tixiDocument);
 
 /**
- * Builds an internal structure of all uids. Memory allocation etc.
+ * Adds the uid of element to the table, after the attribute has been set.
  */
-int uid_buildUIDNodeList(TixiDocument* tixiDocument, xmlNodeSetPtr nodes);
+void uid_addNodeUID(TixiDocument* document, xmlNodePtr element);
+
+/**
+ * Removes the uid of element from the table, before the attribute is changed or removed.
+ */
+void uid_removeNodeUID(TixiDocument* document, xmlNodePtr element);
+
+/**
+ * Adds the uids of all elements of a subtree inserted into the document.
+ */
+void uid_addSubtreeUIDs(TixiDocument* document, xmlNodePtr node);
+
+/**
+ * Removes the uids of all elements of a subtree, before it is removed from the document.
+ */
+void uid_removeSubtreeUIDs(TixiDocument* document, xmlNodePtr node);
 
 /**
  * Checks for not-unique uIDs.
@@ -45,14 +63,58 @@ int uid_buildUIDNodeList(TixiDocument* tixiDocument, xmlNodeSetPtr nodes);
 int uid_checkForDuplicates(TixiDocument *document);
 
 /**
- * Checks for broken links (all links without a corrsponding UID).
+ * Checks for broken links (all links without a corrsponding UID), prints an error for each.
  */
 int uid_checkForBrokenLinks(TixiDocument *document);
 
 /**
- * Cleans up memory and removed the uid-list from the document.
+ * Returns the elements sharing their uid with another element, sorted by uid
+ * and in document order. The arrays are allocated from the arena of the document.
+ */
+ReturnCode uid_getDuplicates(TixiDocument *document, char ***uIDs, char ***xPaths, int *number);
+
+/**
+ * Returns all links without a corresponding uid and the paths of their elements
+ * in document order. The arrays are allocated from the arena of the document.
+ */
+ReturnCode uid_getBrokenLinks(TixiDocument *document, char ***links, char ***xPaths, int *number);
+
+/**
+ * Builds the graph of the references between the uids, if it does not exist yet.
+ * The graph can be built by several readers of the document at the same time, the
+ * first one builds it. It has to be dropped with uid_clearReferenceGraph by every
+ * modification.
+ */
+int uid_readReferenceGraph(TixiDocument *document);
+
+/**
+ * Removes the reference graph from the document.
+ */
+void uid_clearReferenceGraph(TixiDocument *document);
+
+/**
+ * Returns the paths of the elements referring to uID in document order.
+ * The reference graph has to be read before.
+ */
+ReturnCode uid_getIncomingReferences(TixiDocument *document, const char *uID, char ***xPaths, int *number);
+
+/**
+ * Returns the uids referred to by element itself or, if element has a uid, by
+ * its descendants up to the next element with a uid.
+ * The reference graph has to be read before.
+ */
+ReturnCode uid_getOutgoingReferences(TixiDocument *document, xmlNodePtr element, char ***uIDs, int *number);
+
+/**
+ * Returns all uids ordered such that each uid follows the uids it refers to.
+ * The reference graph has to be read before.
+ */
+ReturnCode uid_getTopologicalOrder(TixiDocument *document, char ***uIDs, int *number);
+
+/**
+ * Cleans up memory and removes the uid table from the document.
  */
-int uid_clearUIDList(TixiDocument *document);
+int uid_clearUIDTable(TixiDocument *document);
 
 /**
  * Returns a XPath to a given uID.
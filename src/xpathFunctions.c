@@ -21,9 +21,657 @@
 #include "libxml/xpathInternals.h"
 
 #include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 extern void printMsg(MessageType type, const char* message, ...);
 
+/**
+   XPath contexts of the calling thread, which were used recently. Avoids
+   locking the list of contexts of the document for each evaluation.
+ */
+#define CACHED_XPATH_CONTEXTS 8
+
+typedef struct
+{
+  const TixiDocument* document;
+  unsigned int documentId;
+  xmlXPathContextPtr context;
+} CachedXPathContext;
+
+static TIXI_THREAD_LOCAL CachedXPathContext cachedXPathContexts[CACHED_XPATH_CONTEXTS];
+static TIXI_THREAD_LOCAL int nextCachedXPathContext = 0;
+
+/* the address of this variable identifies the calling thread */
+static TIXI_THREAD_LOCAL char threadIdentity;
+
+static void copyNamespace(void* namespaceURI, void* context, const xmlChar* prefix)
+{
+  xmlXPathRegisterNs((xmlXPathContextPtr) context, prefix, (const xmlChar*) namespaceURI);
+}
+
+/* registers the namespaces of the document's context in the thread context */
+static void copyRegisteredNamespaces(const TixiDocument* document, xmlXPathContextPtr context)
+{
+  if (document->xpathContext && document->xpathContext->nsHash) {
+    xmlHashScan(document->xpathContext->nsHash, copyNamespace, context);
+  }
+}
+
+xmlXPathContextPtr XPathGetContext(TixiDocument* document)
+{
+  TixiXPathContextEntry* entry = NULL;
+  CachedXPathContext* cached = NULL;
+  int i;
+
+  for (i = 0; i < CACHED_XPATH_CONTEXTS; ++i) {
+    cached = &cachedXPathContexts[i];
+    if (cached->document == document && cached->documentId == document->id) {
+      return cached->context;
+    }
+  }
+
+  mutex_lock(&document->threadContextsMutex);
+  for (entry = document->threadContexts; entry; entry = entry->next) {
+    if (entry->thread == &threadIdentity) {
+      break;
+    }
+  }
+
+  if (!entry) {
+    entry = (TixiXPathContextEntry*) malloc(sizeof(TixiXPathContextEntry));
+    if (!entry) {
+      mutex_unlock(&document->threadContextsMutex);
+      return NULL;
+    }
+    entry->thread = &threadIdentity;
+    entry->context = xmlXPathNewContext(document->docPtr);
+    if (entry->context) {
+      /* gives the tree walker access to the child indexes of the document */
+      entry->context->userData = document;
+    }
+    copyRegisteredNamespaces(document, entry->context);
+    entry->next = document->threadContexts;
+    document->threadContexts = entry;
+  }
+  mutex_unlock(&document->threadContextsMutex);
+
+  cached = &cachedXPathContexts[nextCachedXPathContext];
+  nextCachedXPathContext = (nextCachedXPathContext + 1) % CACHED_XPATH_CONTEXTS;
+  cached->document = document;
+  cached->documentId = document->id;
+  cached->context = entry->context;
+
+  return entry->context;
+}
+
+void XPathUpdateThreadContexts(TixiDocument* document)
+{
+  TixiXPathContextEntry* entry = NULL;
+
+  mutex_lock(&document->threadContextsMutex);
+  for (entry = document->threadContexts; entry; entry = entry->next) {
+    xmlXPathRegisteredNsCleanup(entry->context);
+    copyRegisteredNamespaces(document, entry->context);
+  }
+  mutex_unlock(&document->threadContextsMutex);
+}
+
+void XPathFreeThreadContexts(TixiDocument* document)
+{
+  TixiXPathContextEntry* entry = document->threadContexts;
+
+  while (entry) {
+    TixiXPathContextEntry* next = entry->next;
+    xmlXPathFreeContext(entry->context);
+    free(entry);
+    entry = next;
+  }
+  document->threadContexts = NULL;
+}
+
+/**
+   Cache of compiled XPath expressions, shared by all documents and threads.
+
+   The entries are kept in a hash table and in a list ordered by their last
+   use. An entry is referenced by the cache and by each evaluation using it,
+   so an entry evicted during an evaluation is freed when the evaluation is done.
+ */
+#define DEFAULT_XPATH_CACHE_SIZE 1024
+
+typedef struct XPathCacheEntry XPathCacheEntry;
+struct XPathCacheEntry
+{
+  char* expression;
+  unsigned int hash;
+  xmlXPathCompExprPtr compiled;
+  int refCount;
+  XPathCacheEntry* nextInBucket;
+  XPathCacheEntry* newer;
+  XPathCacheEntry* older;
+};
+
+static TixiMutex xpathCacheMutex = TIXI_MUTEX_INITIALIZER;
+static XPathCacheEntry** xpathCacheBuckets = NULL;
+static unsigned int xpathCacheBucketCount = 0;
+static XPathCacheEntry* xpathCacheNewest = NULL;
+static XPathCacheEntry* xpathCacheOldest = NULL;
+static int xpathCacheCount = 0;
+static int xpathCacheSize = DEFAULT_XPATH_CACHE_SIZE;
+static size_t xpathCacheHits = 0;
+static size_t xpathCacheMisses = 0;
+
+/* FNV-1a */
+static unsigned int hashExpression(const char* expression)
+{
+  unsigned int hash = 2166136261u;
+  for (; *expression; ++expression) {
+    hash = (hash ^ (unsigned char) *expression) * 16777619u;
+  }
+  return hash;
+}
+
+static void releaseCacheEntry(XPathCacheEntry* entry)
+{
+  if (--entry->refCount == 0) {
+    xmlXPathFreeCompExpr(entry->compiled);
+    free(entry->expression);
+    free(entry);
+  }
+}
+
+static void unlinkCacheEntry(XPathCacheEntry* entry)
+{
+  if (entry->newer) {
+    entry->newer->older = entry->older;
+  }
+  else {
+    xpathCacheNewest = entry->older;
+  }
+  if (entry->older) {
+    entry->older->newer = entry->newer;
+  }
+  else {
+    xpathCacheOldest = entry->newer;
+  }
+  entry->newer = entry->older = NULL;
+}
+
+static void makeNewestCacheEntry(XPathCacheEntry* entry)
+{
+  entry->older = xpathCacheNewest;
+  entry->newer = NULL;
+  if (xpathCacheNewest) {
+    xpathCacheNewest->newer = entry;
+  }
+  else {
+    xpathCacheOldest = entry;
+  }
+  xpathCacheNewest = entry;
+}
+
+static void removeOldestCacheEntry(void)
+{
+  XPathCacheEntry* entry = xpathCacheOldest;
+  XPathCacheEntry** link = &xpathCacheBuckets[entry->hash & (xpathCacheBucketCount - 1)];
+
+  while (*link != entry) {
+    link = &(*link)->nextInBucket;
+  }
+  *link = entry->nextInBucket;
+  unlinkCacheEntry(entry);
+  xpathCacheCount--;
+  releaseCacheEntry(entry);
+}
+
+/* the cache mutex must be held */
+static void resizeCache(int size)
+{
+  unsigned int bucketCount = 16;
+  XPathCacheEntry* entry = NULL;
+
+  xpathCacheSize = size;
+  while (xpathCacheCount > xpathCacheSize) {
+    removeOldestCacheEntry();
+  }
+
+  /* about two buckets per entry */
+  while (bucketCount < 2 * (unsigned int) size) {
+    bucketCount *= 2;
+  }
+  if (bucketCount == xpathCacheBucketCount) {
+    return;
+  }
+
+  free(xpathCacheBuckets);
+  xpathCacheBuckets = (XPathCacheEntry**) calloc(bucketCount, sizeof(XPathCacheEntry*));
+  if (!xpathCacheBuckets) {
+    /* without a table, nothing can be cached */
+    xpathCacheBucketCount = 0;
+    while (xpathCacheOldest) {
+      entry = xpathCacheOldest;
+      unlinkCacheEntry(entry);
+      releaseCacheEntry(entry);
+    }
+    xpathCacheCount = 0;
+    xpathCacheSize = 0;
+    return;
+  }
+  xpathCacheBucketCount = bucketCount;
+  for (entry = xpathCacheNewest; entry; entry = entry->older) {
+    XPathCacheEntry** bucket = &xpathCacheBuckets[entry->hash & (bucketCount - 1)];
+    entry->nextInBucket = *bucket;
+    *bucket = entry;
+  }
+}
+
+static XPathCacheEntry* findCacheEntry(const char* expression, unsigned int hash)
+{
+  XPathCacheEntry* entry = NULL;
+
+  if (!xpathCacheBuckets) {
+    return NULL;
+  }
+  for (entry = xpathCacheBuckets[hash & (xpathCacheBucketCount - 1)]; entry; entry = entry->nextInBucket) {
+    if (entry->hash == hash && strcmp(entry->expression, expression) == 0) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+/* returns a referenced entry of the compiled expression, NULL if the expression is invalid */
+static XPathCacheEntry* acquireCompiledExpression(const char* xPathExpression)
+{
+  unsigned int hash = hashExpression(xPathExpression);
+  XPathCacheEntry* entry = NULL;
+  XPathCacheEntry* existing = NULL;
+
+  mutex_lock(&xpathCacheMutex);
+  entry = findCacheEntry(xPathExpression, hash);
+  if (entry) {
+    xpathCacheHits++;
+    entry->refCount++;
+    unlinkCacheEntry(entry);
+    makeNewestCacheEntry(entry);
+    mutex_unlock(&xpathCacheMutex);
+    return entry;
+  }
+  xpathCacheMisses++;
+  mutex_unlock(&xpathCacheMutex);
+
+  /* compile without holding the lock, the expression must not depend on a document */
+  entry = (XPathCacheEntry*) calloc(1, sizeof(XPathCacheEntry));
+  if (!entry) {
+    return NULL;
+  }
+  entry->compiled = xmlXPathCompile((const xmlChar*) xPathExpression);
+  entry->expression = (char*) malloc(strlen(xPathExpression) + 1);
+  if (!entry->compiled || !entry->expression) {
+    xmlXPathFreeCompExpr(entry->compiled);
+    free(entry->expression);
+    free(entry);
+    return NULL;
+  }
+  strcpy(entry->expression, xPathExpression);
+  entry->hash = hash;
+  entry->refCount = 1;
+
+  mutex_lock(&xpathCacheMutex);
+  if (xpathCacheSize > 0 && !xpathCacheBuckets) {
+    resizeCache(xpathCacheSize);
+  }
+  existing = findCacheEntry(xPathExpression, hash);
+  if (existing) {
+    /* compiled by another thread in the meantime */
+    existing->refCount++;
+    releaseCacheEntry(entry);
+    mutex_unlock(&xpathCacheMutex);
+    return existing;
+  }
+  if (xpathCacheSize > 0 && xpathCacheBuckets) {
+    XPathCacheEntry** bucket = &xpathCacheBuckets[hash & (xpathCacheBucketCount - 1)];
+    while (xpathCacheCount >= xpathCacheSize) {
+      removeOldestCacheEntry();
+    }
+    entry->nextInBucket = *bucket;
+    *bucket = entry;
+    makeNewestCacheEntry(entry);
+    entry->refCount++;
+    xpathCacheCount++;
+  }
+  mutex_unlock(&xpathCacheMutex);
+  return entry;
+}
+
+xmlXPathObjectPtr XPathEvaluate(xmlXPathContextPtr xpathContext, const char* xPathExpression)
+{
+  XPathCacheEntry* entry = acquireCompiledExpression(xPathExpression);
+  xmlXPathObjectPtr xpathObject = NULL;
+
+  if (!entry) {
+    return NULL;
+  }
+
+  /* errors are reported by printMsg, the externaldata elements are kept */
+  XPathResolveExternalData(xpathContext, xPathExpression, 0);
+
+  /* evaluations only read the compiled expression, it can be used by several threads */
+  xpathObject = xmlXPathCompiledEval(entry->compiled, xpathContext);
+
+  mutex_lock(&xpathCacheMutex);
+  releaseCacheEntry(entry);
+  mutex_unlock(&xpathCacheMutex);
+
+  return xpathObject;
+}
+
+/**
+   Simple paths, resolved by XPathResolveSimplePath
+ */
+#define MAX_SIMPLE_PATH_POSITION 100000000
+
+static int isNameStartChar(char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+static int isNameChar(char c)
+{
+  return isNameStartChar(c) || (c >= '0' && c <= '9') || c == '-' || c == '.';
+}
+
+/* parses an unprefixed name, returns its length or 0 */
+static size_t parseSimpleName(const char* text)
+{
+  size_t length = 0;
+
+  if (!isNameStartChar(text[0])) {
+    return 0;
+  }
+  while (isNameChar(text[length])) {
+    length++;
+  }
+  return length;
+}
+
+int XPathParseSimplePath(const char* path, SimplePathStep* steps)
+{
+  int nSteps = 0;
+
+  if (path[0] == '/') {
+    if (path[1] == '\0') {
+      return 0;
+    }
+    path++;
+  }
+
+  for (;;) {
+    SimplePathStep* step = &steps[nSteps];
+
+    if (nSteps == MAX_SIMPLE_PATH_STEPS) {
+      return -1;
+    }
+    step->name = path;
+    step->nameLength = parseSimpleName(path);
+    if (step->nameLength == 0) {
+      return -1;
+    }
+    path += step->nameLength;
+    step->position = 0;
+    step->attributeName = NULL;
+
+    if (*path == '[' && path[1] >= '0' && path[1] <= '9') {
+      /* [n] */
+      path++;
+      while (*path >= '0' && *path <= '9') {
+        step->position = 10 * step->position + (*path - '0');
+        if (step->position > MAX_SIMPLE_PATH_POSITION) {
+          return -1;
+        }
+        path++;
+      }
+      if (*path != ']' || step->position == 0) {
+        return -1;
+      }
+      path++;
+    }
+    else if (*path == '[' && path[1] == '@') {
+      /* [@name="value"] or [@name='value'] */
+      const char* end = NULL;
+      char quote;
+
+      path += 2;
+      step->attributeName = path;
+      step->attributeNameLength = parseSimpleName(path);
+      if (step->attributeNameLength == 0) {
+        return -1;
+      }
+      path += step->attributeNameLength;
+      if (path[0] != '=' || (path[1] != '"' && path[1] != '\'')) {
+        return -1;
+      }
+      quote = path[1];
+      path += 2;
+      end = strchr(path, quote);
+      if (!end || end[1] != ']') {
+        return -1;
+      }
+      step->attributeValue = path;
+      step->attributeValueLength = (size_t) (end - path);
+      path = end + 2;
+    }
+    nSteps++;
+
+    if (*path == '\0') {
+      return nSteps;
+    }
+    if (*path != '/') {
+      return -1;
+    }
+    path++;
+  }
+}
+
+static int nameEquals(const xmlChar* name, const char* expected, size_t length)
+{
+  return strncmp((const char*) name, expected, length) == 0 && name[length] == '\0';
+}
+
+static int hasAttributeValue(xmlNodePtr element, const SimplePathStep* step)
+{
+  xmlAttrPtr attribute = NULL;
+
+  for (attribute = element->properties; attribute; attribute = attribute->next) {
+    if (!attribute->ns && nameEquals(attribute->name, step->attributeName, step->attributeNameLength)) {
+      xmlNodePtr text = attribute->children;
+      int equal = 0;
+
+      if (text && !text->next && text->type == XML_TEXT_NODE && text->content) {
+        equal = nameEquals(text->content, step->attributeValue, step->attributeValueLength);
+      }
+      else {
+        xmlChar* value = xmlNodeListGetString(element->doc, text, 1);
+        equal = nameEquals(value ? value : (const xmlChar*) "", step->attributeValue, step->attributeValueLength);
+        xmlFree(value);
+      }
+      return equal;
+    }
+  }
+  return 0;
+}
+
+/* depth first search of the matching nodes, stops at the second match */
+static int matchSimplePath(TixiDocument* document, const SimplePathStep* steps, int nSteps, int iStep,
+                           xmlNodePtr parent, xmlNodePtr* node, int nMatches)
+{
+  const SimplePathStep* step = &steps[iStep];
+  xmlNodePtr child = NULL;
+  int position = 0;
+
+  /* positional steps are looked up in the child index of the parent */
+  if (document && step->position > 0 && !step->attributeName
+      && getIndexedChild(document, parent, step->name, step->nameLength, step->position, &child) >= 0) {
+    if (!child) {
+      return nMatches;
+    }
+    if (iStep + 1 < nSteps) {
+      return matchSimplePath(document, steps, nSteps, iStep + 1, child, node, nMatches);
+    }
+    if (nMatches == 0) {
+      *node = child;
+    }
+    return nMatches + 1;
+  }
+
+  for (child = parent->children; child; child = child->next) {
+    if (child->type != XML_ELEMENT_NODE || child->ns || !nameEquals(child->name, step->name, step->nameLength)) {
+      continue;
+    }
+    if (step->attributeName && !hasAttributeValue(child, step)) {
+      continue;
+    }
+    if (step->position > 0 && ++position != step->position) {
+      continue;
+    }
+
+    if (iStep + 1 == nSteps) {
+      if (nMatches == 0) {
+        *node = child;
+      }
+      nMatches++;
+    }
+    else {
+      nMatches = matchSimplePath(document, steps, nSteps, iStep + 1, child, node, nMatches);
+    }
+
+    if (nMatches > 1 || step->position > 0) {
+      break;
+    }
+  }
+  return nMatches;
+}
+
+int XPathResolveSimplePath(xmlXPathContextPtr xpathContext, const char* path, xmlNodePtr* node)
+{
+  SimplePathStep steps[MAX_SIMPLE_PATH_STEPS];
+  xmlNodePtr start = NULL;
+  int nSteps = 0;
+
+  if (!xpathContext) {
+    return -1;
+  }
+
+  /* relative paths start at the context node */
+  start = path[0] == '/' ? (xmlNodePtr) xpathContext->doc : xpathContext->node;
+  if (!start) {
+    return -1;
+  }
+  if (strcmp(path, ".") == 0) {
+    XPathResolveExternalData(xpathContext, path, 0);
+    *node = start;
+    return 1;
+  }
+
+  nSteps = XPathParseSimplePath(path, steps);
+  if (nSteps < 0) {
+    return -1;
+  }
+  XPathResolveExternalData(xpathContext, path, 0);
+  if (nSteps == 0) {
+    *node = start;
+    return 1;
+  }
+  return matchSimplePath((TixiDocument*) xpathContext->userData, steps, nSteps, 0, start, node, 0);
+}
+
+/* includes the pending external files of the children of parent and of the elements on the rest of the path */
+static ReturnCode resolveExternalDataOnPath(TixiDocument* document, const SimplePathStep* steps, int nSteps, int iStep,
+                                            xmlNodePtr parent, int wholeSubtrees)
+{
+  const SimplePathStep* step = &steps[iStep];
+  ReturnCode error = resolveExternalData(document, parent, wholeSubtrees && iStep == nSteps);
+  xmlNodePtr child = NULL;
+  int position = 0;
+
+  if (iStep == nSteps || error == FAILED) {
+    return error;
+  }
+
+  for (child = parent->children; child; child = child->next) {
+    ReturnCode childError;
+
+    if (child->type != XML_ELEMENT_NODE || child->ns || !nameEquals(child->name, step->name, step->nameLength)) {
+      continue;
+    }
+    if (step->attributeName && !hasAttributeValue(child, step)) {
+      continue;
+    }
+    if (step->position > 0 && ++position != step->position) {
+      continue;
+    }
+
+    childError = resolveExternalDataOnPath(document, steps, nSteps, iStep + 1, child, wholeSubtrees);
+    if (error == SUCCESS) {
+      error = childError;
+    }
+    if (step->position > 0) {
+      break;
+    }
+  }
+  return error;
+}
+
+ReturnCode XPathResolveExternalData(xmlXPathContextPtr xpathContext, const char* path, int wholeSubtrees)
+{
+  TixiDocument* document = xpathContext ? (TixiDocument*) xpathContext->userData : NULL;
+  SimplePathStep steps[MAX_SIMPLE_PATH_STEPS];
+  xmlNodePtr start = NULL;
+  int nSteps = 0;
+
+  if (!document || document->nPendingExternalData == 0) {
+    return SUCCESS;
+  }
+
+  start = path[0] == '/' ? (xmlNodePtr) xpathContext->doc : xpathContext->node;
+  nSteps = strcmp(path, ".") == 0 ? 0 : XPathParseSimplePath(path, steps);
+  if (!start || nSteps < 0) {
+    /* the expression may select any element */
+    return resolveExternalData(document, (xmlNodePtr) xpathContext->doc, 1);
+  }
+  return resolveExternalDataOnPath(document, steps, nSteps, 0, start, wholeSubtrees);
+}
+
+void XPathSetCacheSize(int size)
+{
+  mutex_lock(&xpathCacheMutex);
+  resizeCache(size);
+  xpathCacheHits = 0;
+  xpathCacheMisses = 0;
+  mutex_unlock(&xpathCacheMutex);
+}
+
+void XPathGetCacheStatistics(size_t* hits, size_t* misses)
+{
+  mutex_lock(&xpathCacheMutex);
+  *hits = xpathCacheHits;
+  *misses = xpathCacheMisses;
+  mutex_unlock(&xpathCacheMutex);
+}
+
+void XPathClearCache(void)
+{
+  mutex_lock(&xpathCacheMutex);
+  while (xpathCacheOldest) {
+    removeOldestCacheEntry();
+  }
+  free(xpathCacheBuckets);
+  xpathCacheBuckets = NULL;
+  xpathCacheBucketCount = 0;
+  mutex_unlock(&xpathCacheMutex);
+}
+
 xmlXPathObjectPtr XPathEvaluateExpression(xmlXPathContextPtr xpathContext, const char* xPathExpression)
 {
   xmlXPathObjectPtr xpathObject;
@@ -33,7 +681,7 @@ xmlXPathObjectPtr XPathEvaluateExpression(xmlXPathContextPtr xpathContext, const
   }
 
   /* Evaluate Expression */
-  xpathObject = xmlXPathEvalExpression((xmlChar*) xPathExpression, xpathContext);
+  xpathObject = XPathEvaluate(xpathContext, xPathExpression);
   if (!(xpathObject)) {
     printMsg(MESSAGETYPE_ERROR, "Error: Invalid XPath expression \"%s\"\n", xPathExpression);
     return NULL;
@@ -56,7 +704,7 @@ int XPathGetNodeNumber(TixiDocument* tixiDocument, const char* xPathExpression)
   int nodeNr = 0;
 
   /* Load XML document */
-  xpathObject = XPathEvaluateExpression(tixiDocument->xpathContext, xPathExpression);
+  xpathObject = XPathEvaluateExpression(XPathGetContext(tixiDocument), xPathExpression);
   if (xpathObject == NULL) {
     return -1;
   }
@@ -69,16 +717,15 @@ int XPathGetNodeNumber(TixiDocument* tixiDocument, const char* xPathExpression)
 
 
 
-char* XPathExpressionGetText(TixiDocument* tixiDocument, const char* xPathExpression, int index)
+xmlNodePtr XPathExpressionGetNode(TixiDocument* tixiDocument, const char* xPathExpression, int index)
 {
 
   xmlXPathObjectPtr xpathObject;
   xmlNodeSetPtr nodes = NULL;
   xmlNodePtr cur;
-  char* text = NULL;
   int size = 0;
 
-  xpathObject = XPathEvaluateExpression(tixiDocument->xpathContext, xPathExpression);
+  xpathObject = XPathEvaluateExpression(XPathGetContext(tixiDocument), xPathExpression);
   if (xpathObject == NULL) {
     return NULL;
   }
@@ -106,22 +753,27 @@ char* XPathExpressionGetText(TixiDocument* tixiDocument, const char* xPathExpres
 
   cur = nodes->nodeTab[--index];
 
+  xmlXPathFreeObject(xpathObject);
+  return cur;
+}
+
+char* XPathExpressionGetText(TixiDocument* tixiDocument, const char* xPathExpression, int index)
+{
+  xmlNodePtr cur = XPathExpressionGetNode(tixiDocument, xPathExpression, index);
+
+  if (!cur) {
+    return NULL;
+  }
+
   if (cur->type == XML_ELEMENT_NODE) {
     xmlNodePtr children = cur->children;
-    text = (char*) xmlNodeListGetString(tixiDocument->docPtr, children, 0);
+    return (char*) xmlNodeListGetString(tixiDocument->docPtr, children, 0);
   }
-  else if (cur->type == XML_ATTRIBUTE_NODE) {
-    if (cur->children) {
-      text = (char*) cur->children->content;
-    }
-    else {
-      xmlXPathFreeObject(xpathObject);
-      return NULL;
-    }
+  else if (cur->type == XML_ATTRIBUTE_NODE && cur->children) {
+    return (char*) xmlStrdup(cur->children->content);
   }
 
-  xmlXPathFreeObject(xpathObject);
-  return text;
+  return NULL;
 }
 
 char* XPathExpressionGetElementName(TixiDocument* tixiDocument, const char* xPathExpression, int index)
@@ -132,7 +784,7 @@ char* XPathExpressionGetElementName(TixiDocument* tixiDocument, const char* xPat
   xmlNodePtr cur;
   int size = 0;
 
-  xpathObject = XPathEvaluateExpression(tixiDocument->xpathContext, xPathExpression);
+  xpathObject = XPathEvaluateExpression(XPathGetContext(tixiDocument), xPathExpression);
   if (xpathObject == NULL) {
     return NULL;
   }
@@ -180,7 +832,7 @@ char* XPathExpressionGetElementPath(TixiDocument* tixiDocument, const char* xPat
   xmlNodePtr cur;
   int size = 0;
 
-  xpathObject = XPathEvaluateExpression(tixiDocument->xpathContext, xPathExpression);
+  xpathObject = XPathEvaluateExpression(XPathGetContext(tixiDocument), xPathExpression);
   if (xpathObject == NULL) {
     return NULL;
   }
@@ -212,6 +864,151 @@ char* XPathExpressionGetElementPath(TixiDocument* tixiDocument, const char* xPat
   return (char*) xmlGetNodePath(cur);
 }
 
+void XPathInitNodePathBuilder(XPathNodePathBuilder* builder)
+{
+  memset(builder, 0, sizeof(XPathNodePathBuilder));
+}
+
+void XPathFreeNodePathBuilder(XPathNodePathBuilder* builder)
+{
+  int i;
+  for (i = 0; i < XPATH_NODE_PATH_MAX_DEPTH; ++i) {
+    xmlFree(builder->levels[i].path);
+  }
+  XPathInitNodePathBuilder(builder);
+}
+
+/* siblings counted by xmlGetNodePath for the position of an element without namespace */
+static int isSameNameElement(xmlNodePtr node, const xmlChar* name)
+{
+  return node->type == XML_ELEMENT_NODE && node->ns == NULL && xmlStrEqual(node->name, name);
+}
+
+/* returns the position of an element among its siblings of the same name */
+static int getNodePathPosition(XPathNodePathLevel* level, xmlNodePtr node)
+{
+  xmlNodePtr sibling = NULL;
+  int position = 0;
+
+  /* continue counting at the last visited element if it precedes node */
+  if (level->node && level->position > 0 && level->node->parent == node->parent
+      && xmlStrEqual(level->node->name, node->name)) {
+    int count = level->position;
+    for (sibling = level->node->next; sibling && sibling != node; sibling = sibling->next) {
+      if (isSameNameElement(sibling, node->name)) {
+        count++;
+      }
+    }
+    if (sibling) {
+      return count + 1;
+    }
+  }
+
+  position = 1;
+  for (sibling = node->prev; sibling; sibling = sibling->prev) {
+    if (isSameNameElement(sibling, node->name)) {
+      position++;
+    }
+  }
+  return position;
+}
+
+/* returns the path of an element at the given depth, owned by the builder */
+static const xmlChar* buildElementPath(XPathNodePathBuilder* builder, xmlNodePtr node, int depth)
+{
+  XPathNodePathLevel* level = &builder->levels[depth];
+  const xmlChar* parentPath = NULL;
+  xmlNodePtr sibling = NULL;
+  xmlChar* path = NULL;
+  size_t length = 0;
+  int position = 0;
+
+  if (level->node == node) {
+    return level->path;
+  }
+
+  if (depth == 0 || node->ns || node->parent->type != XML_ELEMENT_NODE) {
+    path = xmlGetNodePath(node);
+  }
+  else {
+    parentPath = buildElementPath(builder, node->parent, depth - 1);
+    if (!parentPath) {
+      return NULL;
+    }
+    position = getNodePathPosition(level, node);
+
+    length = (size_t) xmlStrlen(parentPath) + (size_t) xmlStrlen(node->name) + 16;
+    path = (xmlChar*) xmlMalloc(length);
+    if (!path) {
+      return NULL;
+    }
+
+    /* like xmlGetNodePath, omit the position of elements without siblings of the same name */
+    sibling = node->next;
+    if (position == 1) {
+      while (sibling && !isSameNameElement(sibling, node->name)) {
+        sibling = sibling->next;
+      }
+    }
+    if (position > 1 || sibling) {
+      sprintf((char*) path, "%s/%s[%d]", parentPath, node->name, position);
+    }
+    else {
+      sprintf((char*) path, "%s/%s", parentPath, node->name);
+    }
+  }
+
+  xmlFree(level->path);
+  level->node = path ? node : NULL;
+  level->path = path;
+  level->position = position;
+  return path;
+}
+
+xmlChar* XPathBuildNodePath(XPathNodePathBuilder* builder, xmlNodePtr node)
+{
+  xmlNodePtr element = NULL;
+  xmlNodePtr ancestor = NULL;
+  const xmlChar* elementPath = NULL;
+  xmlChar* path = NULL;
+  size_t length = 0;
+  int depth = -1;
+
+  if (node->type == XML_ELEMENT_NODE) {
+    element = node;
+  }
+  else if (node->type == XML_ATTRIBUTE_NODE && node->ns == NULL && node->parent) {
+    element = node->parent;
+  }
+  else {
+    return xmlGetNodePath(node);
+  }
+
+  /* depth 0 is the root element */
+  for (ancestor = element; ancestor && ancestor->type == XML_ELEMENT_NODE; ancestor = ancestor->parent) {
+    depth++;
+  }
+  if (!ancestor || ancestor->type != XML_DOCUMENT_NODE || depth >= XPATH_NODE_PATH_MAX_DEPTH) {
+    return xmlGetNodePath(node);
+  }
+
+  elementPath = buildElementPath(builder, element, depth);
+  if (!elementPath) {
+    return NULL;
+  }
+  if (element == node) {
+    return xmlStrdup(elementPath);
+  }
+
+  /* attribute without namespace */
+  length = (size_t) xmlStrlen(elementPath) + (size_t) xmlStrlen(node->name) + 3;
+  path = (xmlChar*) xmlMalloc(length);
+  if (path) {
+    sprintf((char*) path, "%s/@%s", elementPath, node->name);
+  }
+  return path;
+}
+
 int XPathRegisterNamespace(xmlXPathContextPtr xpathContext, const char *namespaceURI, const char *prefix)
 {
   return xmlXPathRegisterNs(xpathContext, (xmlChar*) prefix, (xmlChar*) namespaceURI);
@@ -227,7 +1024,7 @@ int XPathRegisterDocumentNamespaces(xmlXPathContextPtr xpathContext)
 
 
   /* Get all unique namespace declarations */
-  xpathObj = xmlXPathEvalExpression((xmlChar*) "//*/namespace::*[not(. = ../../namespace::*|preceding::*/namespace::*)]", xpathContext);
+  xpathObj = XPathEvaluate(xpathContext, "//*/namespace::*[not(. = ../../namespace::*|preceding::*/namespace::*)]");
   if (xpathObj == NULL) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to retrieve all namespaces \n");
     return -1;
@@ -36,10 +36,168 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Returns the XPath context of the calling thread for the document.
+ *
+ * An XPath context is modified while evaluating an expression, so each thread
+ * gets its own context, created on first use. It contains all namespaces registered
+ * in document->xpathContext at that time.
+ */
+xmlXPathContextPtr XPathGetContext(TixiDocument *tixiDocument);
+
+/**
+ * @brief Copies the namespaces registered in document->xpathContext into the
+ * contexts of all threads. Requires exclusive access to the document.
+ */
+void XPathUpdateThreadContexts(TixiDocument *tixiDocument);
+
+/**
+ * @brief Frees the XPath contexts of all threads, when the document is freed.
+ */
+void XPathFreeThreadContexts(TixiDocument *tixiDocument);
+
+/**
+ * @brief Evaluates an XPath expression.
+ *
+ * All tixi functions evaluate XPath expressions through this function. The
+ * context must not be used by another thread, see XPathGetContext. The
+ * compiled expressions are cached, see XPathSetCacheSize.
+ *
+ * @return The XPath object (may contain an empty node set) or NULL for an invalid expression
+ */
+xmlXPathObjectPtr XPathEvaluate(xmlXPathContextPtr xpathContext, const char *xPathExpression);
+
+#define MAX_SIMPLE_PATH_STEPS 64
+
+/**
+ * @brief Step of a simple path, the strings point into the parsed path.
+ */
+typedef struct
+{
+  const char* name;
+  size_t nameLength;
+  int position;                  /* 0 if the step has no position predicate */
+  const char* attributeName;     /* NULL if the step has no attribute predicate */
+  size_t attributeNameLength;
+  const char* attributeValue;
+  size_t attributeValueLength;
+} SimplePathStep;
+
+/**
+ * @brief Splits a simple path (see XPathResolveSimplePath) into its steps.
+ *
+ * @param path (in) the path, a leading "/" is skipped
+ * @param steps (out) array of MAX_SIMPLE_PATH_STEPS steps
+ *
+ * @return the number of steps, 0 for "/", -1 if the path is not a simple path
+ */
+int XPathParseSimplePath(const char* path, SimplePathStep* steps);
+
+/**
+ * @brief Resolves simple element paths without the XPath engine.
+ *
+ * Handles paths of child steps with unprefixed element names, each with an
+ * optional position [n] or attribute [@name="value"] predicate, e.g.
+ * /cpacs/vehicles/aircraft/model[@uID="model"]/wings/wing[2]. Relative paths
+ * like wing[2]/sections and "." start at the node of the context. The result is
+ * the same as evaluating the path with XPathEvaluate. Position predicates are
+ * looked up in the child indexes of the document, if the context was created
+ * by XPathGetContext.
+ *
+ * @param xpathContext (in) the XPath context
+ * @param path (in) the path
+ * @param node (out) the first matching node (in document order)
+ *
+ * @return
+ *   - -1 if the path is not such a simple path and must be evaluated by XPathEvaluate
+ *   - 0 if no node matches
+ *   - 1 if exactly one node matches
+ *   - 2 if more than one node matches
+ */
+int XPathResolveSimplePath(xmlXPathContextPtr xpathContext, const char *path, xmlNodePtr *node);
+
+/**
+ * @brief Includes the external files of a document opened with OPENMODE_RECURSIVE_LAZY,
+ * which the path resolves into, see resolveExternalData.
+ *
+ * For simple paths, the pending externaldata elements among the children of the elements on
+ * the path are included, with wholeSubtrees also all below the elements the path resolves to.
+ * Other expressions may select any element and include all external files of the document.
+ * XPathEvaluate and XPathResolveSimplePath call this function before resolving a path.
+ *
+ * @return SUCCESS if there was nothing to include, otherwise see resolveExternalData
+ */
+ReturnCode XPathResolveExternalData(xmlXPathContextPtr xpathContext, const char *path, int wholeSubtrees);
+
+/**
+ * @brief Sets the maximum number of compiled expressions kept by XPathEvaluate.
+ *
+ * The least recently used expressions are removed if the cache is full.
+ * A size of 0 disables the cache. Resets the statistics.
+ */
+void XPathSetCacheSize(int size);
+
+/**
+ * @brief Returns the number of evaluations that found their expression in the
+ * cache and that had to compile it.
+ */
+void XPathGetCacheStatistics(size_t* hits, size_t* misses);
+
+/**
+ * @brief Removes all compiled expressions from the cache.
+ */
+void XPathClearCache(void);
+
+#define XPATH_NODE_PATH_MAX_DEPTH 64
+
+/**
+ * @brief State of XPathBuildNodePath, remembers the last visited element of each depth.
+ */
+typedef struct
+{
+  xmlNodePtr node;            /* last visited element of this depth */
+  xmlChar* path;              /* path of node */
+  int position;               /* position of node among the siblings of the same name, 0 if unknown */
+} XPathNodePathLevel;
+
+typedef struct
+{
+  XPathNodePathLevel levels[XPATH_NODE_PATH_MAX_DEPTH];
+} XPathNodePathBuilder;
+
+void XPathInitNodePathBuilder(XPathNodePathBuilder* builder);
+
+void XPathFreeNodePathBuilder(XPathNodePathBuilder* builder);
+
+/**
+ * @brief Returns the same path as xmlGetNodePath for the nodes of a node set.
+ *
+ * The paths of the ancestors and the positions of the last visited elements
+ * are reused, so visiting the elements of a node set in document order does
+ * not scan all siblings of each element and its ancestors again.
+ *
+ * @return the path, to be freed with xmlFree
+ */
+xmlChar* XPathBuildNodePath(XPathNodePathBuilder* builder, xmlNodePtr node);
+
 xmlXPathObjectPtr XPathEvaluateExpression(xmlXPathContextPtr xpathContext, const char *xPathExpression);
 
 int XPathGetNodeNumber(TixiDocument *tixiDocument, const char *xPathExpression);
 
+/**
+  @brief Returns the i-th node (starting at 1) matching the xPathExpression
+
+  @return
+    The node or NULL if the expression is invalid or the index is out of range.
+ */
+xmlNodePtr XPathExpressionGetNode(TixiDocument *tixiDocument, const char *xPathExpression, int index);
+
+/**
+  @brief Returns the text of the i-th element or attribute matching the xPathExpression
+
+  @return
+    The text, to be freed with xmlFree, or NULL in case of an error.
+ */
 char* XPathExpressionGetText(TixiDocument *tixiDocument, const char *xPathExpression, int index);
 
 /**
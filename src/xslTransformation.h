@@ -27,9 +27,6 @@
 #ifndef XSL_TRANSFORMATION_H
 #define XSL_TRANSFORMATION_H
 
-#ifdef __cplusplus
-extern "C" {
-#endif
 
 #include "libxml/parser.h"
 #include "libxml/xpath.h"
@@ -41,6 +38,10 @@ extern "C" {
 #include "tixi.h"
 #include "tixiData.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 
 /**
   @brief Performs XSL transformation to a document and returns the result doc as string.
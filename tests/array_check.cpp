@@ -20,6 +20,9 @@
 
 #include "tixi.h"
 
+#include <sstream>
+#include <string>
+
 
 /**
     @test Tests for Array routines.
@@ -195,3 +198,135 @@ TEST_F(ArrayTests, array_test_negative)
   ASSERT_EQ   ( NON_MATCHING_SIZE, tixiGetArray(documentHandle, xPath, "cmz", 49, &values));
   ASSERT_EQ   ( NON_MATCHING_SIZE, tixiGetArray(documentHandle, xPath, "cmz", 47, &values));
 }
+
+TEST_F(ArrayTests, array_test_into)
+{
+  double values[48];
+  double* allocatedValues = NULL;
+  int arraySize = 0;
+  size_t bytes = 0, entries = 0;
+
+  // size probe without parsing
+  ASSERT_EQ ( STRING_TRUNCATED, tixiGetArrayInto(documentHandle, xPath, "cmz", NULL, 0, &arraySize) );
+  ASSERT_EQ ( 48, arraySize );
+
+  ASSERT_EQ ( SUCCESS, tixiGetArrayInto(documentHandle, xPath, "cmz", values, 48, &arraySize) );
+  ASSERT_EQ ( SUCCESS, tixiGetArray(documentHandle, xPath, "cmz", 48, &allocatedValues) );
+  for (int i = 0; i < 48; ++i) {
+    ASSERT_EQ ( allocatedValues[i], values[i] );
+  }
+
+  // the values fitting are read
+  values[10] = -1.;
+  ASSERT_EQ ( STRING_TRUNCATED, tixiGetArrayInto(documentHandle, xPath, "cmz", values, 10, &arraySize) );
+  ASSERT_EQ ( 48, arraySize );
+  ASSERT_EQ ( allocatedValues[9], values[9] );
+  ASSERT_EQ ( -1., values[10] );
+
+  // no memory is retained by the document
+  ASSERT_EQ ( SUCCESS, tixiGetRetainedMemory(documentHandle, &bytes, &entries) );
+  ASSERT_EQ ( SUCCESS, tixiGetArrayInto(documentHandle, xPath, "cmz", values, 48, NULL) );
+  size_t entriesAfter = 0;
+  ASSERT_EQ ( SUCCESS, tixiGetRetainedMemory(documentHandle, &bytes, &entriesAfter) );
+  ASSERT_EQ ( entries, entriesAfter );
+
+  ASSERT_EQ ( INVALID_HANDLE, tixiGetArrayInto(123, xPath, "cmz", values, 48, &arraySize) );
+  ASSERT_EQ ( INVALID_XPATH, tixiGetArrayInto(documentHandle, invalidXPath, "cmz", values, 48, &arraySize) );
+  ASSERT_EQ ( ELEMENT_NOT_FOUND, tixiGetArrayInto(documentHandle, wrongXPath, "cmz", values, 48, &arraySize) );
+  ASSERT_EQ ( ATTRIBUTE_NOT_FOUND, tixiGetArrayInto(documentHandle, xPath, "abc", values, 48, &arraySize) );
+}
+
+TEST_F(ArrayTests, array_test_many_arrays)
+{
+  // more arrays than the initial buckets of the descriptor table
+  const int nArrays = 300;
+  std::string xml = "<root>";
+  for (int i = 0; i < nArrays; ++i) {
+    std::ostringstream map;
+    map << "<map><x mapType=\"vector\">1";
+    for (int j = 1; j <= i % 5; ++j) {
+      map << ";" << j + 1;
+    }
+    map << "</x><p mapType=\"array\">" << i << "</p></map>";
+    xml += map.str();
+  }
+  xml += "</root>";
+
+  TixiDocumentHandle handle = -1;
+  ASSERT_EQ ( SUCCESS, tixiImportFromString(xml.c_str(), &handle) );
+
+  // the second pass reads the cached descriptors
+  for (int pass = 0; pass < 2; ++pass) {
+    for (int i = 0; i < nArrays; ++i) {
+      std::ostringstream path;
+      path << "/root/map[" << i + 1 << "]";
+      int size = 0;
+      int arraySize = 0;
+      ASSERT_EQ ( SUCCESS, tixiGetArrayDimensionSizes(handle, path.str().c_str(), &size, &arraySize) );
+      ASSERT_EQ ( i % 5 + 1, arraySize );
+    }
+  }
+  ASSERT_EQ ( SUCCESS, tixiCloseDocument(handle) );
+}
+
+TEST_F(ArrayTests, array_test_descriptor)
+{
+  int nDimensions = 0, nParameters = 0, arraySize = 0;
+  char** dimensionNames = NULL;
+  char** parameterNames = NULL;
+  int* dimensionSizes = NULL;
+  double* dimensionValues = NULL;
+  double* parameterValues = NULL;
+  double* values = NULL;
+  int sizes[4];
+
+  ASSERT_EQ ( SUCCESS, tixiGetArrayDescriptor(documentHandle, xPath, &nDimensions, &dimensionNames, &dimensionSizes,
+                                              &dimensionValues, &nParameters, &parameterNames, NULL, &arraySize) );
+  ASSERT_EQ ( 4, nDimensions );
+  ASSERT_EQ ( 48, arraySize );
+  ASSERT_EQ ( 7, nParameters );
+  ASSERT_STREQ ( "machNumber", dimensionNames[0] );
+  ASSERT_STREQ ( "angleOfAttack", dimensionNames[3] );
+  ASSERT_STREQ ( "cfx", parameterNames[0] );
+  ASSERT_STREQ ( "def", parameterNames[6] );
+  ASSERT_EQ ( 8, dimensionSizes[3] );
+  // the values of all dimensions follow each other
+  ASSERT_EQ ( 1., dimensionValues[0] );
+  ASSERT_EQ ( 2., dimensionValues[2] );
+  ASSERT_EQ ( 10., dimensionValues[5] );
+  ASSERT_EQ ( 8., dimensionValues[13] );
+
+  // cmx and def do not have the size of the array
+  ASSERT_EQ ( NON_MATCHING_SIZE, tixiGetArrayDescriptor(documentHandle, xPath, &nDimensions, &dimensionNames, &dimensionSizes,
+                                                       &dimensionValues, &nParameters, &parameterNames, &parameterValues, &arraySize) );
+  ASSERT_EQ ( SUCCESS, tixiRemoveElement(documentHandle, "/root/aeroPerformanceMap/cfy") );
+  ASSERT_EQ ( SUCCESS, tixiRemoveElement(documentHandle, "/root/aeroPerformanceMap/cfz") );
+  ASSERT_EQ ( SUCCESS, tixiRemoveElement(documentHandle, "/root/aeroPerformanceMap/cmx") );
+  ASSERT_EQ ( SUCCESS, tixiRemoveElement(documentHandle, "/root/aeroPerformanceMap/cmy") );
+  ASSERT_EQ ( SUCCESS, tixiRemoveElement(documentHandle, "/root/aeroPerformanceMap/def") );
+  ASSERT_EQ ( SUCCESS, tixiGetArrayDescriptor(documentHandle, xPath, &nDimensions, &dimensionNames, &dimensionSizes,
+                                              &dimensionValues, &nParameters, &parameterNames, &parameterValues, &arraySize) );
+  ASSERT_EQ ( 2, nParameters );
+  ASSERT_EQ ( 216., parameterValues[47] );
+  ASSERT_EQ ( 1., parameterValues[48] );
+  ASSERT_EQ ( 216., parameterValues[95] );
+
+  // modifications of the document are seen by the getters
+  ASSERT_EQ ( SUCCESS, tixiUpdateTextElement(documentHandle, "/root/aeroPerformanceMap/cmz", "1;2;3;4;5;6;7;8;11;12;13;14;15;16;17;18;101;102;103;104;105;106;107;108;111;112;113;114;115;116;117;118;201;202;203;204;205;206;207;208;209;210;211;212;213;214;215;-1") );
+  ASSERT_EQ ( SUCCESS, tixiGetArray(documentHandle, xPath, "cmz", 48, &values) );
+  ASSERT_EQ ( -1., values[47] );
+  ASSERT_EQ ( SUCCESS, tixiUpdateTextElement(documentHandle, "/root/aeroPerformanceMap/angleOfAttack", "1;2;3;4") );
+  ASSERT_EQ ( SUCCESS, tixiGetArrayDimensionSizes(documentHandle, xPath, sizes, &arraySize) );
+  ASSERT_EQ ( 24, arraySize );
+  ASSERT_EQ ( 4, sizes[3] );
+  ASSERT_EQ ( NON_MATCHING_SIZE, tixiGetArray(documentHandle, xPath, "cmz", 24, &values) );
+
+  ASSERT_EQ ( INVALID_HANDLE, tixiGetArrayDescriptor(123, xPath, &nDimensions, &dimensionNames, &dimensionSizes,
+                                                     &dimensionValues, &nParameters, &parameterNames, NULL, &arraySize) );
+  ASSERT_EQ ( ELEMENT_NOT_FOUND, tixiGetArrayDescriptor(documentHandle, wrongXPath, &nDimensions, &dimensionNames, &dimensionSizes,
+                                                        &dimensionValues, &nParameters, &parameterNames, NULL, &arraySize) );
+  ASSERT_EQ ( ELEMENT_NOT_FOUND, tixiGetArrayDescriptor(documentHandle, "/root", &nDimensions, &dimensionNames, &dimensionSizes,
+                                                        &dimensionValues, &nParameters, &parameterNames, NULL, &arraySize) );
+  ASSERT_EQ ( FAILED, tixiGetArrayDescriptor(documentHandle, xPath, NULL, &dimensionNames, &dimensionSizes,
+                                             &dimensionValues, &nParameters, &parameterNames, NULL, &arraySize) );
+}
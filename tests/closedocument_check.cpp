@@ -52,3 +52,21 @@ TEST(closedocument_checks, close_multiple)
   ASSERT_TRUE( tixiCloseDocument( documentHandle3 ) == SUCCESS );
   ASSERT_TRUE( tixiCloseDocument( documentHandle2 ) == SUCCESS );
 }
+
+
+TEST(closedocument_checks, stale_handle_after_reuse)
+{
+  TixiDocumentHandle documentHandle1 = -1;
+  TixiDocumentHandle documentHandle2 = -1;
+  const char* xmlFilename = "TestData/in.xml";
+
+  ASSERT_TRUE( tixiOpenDocument( xmlFilename, &documentHandle1 ) == SUCCESS );
+  ASSERT_TRUE( tixiCloseDocument( documentHandle1 ) == SUCCESS );
+
+  // the new document reuses the released slot but gets a different handle
+  ASSERT_TRUE( tixiOpenDocument( xmlFilename, &documentHandle2 ) == SUCCESS );
+  ASSERT_NE( documentHandle1, documentHandle2 );
+  ASSERT_TRUE( tixiCloseDocument( documentHandle1 ) == INVALID_HANDLE );
+  ASSERT_TRUE( tixiCheckDocumentHandle( documentHandle2 ) == SUCCESS );
+  ASSERT_TRUE( tixiCloseDocument( documentHandle2 ) == SUCCESS );
+}
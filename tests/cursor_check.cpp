@@ -0,0 +1,186 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "test.h"
+#include "tixi.h"
+
+/**
+  @test Tests for the node cursor functions.
+*/
+
+class CursorChecks : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    handle = -1;
+    ASSERT_EQ(SUCCESS, tixiOpenDocument("TestData/in.xml", &handle));
+  }
+
+  void TearDown()
+  {
+    ASSERT_EQ(SUCCESS, tixiCloseDocument(handle));
+  }
+
+  TixiDocumentHandle handle;
+};
+
+static void silentMessageHandler(MessageType, const char*)
+{
+}
+
+TEST_F(CursorChecks, relativeGetters)
+{
+  TixiNodeCursor wing = 0;
+  double x = 0.;
+  int number = 0;
+  char* text = NULL;
+
+  ASSERT_EQ(SUCCESS, tixiGetNodeCursor(handle, "/plane/wings/wing[2]", &wing));
+  ASSERT_EQ(SUCCESS, tixiCursorGetDoubleElement(handle, wing, "centerOfGravity/y", &x));
+  ASSERT_EQ(-10., x);
+  ASSERT_EQ(SUCCESS, tixiCursorGetTextAttribute(handle, wing, NULL, "position", &text));
+  ASSERT_STREQ("right", text);
+  ASSERT_EQ(SUCCESS, tixiCursorGetTextAttribute(handle, wing, "centerOfGravity/x", "unit", &text));
+  ASSERT_STREQ("m", text);
+  ASSERT_EQ(SUCCESS, tixiCursorCheckElement(handle, wing, "centerOfGravity/z"));
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiCursorCheckElement(handle, wing, "centerOfGravity/t"));
+
+  // absolute paths and XPath expressions relative to the cursor
+  ASSERT_EQ(SUCCESS, tixiCursorGetIntegerElement(handle, wing, "/plane/numberOfPassengers", &number));
+  ASSERT_EQ(57, number);
+  ASSERT_EQ(SUCCESS, tixiCursorGetIntegerAttribute(handle, wing, "..", "numberOfWings", &number));
+  ASSERT_EQ(2, number);
+  ASSERT_EQ(SUCCESS, tixiCursorGetDoubleElement(handle, wing, "preceding-sibling::wing/centerOfGravity/y", &x));
+  ASSERT_EQ(10., x);
+  ASSERT_EQ(ELEMENT_PATH_NOT_UNIQUE, tixiCursorGetTextElement(handle, wing, "centerOfGravity/*", &text));
+
+  // the functions taking paths are not affected
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiCheckElement(handle, "centerOfGravity"));
+
+  TixiNodeCursor point = 0;
+  ASSERT_EQ(SUCCESS, tixiCursorGetNodeCursor(handle, wing, "centerOfGravity", &point));
+  ASSERT_EQ(SUCCESS, tixiCursorGetDoubleElement(handle, point, "z", &x));
+  ASSERT_EQ(5., x);
+  ASSERT_EQ(SUCCESS, tixiCursorGetPath(handle, point, &text));
+  ASSERT_STREQ("/plane/wings/wing[2]/centerOfGravity", text);
+
+  ASSERT_EQ(SUCCESS, tixiReleaseNodeCursor(handle, point));
+  ASSERT_EQ(SUCCESS, tixiReleaseNodeCursor(handle, wing));
+}
+
+TEST_F(CursorChecks, navigation)
+{
+  TixiNodeCursor cursor = 0;
+  char* name = NULL;
+  double x = 0.;
+
+  ASSERT_EQ(SUCCESS, tixiGetNodeCursor(handle, "/plane/wings", &cursor));
+  ASSERT_EQ(SUCCESS, tixiCursorMoveToFirstChild(handle, cursor));
+  ASSERT_EQ(SUCCESS, tixiCursorGetElementName(handle, cursor, &name));
+  ASSERT_STREQ("wing", name);
+
+  // comments are skipped
+  ASSERT_EQ(SUCCESS, tixiCursorMoveToFirstChild(handle, cursor));
+  ASSERT_EQ(SUCCESS, tixiCursorGetElementName(handle, cursor, &name));
+  ASSERT_STREQ("centerOfGravity", name);
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiCursorMoveToNextSibling(handle, cursor));
+
+  ASSERT_EQ(SUCCESS, tixiCursorMoveToParent(handle, cursor));
+  ASSERT_EQ(SUCCESS, tixiCursorMoveToNextSibling(handle, cursor));
+  ASSERT_EQ(SUCCESS, tixiCursorGetDoubleElement(handle, cursor, "centerOfGravity/y", &x));
+  ASSERT_EQ(-10., x);
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiCursorMoveToNextSibling(handle, cursor));
+
+  ASSERT_EQ(SUCCESS, tixiCursorGetNodeCursor(handle, cursor, "centerOfGravity/x", &cursor));
+  ASSERT_EQ(NO_CHILDREN, tixiCursorMoveToFirstChild(handle, cursor));
+
+  ASSERT_EQ(SUCCESS, tixiGetNodeCursor(handle, "/plane", &cursor));
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiCursorMoveToParent(handle, cursor));
+  ASSERT_EQ(SUCCESS, tixiCursorGetElementName(handle, cursor, &name));
+  ASSERT_STREQ("plane", name);
+}
+
+TEST_F(CursorChecks, setters)
+{
+  TixiNodeCursor point = 0;
+  double x = 0.;
+  int boolean = 0;
+  char* text = NULL;
+
+  ASSERT_EQ(SUCCESS, tixiGetNodeCursor(handle, "/plane/aPoint/point", &point));
+  ASSERT_EQ(SUCCESS, tixiAddTextElement(handle, "/plane/aPoint/point", "visible", "true"));
+  ASSERT_EQ(SUCCESS, tixiCursorGetBooleanElement(handle, point, "visible", &boolean));
+  ASSERT_EQ(1, boolean);
+  ASSERT_EQ(SUCCESS, tixiCursorUpdateDoubleElement(handle, point, "x", 1.5, NULL));
+  ASSERT_EQ(SUCCESS, tixiCursorUpdateIntegerElement(handle, point, "y", 3, "%d"));
+  ASSERT_EQ(SUCCESS, tixiCursorUpdateTextElement(handle, point, "z", "4.25"));
+  ASSERT_EQ(SUCCESS, tixiCursorAddTextAttribute(handle, point, "", "name", "p1"));
+  ASSERT_EQ(SUCCESS, tixiCursorAddDoubleAttribute(handle, point, "x", "weight", 0.5, NULL));
+
+  ASSERT_EQ(SUCCESS, tixiGetDoubleElement(handle, "/plane/aPoint/point/x", &x));
+  ASSERT_EQ(1.5, x);
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(handle, "/plane/aPoint/point/y", &text));
+  ASSERT_STREQ("3", text);
+  ASSERT_EQ(SUCCESS, tixiGetDoubleElement(handle, "/plane/aPoint/point/z", &x));
+  ASSERT_EQ(4.25, x);
+  ASSERT_EQ(SUCCESS, tixiGetTextAttribute(handle, "/plane/aPoint/point", "name", &text));
+  ASSERT_STREQ("p1", text);
+  ASSERT_EQ(SUCCESS, tixiCursorGetDoubleAttribute(handle, point, "x", "weight", &x));
+  ASSERT_EQ(0.5, x);
+
+  ASSERT_EQ(SUCCESS, tixiReleaseNodeCursor(handle, point));
+}
+
+TEST_F(CursorChecks, invalidation)
+{
+  TixiNodeCursor wing = 0, point = 0, other = 0, origin = 0;
+  double x = 0.;
+
+  TixiPrintMsgFnc oldHandler = tixiGetPrintMsgFunc();
+  tixiSetPrintMsgFunc(silentMessageHandler);
+
+  ASSERT_EQ(SUCCESS, tixiGetNodeCursor(handle, "/plane/wings/wing[1]", &wing));
+  ASSERT_EQ(SUCCESS, tixiGetNodeCursor(handle, "/plane/wings/wing[1]/centerOfGravity/x", &point));
+  ASSERT_EQ(SUCCESS, tixiGetNodeCursor(handle, "/plane/wings/wing[2]", &other));
+  ASSERT_EQ(SUCCESS, tixiGetNodeCursor(handle, "/plane/coordinateOrigin", &origin));
+
+  // cursors inside of the removed subtree become invalid, the others stay valid
+  ASSERT_EQ(SUCCESS, tixiRemoveElement(handle, "/plane/wings/wing[1]"));
+  ASSERT_EQ(INVALID_CURSOR, tixiCursorGetDoubleElement(handle, wing, "centerOfGravity/x", &x));
+  ASSERT_EQ(INVALID_CURSOR, tixiCursorGetDoubleElement(handle, point, NULL, &x));
+  ASSERT_EQ(INVALID_CURSOR, tixiCursorMoveToParent(handle, point));
+  ASSERT_EQ(SUCCESS, tixiCursorGetDoubleElement(handle, other, "centerOfGravity/y", &x));
+  ASSERT_EQ(-10., x);
+
+  // replacing the content of an element removes its child elements
+  ASSERT_EQ(SUCCESS, tixiCursorGetNodeCursor(handle, origin, "x", &point));
+  ASSERT_EQ(SUCCESS, tixiCursorUpdateTextElement(handle, origin, NULL, "none"));
+  ASSERT_EQ(INVALID_CURSOR, tixiCursorGetDoubleElement(handle, point, NULL, &x));
+  ASSERT_EQ(SUCCESS, tixiCursorCheckElement(handle, origin, NULL));
+
+  // released cursors are invalid, even if the slot is reused
+  ASSERT_EQ(SUCCESS, tixiReleaseNodeCursor(handle, wing));
+  ASSERT_EQ(INVALID_CURSOR, tixiReleaseNodeCursor(handle, wing));
+  TixiNodeCursor reused = 0;
+  ASSERT_EQ(SUCCESS, tixiGetNodeCursor(handle, "/plane/name", &reused));
+  ASSERT_NE(wing, reused);
+  ASSERT_EQ(INVALID_CURSOR, tixiCursorGetDoubleElement(handle, wing, NULL, &x));
+  ASSERT_EQ(INVALID_CURSOR, tixiCursorGetDoubleElement(handle, 0, NULL, &x));
+  ASSERT_EQ(INVALID_HANDLE, tixiCursorGetDoubleElement(-1, other, NULL, &x));
+
+  tixiSetPrintMsgFunc(oldHandler);
+}
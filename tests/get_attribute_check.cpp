@@ -59,6 +59,25 @@ TEST_F(GetAttributeTests, attributeNotFound)
   ASSERT_TRUE( tixiGetTextAttribute( documentHandle, elementPath, attributeName, &text ) == ATTRIBUTE_NOT_FOUND );
 }
 
+TEST_F(GetAttributeTests, getTextAttributeInto)
+{
+  char buffer[16];
+  char small[3];
+  int requiredSize = 0;
+
+  ASSERT_EQ(SUCCESS, tixiGetTextAttributeInto(documentHandle, "/plane/wings/wing[1]", "position", buffer, sizeof(buffer), &requiredSize));
+  ASSERT_STREQ("left", buffer);
+  ASSERT_EQ(5, requiredSize);
+
+  ASSERT_EQ(STRING_TRUNCATED, tixiGetTextAttributeInto(documentHandle, "/plane/wings/wing[2]", "position", small, sizeof(small), &requiredSize));
+  ASSERT_STREQ("ri", small);
+  ASSERT_EQ(6, requiredSize);
+
+  ASSERT_EQ(ATTRIBUTE_NOT_FOUND, tixiGetTextAttributeInto(documentHandle, "/plane/wings/wing[1]", "non_existing_attribute", buffer, sizeof(buffer), &requiredSize));
+  ASSERT_EQ(INVALID_NAMESPACE_PREFIX, tixiGetTextAttributeInto(documentHandle, "/plane/wings/wing[1]", "ns:position", buffer, sizeof(buffer), &requiredSize));
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiGetTextAttributeInto(documentHandle, "/plane/name/pp", "position", buffer, sizeof(buffer), &requiredSize));
+}
+
 TEST_F(GetAttributeTests, elementNotFound)
 {
   char* text = NULL;
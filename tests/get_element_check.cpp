@@ -23,6 +23,8 @@
 
 #include "tixi.h"
 
+#include <vector>
+
 
 /**
     @test Tests for getting attributes.
@@ -236,3 +238,156 @@ TEST_F(GetElementTests, GetChildElements)
   ASSERT_STREQ("#comment", string);
 }
 
+
+TEST_F(GetElementTests, returnedStringsStayValid)
+{
+  // enough strings to fill several chunks of the document memory
+  std::vector<char*> names;
+  char* exported = NULL;
+  for (int i = 0; i < 20000; ++i) {
+    char* text = NULL;
+    ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandle, "/plane/name", &text));
+    names.push_back(text);
+  }
+  ASSERT_EQ(SUCCESS, tixiExportDocumentAsString(documentHandle, &exported));
+
+  for (size_t i = 0; i < names.size(); ++i) {
+    ASSERT_STREQ("Junkers JU 52", names[i]);
+  }
+  ASSERT_TRUE(strstr(exported, "Junkers JU 52") != NULL);
+}
+
+TEST_F(GetElementTests, getElementTextInto)
+{
+  char buffer[14];
+  char small[5];
+  int requiredSize = 0;
+
+  ASSERT_EQ(SUCCESS, tixiGetTextElementInto(documentHandle, "/plane/name", buffer, sizeof(buffer), &requiredSize));
+  ASSERT_STREQ("Junkers JU 52", buffer);
+  ASSERT_EQ(14, requiredSize);
+
+  // the text is truncated, the required size is still reported
+  ASSERT_EQ(STRING_TRUNCATED, tixiGetTextElementInto(documentHandle, "/plane/name", small, sizeof(small), &requiredSize));
+  ASSERT_STREQ("Junk", small);
+  ASSERT_EQ(14, requiredSize);
+  ASSERT_EQ(STRING_TRUNCATED, tixiGetTextElementInto(documentHandle, "/plane/name", NULL, 0, &requiredSize));
+  ASSERT_EQ(14, requiredSize);
+
+  ASSERT_EQ(SUCCESS, tixiGetTextElementInto(documentHandle, "/plane/empty", buffer, sizeof(buffer), NULL));
+  ASSERT_STREQ("", buffer);
+
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiGetTextElementInto(documentHandle, "/plane/name/pp", buffer, sizeof(buffer), &requiredSize));
+  ASSERT_EQ(INVALID_HANDLE, tixiGetTextElementInto(-1, "/plane/name", buffer, sizeof(buffer), &requiredSize));
+}
+
+TEST_F(GetElementTests, getElementTextBorrowed)
+{
+  const char* text = NULL;
+  double value = 0.;
+  int number = 0;
+
+  ASSERT_EQ(SUCCESS, tixiGetTextElementBorrowed(documentHandle, "/plane/name", &text));
+  ASSERT_STREQ("Junkers JU 52", text);
+  ASSERT_EQ(SUCCESS, tixiGetTextElementBorrowed(documentHandle, "/plane/empty", &text));
+  ASSERT_STREQ("", text);
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiGetTextElementBorrowed(documentHandle, "/plane/name/pp", &text));
+
+  ASSERT_EQ(SUCCESS, tixiGetDoubleElement(documentHandle, "/plane/wings/wing[1]/centerOfGravity/x", &value));
+  ASSERT_EQ(30., value);
+  ASSERT_EQ(SUCCESS, tixiGetIntegerElement(documentHandle, "/plane/wings/wing[1]/centerOfGravity/x", &number));
+  ASSERT_EQ(30, number);
+}
+
+TEST(GetElementTests2, textVariantsAreConsistent)
+{
+  // texts that are escaped, assembled from several nodes or contain entities
+  TixiDocumentHandle handle = -1;
+  const char* paths[] = {"/r/plain", "/r/escaped", "/r/cdata", "/r/nonascii", "/r/empty"};
+  ASSERT_EQ(SUCCESS, tixiImportFromString("<r><plain>text</plain><escaped>x &amp; y &lt; z</escaped>"
+                                          "<cdata><![CDATA[q<]]>w</cdata><nonascii>caf\xc3\xa9</nonascii><empty/></r>", &handle));
+
+  for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); ++i) {
+    char* text = NULL;
+    const char* borrowed = NULL;
+    char buffer[64];
+    ASSERT_EQ(SUCCESS, tixiGetTextElement(handle, paths[i], &text));
+    ASSERT_EQ(SUCCESS, tixiGetTextElementBorrowed(handle, paths[i], &borrowed));
+    ASSERT_EQ(SUCCESS, tixiGetTextElementInto(handle, paths[i], buffer, sizeof(buffer), NULL));
+    ASSERT_STREQ(text, borrowed);
+    ASSERT_STREQ(text, buffer);
+  }
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(handle));
+}
+
+TEST_F(GetElementTests, getValues)
+{
+  const char* paths[] = {
+    "/plane/wings/wing[2]/centerOfGravity/x",
+    "/plane/wings/wing[2]/centerOfGravity/y",
+    "/plane/wings/wing[2]/centerOfGravity/y/@unit",
+    "/plane/wings/wing[2]/centerOfGravity/t",
+    "/plane/wings/wing[2]/centerOfGravity/*",
+    "/plane/wings/wing[2]/@top",
+    "/plane/wings/@numberOfWings",
+    "/plane/numberOfPassengers",
+    "/plane/bool/aBool1",
+    "/plane/bool/aBool3",
+    "/plane/bool/aBool2b",
+    "//wing[@position='left']/centerOfGravity/y",
+    "/plane/name/text()",
+    "/plane/wings/wing[2]/centerOfGravity/z",
+    "/plane/name/pp",
+    "/plane/wings/wing[3]/centerOfGravity/x",
+    "/plane/wings/wing[2]/centerOfGravity/x",
+    "/plane/$",
+  };
+  const int types[] = {
+    VALUETYPE_DOUBLE, VALUETYPE_DOUBLE, VALUETYPE_DOUBLE, VALUETYPE_DOUBLE, VALUETYPE_DOUBLE,
+    VALUETYPE_BOOLEAN, VALUETYPE_INTEGER, VALUETYPE_INTEGER, VALUETYPE_BOOLEAN, VALUETYPE_BOOLEAN,
+    VALUETYPE_BOOLEAN, VALUETYPE_DOUBLE, VALUETYPE_DOUBLE, VALUETYPE_INTEGER, VALUETYPE_DOUBLE,
+    VALUETYPE_DOUBLE, 42, VALUETYPE_DOUBLE
+  };
+  const ReturnCode expectedErrors[] = {
+    SUCCESS, SUCCESS, SUCCESS, ELEMENT_NOT_FOUND, ELEMENT_PATH_NOT_UNIQUE,
+    SUCCESS, SUCCESS, SUCCESS, SUCCESS, FAILED,
+    SUCCESS, SUCCESS, NOT_AN_ELEMENT, SUCCESS, ELEMENT_NOT_FOUND,
+    ELEMENT_NOT_FOUND, FAILED, INVALID_XPATH
+  };
+  const double expectedValues[] = {
+    30., -10., 0., 0., 0.,
+    0., 2., 57., 1., 0.,
+    0., 10., 0., 5., 0.,
+    0., 0., 0.
+  };
+  const int nValues = sizeof(paths) / sizeof(paths[0]);
+  std::vector<double> values(nValues, -1.);
+  std::vector<ReturnCode> errors(nValues, FAILED);
+
+  ASSERT_EQ(SUCCESS, tixiGetValues(documentHandle, paths, types, nValues, &values[0], &errors[0]));
+  for (int i = 0; i < nValues; ++i) {
+    ASSERT_EQ(expectedErrors[i], errors[i]) << paths[i];
+    ASSERT_EQ(expectedValues[i], values[i]) << paths[i];
+  }
+
+  // the results match the single getters
+  double value = 0.;
+  int number = 0;
+  ASSERT_EQ(SUCCESS, tixiGetDoubleElement(documentHandle, paths[1], &value));
+  ASSERT_EQ(values[1], value);
+  ASSERT_EQ(SUCCESS, tixiGetIntegerAttribute(documentHandle, "/plane/wings", "numberOfWings", &number));
+  ASSERT_EQ(values[6], number);
+  ASSERT_EQ(SUCCESS, tixiGetBooleanElement(documentHandle, paths[8], &number));
+  ASSERT_EQ(values[8], number);
+
+  // the batch is not affected by changes between the calls
+  ASSERT_EQ(SUCCESS, tixiUpdateDoubleElement(documentHandle, paths[0], 12.5, "%g"));
+  ASSERT_EQ(SUCCESS, tixiGetValues(documentHandle, paths, types, 1, &values[0], &errors[0]));
+  ASSERT_EQ(SUCCESS, errors[0]);
+  ASSERT_EQ(12.5, values[0]);
+
+  ASSERT_EQ(SUCCESS, tixiGetValues(documentHandle, NULL, NULL, 0, NULL, NULL));
+  ASSERT_EQ(FAILED, tixiGetValues(documentHandle, paths, types, -1, &values[0], &errors[0]));
+  ASSERT_EQ(FAILED, tixiGetValues(documentHandle, paths, types, nValues, NULL, &errors[0]));
+  ASSERT_EQ(INVALID_HANDLE, tixiGetValues(-1, paths, types, nValues, &values[0], &errors[0]));
+}
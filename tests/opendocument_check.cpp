@@ -19,6 +19,10 @@
 #include "test.h" // Brings in the GTest framework
 #include "tixi.h"
 
+#include <cstdio>
+#include <cstring>
+#include <string>
+
 
 TEST(opendocument_checks, non_existing)
 {
@@ -45,6 +49,18 @@ TEST(opendocument_checks, is_well_formed)
   tixiCloseDocument( documentHandle );
 }
 
+TEST(opendocument_checks, is_well_formed_compressed)
+{
+  TixiDocumentHandle documentHandle = -1;
+  const char* xmlFilename = "TestData/in.xml.gz";
+  char* text = NULL;
+
+  ASSERT_EQ(SUCCESS, tixiOpenDocument(xmlFilename, &documentHandle));
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandle, "/plane/name", &text));
+  ASSERT_STREQ("Junkers JU 52", text);
+  tixiCloseDocument(documentHandle);
+}
+
 
 TEST(opendocument_checks, check_handle)
 {
@@ -115,3 +131,342 @@ TEST(opendocument_checks, external_data_noextnodes)
   ASSERT_EQ(SUCCESS,  tixiOpenDocumentRecursive( file, &documentHandle, OPENMODE_RECURSIVE));
   tixiCloseDocument(documentHandle);
 }
+
+namespace
+{
+  void writeFile(const std::string& name, const std::string& content)
+  {
+    FILE* file = fopen(name.c_str(), "w");
+    fputs(content.c_str(), file);
+    fclose(file);
+  }
+
+  std::string toString(int value)
+  {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%d", value);
+    return buffer;
+  }
+}
+
+TEST(opendocument_checks, external_data_many_nested)
+{
+  TixiDocumentHandle documentHandle = -1;
+  const int nSites = 20;
+  std::string main = "<root>";
+  char* text = NULL;
+  int count = 0;
+
+  // each site includes two files, the first of them includes a third one
+  for (int i = 0; i < nSites; ++i) {
+    std::string index = toString(i);
+    main += "<externaldata><path></path><filename>ext_many_a" + index + ".xml</filename>"
+            "<filename>ext_many_b" + index + ".xml</filename></externaldata>";
+    writeFile("ext_many_a" + index + ".xml", "<partA><externaldata><path></path><filename>ext_many_n" + index +
+              ".xml</filename></externaldata></partA>");
+    writeFile("ext_many_b" + index + ".xml", "<partB>" + index + "</partB>");
+    writeFile("ext_many_n" + index + ".xml", "<nested>" + index + "</nested>");
+  }
+  writeFile("ext_many.xml", main + "</root>");
+
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentRecursive("ext_many.xml", &documentHandle, OPENMODE_RECURSIVE));
+  ASSERT_EQ(SUCCESS, tixiGetNumberOfChilds(documentHandle, "/root", &count));
+  ASSERT_EQ(2 * nSites, count);
+  for (int i = 0; i < nSites; ++i) {
+    std::string index = toString(i);
+    ASSERT_EQ(SUCCESS, tixiGetChildNodeName(documentHandle, "/root", 2 * i + 1, &text));
+    ASSERT_STREQ("partA", text);
+    ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandle, ("/root/partA[" + toString(i + 1) + "]/nested").c_str(), &text));
+    ASSERT_EQ(index, text);
+    ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandle, ("/root/partB[" + toString(i + 1) + "]").c_str(), &text));
+    ASSERT_EQ(index, text);
+    ASSERT_EQ(SUCCESS, tixiGetTextAttribute(documentHandle, ("/root/partB[" + toString(i + 1) + "]").c_str(),
+                                            "externalFileName", &text));
+    ASSERT_EQ("ext_many_b" + index + ".xml", text);
+  }
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiCheckElement(documentHandle, "//externaldata"));
+  tixiCloseDocument(documentHandle);
+
+  remove("ext_many.xml");
+  for (int i = 0; i < nSites; ++i) {
+    std::string index = toString(i);
+    remove(("ext_many_a" + index + ".xml").c_str());
+    remove(("ext_many_b" + index + ".xml").c_str());
+    remove(("ext_many_n" + index + ".xml").c_str());
+  }
+}
+
+TEST(opendocument_checks, external_data_lazy_cursor)
+{
+  TixiDocumentHandle documentHandle = -1;
+  TixiNodeCursor cursor = 0;
+  char* name = NULL;
+
+  writeFile("lazy_cursor.xml", "<root><a><b><externaldata><path></path><filename>lazy_inc.xml</filename></externaldata>"
+            "</b><externaldata><path></path><filename>lazy_sibling.xml</filename></externaldata></a></root>");
+  writeFile("lazy_inc.xml", "<inc><x>1</x></inc>");
+  writeFile("lazy_sibling.xml", "<sibling/>");
+
+  // moving a cursor into an element reads its external files
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentRecursive("lazy_cursor.xml", &documentHandle, OPENMODE_RECURSIVE_LAZY));
+  ASSERT_EQ(SUCCESS, tixiGetNodeCursor(documentHandle, "/root", &cursor));
+  ASSERT_EQ(SUCCESS, tixiCursorMoveToFirstChild(documentHandle, cursor));
+  ASSERT_EQ(SUCCESS, tixiCursorMoveToFirstChild(documentHandle, cursor));
+  ASSERT_EQ(SUCCESS, tixiCursorGetElementName(documentHandle, cursor, &name));
+  ASSERT_STREQ("b", name);
+  ASSERT_EQ(SUCCESS, tixiCursorMoveToNextSibling(documentHandle, cursor));
+  ASSERT_EQ(SUCCESS, tixiCursorGetElementName(documentHandle, cursor, &name));
+  ASSERT_STREQ("sibling", name);
+  ASSERT_EQ(SUCCESS, tixiCursorMoveToParent(documentHandle, cursor));
+  ASSERT_EQ(SUCCESS, tixiCursorMoveToFirstChild(documentHandle, cursor));
+  ASSERT_EQ(SUCCESS, tixiCursorMoveToFirstChild(documentHandle, cursor));
+  ASSERT_EQ(SUCCESS, tixiCursorGetElementName(documentHandle, cursor, &name));
+  ASSERT_STREQ("inc", name);
+  tixiCloseDocument(documentHandle);
+
+  remove("lazy_cursor.xml");
+  remove("lazy_inc.xml");
+  remove("lazy_sibling.xml");
+}
+
+TEST(opendocument_checks, external_data_lazy)
+{
+  TixiDocumentHandle documentHandle = -1;
+  TixiDocumentHandle savedHandle = -1;
+  char* text = NULL;
+  char* exported = NULL;
+  double value = 0.;
+
+  writeFile("lazy_main.xml", "<root><c>1</c>"
+            "<partA><externaldata><path></path><filename>lazy_a.xml</filename></externaldata></partA>"
+            "<partB><externaldata><path></path><filename>lazy_b.xml</filename></externaldata></partB></root>");
+  writeFile("lazy_a.xml", "<a><value>1.5</value><nested><externaldata><path></path>"
+            "<filename>lazy_n.xml</filename></externaldata></nested></a>");
+  writeFile("lazy_b.xml", "<b><value>2.5</value></b>");
+  writeFile("lazy_n.xml", "<n>3</n>");
+
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentRecursive("lazy_main.xml", &documentHandle, OPENMODE_RECURSIVE_LAZY));
+  ASSERT_EQ(SUCCESS, tixiGetDoubleElement(documentHandle, "/root/c", &value));
+  ASSERT_EQ(1., value);
+  ASSERT_EQ(SUCCESS, tixiExportDocumentAsString(documentHandle, &exported));
+  ASSERT_TRUE(strstr(exported, "<filename>lazy_a.xml</filename>") != NULL);
+  ASSERT_TRUE(strstr(exported, "<filename>lazy_b.xml</filename>") != NULL);
+
+  // only the files on the path are read
+  ASSERT_EQ(SUCCESS, tixiGetDoubleElement(documentHandle, "/root/partA/a/value", &value));
+  ASSERT_EQ(1.5, value);
+  ASSERT_EQ(SUCCESS, tixiExportDocumentAsString(documentHandle, &exported));
+  ASSERT_TRUE(strstr(exported, "<filename>lazy_a.xml</filename>") == NULL);
+  ASSERT_TRUE(strstr(exported, "<filename>lazy_n.xml</filename>") != NULL);
+  ASSERT_TRUE(strstr(exported, "<filename>lazy_b.xml</filename>") != NULL);
+
+  ASSERT_EQ(SUCCESS, tixiResolveExternal(documentHandle, "/root/partA"));
+  ASSERT_EQ(SUCCESS, tixiGetDoubleElement(documentHandle, "/root/partA/a/nested/n", &value));
+  ASSERT_EQ(3., value);
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiResolveExternal(documentHandle, "/root/missing"));
+  ASSERT_EQ(INVALID_HANDLE, tixiResolveExternal(-1, "/"));
+
+  // the untouched file is not read when saving, the externaldata element is kept
+  remove("lazy_b.xml");
+  ASSERT_EQ(SUCCESS, tixiSaveDocument(documentHandle, "lazy_saved.xml"));
+  ASSERT_EQ(SUCCESS, tixiOpenDocument("lazy_saved.xml", &savedHandle));
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(savedHandle, "/root/partA/externaldata/filename", &text));
+  ASSERT_STREQ("lazy_a.xml", text);
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(savedHandle, "/root/partB/externaldata/filename", &text));
+  ASSERT_STREQ("lazy_b.xml", text);
+  tixiCloseDocument(savedHandle);
+
+  // a file which cannot be read keeps its externaldata element
+  ASSERT_EQ(OPEN_FAILED, tixiResolveExternal(documentHandle, "/"));
+  ASSERT_EQ(SUCCESS, tixiCheckElement(documentHandle, "/root/partB/externaldata"));
+  ASSERT_EQ(SUCCESS, tixiResolveExternal(documentHandle, "/"));
+  tixiCloseDocument(documentHandle);
+
+  // the uIDs are looked up in all files
+  writeFile("lazy_b.xml", "<b uID=\"b1\"><value>2.5</value></b>");
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentRecursive("lazy_main.xml", &documentHandle, OPENMODE_RECURSIVE_LAZY));
+  ASSERT_EQ(SUCCESS, tixiUIDGetXPath(documentHandle, "b1", &text));
+  ASSERT_STREQ("/root/partB/b", text);
+  tixiCloseDocument(documentHandle);
+
+  // the untouched files are still found after saving to another directory
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentRecursive("lazy_main.xml", &documentHandle, OPENMODE_RECURSIVE_LAZY));
+  ASSERT_EQ(SUCCESS, tixiGetDoubleElement(documentHandle, "/root/partA/a/value", &value));
+  ASSERT_EQ(SUCCESS, tixiSaveDocument(documentHandle, "TestData/lazy_moved.xml"));
+  tixiCloseDocument(documentHandle);
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentRecursive("TestData/lazy_moved.xml", &savedHandle, OPENMODE_RECURSIVE));
+  ASSERT_EQ(SUCCESS, tixiGetDoubleElement(savedHandle, "/root/partA/a/value", &value));
+  ASSERT_EQ(1.5, value);
+  ASSERT_EQ(SUCCESS, tixiGetDoubleElement(savedHandle, "/root/partA/a/nested/n", &value));
+  ASSERT_EQ(3., value);
+  ASSERT_EQ(SUCCESS, tixiGetDoubleElement(savedHandle, "/root/partB/b/value", &value));
+  ASSERT_EQ(2.5, value);
+  tixiCloseDocument(savedHandle);
+
+  const char* files[] = {"lazy_main.xml", "lazy_a.xml", "lazy_b.xml", "lazy_n.xml", "lazy_saved.xml",
+                         "TestData/lazy_moved.xml", "TestData/lazy_a.xml"};
+  for (int i = 0; i < 7; ++i) {
+    remove(files[i]);
+  }
+}
+
+TEST(opendocument_checks, open_with_options)
+{
+  TixiDocumentHandle documentHandle = -1;
+  TixiOpenOptions options = {OPENMODE_PLAIN, 0, 0, NULL, 0, NULL, 0};
+  int flags[4] = {0, OPENFLAG_MEMORY_MAP, OPENFLAG_COMPACT | OPENFLAG_HUGE, OPENFLAG_MEMORY_MAP | OPENFLAG_COMPACT};
+  char* text = NULL;
+
+  for (int i = 0; i < 4; ++i) {
+    options.flags = flags[i];
+    options.sizeHint = i * 100000;
+    ASSERT_EQ(SUCCESS, tixiOpenDocumentWithOptions("TestData/in.xml", &documentHandle, &options));
+    ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandle, "/plane/name", &text));
+    ASSERT_STREQ("Junkers JU 52", text);
+    tixiCloseDocument(documentHandle);
+
+    // compressed files are decompressed by libxml2
+    ASSERT_EQ(SUCCESS, tixiOpenDocumentWithOptions("TestData/in.xml.gz", &documentHandle, &options));
+    ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandle, "/plane/name", &text));
+    ASSERT_STREQ("Junkers JU 52", text);
+    tixiCloseDocument(documentHandle);
+
+    ASSERT_EQ(OPEN_FAILED, tixiOpenDocumentWithOptions("____HOPEFULLY_THIS_FILE_NAME_DOES_NOT_EXIST~~~~", &documentHandle, &options));
+    ASSERT_EQ(NOT_WELL_FORMED, tixiOpenDocumentWithOptions("TestData/illformed.xml", &documentHandle, &options));
+  }
+
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentWithOptions("TestData/in.xml", &documentHandle, NULL));
+  tixiCloseDocument(documentHandle);
+
+  options.openMode = OPENMODE_RECURSIVE;
+  options.flags = OPENFLAG_MEMORY_MAP;
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentWithOptions("TestData/externaldata-main.xml", &documentHandle, &options));
+  tixiCloseDocument(documentHandle);
+}
+
+TEST(opendocument_checks, open_with_options_blanks)
+{
+  TixiDocumentHandle documentHandle = -1;
+  TixiOpenOptions options = {OPENMODE_PLAIN, 0, 0, NULL, 0, NULL, 0};
+  int nChildren = 0, nChildrenWithBlanks = 0;
+
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentWithOptions("TestData/in.xml", &documentHandle, &options));
+  ASSERT_EQ(SUCCESS, tixiGetNumberOfChilds(documentHandle, "/plane", &nChildren));
+  tixiCloseDocument(documentHandle);
+
+  options.flags = OPENFLAG_KEEP_BLANKS;
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentWithOptions("TestData/in.xml", &documentHandle, &options));
+  ASSERT_EQ(SUCCESS, tixiGetNumberOfChilds(documentHandle, "/plane", &nChildrenWithBlanks));
+  tixiCloseDocument(documentHandle);
+
+  ASSERT_GT(nChildrenWithBlanks, nChildren);
+}
+
+TEST(opendocument_checks, open_with_options_huge)
+{
+  TixiDocumentHandle documentHandle = -1;
+  TixiOpenOptions options = {OPENMODE_PLAIN, 0, 0, NULL, 0, NULL, 0};
+  const char* file = "huge_text.xml";
+  char* text = NULL;
+
+  // texts above 10 MB are only accepted with OPENFLAG_HUGE
+  std::string hugeText(11 * 1000 * 1000, 'x');
+  ASSERT_EQ(SUCCESS, tixiCreateDocument("root", &documentHandle));
+  ASSERT_EQ(SUCCESS, tixiAddTextElement(documentHandle, "/root", "text", hugeText.c_str()));
+  ASSERT_EQ(SUCCESS, tixiSaveDocument(documentHandle, file));
+  tixiCloseDocument(documentHandle);
+
+  ASSERT_EQ(NOT_WELL_FORMED, tixiOpenDocumentWithOptions(file, &documentHandle, &options));
+  options.flags = OPENFLAG_HUGE;
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentWithOptions(file, &documentHandle, &options));
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandle, "/root/text", &text));
+  ASSERT_EQ(hugeText.size(), strlen(text));
+  tixiCloseDocument(documentHandle);
+  remove(file);
+}
+
+TEST(opendocument_checks, open_with_options_include)
+{
+  TixiDocumentHandle documentHandle = -1;
+  TixiOpenOptions options = {OPENMODE_PLAIN, 0, 0, NULL, 0, NULL, 0};
+  const char* includePaths[] = {"/plane/wings/wing[@position=\"right\"]", "/plane/aPoint"};
+  const char* invalidPaths[] = {"/plane/wings/@numberOfWings"};
+  int count = 0;
+  double value = 0.;
+  char* text = NULL;
+
+  options.includePaths = includePaths;
+  options.nIncludePaths = 2;
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentWithOptions("TestData/in.xml", &documentHandle, &options));
+
+  // the ancestors of the included elements are loaded without their other children
+  ASSERT_EQ(SUCCESS, tixiGetNumberOfChilds(documentHandle, "/plane", &count));
+  ASSERT_EQ(2, count);
+  ASSERT_EQ(SUCCESS, tixiGetNamedChildrenCount(documentHandle, "/plane/wings", "wing", &count));
+  ASSERT_EQ(1, count);
+  ASSERT_EQ(SUCCESS, tixiGetTextAttribute(documentHandle, "/plane/wings", "numberOfWings", &text));
+  ASSERT_STREQ("2", text);
+  ASSERT_EQ(SUCCESS, tixiGetDoubleElement(documentHandle, "/plane/wings/wing/centerOfGravity/y", &value));
+  ASSERT_EQ(-10., value);
+  ASSERT_EQ(SUCCESS, tixiGetDoubleElement(documentHandle, "/plane/aPoint/point/z", &value));
+  ASSERT_EQ(31.3453, value);
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiGetTextElement(documentHandle, "/plane/name", &text));
+
+  // the document does not hold the whole file
+  ASSERT_EQ(FAILED, tixiSaveDocument(documentHandle, "include.xml"));
+  ASSERT_EQ(FAILED, tixiSaveCompleteDocument(documentHandle, "include.xml"));
+  ASSERT_EQ(FAILED, tixiExportDocumentAsString(documentHandle, &text));
+  ASSERT_TRUE(text == NULL);
+  tixiCloseDocument(documentHandle);
+
+  // elements on the way to an include path are kept, even if nothing below them matches
+  const char* unmatchedPaths[] = {"/plane/wings/wing[@position=\"middle\"]"};
+  options.includePaths = unmatchedPaths;
+  options.nIncludePaths = 1;
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentWithOptions("TestData/in.xml", &documentHandle, &options));
+  ASSERT_EQ(SUCCESS, tixiGetTextAttribute(documentHandle, "/plane/wings", "numberOfWings", &text));
+  ASSERT_STREQ("2", text);
+  ASSERT_EQ(SUCCESS, tixiGetNamedChildrenCount(documentHandle, "/plane/wings", "wing", &count));
+  ASSERT_EQ(0, count);
+  tixiCloseDocument(documentHandle);
+
+  options.includePaths = invalidPaths;
+  options.nIncludePaths = 1;
+  ASSERT_EQ(INVALID_XPATH, tixiOpenDocumentWithOptions("TestData/in.xml", &documentHandle, &options));
+}
+
+TEST(opendocument_checks, open_with_options_exclude)
+{
+  TixiDocumentHandle documentHandle = -1;
+  TixiOpenOptions options = {OPENMODE_PLAIN, 0, 0, NULL, 0, NULL, 0};
+  const char* excludePaths[] = {"/plane/wings/wing[1]", "/plane/points", "/plane/missing"};
+  const char* missingPaths[] = {"/plane/missing"};
+  const char* file = "exclude.xml";
+  int count = 0, countAll = 0;
+  double value = 0.;
+
+  ASSERT_EQ(SUCCESS, tixiOpenDocument("TestData/in.xml", &documentHandle));
+  ASSERT_EQ(SUCCESS, tixiGetNumberOfChilds(documentHandle, "/plane", &countAll));
+  tixiCloseDocument(documentHandle);
+
+  options.excludePaths = excludePaths;
+  options.nExcludePaths = 3;
+  options.flags = OPENFLAG_MEMORY_MAP;
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentWithOptions("TestData/in.xml", &documentHandle, &options));
+  ASSERT_EQ(SUCCESS, tixiGetNumberOfChilds(documentHandle, "/plane", &count));
+  ASSERT_EQ(countAll - 1, count);
+  ASSERT_EQ(SUCCESS, tixiGetNamedChildrenCount(documentHandle, "/plane/wings", "wing", &count));
+  ASSERT_EQ(1, count);
+  ASSERT_EQ(SUCCESS, tixiGetDoubleElement(documentHandle, "/plane/wings/wing/centerOfGravity/y", &value));
+  ASSERT_EQ(-10., value);
+  ASSERT_EQ(FAILED, tixiSaveDocument(documentHandle, file));
+  tixiCloseDocument(documentHandle);
+
+  // nothing was skipped, so the document can be saved
+  options.excludePaths = missingPaths;
+  options.nExcludePaths = 1;
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentWithOptions("TestData/in.xml", &documentHandle, &options));
+  ASSERT_EQ(SUCCESS, tixiSaveDocument(documentHandle, file));
+  tixiCloseDocument(documentHandle);
+  remove(file);
+}
@@ -135,6 +135,75 @@ TEST_F(OtherTests, childCount_twoChildren)
   ASSERT_TRUE( count == 2 );
 }
 
+TEST_F(OtherTests, childCount_followsTextUpdates)
+{
+  int count = 0, nChilds = 0;
+  char* text = NULL;
+
+  // indexes of the replaced text and of its siblings
+  ASSERT_EQ(SUCCESS, tixiGetNumberOfChilds(inDocumentHandle, "/plane/wings/wing[1]/centerOfGravity/x", &nChilds));
+  ASSERT_EQ(1, nChilds);
+  ASSERT_EQ(SUCCESS, tixiGetNamedChildrenCount(inDocumentHandle, "/plane/wings/wing[1]/centerOfGravity", "y", &count));
+  ASSERT_EQ(1, count);
+  ASSERT_EQ(SUCCESS, tixiUpdateTextElement(inDocumentHandle, "/plane/wings/wing[1]/centerOfGravity/x", "12.5"));
+  ASSERT_EQ(SUCCESS, tixiGetChildNodeName(inDocumentHandle, "/plane/wings/wing[1]/centerOfGravity/x", 1, &text));
+  ASSERT_STREQ("#text", text);
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(inDocumentHandle, "/plane/wings/wing[1]/centerOfGravity/y[1]", &text));
+  ASSERT_STREQ("10.0", text);
+
+  // the first child of the wing is an element, the indexes inside of it are dropped
+  ASSERT_EQ(SUCCESS, tixiUpdateTextElement(inDocumentHandle, "/plane/wings/wing[1]", "replaced"));
+  ASSERT_EQ(SUCCESS, tixiGetNamedChildrenCount(inDocumentHandle, "/plane/wings/wing[1]", "centerOfGravity", &count));
+  ASSERT_EQ(0, count);
+  ASSERT_EQ(SUCCESS, tixiGetChildNodeName(inDocumentHandle, "/plane/wings/wing[1]", 1, &text));
+  ASSERT_STREQ("#text", text);
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiCheckElement(inDocumentHandle, "/plane/wings/wing[1]/centerOfGravity/y[1]"));
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(inDocumentHandle, "/plane/wings/wing[2]/centerOfGravity/y[1]", &text));
+  ASSERT_STREQ("-10.0", text);
+}
+
+TEST_F(OtherTests, childCount_followsModifications)
+{
+  int count = 0, nChilds = 0, nNodes = 0;
+  char* text = NULL;
+
+  ASSERT_EQ(SUCCESS, tixiGetNamedChildrenCount(inDocumentHandle, "/plane/wings", "wing", &count));
+  ASSERT_EQ(2, count);
+  ASSERT_EQ(SUCCESS, tixiGetTextAttribute(inDocumentHandle, "/plane/wings/wing[2]", "position", &text));
+  ASSERT_STREQ("right", text);
+  ASSERT_EQ(SUCCESS, tixiGetNumberOfChilds(inDocumentHandle, "/plane/wings", &nChilds));
+  ASSERT_EQ(SUCCESS, tixiXPathEvaluateNodeNumber(inDocumentHandle, "/plane/wings/node()", &nNodes));
+  ASSERT_EQ(nNodes, nChilds);
+
+  // new children are counted and shift the positions of the following ones
+  ASSERT_EQ(SUCCESS, tixiCreateElementAtIndex(inDocumentHandle, "/plane/wings", "wing", 1));
+  ASSERT_EQ(SUCCESS, tixiGetNamedChildrenCount(inDocumentHandle, "/plane/wings", "wing", &count));
+  ASSERT_EQ(3, count);
+  ASSERT_EQ(SUCCESS, tixiGetTextAttribute(inDocumentHandle, "/plane/wings/wing[2]", "position", &text));
+  ASSERT_STREQ("left", text);
+  ASSERT_EQ(SUCCESS, tixiGetTextAttribute(inDocumentHandle, "/plane/wings/wing[3]", "position", &text));
+  ASSERT_STREQ("right", text);
+  ASSERT_EQ(SUCCESS, tixiGetNumberOfChilds(inDocumentHandle, "/plane/wings", &nChilds));
+  ASSERT_EQ(SUCCESS, tixiXPathEvaluateNodeNumber(inDocumentHandle, "/plane/wings/node()", &nNodes));
+  ASSERT_EQ(nNodes, nChilds);
+  ASSERT_EQ(SUCCESS, tixiGetChildNodeName(inDocumentHandle, "/plane/wings", nChilds, &text));
+  ASSERT_STREQ("wing", text);
+  ASSERT_EQ(INDEX_OUT_OF_RANGE, tixiGetChildNodeName(inDocumentHandle, "/plane/wings", nChilds + 1, &text));
+
+  ASSERT_EQ(SUCCESS, tixiRemoveElement(inDocumentHandle, "/plane/wings/wing[2]"));
+  ASSERT_EQ(SUCCESS, tixiGetNamedChildrenCount(inDocumentHandle, "/plane/wings", "wing", &count));
+  ASSERT_EQ(2, count);
+  ASSERT_EQ(SUCCESS, tixiGetTextAttribute(inDocumentHandle, "/plane/wings/wing[2]", "position", &text));
+  ASSERT_STREQ("right", text);
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiCheckElement(inDocumentHandle, "/plane/wings/wing[3]"));
+
+  // children with a namespace are not selected by unprefixed names
+  ASSERT_EQ(SUCCESS, tixiSetElementNamespace(inDocumentHandle, "/plane/wings/wing[2]", "http://www.example.org/ns", "ns"));
+  ASSERT_EQ(SUCCESS, tixiGetNamedChildrenCount(inDocumentHandle, "/plane/wings", "wing", &count));
+  ASSERT_EQ(1, count);
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiCheckElement(inDocumentHandle, "/plane/wings/wing[2]"));
+}
+
 TEST_F(OtherTests, addExternalLink_withAttribute)
 {
   const char* parentPath = "/root";
@@ -171,6 +240,55 @@ TEST_F(OtherTests, exportAsString)
   ASSERT_EQ(FAILED, tixiExportDocumentAsString(inDocumentHandle, NULL));
 }
 
+TEST_F(OtherTests, memoryCheckpoint)
+{
+  char* text = NULL;
+  char* name = NULL;
+  int mark = -1, innerMark = -1;
+  size_t bytes = 0, entries = 0, bytesAtMark = 0, entriesAtMark = 0;
+
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(inDocumentHandle, "/plane/name", &name));
+  ASSERT_EQ(SUCCESS, tixiMemoryCheckpoint(inDocumentHandle, &mark));
+  ASSERT_EQ(SUCCESS, tixiGetRetainedMemory(inDocumentHandle, &bytesAtMark, &entriesAtMark));
+  ASSERT_EQ(1u, entriesAtMark);
+
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_EQ(SUCCESS, tixiGetTextElement(inDocumentHandle, "/plane/name", &text));
+  }
+  ASSERT_EQ(SUCCESS, tixiExportDocumentAsString(inDocumentHandle, &text));
+  ASSERT_EQ(SUCCESS, tixiGetRetainedMemory(inDocumentHandle, &bytes, &entries));
+  ASSERT_EQ(entriesAtMark + 10001, entries);
+  ASSERT_TRUE(bytes > bytesAtMark);
+
+  // nested checkpoint is discarded by releasing the outer one
+  ASSERT_EQ(SUCCESS, tixiMemoryCheckpoint(inDocumentHandle, &innerMark));
+  ASSERT_EQ(SUCCESS, tixiMemoryReleaseTo(inDocumentHandle, mark));
+  ASSERT_EQ(SUCCESS, tixiGetRetainedMemory(inDocumentHandle, &bytes, &entries));
+  ASSERT_EQ(bytesAtMark, bytes);
+  ASSERT_EQ(entriesAtMark, entries);
+  ASSERT_EQ(INDEX_OUT_OF_RANGE, tixiMemoryReleaseTo(inDocumentHandle, innerMark));
+
+  // memory returned before the checkpoint is still valid, the mark can be reused
+  ASSERT_STREQ("Junkers JU 52", name);
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(inDocumentHandle, "/plane/name", &text));
+  ASSERT_STREQ("Junkers JU 52", text);
+  ASSERT_EQ(SUCCESS, tixiMemoryReleaseTo(inDocumentHandle, mark));
+
+  // a discarded checkpoint does not release a later one at the same position of the stack
+  int laterMark = -1;
+  ASSERT_EQ(SUCCESS, tixiMemoryCheckpoint(inDocumentHandle, &laterMark));
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(inDocumentHandle, "/plane/name", &text));
+  ASSERT_EQ(INDEX_OUT_OF_RANGE, tixiMemoryReleaseTo(inDocumentHandle, innerMark));
+  ASSERT_STREQ("Junkers JU 52", text);
+  ASSERT_EQ(SUCCESS, tixiMemoryReleaseTo(inDocumentHandle, laterMark));
+  ASSERT_EQ(SUCCESS, tixiMemoryReleaseTo(inDocumentHandle, mark));
+
+  ASSERT_EQ(INDEX_OUT_OF_RANGE, tixiMemoryReleaseTo(inDocumentHandle, -1));
+  ASSERT_EQ(INVALID_HANDLE, tixiMemoryCheckpoint(-1, &mark));
+  ASSERT_EQ(INVALID_HANDLE, tixiMemoryReleaseTo(-1, mark));
+  ASSERT_EQ(INVALID_HANDLE, tixiGetRetainedMemory(-1, &bytes, &entries));
+}
+
 TEST_F(OtherTests, getDocumentPath)
 {
   char* text  = NULL;
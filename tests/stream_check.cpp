@@ -0,0 +1,194 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "test.h" // Brings in the GTest framework
+#include "tixi.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+/**
+    @test Tests for tixiStreamDocument.
+*/
+
+namespace
+{
+  struct StreamValue
+  {
+    int pathIndex;
+    std::string text;
+    std::vector<double> vector;
+    bool isVector;
+  };
+
+  struct StreamResult
+  {
+    std::vector<StreamValue> values;
+    size_t maxValues;
+
+    StreamResult() : maxValues(1000) {}
+  };
+
+  int collectValue(int pathIndex, const char* text, const double* vector, int vectorSize, void* userData)
+  {
+    StreamResult* result = static_cast<StreamResult*>(userData);
+    StreamValue value;
+
+    value.pathIndex = pathIndex;
+    value.text = text;
+    value.isVector = vector != NULL;
+    if (vector) {
+      value.vector.assign(vector, vector + vectorSize);
+    }
+    result->values.push_back(value);
+    return result->values.size() >= result->maxValues ? 1 : 0;
+  }
+}
+
+TEST(StreamTests, elements_and_attributes)
+{
+  const char* paths[] = {
+    "/plane/name",
+    "/plane/wings/@numberOfWings",
+    "/plane/wings/wing[3]/centerOfGravity/y",
+    "/plane/wings/wing[@position=\"right\"]/centerOfGravity/y",
+    "/plane/wings/wing/@position",
+    "/plane/missing",
+    "/plane/wings/wing[3]/centerOfGravity/x/@unit"
+  };
+  const int expectedPaths[] = {0, 1, 4, 4, 3, 4, 6, 2, 3};
+  const char* expectedTexts[] = {"Junkers JU 52", "2", "left", "right", "-10.0", "right", "m", "-15.0", "-15.0"};
+  StreamResult result;
+
+  // attributes are reported at the start of their element, elements at their end
+  ASSERT_EQ(SUCCESS, tixiStreamDocument("TestData/externaldata-main.xml", OPENMODE_PLAIN, paths, 7, collectValue, &result));
+  ASSERT_EQ(9u, result.values.size());
+  for (size_t i = 0; i < result.values.size(); ++i) {
+    ASSERT_EQ(expectedPaths[i], result.values[i].pathIndex);
+    ASSERT_EQ(expectedTexts[i], result.values[i].text);
+    ASSERT_FALSE(result.values[i].isVector);
+  }
+}
+
+TEST(StreamTests, same_as_document)
+{
+  const char* paths[] = {"/plane/coordinateOrigin/y", "/plane/myMatrix/blub[2]/bla[2]", "/plane/wings/wing[1]"};
+  StreamResult result;
+  TixiDocumentHandle handle = -1;
+  char* text = NULL;
+
+  ASSERT_EQ(SUCCESS, tixiStreamDocument("TestData/in.xml", OPENMODE_PLAIN, paths, 3, collectValue, &result));
+  ASSERT_EQ(3u, result.values.size());
+
+  ASSERT_EQ(SUCCESS, tixiOpenDocument("TestData/in.xml", &handle));
+  for (size_t i = 0; i < result.values.size(); ++i) {
+    ASSERT_EQ(SUCCESS, tixiGetTextElement(handle, paths[result.values[i].pathIndex], &text));
+    ASSERT_EQ(std::string(text), result.values[i].text);
+  }
+  tixiCloseDocument(handle);
+}
+
+TEST(StreamTests, vectors)
+{
+  const char* paths[] = {"/a/aeroPerformanceMap/angleOfYaw", "/a/aeroPerformanceMap/cfz", "/a/aeroPerformanceMap/machNumber"};
+  StreamResult result;
+
+  ASSERT_EQ(SUCCESS, tixiStreamDocument("TestData/vectorcount.xml", OPENMODE_PLAIN, paths, 3, collectValue, &result));
+  ASSERT_EQ(3u, result.values.size());
+
+  ASSERT_EQ(2, result.values[0].pathIndex);
+  ASSERT_TRUE(result.values[0].isVector);
+  ASSERT_EQ(1u, result.values[0].vector.size());
+  ASSERT_EQ(1., result.values[0].vector[0]);
+
+  ASSERT_EQ(0, result.values[1].pathIndex);
+  ASSERT_EQ("0;5;10", result.values[1].text);
+  ASSERT_TRUE(result.values[1].isVector);
+  ASSERT_EQ(3u, result.values[1].vector.size());
+  ASSERT_EQ(10., result.values[1].vector[2]);
+
+  // the mapType is case sensitive
+  ASSERT_EQ(1, result.values[2].pathIndex);
+  ASSERT_EQ("1;2", result.values[2].text);
+  ASSERT_FALSE(result.values[2].isVector);
+}
+
+TEST(StreamTests, base64_vectors)
+{
+  const char* file = "stream_base64.xml";
+  const char* paths[] = {"/a/test"};
+  double points[3] = {1. / 3., -2.5e-310, 123456.789};
+  TixiDocumentHandle handle = -1;
+  StreamResult result;
+
+  ASSERT_EQ(SUCCESS, tixiCreateDocument("a", &handle));
+  ASSERT_EQ(SUCCESS, tixiUseBase64Vectors(handle, 1));
+  ASSERT_EQ(SUCCESS, tixiAddFloatVector(handle, "/a", "test", points, 3, NULL));
+  ASSERT_EQ(SUCCESS, tixiSaveDocument(handle, file));
+  tixiCloseDocument(handle);
+
+  ASSERT_EQ(SUCCESS, tixiStreamDocument(file, OPENMODE_PLAIN, paths, 1, collectValue, &result));
+  ASSERT_EQ(1u, result.values.size());
+  ASSERT_EQ(3u, result.values[0].vector.size());
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(points[i], result.values[0].vector[i]);
+  }
+  remove(file);
+}
+
+TEST(StreamTests, external_data)
+{
+  const char* paths[] = {"/plane/testNode/aVeryTest/point/x", "/plane/aPoint/point/x"};
+  StreamResult result;
+
+  // without OPENMODE_RECURSIVE, the external files are not read
+  ASSERT_EQ(SUCCESS, tixiStreamDocument("TestData/externaldata-main.xml", OPENMODE_PLAIN, paths, 2, collectValue, &result));
+  ASSERT_EQ(1u, result.values.size());
+  ASSERT_EQ(1, result.values[0].pathIndex);
+
+  // textfile.txt is no xml file and ignored like by tixiOpenDocumentRecursive
+  result.values.clear();
+  ASSERT_EQ(SUCCESS, tixiStreamDocument("TestData/externaldata-main.xml", OPENMODE_RECURSIVE, paths, 2, collectValue, &result));
+  ASSERT_EQ(2u, result.values.size());
+  ASSERT_EQ(0, result.values[0].pathIndex);
+  ASSERT_EQ("22", result.values[0].text);
+  ASSERT_EQ(1, result.values[1].pathIndex);
+  ASSERT_EQ("11.0", result.values[1].text);
+
+  ASSERT_EQ(OPEN_FAILED, tixiStreamDocument("TestData/externaldata-nopath.xml", OPENMODE_RECURSIVE, paths, 2, collectValue, &result));
+  ASSERT_EQ(OPEN_FAILED, tixiStreamDocument("TestData/externaldata-nofiles.xml", OPENMODE_RECURSIVE, paths, 2, collectValue, &result));
+}
+
+TEST(StreamTests, stop_and_errors)
+{
+  const char* paths[] = {"/plane/wings/wing/centerOfGravity/x"};
+  const char* invalidPaths[] = {"/plane//x"};
+  const char* attributePaths[] = {"/plane/@"};
+  StreamResult result, stopped;
+
+  stopped.maxValues = 1;
+  ASSERT_EQ(SUCCESS, tixiStreamDocument("TestData/in.xml", OPENMODE_PLAIN, paths, 1, collectValue, &stopped));
+  ASSERT_EQ(1u, stopped.values.size());
+
+  ASSERT_EQ(INVALID_XPATH, tixiStreamDocument("TestData/in.xml", OPENMODE_PLAIN, invalidPaths, 1, collectValue, &result));
+  ASSERT_EQ(INVALID_XPATH, tixiStreamDocument("TestData/in.xml", OPENMODE_PLAIN, attributePaths, 1, collectValue, &result));
+  ASSERT_EQ(OPEN_FAILED, tixiStreamDocument("____HOPEFULLY_THIS_FILE_NAME_DOES_NOT_EXIST~~~~", OPENMODE_PLAIN, paths, 1,
+                                            collectValue, &result));
+  ASSERT_EQ(NOT_WELL_FORMED, tixiStreamDocument("TestData/illformed.xml", OPENMODE_PLAIN, paths, 1, collectValue, &result));
+  ASSERT_EQ(FAILED, tixiStreamDocument("TestData/in.xml", OPENMODE_PLAIN, paths, 1, NULL, NULL));
+}
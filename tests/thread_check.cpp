@@ -0,0 +1,525 @@
+/*
+* Copyright (C) 2015 German Aerospace Center (DLR/SC)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "test.h"
+#include "tixi.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+/**
+  @test Stress tests of tixi used from several threads.
+*/
+
+static const int nThreads = 8;
+static const int nIterations = 500;
+
+static void readDocument(TixiDocumentHandle handle, int* nErrors)
+{
+  for (int i = 0; i < nIterations; ++i) {
+    char* text = NULL;
+    double x = 0.;
+    int number = 0;
+
+    if (tixiGetTextElement(handle, "/plane/name", &text) != SUCCESS || strcmp(text, "Junkers JU 52") != 0) {
+      (*nErrors)++;
+    }
+    if (tixiGetDoubleElement(handle, "/plane/wings/wing[2]/centerOfGravity/y", &x) != SUCCESS || x != -10.) {
+      (*nErrors)++;
+    }
+    if (tixiXPathEvaluateNodeNumber(handle, "/plane/wings/wing", &number) != SUCCESS || number != 2) {
+      (*nErrors)++;
+    }
+    if (tixiGetTextAttribute(handle, "/plane/wings/wing[1]", "position", &text) != SUCCESS || strcmp(text, "left") != 0) {
+      (*nErrors)++;
+    }
+  }
+}
+
+static void modifyDocument(TixiDocumentHandle handle, int* nErrors)
+{
+  for (int i = 0; i < nIterations; ++i) {
+    if (tixiAddTextElement(handle, "/plane", "scratch", "value") != SUCCESS) {
+      (*nErrors)++;
+    }
+    if (tixiRemoveElement(handle, "/plane/scratch") != SUCCESS) {
+      (*nErrors)++;
+    }
+  }
+}
+
+TEST(thread_checks, concurrent_readers_and_writer)
+{
+  TixiDocumentHandle handle = -1;
+  ASSERT_EQ(SUCCESS, tixiOpenDocument("TestData/in.xml", &handle));
+
+  std::vector<int> errors(nThreads + 1, 0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nThreads; ++i) {
+    threads.push_back(std::thread(readDocument, handle, &errors[i]));
+  }
+  threads.push_back(std::thread(modifyDocument, handle, &errors[nThreads]));
+
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+
+  for (int i = 0; i <= nThreads; ++i) {
+    ASSERT_EQ(0, errors[i]);
+  }
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiCheckElement(handle, "/plane/scratch"));
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(handle));
+}
+
+static void openAndCloseDocuments(int* nErrors)
+{
+  for (int i = 0; i < nIterations / 10; ++i) {
+    TixiDocumentHandle handle = -1;
+    char* text = NULL;
+
+    if (tixiImportFromString("<root><a>text</a></root>", &handle) != SUCCESS) {
+      (*nErrors)++;
+      continue;
+    }
+    if (tixiGetTextElement(handle, "/root/a", &text) != SUCCESS || strcmp(text, "text") != 0) {
+      (*nErrors)++;
+    }
+    if (tixiCloseDocument(handle) != SUCCESS) {
+      (*nErrors)++;
+    }
+  }
+}
+
+TEST(thread_checks, concurrent_open_close)
+{
+  std::vector<int> errors(nThreads, 0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nThreads; ++i) {
+    threads.push_back(std::thread(openAndCloseDocuments, &errors[i]));
+  }
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+  for (int i = 0; i < nThreads; ++i) {
+    ASSERT_EQ(0, errors[i]);
+  }
+}
+
+static void readUntilClosed(TixiDocumentHandle handle, int* nErrors)
+{
+  for (;;) {
+    char* text = NULL;
+    ReturnCode ret = tixiGetTextElement(handle, "/plane/name", &text);
+    if (ret == INVALID_HANDLE) {
+      return;
+    }
+    // the text belongs to the document and must not be used after the close
+    if (ret != SUCCESS) {
+      (*nErrors)++;
+    }
+  }
+}
+
+static void silentMessageHandler(MessageType, const char*)
+{
+}
+
+TEST(thread_checks, close_while_reading)
+{
+  TixiDocumentHandle handle = -1;
+  ASSERT_EQ(SUCCESS, tixiOpenDocument("TestData/in.xml", &handle));
+
+  // the readers get INVALID_HANDLE after the close, but never a dangling document
+  TixiPrintMsgFnc oldHandler = tixiGetPrintMsgFunc();
+  tixiSetPrintMsgFunc(silentMessageHandler);
+
+  std::vector<int> errors(nThreads, 0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nThreads; ++i) {
+    threads.push_back(std::thread(readUntilClosed, handle, &errors[i]));
+  }
+
+  std::this_thread::yield();
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(handle));
+
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+  tixiSetPrintMsgFunc(oldHandler);
+
+  for (int i = 0; i < nThreads; ++i) {
+    ASSERT_EQ(0, errors[i]);
+  }
+}
+
+static void readNamespacedElement(TixiDocumentHandle handle, int* nErrors)
+{
+  for (int i = 0; i < nIterations; ++i) {
+    char* text = NULL;
+    if (tixiGetTextElement(handle, "/root/h:table/h:tr/h:td[2]", &text) != SUCCESS || strcmp(text, "Bananas") != 0) {
+      (*nErrors)++;
+    }
+  }
+}
+
+TEST(thread_checks, registered_namespaces_in_all_threads)
+{
+  TixiDocumentHandle handle = -1;
+  ASSERT_EQ(SUCCESS, tixiOpenDocument("TestData/namespaces_1.xml", &handle));
+  ASSERT_EQ(SUCCESS, tixiRegisterNamespace(handle, "http://www.w3.org/TR/html4/", "h"));
+
+  std::vector<int> errors(nThreads, 0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nThreads; ++i) {
+    threads.push_back(std::thread(readNamespacedElement, handle, &errors[i]));
+  }
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+  for (int i = 0; i < nThreads; ++i) {
+    ASSERT_EQ(0, errors[i]);
+  }
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(handle));
+}
+
+static void readExternalElements(TixiDocumentHandle handle, int* nErrors)
+{
+  for (int i = 0; i < nIterations; ++i) {
+    double x = 0.;
+    if (tixiGetDoubleElement(handle, "/plane/testNode/aVeryTest/point/x", &x) != SUCCESS || x != 22.) {
+      (*nErrors)++;
+    }
+    if (tixiGetDoubleElement(handle, "/plane/aPoint/point/x", &x) != SUCCESS || x != 11.) {
+      (*nErrors)++;
+    }
+  }
+}
+
+TEST(thread_checks, lazy_external_data_in_all_threads)
+{
+  TixiDocumentHandle handle = -1;
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentRecursive("TestData/externaldata-main.xml", &handle, OPENMODE_RECURSIVE_LAZY));
+
+  // the first readers load the external files, all others have to wait for them
+  std::vector<int> errors(nThreads, 0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nThreads; ++i) {
+    threads.push_back(std::thread(readExternalElements, handle, &errors[i]));
+  }
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+  for (int i = 0; i < nThreads; ++i) {
+    ASSERT_EQ(0, errors[i]);
+  }
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(handle));
+}
+
+namespace
+{
+  struct NestedLocks
+  {
+    std::vector<TixiDocumentHandle> handles;
+    size_t depth;
+    ReturnCode innerRead;
+    ReturnCode innerWrite;
+  };
+
+  // locks the documents one after the other by nested callbacks
+  int lockNextDocument(int, const char*, const char*, const char*, void* userData)
+  {
+    NestedLocks* locks = static_cast<NestedLocks*>(userData);
+    if (locks->depth < locks->handles.size()) {
+      locks->depth++;
+      tixiXPathExpressionForEach(locks->handles[locks->depth - 1], "/*", lockNextDocument, locks);
+    }
+    else {
+      char* text = NULL;
+      locks->innerRead = tixiGetTextElement(locks->handles[0], "/root/a", &text);
+      locks->innerWrite = tixiAddTextElement(locks->handles[0], "/root", "b", "text");
+    }
+    return 1;
+  }
+
+  void modifyDocuments(const std::vector<TixiDocumentHandle>* handles, int* nErrors)
+  {
+    for (size_t i = 0; i < handles->size(); ++i) {
+      if (tixiAddTextElement((*handles)[i], "/root", "c", "text") != SUCCESS) {
+        (*nErrors)++;
+      }
+    }
+  }
+}
+
+TEST(thread_checks, many_documents_locked_by_one_thread)
+{
+  NestedLocks locks;
+  locks.depth = 0;
+  locks.innerRead = FAILED;
+  locks.innerWrite = SUCCESS;
+  for (int i = 0; i < 40; ++i) {
+    TixiDocumentHandle handle = -1;
+    ASSERT_EQ(SUCCESS, tixiImportFromString("<root><a>text</a></root>", &handle));
+    locks.handles.push_back(handle);
+  }
+
+  // a document locked for reading can not be modified
+  TixiPrintMsgFnc oldHandler = tixiGetPrintMsgFunc();
+  tixiSetPrintMsgFunc(silentMessageHandler);
+  lockNextDocument(0, NULL, NULL, NULL, &locks);
+  tixiSetPrintMsgFunc(oldHandler);
+  ASSERT_EQ(SUCCESS, locks.innerRead);
+  ASSERT_EQ(INVALID_HANDLE, locks.innerWrite);
+
+  // all locks have been released
+  int nErrors = 0;
+  std::thread writer(modifyDocuments, &locks.handles, &nErrors);
+  writer.join();
+  ASSERT_EQ(0, nErrors);
+  modifyDocuments(&locks.handles, &nErrors);
+  ASSERT_EQ(0, nErrors);
+
+  for (size_t i = 0; i < locks.handles.size(); ++i) {
+    ASSERT_EQ(SUCCESS, tixiCloseDocument(locks.handles[i]));
+  }
+}
+
+TEST(thread_checks, lazy_external_data_locked_after_many_documents)
+{
+  NestedLocks locks;
+  locks.depth = 0;
+  locks.innerRead = FAILED;
+  locks.innerWrite = SUCCESS;
+  for (int i = 0; i < 20; ++i) {
+    TixiDocumentHandle handle = -1;
+    ASSERT_EQ(SUCCESS, tixiImportFromString("<root><a>text</a></root>", &handle));
+    locks.handles.push_back(handle);
+  }
+  TixiDocumentHandle lazyHandle = -1;
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentRecursive("TestData/externaldata-main.xml", &lazyHandle, OPENMODE_RECURSIVE_LAZY));
+  locks.handles.push_back(lazyHandle);
+
+  // the exclusive read lock of the lazy document is released as such
+  TixiPrintMsgFnc oldHandler = tixiGetPrintMsgFunc();
+  tixiSetPrintMsgFunc(silentMessageHandler);
+  lockNextDocument(0, NULL, NULL, NULL, &locks);
+  tixiSetPrintMsgFunc(oldHandler);
+  ASSERT_EQ(SUCCESS, locks.innerRead);
+
+  int nErrors = 0;
+  std::thread reader(readExternalElements, lazyHandle, &nErrors);
+  reader.join();
+  ASSERT_EQ(0, nErrors);
+
+  for (size_t i = 0; i < locks.handles.size(); ++i) {
+    ASSERT_EQ(SUCCESS, tixiCloseDocument(locks.handles[i]));
+  }
+}
+
+static void readUIDs(TixiDocumentHandle handle, int* nErrors)
+{
+  for (int i = 0; i < nIterations; ++i) {
+    char* xpath = NULL;
+    char** uIDs = NULL;
+    char** xPaths = NULL;
+    int number = -1;
+
+    if (tixiUIDGetXPath(handle, "b", &xpath) != SUCCESS || strcmp(xpath, "/root/a[1]/b[2]") != 0) {
+      (*nErrors)++;
+    }
+    if (tixiUIDCheckExists(handle, "c_element") != SUCCESS) {
+      (*nErrors)++;
+    }
+    if (tixiUIDCheckDuplicates(handle) != SUCCESS) {
+      (*nErrors)++;
+    }
+    if (tixiUIDGetDuplicates(handle, &uIDs, &xPaths, &number) != SUCCESS || number != 0) {
+      (*nErrors)++;
+    }
+    if (tixiUIDGetBrokenLinks(handle, &uIDs, &xPaths, &number) != SUCCESS || number != 0) {
+      (*nErrors)++;
+    }
+  }
+}
+
+static void modifyUIDs(TixiDocumentHandle handle, int* nErrors)
+{
+  for (int i = 0; i < nIterations / 10; ++i) {
+    if (tixiAddTextElement(handle, "/root", "scratch", "value") != SUCCESS
+        || tixiAddTextAttribute(handle, "/root/scratch", "uID", "scratch") != SUCCESS) {
+      (*nErrors)++;
+    }
+    if (tixiRemoveElement(handle, "/root/scratch") != SUCCESS) {
+      (*nErrors)++;
+    }
+  }
+}
+
+TEST(thread_checks, concurrent_uid_lookups)
+{
+  TixiDocumentHandle handle = -1;
+  ASSERT_EQ(SUCCESS, tixiOpenDocument("TestData/uid_correct.xml", &handle));
+
+  // the readers build the uid table of the document together
+  std::vector<int> errors(nThreads + 1, 0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nThreads; ++i) {
+    threads.push_back(std::thread(readUIDs, handle, &errors[i]));
+  }
+  threads.push_back(std::thread(modifyUIDs, handle, &errors[nThreads]));
+
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+  for (int i = 0; i <= nThreads; ++i) {
+    ASSERT_EQ(0, errors[i]);
+  }
+  ASSERT_EQ(UID_DONT_EXISTS, tixiUIDCheckExists(handle, "scratch"));
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(handle));
+}
+
+static void readReferences(TixiDocumentHandle handle, int* nErrors)
+{
+  for (int i = 0; i < nIterations; ++i) {
+    char** xPaths = NULL;
+    char** uIDs = NULL;
+    int number = -1;
+
+    if (tixiUIDGetIncomingReferences(handle, "sec2", &xPaths, &number) != SUCCESS || number != 2) {
+      (*nErrors)++;
+    }
+    if (tixiUIDGetOutgoingReferences(handle, "/cpacs/copy", &uIDs, &number) != SUCCESS || number != 1) {
+      (*nErrors)++;
+    }
+    if (tixiUIDGetTopologicalOrder(handle, &uIDs, &number) != SUCCESS || number != 4) {
+      (*nErrors)++;
+    }
+  }
+}
+
+static void modifyReferences(TixiDocumentHandle handle, int* nErrors)
+{
+  for (int i = 0; i < nIterations / 10; ++i) {
+    if (tixiAddTextElement(handle, "/cpacs", "scratchUID", "wing1") != SUCCESS) {
+      (*nErrors)++;
+    }
+    if (tixiRemoveElement(handle, "/cpacs/scratchUID") != SUCCESS) {
+      (*nErrors)++;
+    }
+  }
+}
+
+TEST(thread_checks, concurrent_reference_queries)
+{
+  TixiDocumentHandle handle = -1;
+  ASSERT_EQ(SUCCESS, tixiOpenDocument("TestData/uid_references.xml", &handle));
+
+  // the readers build the reference graph again after each modification
+  std::vector<int> errors(nThreads + 1, 0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nThreads; ++i) {
+    threads.push_back(std::thread(readReferences, handle, &errors[i]));
+  }
+  threads.push_back(std::thread(modifyReferences, handle, &errors[nThreads]));
+
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+  for (int i = 0; i <= nThreads; ++i) {
+    ASSERT_EQ(0, errors[i]);
+  }
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(handle));
+}
+
+namespace
+{
+  struct SharedLazyRead
+  {
+    TixiDocumentHandle handle;
+    std::thread reader;
+    std::atomic<bool> readerDone;
+    bool readerDoneWhileLocked;
+    ReturnCode nestedRead;
+    double nestedValue;
+  };
+
+  void readIncludedElement(SharedLazyRead* state)
+  {
+    double value = 0.;
+    if (tixiGetDoubleElement(state->handle, "/root/c", &value) == SUCCESS && value == 1.) {
+      state->readerDone = true;
+    }
+  }
+
+  // lets another thread read while holding a read lock, then includes a file of the locked document
+  int readWhileLocked(int, const char*, const char*, const char*, void* userData)
+  {
+    SharedLazyRead* state = static_cast<SharedLazyRead*>(userData);
+    state->reader = std::thread(readIncludedElement, state);
+    for (int i = 0; i < 1000 && !state->readerDone; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    state->readerDoneWhileLocked = state->readerDone;
+    state->nestedRead = tixiGetDoubleElement(state->handle, "/root/partA/a/value", &state->nestedValue);
+    return 0;
+  }
+
+  void writeTextFile(const char* name, const char* content)
+  {
+    FILE* file = fopen(name, "w");
+    fputs(content, file);
+    fclose(file);
+  }
+}
+
+TEST(thread_checks, lazy_external_data_shared_by_readers)
+{
+  writeTextFile("lazy_shared_main.xml", "<root><c>1</c>"
+                "<partA><externaldata><path></path><filename>lazy_shared_a.xml</filename></externaldata></partA>"
+                "<partB><externaldata><path></path><filename>lazy_shared_b.xml</filename></externaldata></partB></root>");
+  writeTextFile("lazy_shared_a.xml", "<a><value>1.5</value></a>");
+  writeTextFile("lazy_shared_b.xml", "<b><value>2.5</value></b>");
+
+  SharedLazyRead state;
+  state.handle = -1;
+  state.readerDone = false;
+  state.readerDoneWhileLocked = false;
+  state.nestedRead = FAILED;
+  state.nestedValue = 0.;
+  ASSERT_EQ(SUCCESS, tixiOpenDocumentRecursive("lazy_shared_main.xml", &state.handle, OPENMODE_RECURSIVE_LAZY));
+
+  // the files below partA and partB are not read yet, they do not keep the other reader out
+  ASSERT_EQ(SUCCESS, tixiXPathExpressionForEach(state.handle, "/root/c", readWhileLocked, &state));
+  state.reader.join();
+  ASSERT_TRUE(state.readerDoneWhileLocked);
+
+  // the nested reader upgraded its lock to include the file of partA
+  ASSERT_EQ(SUCCESS, state.nestedRead);
+  ASSERT_EQ(1.5, state.nestedValue);
+  char* exported = NULL;
+  ASSERT_EQ(SUCCESS, tixiExportDocumentAsString(state.handle, &exported));
+  ASSERT_TRUE(strstr(exported, "<filename>lazy_shared_a.xml</filename>") == NULL);
+  ASSERT_TRUE(strstr(exported, "<filename>lazy_shared_b.xml</filename>") != NULL);
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(state.handle));
+
+  remove("lazy_shared_main.xml");
+  remove("lazy_shared_a.xml");
+  remove("lazy_shared_b.xml");
+}
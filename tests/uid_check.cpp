@@ -25,6 +25,7 @@ static const char* filename_uid_duplicated = "TestData/uid_duplicated.xml";
 static const char* filename_without_uids = "TestData/uid_no_uids.xml";
 static const char* filename_links_broken = "TestData/uid_broken_link.xml";
 static const char* filename_links = "TestData/uid_link.xml";
+static const char* filename_references = "TestData/uid_references.xml";
 static const char* xmlFilename = "TestData/xpaths.xml";
 
 
@@ -119,3 +120,164 @@ TEST(uid_checks, tixiUIDCheck_checkLink)
   ASSERT_TRUE( tixiUIDCheckLinks(documentHandle) == SUCCESS );
   ASSERT_TRUE( tixiCloseDocument( documentHandle ) == SUCCESS );
 }
+
+TEST(uid_checks, tixiUIDCheck_followsModifications)
+{
+  TixiDocumentHandle documentHandle = -1;
+  char* xpath = NULL;
+  const char* uids[] = {"p1", "p2"};
+  const double values[] = {1., 2.};
+
+  ASSERT_EQ(SUCCESS, tixiOpenDocument(filename_uid_correct, &documentHandle));
+  ASSERT_EQ(SUCCESS, tixiUIDCheckExists(documentHandle, "b"));
+
+  /* changed uIDs */
+  ASSERT_EQ(SUCCESS, tixiUIDSetToXPath(documentHandle, "/root/a[1]/b[2]", "b2"));
+  ASSERT_EQ(UID_DONT_EXISTS, tixiUIDCheckExists(documentHandle, "b"));
+  ASSERT_EQ(SUCCESS, tixiUIDGetXPath(documentHandle, "b2", &xpath));
+  ASSERT_STREQ("/root/a[1]/b[2]", xpath);
+
+  /* duplicates are detected until the attribute is removed again */
+  ASSERT_EQ(SUCCESS, tixiAddTextAttribute(documentHandle, "/root/b/c", "uID", "test"));
+  ASSERT_EQ(UID_NOT_UNIQUE, tixiUIDCheckDuplicates(documentHandle));
+  ASSERT_EQ(SUCCESS, tixiRemoveAttribute(documentHandle, "/root/b/c", "uID"));
+  ASSERT_EQ(SUCCESS, tixiUIDCheckDuplicates(documentHandle));
+  ASSERT_EQ(SUCCESS, tixiUIDCheckExists(documentHandle, "test"));
+  ASSERT_EQ(UID_DONT_EXISTS, tixiUIDCheckExists(documentHandle, "c_element"));
+
+  /* removed elements */
+  ASSERT_EQ(SUCCESS, tixiRemoveElement(documentHandle, "/root/a[2]"));
+  ASSERT_EQ(UID_DONT_EXISTS, tixiUIDCheckExists(documentHandle, "schlumpf"));
+  ASSERT_EQ(UID_DONT_EXISTS, tixiUIDCheckExists(documentHandle, "empty_element"));
+
+  /* added elements */
+  ASSERT_EQ(SUCCESS, tixiAddDoubleListWithAttributes(documentHandle, "/root", "points", "point", "uID", values, NULL, uids, 2));
+  ASSERT_EQ(SUCCESS, tixiUIDGetXPath(documentHandle, "p2", &xpath));
+  ASSERT_STREQ("/root/points/point[2]", xpath);
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(documentHandle));
+
+  /* duplicated uIDs resolve to the first element in document order */
+  ASSERT_EQ(SUCCESS, tixiOpenDocument(filename_uid_duplicated, &documentHandle));
+  ASSERT_EQ(SUCCESS, tixiUIDGetXPath(documentHandle, "a", &xpath));
+  ASSERT_STREQ("/root/a[1]/b[1]", xpath);
+  ASSERT_EQ(SUCCESS, tixiRemoveElement(documentHandle, "/root/a[1]"));
+  ASSERT_EQ(SUCCESS, tixiUIDCheckDuplicates(documentHandle));
+  ASSERT_EQ(SUCCESS, tixiUIDGetXPath(documentHandle, "a", &xpath));
+  ASSERT_STREQ("/root/b/c", xpath);
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(documentHandle));
+}
+
+TEST(uid_checks, tixiUIDCheck_report)
+{
+  TixiDocumentHandle documentHandle = -1;
+  char** uids = NULL;
+  char** links = NULL;
+  char** xpaths = NULL;
+  int number = -1;
+
+  ASSERT_EQ(SUCCESS, tixiOpenDocument(filename_uid_correct, &documentHandle));
+  ASSERT_EQ(SUCCESS, tixiUIDGetDuplicates(documentHandle, &uids, &xpaths, &number));
+  ASSERT_EQ(0, number);
+  ASSERT_TRUE(uids == NULL);
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(documentHandle));
+
+  /* all duplicates, sorted by uID and in document order */
+  ASSERT_EQ(SUCCESS, tixiOpenDocument(filename_uid_duplicated, &documentHandle));
+  ASSERT_EQ(SUCCESS, tixiAddTextAttribute(documentHandle, "/root/a[2]/b[2]", "uID", "test"));
+  ASSERT_EQ(SUCCESS, tixiUIDGetDuplicates(documentHandle, &uids, &xpaths, &number));
+  ASSERT_EQ(4, number);
+  ASSERT_STREQ("a", uids[0]);
+  ASSERT_STREQ("/root/a[1]/b[1]", xpaths[0]);
+  ASSERT_STREQ("a", uids[1]);
+  ASSERT_STREQ("/root/b/c", xpaths[1]);
+  ASSERT_STREQ("test", uids[2]);
+  ASSERT_STREQ("/root/a[1]", xpaths[2]);
+  ASSERT_STREQ("test", uids[3]);
+  ASSERT_STREQ("/root/a[2]/b[2]", xpaths[3]);
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(documentHandle));
+
+  /* all broken links in document order */
+  ASSERT_EQ(SUCCESS, tixiOpenDocument(filename_links_broken, &documentHandle));
+  ASSERT_EQ(SUCCESS, tixiAddTextAttribute(documentHandle, "/root/a[1]/b[2]", "isLink", "missing"));
+  ASSERT_EQ(SUCCESS, tixiAddTextAttribute(documentHandle, "/root/a[2]/b[1]", "isLink", "test"));
+  ASSERT_EQ(SUCCESS, tixiUIDGetBrokenLinks(documentHandle, &links, &xpaths, &number));
+  ASSERT_EQ(2, number);
+  ASSERT_STREQ("missing", links[0]);
+  ASSERT_STREQ("/root/a[1]/b[2]", xpaths[0]);
+  ASSERT_STREQ("bla", links[1]);
+  ASSERT_STREQ("/root/b/c", xpaths[1]);
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(documentHandle));
+
+  ASSERT_EQ(SUCCESS, tixiOpenDocument(filename_links, &documentHandle));
+  ASSERT_EQ(SUCCESS, tixiUIDGetBrokenLinks(documentHandle, &links, &xpaths, &number));
+  ASSERT_EQ(0, number);
+  ASSERT_TRUE(links == NULL);
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(documentHandle));
+}
+
+TEST(uid_checks, tixiUIDReferences)
+{
+  TixiDocumentHandle documentHandle = -1;
+  char** xpaths = NULL;
+  char** uids = NULL;
+  int number = -1;
+
+  ASSERT_EQ(SUCCESS, tixiOpenDocument(filename_references, &documentHandle));
+
+  ASSERT_EQ(SUCCESS, tixiUIDGetIncomingReferences(documentHandle, "sec2", &xpaths, &number));
+  ASSERT_EQ(2, number);
+  ASSERT_STREQ("/cpacs/wing/segments/segment/toElementUID", xpaths[0]);
+  ASSERT_STREQ("/cpacs/wing/positionings/positioning/toSectionUID", xpaths[1]);
+  ASSERT_EQ(SUCCESS, tixiUIDGetIncomingReferences(documentHandle, "seg1", &xpaths, &number));
+  ASSERT_EQ(1, number);
+  ASSERT_STREQ("/cpacs/copy", xpaths[0]);
+  ASSERT_EQ(SUCCESS, tixiUIDGetIncomingReferences(documentHandle, "missing", &xpaths, &number));
+  ASSERT_EQ(1, number);
+  ASSERT_EQ(SUCCESS, tixiUIDGetIncomingReferences(documentHandle, "wing1", &xpaths, &number));
+  ASSERT_EQ(0, number);
+  ASSERT_TRUE(xpaths == NULL);
+
+  /* elements with a uID own the references of their descendants */
+  ASSERT_EQ(SUCCESS, tixiUIDGetOutgoingReferences(documentHandle, "/cpacs/wing/segments/segment", &uids, &number));
+  ASSERT_EQ(2, number);
+  ASSERT_STREQ("sec1", uids[0]);
+  ASSERT_STREQ("sec2", uids[1]);
+  ASSERT_EQ(SUCCESS, tixiUIDGetOutgoingReferences(documentHandle, "/cpacs/wing", &uids, &number));
+  ASSERT_EQ(1, number);
+  ASSERT_STREQ("sec2", uids[0]);
+  ASSERT_EQ(SUCCESS, tixiUIDGetOutgoingReferences(documentHandle, "/cpacs/wing/segments/segment/toElementUID", &uids, &number));
+  ASSERT_EQ(1, number);
+  ASSERT_STREQ("sec2", uids[0]);
+  ASSERT_EQ(SUCCESS, tixiUIDGetOutgoingReferences(documentHandle, "/cpacs/copy", &uids, &number));
+  ASSERT_EQ(1, number);
+  ASSERT_STREQ("seg1", uids[0]);
+  ASSERT_EQ(SUCCESS, tixiUIDGetOutgoingReferences(documentHandle, "/cpacs/wing/sections", &uids, &number));
+  ASSERT_EQ(0, number);
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiUIDGetOutgoingReferences(documentHandle, "/cpacs/fuselage", &uids, &number));
+
+  ASSERT_EQ(SUCCESS, tixiUIDGetTopologicalOrder(documentHandle, &uids, &number));
+  ASSERT_EQ(4, number);
+  ASSERT_STREQ("sec1", uids[0]);
+  ASSERT_STREQ("sec2", uids[1]);
+  ASSERT_STREQ("seg1", uids[2]);
+  ASSERT_STREQ("wing1", uids[3]);
+
+  /* the references follow modifications */
+  ASSERT_EQ(SUCCESS, tixiUpdateTextElement(documentHandle, "/cpacs/wing/positionings/positioning/toSectionUID", "sec1"));
+  ASSERT_EQ(SUCCESS, tixiUIDGetIncomingReferences(documentHandle, "sec2", &xpaths, &number));
+  ASSERT_EQ(1, number);
+  ASSERT_EQ(SUCCESS, tixiAddTextElement(documentHandle, "/cpacs/wing/sections/section[1]", "parentUID", "seg1"));
+  ASSERT_EQ(UID_REFERENCE_CYCLE, tixiUIDGetTopologicalOrder(documentHandle, &uids, &number));
+  ASSERT_EQ(0, number);
+  ASSERT_EQ(SUCCESS, tixiAddTextAttribute(documentHandle, "/cpacs/broken", "isLink", "sec1"));
+  ASSERT_EQ(SUCCESS, tixiUIDGetIncomingReferences(documentHandle, "sec1", &xpaths, &number));
+  ASSERT_EQ(3, number);
+  ASSERT_STREQ("/cpacs/broken", xpaths[2]);
+  ASSERT_EQ(SUCCESS, tixiRemoveElement(documentHandle, "/cpacs/wing/sections/section[1]/parentUID"));
+  ASSERT_EQ(SUCCESS, tixiUIDGetTopologicalOrder(documentHandle, &uids, &number));
+  ASSERT_EQ(4, number);
+  ASSERT_STREQ("wing1", uids[2]);
+  ASSERT_STREQ("seg1", uids[3]);
+
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(documentHandle));
+}
@@ -19,6 +19,12 @@
 #include "test.h" // Brings in the GTest framework
 #include "tixi.h"
 
+#include <clocale>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
 
 /**
     @test Tests for vector routines.
@@ -108,3 +114,199 @@ TEST_F(VectorTests, tixiUpdateVectorTests)
   ASSERT_TRUE ( tixiUpdateFloatVector(-1, "/a/test", pointsUpdated, count, "%f") == INVALID_HANDLE );
   ASSERT_TRUE ( tixiUpdateFloatVector(documentHandleAdd, "/a/test", pointsUpdated, 0, "%f") == FAILED );
 }
+
+TEST_F(VectorTests, tixiVectorFormatting)
+{
+  double points[12] = {0., -0., 1e-5, 0.000123456789, -1.5, 3.14159265, 123456.5, 999999.5, 1234565., 1e20, -2.5e-300, 1e300};
+  std::string expected;
+  char* text = NULL;
+  char number[64];
+
+  // the default format gives the same text as "%g"
+  for (int i = 0; i < 12; ++i) {
+    sprintf(number, "%g", points[i]);
+    expected += (i > 0 ? ";" : "") + std::string(number);
+  }
+  ASSERT_EQ(SUCCESS, tixiAddFloatVector(documentHandleAdd, "/a", "test", points, 12, NULL));
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandleAdd, "/a/test", &text));
+  ASSERT_STREQ(expected.c_str(), text);
+
+  // texts longer than the initial buffer
+  ASSERT_EQ(SUCCESS, tixiUpdateFloatVector(documentHandleAdd, "/a/test", points + 4, 2, "%.40f"));
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandleAdd, "/a/test", &text));
+  sprintf(number, "%.40f", points[5]);
+  ASSERT_EQ("-1.5000000000000000000000000000000000000000;" + std::string(number), text);
+
+  ASSERT_EQ(SUCCESS, tixiAddPoint(documentHandleAdd, "/a", 1.5, -2e-7, 1e300, "%.50g"));
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandleAdd, "/a/y", &text));
+  sprintf(number, "%.50g", -2e-7);
+  ASSERT_STREQ(number, text);
+
+  // a large vector reads back
+  std::vector<double> values(100000);
+  double* readValues = NULL;
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = 0.25 * (double) i - 1000.;
+  }
+  ASSERT_EQ(SUCCESS, tixiAddFloatVector(documentHandleAdd, "/a", "large", &values[0], (int) values.size(), "%.10g"));
+  ASSERT_EQ(SUCCESS, tixiGetFloatVector(documentHandleAdd, "/a/large", &readValues, (int) values.size()));
+  for (size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(values[i], readValues[i]);
+  }
+}
+
+TEST_F(VectorTests, tixiVectorParsing)
+{
+  const char* text = "  1.5; ;;-2.5e-3 ;1e2;abc;0.1;123456789012345678901234;3,5;";
+  double* values = NULL;
+  int count = 0;
+
+  ASSERT_EQ(SUCCESS, tixiAddTextElement(documentHandleAdd, "/a", "parsed", text));
+  ASSERT_EQ(SUCCESS, tixiAddTextAttribute(documentHandleAdd, "/a/parsed", "mapType", "vector"));
+  ASSERT_EQ(SUCCESS, tixiGetVectorSize(documentHandleAdd, "/a/parsed", &count));
+  ASSERT_EQ(8, count);
+
+  // the values are read as by atof in the "C" locale, whatever locale is set
+  const char* locales[] = {"de_DE.UTF-8", "de_DE", "German", "C"};
+  for (int i = 0; i < 4; ++i) {
+    if (!setlocale(LC_NUMERIC, locales[i])) {
+      continue;
+    }
+    ASSERT_EQ(SUCCESS, tixiGetFloatVector(documentHandleAdd, "/a/parsed", &values, count));
+    setlocale(LC_NUMERIC, "C");
+    ASSERT_EQ(1.5, values[0]);
+    ASSERT_EQ(0., values[1]);
+    ASSERT_EQ(-2.5e-3, values[2]);
+    ASSERT_EQ(100., values[3]);
+    ASSERT_EQ(0., values[4]);
+    ASSERT_EQ(0.1, values[5]);
+    ASSERT_EQ(strtod("123456789012345678901234", NULL), values[6]);
+    ASSERT_EQ(3., values[7]);
+  }
+  ASSERT_EQ(INDEX_OUT_OF_RANGE, tixiGetFloatVector(documentHandleAdd, "/a/parsed", &values, count + 1));
+}
+
+TEST_F(VectorTests, tixiGetFloatVectorInto)
+{
+  double points[5] = {1., 2.5, -3., 4e10, 5.};
+  double values[5] = {0., 0., 0., 0., 0.};
+  int count = 0;
+  size_t bytes = 0, entries = 0, entriesAfter = 0;
+
+  ASSERT_EQ(SUCCESS, tixiAddFloatVector(documentHandleAdd, "/a", "test", points, 5, NULL));
+
+  // size probe without parsing
+  ASSERT_EQ(STRING_TRUNCATED, tixiGetFloatVectorInto(documentHandleAdd, "/a/test", NULL, 0, &count));
+  ASSERT_EQ(5, count);
+
+  ASSERT_EQ(SUCCESS, tixiGetRetainedMemory(documentHandleAdd, &bytes, &entries));
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(SUCCESS, tixiGetFloatVectorInto(documentHandleAdd, "/a/test", values, 5, &count));
+  }
+  ASSERT_EQ(SUCCESS, tixiGetRetainedMemory(documentHandleAdd, &bytes, &entriesAfter));
+  ASSERT_EQ(entries, entriesAfter);
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ(points[i], values[i]);
+  }
+
+  // larger arrays are filled partially, smaller ones get the first values
+  values[4] = 0.;
+  ASSERT_EQ(STRING_TRUNCATED, tixiGetFloatVectorInto(documentHandleAdd, "/a/test", values, 3, &count));
+  ASSERT_EQ(5, count);
+  ASSERT_EQ(-3., values[2]);
+  ASSERT_EQ(0., values[4]);
+  ASSERT_EQ(SUCCESS, tixiGetFloatVectorInto(documentHandleAdd, "/a/test", values, 5, NULL));
+
+  ASSERT_EQ(INVALID_HANDLE, tixiGetFloatVectorInto(-1, "/a/test", values, 5, &count));
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiGetFloatVectorInto(documentHandleAdd, "/a/test_not_there", values, 5, &count));
+  ASSERT_EQ(ATTRIBUTE_NOT_FOUND, tixiGetFloatVectorInto(documentHandleAdd, "/a", values, 5, &count));
+}
+
+TEST_F(VectorTests, tixiBase64Vectors)
+{
+  double points[7] = {0., -0., 1. / 3., -2.5e-310, 1.7976931348623157e308, 123456.789, -1.};
+  double values[7];
+  double* readValues = NULL;
+  char* text = NULL;
+  int count = 0;
+
+  ASSERT_EQ(SUCCESS, tixiUseBase64Vectors(documentHandleAdd, 1));
+  ASSERT_EQ(SUCCESS, tixiAddFloatVector(documentHandleAdd, "/a", "test", points, 7, "%g"));
+  ASSERT_EQ(SUCCESS, tixiGetTextAttribute(documentHandleAdd, "/a/test", "encoding", &text));
+  ASSERT_STREQ("base64-le-f64", text);
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandleAdd, "/a/test", &text));
+  ASSERT_EQ(76u, strlen(text));
+
+  // the values are stored exactly
+  ASSERT_EQ(SUCCESS, tixiGetVectorSize(documentHandleAdd, "/a/test", &count));
+  ASSERT_EQ(7, count);
+  ASSERT_EQ(SUCCESS, tixiGetFloatVector(documentHandleAdd, "/a/test", &readValues, 7));
+  ASSERT_EQ(SUCCESS, tixiGetFloatVectorInto(documentHandleAdd, "/a/test", values, 7, &count));
+  for (int i = 0; i < 7; ++i) {
+    ASSERT_EQ(0, memcmp(&points[i], &readValues[i], sizeof(double)));
+    ASSERT_EQ(0, memcmp(&points[i], &values[i], sizeof(double)));
+  }
+  ASSERT_EQ(STRING_TRUNCATED, tixiGetFloatVectorInto(documentHandleAdd, "/a/test", values, 2, &count));
+  ASSERT_EQ(7, count);
+
+  // 1.0 and 2.0 as little endian doubles, with line breaks
+  ASSERT_EQ(SUCCESS, tixiUpdateTextElement(documentHandleAdd, "/a/test", "AAAAAAAA\n 8D8AAAAA\n AAAAQA=="));
+  ASSERT_EQ(SUCCESS, tixiGetFloatVector(documentHandleAdd, "/a/test", &readValues, 2));
+  ASSERT_EQ(1., readValues[0]);
+  ASSERT_EQ(2., readValues[1]);
+
+  ASSERT_EQ(SUCCESS, tixiUpdateTextElement(documentHandleAdd, "/a/test", "AAAAAAAA8D8A;AAAAAAAQA=="));
+  ASSERT_EQ(FAILED, tixiGetVectorSize(documentHandleAdd, "/a/test", &count));
+  ASSERT_EQ(SUCCESS, tixiUpdateTextElement(documentHandleAdd, "/a/test", "AAAAAAA="));
+  ASSERT_EQ(FAILED, tixiGetFloatVector(documentHandleAdd, "/a/test", &readValues, 1));
+
+  // the encoding follows the setting when updating
+  ASSERT_EQ(SUCCESS, tixiAddFloatVector(documentHandleAdd, "/a", "plain", points, 7, NULL));
+  ASSERT_EQ(SUCCESS, tixiUseBase64Vectors(documentHandleAdd, 0));
+  ASSERT_EQ(SUCCESS, tixiAddFloatVector(documentHandleAdd, "/a", "text", points, 7, NULL));
+  ASSERT_EQ(ATTRIBUTE_NOT_FOUND, tixiCheckAttribute(documentHandleAdd, "/a/text", "encoding"));
+  ASSERT_EQ(SUCCESS, tixiUseBase64Vectors(documentHandleAdd, 1));
+  ASSERT_EQ(SUCCESS, tixiUpdateFloatVector(documentHandleAdd, "/a/text", points, 7, NULL));
+  ASSERT_EQ(SUCCESS, tixiCheckAttribute(documentHandleAdd, "/a/text", "encoding"));
+  ASSERT_EQ(SUCCESS, tixiUseBase64Vectors(documentHandleAdd, 0));
+  ASSERT_EQ(SUCCESS, tixiUpdateFloatVector(documentHandleAdd, "/a/test", points, 7, NULL));
+  ASSERT_EQ(ATTRIBUTE_NOT_FOUND, tixiCheckAttribute(documentHandleAdd, "/a/test", "encoding"));
+  ASSERT_EQ(SUCCESS, tixiGetVectorSize(documentHandleAdd, "/a/test", &count));
+  ASSERT_EQ(7, count);
+
+  ASSERT_EQ(FAILED, tixiUseBase64Vectors(documentHandleAdd, 2));
+  ASSERT_EQ(INVALID_HANDLE, tixiUseBase64Vectors(-1, 1));
+}
+
+TEST_F(VectorTests, tixiBase64Arrays)
+{
+  double dimension[3] = {1., 2., 3.};
+  double parameter[6] = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6};
+  double* values = NULL;
+  int sizes[2];
+  int arraySize = 0;
+
+  ASSERT_EQ(SUCCESS, tixiCreateElement(documentHandleAdd, "/a", "map"));
+  ASSERT_EQ(SUCCESS, tixiUseBase64Vectors(documentHandleAdd, 1));
+  ASSERT_EQ(SUCCESS, tixiAddFloatVector(documentHandleAdd, "/a/map", "x", dimension, 3, NULL));
+  ASSERT_EQ(SUCCESS, tixiUseBase64Vectors(documentHandleAdd, 0));
+  ASSERT_EQ(SUCCESS, tixiAddFloatVector(documentHandleAdd, "/a/map", "y", dimension, 2, NULL));
+  ASSERT_EQ(SUCCESS, tixiUseBase64Vectors(documentHandleAdd, 1));
+  ASSERT_EQ(SUCCESS, tixiAddFloatVector(documentHandleAdd, "/a/map", "p", parameter, 6, NULL));
+  ASSERT_EQ(SUCCESS, tixiAddTextAttribute(documentHandleAdd, "/a/map/p", "mapType", "array"));
+
+  ASSERT_EQ(SUCCESS, tixiGetArrayDimensionSizes(documentHandleAdd, "/a/map", sizes, &arraySize));
+  ASSERT_EQ(3, sizes[0]);
+  ASSERT_EQ(2, sizes[1]);
+  ASSERT_EQ(6, arraySize);
+  ASSERT_EQ(SUCCESS, tixiGetArray(documentHandleAdd, "/a/map", "p", 6, &values));
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_EQ(parameter[i], values[i]);
+  }
+  // paths with several results are read without the cached descriptor
+  ASSERT_EQ(SUCCESS, tixiGetArray(documentHandleAdd, "/a/map|/a/none", "p", 6, &values));
+  ASSERT_EQ(parameter[5], values[5]);
+
+  ASSERT_EQ(SUCCESS, tixiUpdateTextElement(documentHandleAdd, "/a/map/p", "AAAA"));
+  ASSERT_EQ(FAILED, tixiGetArray(documentHandleAdd, "/a/map", "p", 6, &values));
+}
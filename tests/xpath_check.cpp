@@ -22,6 +22,9 @@
 #include "tixiInternal.h"
 #include "xpathFunctions.h"
 
+#include <string>
+#include <vector>
+
 
 static const char* xPathXmlFilename = "TestData/xpathsEvaluate.xml";
 
@@ -71,6 +74,125 @@ TEST_F(XPathChecks, tixiXPathExpressionGetTextByIndex_char)
   ASSERT_TRUE( !strcmp(text, "schlumpf"));
 }
 
+TEST_F(XPathChecks, tixiXPathExpressionGetTextByIndexInto)
+{
+  char buffer[16];
+  int requiredSize = 0;
+
+  ASSERT_EQ(SUCCESS, tixiXPathExpressionGetTextByIndexInto(documentHandle, "//@uID", 4, buffer, sizeof(buffer), &requiredSize));
+  ASSERT_STREQ("schlumpf", buffer);
+  ASSERT_EQ(9, requiredSize);
+
+  ASSERT_EQ(SUCCESS, tixiXPathExpressionGetTextByIndexInto(documentHandle, "/root/a/b", 2, buffer, sizeof(buffer), &requiredSize));
+  ASSERT_STREQ("Blupp", buffer);
+
+  ASSERT_EQ(STRING_TRUNCATED, tixiXPathExpressionGetTextByIndexInto(documentHandle, "/root/a/b", 3, buffer, 3, &requiredSize));
+  ASSERT_STREQ("No", buffer);
+  ASSERT_EQ(7, requiredSize);
+
+  ASSERT_EQ(FAILED, tixiXPathExpressionGetTextByIndexInto(documentHandle, "/root/a/b", 10, buffer, sizeof(buffer), &requiredSize));
+}
+
+TEST_F(XPathChecks, compiledExpressionCache)
+{
+  size_t hits = 0, misses = 0;
+  char* text = NULL;
+
+  // simple paths like /root/a[1]/b[2] do not use the XPath engine
+  ASSERT_EQ(SUCCESS, tixiSetXPathCacheSize(2));
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandle, "//a[1]/b[2]", &text));
+    ASSERT_STREQ("Blupp", text);
+  }
+  ASSERT_EQ(SUCCESS, tixiGetXPathCacheStatistics(&hits, &misses));
+  ASSERT_EQ(4u, hits);
+  ASSERT_EQ(1u, misses);
+
+  // the least recently used expression is removed
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandle, "//a[2]/b[1]", &text));
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandle, "//a[2]/b[2]", &text));
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandle, "//a[1]/b[2]", &text));
+  ASSERT_STREQ("Blupp", text);
+  ASSERT_EQ(SUCCESS, tixiGetXPathCacheStatistics(&hits, &misses));
+  ASSERT_EQ(4u, hits);
+  ASSERT_EQ(4u, misses);
+
+  // invalid expressions are not cached
+  ASSERT_EQ(INVALID_XPATH, tixiGetTextElement(documentHandle, "//a[[1]", &text));
+  ASSERT_EQ(INVALID_XPATH, tixiGetTextElement(documentHandle, "//a[[1]", &text));
+
+  // disabled cache
+  ASSERT_EQ(SUCCESS, tixiSetXPathCacheSize(0));
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandle, "//a[1]/b[2]", &text));
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandle, "//a[1]/b[2]", &text));
+  ASSERT_STREQ("Blupp", text);
+  ASSERT_EQ(SUCCESS, tixiGetXPathCacheStatistics(&hits, &misses));
+  ASSERT_EQ(0u, hits);
+  ASSERT_EQ(2u, misses);
+
+  ASSERT_EQ(FAILED, tixiSetXPathCacheSize(-1));
+  ASSERT_EQ(SUCCESS, tixiSetXPathCacheSize(1024));
+}
+
+TEST(XPathSimplePaths, sameResultAsXPath)
+{
+  const char* xml =
+      "<root xmlns:n=\"urn:n\">"
+      "  <!-- comment -->"
+      "  <a uID=\"a1\"><b>1</b><b uID=\"b2\">2</b><c/></a>"
+      "  <a uID='a2'><b>3</b><n:b>4</n:b><d><b>5</b></d></a>"
+      "  <a><c xmlns=\"urn:default\"/><e.f-g_h1 name=\"x&amp;y\"/></a>"
+      "</root>";
+  const char* paths[] = {
+    "/root", "/root/a", "/root/a[1]", "/root/a[2]/b", "/root/a[3]", "/root/a[4]", "/root/a/b",
+    "/root/a/c", "/root/a[3]/c", "/root/a[1]/b[2]", "/root/a[1]/b[3]", "/root/a[01]/b[0002]",
+    "/root/a[@uID=\"a2\"]/d/b", "/root/a[@uID='a1']/b[@uID='b2']", "/root/a[@uID=\"a3\"]",
+    "/root/a/b[@uID=\"b2\"]", "/root/a/e.f-g_h1[@name=\"x&y\"]", "/root/a[@uID=\"\"]", "/root/x",
+    "/other", "/root/a/d/b"
+  };
+  const char* complexPaths[] = {
+    "//a", "/root/a[0]", "/root/a[last()]", "/root/n:b", "/root/*", "/root/a/..", "/root/a[ 1]",
+    "/root/a[@uID=\"a1\"][1]", "/root/a/@uID", "/root/a/text()", "root/a", "/root/a[@uID=a1]",
+    "/root//b", "/root/a[1", ""
+  };
+  TixiDocumentHandle handle = -1;
+
+  ASSERT_EQ(SUCCESS, tixiImportFromString(xml, &handle));
+  TixiDocument* document = getDocument(handle);
+  xmlXPathContextPtr context = XPathGetContext(document);
+
+  for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); ++i) {
+    xmlNodePtr node = NULL;
+    int nNodes = XPathResolveSimplePath(context, paths[i], &node);
+    xmlXPathObjectPtr xpathObject = XPathEvaluate(context, paths[i]);
+    ASSERT_TRUE(xpathObject != NULL) << paths[i];
+
+    int expected = xmlXPathNodeSetGetLength(xpathObject->nodesetval);
+    ASSERT_EQ(expected > 2 ? 2 : expected, nNodes) << paths[i];
+    if (expected > 0) {
+      ASSERT_EQ(xmlXPathNodeSetItem(xpathObject->nodesetval, 0), node) << paths[i];
+    }
+    xmlXPathFreeObject(xpathObject);
+  }
+
+  for (size_t i = 0; i < sizeof(complexPaths) / sizeof(complexPaths[0]); ++i) {
+    xmlNodePtr node = NULL;
+    ASSERT_EQ(-1, XPathResolveSimplePath(context, complexPaths[i], &node)) << complexPaths[i];
+  }
+
+  // public api on both code paths
+  char* text = NULL;
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(handle, "/root/a[2]/d/b/", &text));
+  ASSERT_STREQ("5", text);
+  int nChilds = 0;
+  ASSERT_EQ(SUCCESS, tixiGetNumberOfChilds(handle, "/root/a[@uID='a1']", &nChilds));
+  ASSERT_EQ(3, nChilds);
+  ASSERT_EQ(ELEMENT_PATH_NOT_UNIQUE, tixiGetNumberOfChilds(handle, "/root/a/b", &nChilds));
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiGetNumberOfChilds(handle, "/root/a[@uID=\"a3\"]", &nChilds));
+  ASSERT_EQ(NOT_AN_ELEMENT, tixiGetNumberOfChilds(handle, "/root/a[1]/@uID", &nChilds));
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(handle));
+}
+
 TEST_F(XPathChecks, XPathEvaluateExpression)
 {
   TixiDocument* document = getDocument(documentHandle);
@@ -229,3 +351,115 @@ TEST_F(XPathChecks, tixiXPathExpressionGetXPath)
   ASSERT_EQ(INVALID_HANDLE, tixiXPathExpressionGetXPath(-1, "//a", 1, &xpath));
 }
 
+
+namespace
+{
+  struct VisitedNode
+  {
+    std::string name;
+    std::string text;
+    std::string xPath;
+    bool hasName;
+    bool hasText;
+  };
+
+  struct NodeCollector
+  {
+    std::vector<VisitedNode> nodes;
+    int stopAfter;
+  };
+
+  int collectNode(int index, const char* elementName, const char* text, const char* xPath, void* userData)
+  {
+    NodeCollector* collector = static_cast<NodeCollector*>(userData);
+    VisitedNode node;
+    node.hasName = elementName != NULL;
+    node.hasText = text != NULL;
+    node.name = elementName ? elementName : "";
+    node.text = text ? text : "";
+    node.xPath = xPath ? xPath : "";
+    collector->nodes.push_back(node);
+    EXPECT_EQ((int) collector->nodes.size(), index);
+    return (int) collector->nodes.size() == collector->stopAfter;
+  }
+}
+
+TEST(XPathIteration, sameResultAsIndexedAccess)
+{
+  // mixed siblings of the same and of different names, a namespaced element, attributes and text nodes
+  TixiDocumentHandle handle = -1;
+  ASSERT_EQ(SUCCESS, tixiImportFromString("<r xmlns:n=\"urn:n\"><a>1</a><b>x<!--c-->y</b><a u=\"v\">2</a><c/>"
+                                          "<n:a>3</n:a><a><a>4</a><d/><a>5</a></a><e n:q=\"w\"><f/><n:g><f/><f/></n:g></e></r>", &handle));
+
+  const char* expressions[] = {"//*", "//a", "/r/a[2] | /r/c | //f", "//@*", "//text()", "/r/*/a", "//d/following-sibling::*"};
+  for (size_t i = 0; i < sizeof(expressions) / sizeof(expressions[0]); ++i) {
+    NodeCollector collector;
+    int number = 0;
+    collector.stopAfter = -1;
+    ASSERT_EQ(SUCCESS, tixiXPathExpressionForEach(handle, expressions[i], collectNode, &collector));
+    ASSERT_EQ(SUCCESS, tixiXPathEvaluateNodeNumber(handle, expressions[i], &number));
+    ASSERT_EQ(number, (int) collector.nodes.size()) << expressions[i];
+
+    char** texts = NULL;
+    int nTexts = 0;
+    ASSERT_EQ(SUCCESS, tixiXPathExpressionGetAllTexts(handle, expressions[i], &texts, &nTexts));
+    ASSERT_EQ(number, nTexts);
+
+    for (int index = 1; index <= number; ++index) {
+      const VisitedNode& node = collector.nodes[index - 1];
+      char* xPath = NULL;
+      char* text = NULL;
+      ASSERT_EQ(SUCCESS, tixiXPathExpressionGetXPath(handle, expressions[i], index, &xPath));
+      ASSERT_STREQ(xPath, node.xPath.c_str()) << expressions[i];
+      if (tixiXPathExpressionGetTextByIndex(handle, expressions[i], index, &text) == SUCCESS) {
+        ASSERT_STREQ(text, node.text.c_str()) << expressions[i];
+        ASSERT_STREQ(text, texts[index - 1]) << expressions[i];
+      }
+    }
+  }
+
+  NodeCollector collector;
+  collector.stopAfter = -1;
+  ASSERT_EQ(SUCCESS, tixiXPathExpressionForEach(handle, "/r/b | /r/b/text() | /r/a[2]/@u", collectNode, &collector));
+  ASSERT_EQ(4u, collector.nodes.size());
+  ASSERT_EQ("b", collector.nodes[0].name);
+  ASSERT_EQ("xy", collector.nodes[0].text);
+  ASSERT_FALSE(collector.nodes[1].hasName);
+  ASSERT_EQ("x", collector.nodes[1].text);
+  ASSERT_EQ("y", collector.nodes[2].text);
+  ASSERT_EQ("u", collector.nodes[3].name);
+  ASSERT_EQ("v", collector.nodes[3].text);
+  ASSERT_EQ("/r/a[2]/@u", collector.nodes[3].xPath);
+
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(handle));
+}
+
+TEST_F(XPathChecks, forEachStopsAndReportsErrors)
+{
+  NodeCollector collector;
+  collector.stopAfter = 2;
+  ASSERT_EQ(SUCCESS, tixiXPathExpressionForEach(documentHandle, "//b", collectNode, &collector));
+  ASSERT_EQ(2u, collector.nodes.size());
+  ASSERT_EQ("/root/a[1]/b[2]", collector.nodes[1].xPath);
+  ASSERT_EQ("Blupp", collector.nodes[1].text);
+
+  // empty results are no error, unlike for tixiXPathEvaluateNodeNumber
+  collector.nodes.clear();
+  ASSERT_EQ(SUCCESS, tixiXPathExpressionForEach(documentHandle, "//c", collectNode, &collector));
+  ASSERT_EQ(0u, collector.nodes.size());
+
+  char** texts = NULL;
+  int number = -1;
+  ASSERT_EQ(SUCCESS, tixiXPathExpressionGetAllTexts(documentHandle, "//c", &texts, &number));
+  ASSERT_EQ(0, number);
+  ASSERT_TRUE(texts == NULL);
+  ASSERT_EQ(SUCCESS, tixiXPathExpressionGetAllTexts(documentHandle, "//b/@uID", &texts, &number));
+  ASSERT_EQ(4, number);
+  ASSERT_STREQ("empty_element", texts[3]);
+
+  ASSERT_EQ(INVALID_XPATH, tixiXPathExpressionForEach(documentHandle, "//a[", collectNode, &collector));
+  ASSERT_EQ(INVALID_XPATH, tixiXPathExpressionGetAllTexts(documentHandle, "//a[", &texts, &number));
+  ASSERT_EQ(FAILED, tixiXPathExpressionForEach(documentHandle, "//a", NULL, NULL));
+  ASSERT_EQ(INVALID_HANDLE, tixiXPathExpressionForEach(-1, "//a", collectNode, &collector));
+  ASSERT_EQ(INVALID_HANDLE, tixiXPathExpressionGetAllTexts(-1, "//a", &texts, &number));
+}